@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2015 Akihiro Kaneda.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1.Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   2.Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   3.Neither the name of the Monochrome Soft nor the names of its contributors
+ *     may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!
+ @file AKArchiveFileUtils.cpp
+ @brief アーカイブファイル読み込みクラス定義
+ 
+ リソースファイルをアセットアーカイブから読み込むFileUtilsを定義する。
+ */
+
+#include "AKArchiveFileUtils.h"
+
+#if CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID
+
+#include "AKAssetArchive.h"
+#include <android/asset_manager.h>
+
+using std::string;
+using cocos2d::Data;
+using cocos2d::FileUtils;
+using cocos2d::FileUtilsAndroid;
+
+/*!
+ @brief FileUtilsの置き換え
+ 
+ FileUtilsのインスタンスをこのクラスに置き換える。
+ 置き換え前に設定した検索パスは破棄されるため、検索パスの設定より前に呼び出すこと。
+ */
+void AKArchiveFileUtils::install()
+{
+    AKArchiveFileUtils *fileUtils = new AKArchiveFileUtils();
+    if (!fileUtils->init()) {
+        AKAssert(false, "FileUtilsの初期化に失敗");
+        delete fileUtils;
+        return;
+    }
+    
+    FileUtils::setDelegate(fileUtils);
+}
+
+/*!
+ @brief 文字列読み込み
+ 
+ ファイルの内容を文字列として読み込む。
+ アーカイブに格納されている場合はアーカイブのメモリからコピーする。
+ @param filename ファイル名
+ @return ファイルの内容
+ */
+string AKArchiveFileUtils::getStringFromFile(const string &filename)
+{
+    const unsigned char *bytes = NULL;
+    ssize_t size = 0;
+    if (findInArchive(fullPathForFilename(filename), &bytes, &size)) {
+        return string(reinterpret_cast<const char*>(bytes), size);
+    }
+    
+    return FileUtilsAndroid::getStringFromFile(filename);
+}
+
+/*!
+ @brief データ読み込み
+ 
+ ファイルの内容を読み込む。
+ アーカイブに格納されている場合はアーカイブのメモリからコピーする。
+ Dataは内容のメモリを所有して解放するため、アーカイブのメモリを直接渡すことはできない。
+ @param filename ファイル名
+ @return ファイルの内容
+ */
+Data AKArchiveFileUtils::getDataFromFile(const string &filename)
+{
+    const unsigned char *bytes = NULL;
+    ssize_t size = 0;
+    if (findInArchive(fullPathForFilename(filename), &bytes, &size)) {
+        Data data;
+        data.copy(bytes, size);
+        return data;
+    }
+    
+    return FileUtilsAndroid::getDataFromFile(filename);
+}
+
+/*!
+ @brief ファイル存在確認
+ 
+ ファイルが存在するかどうかを確認する。
+ アーカイブに格納されている場合はアセットを開かずに存在するものとする。
+ それ以外はFileUtilsAndroidと同じ方法で確認する(OBBファイルは使用しないため対象外)。
+ @param strFilePath ファイルのフルパス
+ @return 存在する場合true
+ */
+bool AKArchiveFileUtils::isFileExistInternal(const string &strFilePath) const
+{
+    if (strFilePath.empty()) {
+        return false;
+    }
+    
+    const unsigned char *bytes = NULL;
+    ssize_t size = 0;
+    if (findInArchive(strFilePath, &bytes, &size)) {
+        return true;
+    }
+    
+    // 相対パスの場合はAPK内のアセットを確認する
+    if (strFilePath[0] != '/') {
+        string assetPath = strFilePath;
+        if (assetPath.find(_defaultResRootPath) == 0) {
+            assetPath = assetPath.substr(_defaultResRootPath.size());
+        }
+        
+        AAssetManager *manager = getAssetManager();
+        if (manager == NULL) {
+            return false;
+        }
+        
+        AAsset *asset = AAssetManager_open(manager, assetPath.c_str(), AASSET_MODE_UNKNOWN);
+        if (asset == NULL) {
+            return false;
+        }
+        AAsset_close(asset);
+        return true;
+    }
+    
+    // 絶対パスの場合はファイルを開けるかどうか確認する
+    FILE *fp = fopen(strFilePath.c_str(), "r");
+    if (fp == NULL) {
+        return false;
+    }
+    fclose(fp);
+    return true;
+}
+
+/*!
+ @brief アーカイブ内のファイル検索
+ 
+ フルパスからAPK内のアセットのルートディレクトリを取り除き、アーカイブ内を検索する。
+ 書き込み用ディレクトリなどの絶対パスのファイルはアーカイブの対象外とする。
+ @param fullPath ファイルのフルパス
+ @param bytes ファイルの内容の先頭(出力)
+ @param size ファイルのサイズ(出力)
+ @return アーカイブに格納されている場合true
+ */
+bool AKArchiveFileUtils::findInArchive(const string &fullPath, const unsigned char **bytes, ssize_t *size) const
+{
+    if (fullPath.find(_defaultResRootPath) != 0) {
+        return false;
+    }
+    
+    return AKAssetArchive::getInstance()->find(fullPath.substr(_defaultResRootPath.size()), bytes, size);
+}
+
+#endif
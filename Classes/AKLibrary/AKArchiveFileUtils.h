@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013 Akihiro Kaneda.
+ * Copyright (c) 2015 Akihiro Kaneda.
  * All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
@@ -27,41 +27,44 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 /*!
- @file AKNWayAngle.h
- @brief n-way弾角度計算クラス定義
+ @file AKArchiveFileUtils.h
+ @brief アーカイブファイル読み込みクラス定義
  
- n-way弾角度の計算を行うクラスを定義する。
+ リソースファイルをアセットアーカイブから読み込むFileUtilsを定義する。
  */
 
-#ifndef AKNWAYANGLE_H
-#define AKNWAYANGLE_H
+#ifndef AKARCHIVEFILEUTILS_H
+#define AKARCHIVEFILEUTILS_H
 
-#include "AKToritoma.h"
+#include "AKCommon.h"
+
+#if CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID
+
+#include "platform/android/CCFileUtils-android.h"
 
 /*!
- @brief n-way弾角度計算クラス
+ @brief アーカイブファイル読み込みクラス
  
- n-way弾を作成する際の角度を計算するクラス。
+ AndroidのFileUtilsを拡張し、アセットアーカイブに格納されているファイルは
+ APK内の個別のアセットを開かずにアーカイブのメモリから読み込む。
+ アーカイブに格納されていないファイルは元のFileUtilsで読み込む。
  */
-class AKNWayAngle {
-private:
-    /// 弾の角度
-    std::vector<float> m_angles;
-private:
-    // デフォルトコンストラクタは使用禁止にする
-    AKNWayAngle();
+class AKArchiveFileUtils : public cocos2d::FileUtilsAndroid {
 public:
-    // 2点間指定によるn-way角度計算
-    AKNWayAngle(const cocos2d::Vec2 &src, const cocos2d::Vec2 &dest, int count, float interval);
-    // 中心角度指定によるn-way角度計算
-    AKNWayAngle(float center, int count, float interval);
-    // 弾の角度取得
-    const std::vector<float>* getAngles();
-    // 1個目の弾の角度取得
-    float getTopAngle();
+    // FileUtilsの置き換え
+    static void install();
+    // 文字列読み込み
+    virtual std::string getStringFromFile(const std::string &filename);
+    // データ読み込み
+    virtual cocos2d::Data getDataFromFile(const std::string &filename);
+    
 private:
-    // 各弾の角度計算
-    void calcAngles(float center, int count, float interval);
+    // ファイル存在確認
+    virtual bool isFileExistInternal(const std::string &strFilePath) const;
+    // アーカイブ内のファイル検索
+    bool findInArchive(const std::string &fullPath, const unsigned char **bytes, ssize_t *size) const;
 };
 
-#endif
\ No newline at end of file
+#endif
+
+#endif
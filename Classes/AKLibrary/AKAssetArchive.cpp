@@ -0,0 +1,356 @@
+/*
+ * Copyright (c) 2015 Akihiro Kaneda.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1.Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   2.Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   3.Neither the name of the Monochrome Soft nor the names of its contributors
+ *     may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!
+ @file AKAssetArchive.cpp
+ @brief アセットアーカイブクラス定義
+ 
+ 複数のリソースファイルをまとめたアーカイブをメモリマップして読み込むクラスを定義する。
+ */
+
+#include "AKAssetArchive.h"
+#if CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID
+#include "platform/android/CCFileUtils-android.h"
+#include <android/asset_manager.h>
+#elif (CC_TARGET_PLATFORM != CC_PLATFORM_WIN32) && (CC_TARGET_PLATFORM != CC_PLATFORM_WINRT)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using std::string;
+using cocos2d::FileUtils;
+
+/// マジックナンバー
+static const char kAKArchiveMagic[4] = {'A', 'K', 'P', 'K'};
+/// バージョン(tools/make_asset_archive.pyのVERSIONと合わせる)
+static const uint32_t kAKArchiveVersion = 1;
+/// ヘッダサイズ(マジックナンバー、バージョン、ファイル数、ファイル名領域のサイズ)
+static const size_t kAKArchiveHeaderSize = 16;
+/// エントリのサイズ
+static const size_t kAKArchiveEntrySize = 24;
+/// FNV-1a 64bitのオフセット基底
+static const uint64_t kAKFNVOffsetBasis = 0xcbf29ce484222325ULL;
+/// FNV-1a 64bitの素数
+static const uint64_t kAKFNVPrime = 0x100000001b3ULL;
+
+/*!
+ @brief ファイル名のハッシュ値計算
+ 
+ ファイル名のハッシュ値をFNV-1a 64bitで計算する。
+ tools/make_asset_archive.pyのfnv1a64と同じ計算を行う。
+ @param name ファイル名
+ @return ハッシュ値
+ */
+static uint64_t calcHash(const string &name)
+{
+    uint64_t hash = kAKFNVOffsetBasis;
+    for (unsigned char c : name) {
+        hash ^= c;
+        hash *= kAKFNVPrime;
+    }
+    return hash;
+}
+
+/*!
+ @brief インスタンス取得
+ 
+ シングルトンのインスタンスを取得する。
+ @return インスタンス
+ */
+AKAssetArchive* AKAssetArchive::getInstance()
+{
+    static AKAssetArchive instance;
+    return &instance;
+}
+
+/*!
+ @brief コンストラクタ
+ 
+ メンバを初期化する。
+ */
+AKAssetArchive::AKAssetArchive() :
+m_bytes(NULL), m_size(0), m_entries(NULL), m_count(0), m_names(NULL), m_handle(NULL)
+{
+}
+
+/*!
+ @brief デストラクタ
+ 
+ アーカイブを閉じる。
+ */
+AKAssetArchive::~AKAssetArchive()
+{
+    close();
+}
+
+/*!
+ @brief アーカイブを開く
+ 
+ アーカイブファイルをメモリマップし、索引を解析する。
+ 既にアーカイブを開いている場合は閉じてから開く。
+ @param fileName アーカイブファイル名(Resourcesからの相対パス)
+ @return 開けた場合true
+ */
+bool AKAssetArchive::open(const string &fileName)
+{
+    close();
+    
+    // アーカイブファイルをメモリマップする
+    if (!map(fileName)) {
+        AKLog(kAKLogAssetArchive_1, "アーカイブなし:%s", fileName.c_str());
+        return false;
+    }
+    
+    // 索引を解析する
+    if (!parseIndex()) {
+        AKAssert(false, "アーカイブが不正:%s", fileName.c_str());
+        close();
+        return false;
+    }
+    
+    AKLog(kAKLogAssetArchive_0, "アーカイブを開いた:%s files=%u size=%lu", fileName.c_str(), m_count, (unsigned long)m_size);
+    return true;
+}
+
+/*!
+ @brief アーカイブを閉じる
+ 
+ メモリマップを解除する。
+ アーカイブから取得したファイルの内容はこれ以降参照できなくなる。
+ */
+void AKAssetArchive::close()
+{
+    if (m_bytes != NULL) {
+        unmap();
+    }
+    
+    m_bytes = NULL;
+    m_size = 0;
+    m_entries = NULL;
+    m_count = 0;
+    m_names = NULL;
+    m_handle = NULL;
+}
+
+/*!
+ @brief アーカイブを開いているかどうか
+ 
+ アーカイブを開いているかどうかを取得する。
+ @return アーカイブを開いている場合true
+ */
+bool AKAssetArchive::isOpen() const
+{
+    return m_bytes != NULL;
+}
+
+/*!
+ @brief ファイル検索
+ 
+ アーカイブに格納されているファイルを検索する。
+ 取得した内容はアーカイブのメモリを直接指しており、コピーは行わない。
+ アーカイブを閉じるまで有効。
+ @param name ファイル名(Resourcesからの相対パス)
+ @param bytes ファイルの内容の先頭(出力)
+ @param size ファイルのサイズ(出力)
+ @return 格納されている場合true
+ */
+bool AKAssetArchive::find(const string &name, const unsigned char **bytes, ssize_t *size) const
+{
+    if (m_entries == NULL) {
+        return false;
+    }
+    
+    // ハッシュ値が一致する最初のエントリを二分探索する
+    // アーカイブは4バイト境界までしか揃っていない場合があるため、ハッシュ値はコピーして比較する
+    uint64_t hash = calcHash(name);
+    uint32_t low = 0;
+    uint32_t high = m_count;
+    while (low < high) {
+        uint32_t middle = low + (high - low) / 2;
+        uint64_t middleHash = 0;
+        memcpy(&middleHash, &m_entries[middle].hash, sizeof(middleHash));
+        if (middleHash < hash) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+    
+    // ハッシュ値が一致するエントリのファイル名を確認する
+    for (uint32_t i = low; i < m_count; i++) {
+        const Entry &entry = m_entries[i];
+        uint64_t entryHash = 0;
+        memcpy(&entryHash, &entry.hash, sizeof(entryHash));
+        if (entryHash != hash) {
+            break;
+        }
+        
+        if (entry.nameLength == name.size() &&
+            memcmp(m_names + entry.nameOffset, name.data(), name.size()) == 0) {
+            
+            *bytes = m_bytes + entry.dataOffset;
+            *size = entry.dataSize;
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+/*!
+ @brief アーカイブファイルのメモリマップ
+ 
+ アーカイブファイルをメモリマップする。
+ Androidの場合はAPK内のアセットをバッファとして開く。
+ 非圧縮で格納されていればAPKがそのままメモリマップされ、コピーは発生しない。
+ @param fileName アーカイブファイル名(Resourcesからの相対パス)
+ @return メモリマップできた場合true
+ */
+bool AKAssetArchive::map(const string &fileName)
+{
+#if CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID
+    
+    AAssetManager *manager = cocos2d::FileUtilsAndroid::getAssetManager();
+    if (manager == NULL) {
+        return false;
+    }
+    
+    AAsset *asset = AAssetManager_open(manager, fileName.c_str(), AASSET_MODE_BUFFER);
+    if (asset == NULL) {
+        return false;
+    }
+    
+    const void *buffer = AAsset_getBuffer(asset);
+    if (buffer == NULL) {
+        AAsset_close(asset);
+        return false;
+    }
+    
+    m_bytes = static_cast<const unsigned char*>(buffer);
+    m_size = AAsset_getLength(asset);
+    m_handle = asset;
+    return true;
+    
+#elif (CC_TARGET_PLATFORM == CC_PLATFORM_WIN32) || (CC_TARGET_PLATFORM == CC_PLATFORM_WINRT)
+    
+    // Windowsはアーカイブに対応しない(個別のファイルを読み込む)
+    return false;
+    
+#else
+    
+    string path = FileUtils::getInstance()->fullPathForFilename(fileName);
+    if (path.empty()) {
+        return false;
+    }
+    
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    
+    // マップした後はファイルディスクリプタは不要なため閉じる
+    struct stat status;
+    void *mapped = MAP_FAILED;
+    if (fstat(fd, &status) == 0 && status.st_size > 0) {
+        mapped = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    ::close(fd);
+    
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+    
+    m_bytes = static_cast<const unsigned char*>(mapped);
+    m_size = status.st_size;
+    m_handle = mapped;
+    return true;
+    
+#endif
+}
+
+/*!
+ @brief メモリマップの解除
+ 
+ アーカイブファイルのメモリマップを解除する。
+ */
+void AKAssetArchive::unmap()
+{
+#if CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID
+    AAsset_close(static_cast<AAsset*>(m_handle));
+#elif (CC_TARGET_PLATFORM != CC_PLATFORM_WIN32) && (CC_TARGET_PLATFORM != CC_PLATFORM_WINRT)
+    munmap(m_handle, m_size);
+#endif
+}
+
+/*!
+ @brief 索引の解析
+ 
+ ヘッダを検証し、索引とファイル名領域の位置を設定する。
+ 各ファイルの範囲がアーカイブ内に収まっていることもここで確認し、検索時には確認しない。
+ 数値はリトルエンディアンで格納されている(対象の端末はすべてリトルエンディアン)。
+ @return 正しいアーカイブの場合true
+ */
+bool AKAssetArchive::parseIndex()
+{
+    // ヘッダを読み込めない場合はエラーとする
+    if (m_size < kAKArchiveHeaderSize) {
+        return false;
+    }
+    
+    // マジックナンバーとバージョンを確認する
+    const uint32_t *header = reinterpret_cast<const uint32_t*>(m_bytes);
+    if (memcmp(m_bytes, kAKArchiveMagic, sizeof(kAKArchiveMagic)) != 0 || header[1] != kAKArchiveVersion) {
+        return false;
+    }
+    
+    // 索引とファイル名領域がアーカイブ内に収まっていることを確認する
+    uint32_t count = header[2];
+    uint32_t namesSize = header[3];
+    uint64_t indexSize = kAKArchiveHeaderSize + (uint64_t)count * kAKArchiveEntrySize + namesSize;
+    if (indexSize > m_size) {
+        return false;
+    }
+    
+    const Entry *entries = reinterpret_cast<const Entry*>(m_bytes + kAKArchiveHeaderSize);
+    for (uint32_t i = 0; i < count; i++) {
+        const Entry &entry = entries[i];
+        if ((uint64_t)entry.nameOffset + entry.nameLength > namesSize ||
+            (uint64_t)entry.dataOffset + entry.dataSize > m_size) {
+            return false;
+        }
+    }
+    
+    // 索引とファイル名領域の位置を設定する
+    m_entries = entries;
+    m_count = count;
+    m_names = reinterpret_cast<const char*>(m_bytes + kAKArchiveHeaderSize + count * kAKArchiveEntrySize);
+    return true;
+}
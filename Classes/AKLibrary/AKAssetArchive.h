@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2015 Akihiro Kaneda.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1.Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   2.Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   3.Neither the name of the Monochrome Soft nor the names of its contributors
+ *     may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!
+ @file AKAssetArchive.h
+ @brief アセットアーカイブクラス定義
+ 
+ 複数のリソースファイルをまとめたアーカイブをメモリマップして読み込むクラスを定義する。
+ */
+
+#ifndef AKASSETARCHIVE_H
+#define AKASSETARCHIVE_H
+
+#include "AKCommon.h"
+
+/*!
+ @brief アセットアーカイブクラス
+ 
+ tools/make_asset_archive.pyで作成したアーカイブファイルをメモリマップし、
+ 格納されているファイルの内容をコピーせずに参照できるようにする。
+ ファイルはResourcesからの相対パスで指定し、ファイル名のハッシュ値で索引を二分探索する。
+ アーカイブを開いた後は読み込みのみのため、複数のスレッドから同時に検索してよい。
+ アーカイブはproj.android-studioのビルド時に作成してapkに格納する。
+ それ以外のプロジェクトではアーカイブを格納しないため、個別のファイルを読み込む。
+ */
+class AKAssetArchive {
+private:
+    /// 索引のエントリ(アーカイブ内のデータをそのまま参照する)
+    struct Entry {
+        /// ファイル名のハッシュ値
+        uint64_t hash;
+        /// ファイル名のファイル名領域先頭からのオフセット
+        uint32_t nameOffset;
+        /// ファイル名の長さ
+        uint32_t nameLength;
+        /// データのアーカイブ先頭からのオフセット
+        uint32_t dataOffset;
+        /// データのサイズ
+        uint32_t dataSize;
+    };
+    
+    /// アーカイブの先頭
+    const unsigned char *m_bytes;
+    /// アーカイブのサイズ
+    size_t m_size;
+    /// 索引
+    const Entry *m_entries;
+    /// ファイル数
+    uint32_t m_count;
+    /// ファイル名領域
+    const char *m_names;
+    /// メモリマップの解除に使用するハンドル
+    void *m_handle;
+    
+public:
+    // インスタンス取得
+    static AKAssetArchive* getInstance();
+    // デストラクタ
+    ~AKAssetArchive();
+    // アーカイブを開く
+    bool open(const std::string &fileName);
+    // アーカイブを閉じる
+    void close();
+    // アーカイブを開いているかどうか
+    bool isOpen() const;
+    // ファイル検索
+    bool find(const std::string &name, const unsigned char **bytes, ssize_t *size) const;
+    
+private:
+    // コンストラクタ
+    AKAssetArchive();
+    // コピーコンストラクタは使用禁止
+    AKAssetArchive(const AKAssetArchive &other);
+    // 代入演算子は使用禁止
+    AKAssetArchive& operator=(const AKAssetArchive &other);
+    // アーカイブファイルのメモリマップ
+    bool map(const std::string &fileName);
+    // メモリマップの解除
+    void unmap();
+    // 索引の解析
+    bool parseIndex();
+};
+
+#endif
@@ -0,0 +1,453 @@
+/*
+ * Copyright (c) 2015 Akihiro Kaneda.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1.Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   2.Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   3.Neither the name of the Monochrome Soft nor the names of its contributors
+ *     may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!
+ @file AKAssetLoader.cpp
+ @brief アセット読み込みクラス定義
+ 
+ テクスチャアトラスをワーカースレッドで並列に読み込むクラスを定義する。
+ */
+
+#include "AKAssetLoader.h"
+#include <cstdio>
+
+using std::string;
+using std::vector;
+using std::lock_guard;
+using std::unique_lock;
+using std::mutex;
+using std::chrono::steady_clock;
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+using cocos2d::Director;
+using cocos2d::EventCustom;
+using cocos2d::FileUtils;
+using cocos2d::Image;
+using cocos2d::SpriteFrameCache;
+using cocos2d::Texture2D;
+
+/*!
+ @brief 経過時間取得
+ 
+ 基準時刻からの経過時間をマイクロ秒単位で取得する。
+ @param begin 基準時刻
+ @param end 時刻
+ @return 経過時間(マイクロ秒)
+ */
+static long long getElapsedTime(const steady_clock::time_point &begin, const steady_clock::time_point &end)
+{
+    return duration_cast<microseconds>(end - begin).count();
+}
+
+/*!
+ @brief インスタンス取得
+ 
+ シングルトンのインスタンスを取得する。
+ @return インスタンス
+ */
+AKAssetLoader* AKAssetLoader::getInstance()
+{
+    static AKAssetLoader instance;
+    return &instance;
+}
+
+/*!
+ @brief コンストラクタ
+ 
+ タイムラインの基準時刻を設定する。
+ */
+AKAssetLoader::AKAssetLoader() :
+m_nextDecode(0), m_remainCount(0), m_afterUpdateListener(NULL), m_startTime(steady_clock::now())
+{
+}
+
+/*!
+ @brief デストラクタ
+ 
+ ワーカースレッドの終了を待ち、メンバを解放する。
+ */
+AKAssetLoader::~AKAssetLoader()
+{
+    for (std::thread &worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    
+    for (Asset *asset : m_assets) {
+        if (asset->image != NULL) {
+            asset->image->release();
+        }
+        delete asset;
+    }
+}
+
+/*!
+ @brief テクスチャアトラス読み込み要求
+ 
+ テクスチャアトラスの読み込みを要求する。
+ ファイルの読み込みと画像のデコードはワーカースレッドで行う。
+ ファイルのパスはメインスレッドで決定しておき、ワーカースレッドで検索パスを参照しないようにする。
+ @param plistName テクスチャアトラス定義ファイル名
+ @param imageName 画像ファイル名
+ */
+void AKAssetLoader::requestSpriteFrames(const char *plistName, const char *imageName)
+{
+    // 要求済みの場合は無処理
+    if (findAsset(plistName) != NULL) {
+        return;
+    }
+    
+    AKLog(kAKLogAssetLoader_1, "読み込み要求:%s", plistName);
+    
+    Asset *asset = new Asset();
+    asset->plistName = plistName;
+    asset->plistPath = FileUtils::getInstance()->fullPathForFilename(plistName);
+    asset->imagePath = FileUtils::getInstance()->fullPathForFilename(imageName);
+    asset->image = NULL;
+    asset->isDecoded = false;
+    asset->isLoaded = false;
+    asset->worker = -1;
+    asset->requestTime = steady_clock::now();
+    
+    // ワーカースレッドの数はメインスレッドの分を除いたコア数とし、最大数までとする
+    int maxWorkers = static_cast<int>(std::thread::hardware_concurrency());
+    if (maxWorkers > 1) {
+        maxWorkers--;
+    }
+    if (maxWorkers > kAKAssetLoaderMaxWorkers) {
+        maxWorkers = kAKAssetLoaderMaxWorkers;
+    }
+    
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_assets.push_back(asset);
+        m_remainCount++;
+        
+        // 処理中のワーカースレッドの数を数える
+        int runningCount = 0;
+        for (int i = 0; i < static_cast<int>(m_isWorkerRunning.size()); i++) {
+            if (m_isWorkerRunning[i]) {
+                runningCount++;
+            }
+        }
+        
+        // デコード待ちのアセットの数より少なく、最大数に達していない場合はワーカースレッドを開始する
+        // 処理するアセットがなくなったワーカースレッドは終了しているため、その枠を再利用する
+        if (runningCount < static_cast<int>(m_assets.size()) - m_nextDecode && runningCount < maxWorkers) {
+            
+            int slot = 0;
+            while (slot < static_cast<int>(m_isWorkerRunning.size()) && m_isWorkerRunning[slot]) {
+                slot++;
+            }
+            
+            if (slot < static_cast<int>(m_workers.size())) {
+                if (m_workers[slot].joinable()) {
+                    m_workers[slot].join();
+                }
+                m_workers[slot] = std::thread(&AKAssetLoader::run, this, slot);
+                m_isWorkerRunning[slot] = true;
+            }
+            else {
+                m_workers.push_back(std::thread(&AKAssetLoader::run, this, slot));
+                m_isWorkerRunning.push_back(true);
+            }
+        }
+    }
+    
+    // 更新処理終了イベントのリスナーを登録する
+    if (m_afterUpdateListener == NULL) {
+        m_afterUpdateListener = Director::getInstance()->getEventDispatcher()->addCustomEventListener(Director::EVENT_AFTER_UPDATE, CC_CALLBACK_1(AKAssetLoader::onAfterUpdate, this));
+    }
+}
+
+/*!
+ @brief テクスチャアトラス登録
+ 
+ テクスチャアトラスのスプライトフレームをスプライトフレームキャッシュに登録する。
+ 読み込み要求済みで登録前の場合はデコードが終わるまで待ってから登録する。
+ それ以外の場合はスプライトフレームキャッシュから直接読み込む。
+ テクスチャは登録済みのものが使用されるため、画像のデコードは行われない。
+ @param plistName テクスチャアトラス定義ファイル名
+ @param imageName 画像ファイル名
+ */
+void AKAssetLoader::addSpriteFrames(const char *plistName, const char *imageName)
+{
+    Asset *asset = findAsset(plistName);
+    
+    // 読み込み要求していない場合、登録済みの場合はスプライトフレームキャッシュから読み込む
+    if (asset == NULL || asset->isLoaded) {
+        SpriteFrameCache::getInstance()->addSpriteFramesWithFile(plistName, imageName);
+        return;
+    }
+    
+    // デコードが終わるまで待つ
+    {
+        unique_lock<mutex> lock(m_mutex);
+        while (!asset->isDecoded) {
+            m_condition.wait(lock);
+        }
+    }
+    
+    load(asset);
+}
+
+/*!
+ @brief タイムラインの目印追加
+ 
+ 現在時刻にタイムラインの目印を追加する。
+ @param name 名前
+ */
+void AKAssetLoader::markMilestone(const char *name)
+{
+    Milestone milestone = {name, steady_clock::now()};
+    m_milestones.push_back(milestone);
+    
+    AKLog(kAKLogAssetLoader_1, "%s:%lldus", name, getElapsedTime(m_startTime, milestone.time));
+}
+
+/*!
+ @brief タイムライン出力ファイル名設定
+ 
+ 要求されたアセットの登録がすべて終わった時にタイムラインを出力するファイル名を設定する。
+ @param fileName ファイル名(書き込み可能なディレクトリからの相対パス)
+ */
+void AKAssetLoader::setTimelineFileName(const char *fileName)
+{
+    m_timelineFileName = fileName;
+}
+
+/*!
+ @brief タイムライン出力
+ 
+ アセットごとの要求、デコード開始、デコード終了、登録終了の時刻と目印の時刻をCSV形式でファイルに出力する。
+ 時刻はこのクラスの作成時からの経過時間(マイクロ秒)とする。
+ @param fileName ファイル名(書き込み可能なディレクトリからの相対パス)
+ @return 出力に成功した場合true
+ */
+bool AKAssetLoader::exportTimeline(const string &fileName) const
+{
+    string path = FileUtils::getInstance()->getWritablePath() + fileName;
+    
+    FILE *fp = fopen(path.c_str(), "w");
+    if (fp == NULL) {
+        AKLog(kAKLogAssetLoader_0, "ファイルを開けない:%s", path.c_str());
+        return false;
+    }
+    
+    fprintf(fp, "asset,worker,request_us,decode_begin_us,decode_end_us,load_end_us\n");
+    for (const Asset *asset : m_assets) {
+        
+        // 登録が終わっていないものは出力しない
+        if (!asset->isLoaded) {
+            continue;
+        }
+        
+        fprintf(fp, "%s,%d,%lld,%lld,%lld,%lld\n",
+                asset->plistName.c_str(),
+                asset->worker,
+                getElapsedTime(m_startTime, asset->requestTime),
+                getElapsedTime(m_startTime, asset->decodeBeginTime),
+                getElapsedTime(m_startTime, asset->decodeEndTime),
+                getElapsedTime(m_startTime, asset->loadEndTime));
+    }
+    
+    fprintf(fp, "\nmilestone,time_us\n");
+    for (const Milestone &milestone : m_milestones) {
+        fprintf(fp, "%s,%lld\n", milestone.name.c_str(), getElapsedTime(m_startTime, milestone.time));
+    }
+    
+    fclose(fp);
+    
+    AKLog(kAKLogAssetLoader_1, "タイムライン出力:%s", path.c_str());
+    
+    return true;
+}
+
+/*!
+ @brief 更新処理終了処理
+ 
+ デコードが終わったアセットを登録する。
+ @param event イベント
+ */
+void AKAssetLoader::onAfterUpdate(EventCustom *event)
+{
+    // デコードが終わったアセットを取得する
+    vector<Asset*> decodedAssets;
+    {
+        lock_guard<mutex> lock(m_mutex);
+        for (Asset *asset : m_assets) {
+            if (asset->isDecoded && !asset->isLoaded) {
+                decodedAssets.push_back(asset);
+            }
+        }
+    }
+    
+    for (Asset *asset : decodedAssets) {
+        load(asset);
+    }
+}
+
+/*!
+ @brief アセット登録
+ 
+ デコードした画像をテクスチャとして転送し、スプライトフレームを登録する。
+ ワーカースレッドでの読み込みに失敗していた場合は、同期的に読み込んで登録する。
+ メインスレッドから呼び出すこと。
+ @param asset アセット
+ */
+void AKAssetLoader::load(Asset *asset)
+{
+    AKAssert(asset->isDecoded && !asset->isLoaded, "アセットの状態が不正:%s", asset->plistName.c_str());
+    
+    // 画像ファイルのパスをキーにしてテクスチャキャッシュに登録する
+    // 画像ファイル名での読み込みと同じキーにすることで、以降の読み込みはこのテクスチャを使用する
+    if (asset->image != NULL && !asset->plistContent.empty()) {
+        Texture2D *texture = Director::getInstance()->getTextureCache()->addImage(asset->image, asset->imagePath);
+        SpriteFrameCache::getInstance()->addSpriteFramesWithFileContent(asset->plistContent, texture);
+    }
+    // ワーカースレッドでの読み込みに失敗した場合は、スプライトフレームが未登録のまま使用されないように
+    // メインスレッドで読み込み直す
+    else {
+        AKLog(kAKLogAssetLoader_0, "ワーカースレッドでの読み込みに失敗:%s", asset->plistName.c_str());
+        SpriteFrameCache::getInstance()->addSpriteFramesWithFile(asset->plistName);
+    }
+    if (asset->image != NULL) {
+        asset->image->release();
+        asset->image = NULL;
+    }
+    asset->plistContent.clear();
+    
+    asset->loadEndTime = steady_clock::now();
+    asset->isLoaded = true;
+    
+    AKLog(kAKLogAssetLoader_1, "%s: decode=%lldus load=%lldus",
+          asset->plistName.c_str(),
+          getElapsedTime(asset->decodeBeginTime, asset->decodeEndTime),
+          getElapsedTime(asset->decodeEndTime, asset->loadEndTime));
+    
+    // すべてのアセットの登録が終わった場合は終了処理を行う
+    m_remainCount--;
+    if (m_remainCount <= 0) {
+        finish();
+    }
+}
+
+/*!
+ @brief アセット検索
+ 
+ テクスチャアトラス定義ファイル名からアセットを検索する。
+ アセットの追加はメインスレッドのみで行うため、メインスレッドからは排他制御なしで検索できる。
+ @param plistName テクスチャアトラス定義ファイル名
+ @return アセット(見つからない場合はNULL)
+ */
+AKAssetLoader::Asset* AKAssetLoader::findAsset(const char *plistName) const
+{
+    for (Asset *asset : m_assets) {
+        if (asset->plistName.compare(plistName) == 0) {
+            return asset;
+        }
+    }
+    return NULL;
+}
+
+/*!
+ @brief ワーカースレッドの処理
+ 
+ デコードしていないアセットを順番に取り出し、ファイル読み込みと画像のデコードを行う。
+ デコードするアセットがなくなった時点で終了する。
+ @param worker ワーカースレッドの番号
+ */
+void AKAssetLoader::run(int worker)
+{
+    while (true) {
+        
+        // 次にデコードするアセットを取り出す
+        Asset *asset = NULL;
+        {
+            lock_guard<mutex> lock(m_mutex);
+            if (m_nextDecode >= static_cast<int>(m_assets.size())) {
+                m_isWorkerRunning[worker] = false;
+                break;
+            }
+            asset = m_assets[m_nextDecode];
+            m_nextDecode++;
+        }
+        
+        Time decodeBeginTime = steady_clock::now();
+        
+        // テクスチャアトラス定義ファイルを読み込む
+        string plistContent = FileUtils::getInstance()->getStringFromFile(asset->plistPath);
+        
+        // 画像ファイルを読み込んでデコードする
+        Image *image = new Image();
+        if (!image->initWithImageFile(asset->imagePath)) {
+            image->release();
+            image = NULL;
+        }
+        
+        // デコード結果を設定して、待っているメインスレッドに通知する
+        {
+            lock_guard<mutex> lock(m_mutex);
+            asset->plistContent.swap(plistContent);
+            asset->image = image;
+            asset->worker = worker;
+            asset->decodeBeginTime = decodeBeginTime;
+            asset->decodeEndTime = steady_clock::now();
+            asset->isDecoded = true;
+        }
+        m_condition.notify_all();
+    }
+}
+
+/*!
+ @brief 全アセット登録終了処理
+ 
+ 更新処理終了イベントのリスナーを削除し、ワーカースレッドの終了を待つ。
+ タイムラインの出力ファイル名が設定されている場合はタイムラインを出力する。
+ */
+void AKAssetLoader::finish()
+{
+    // 更新処理終了イベントのリスナーを削除する
+    if (m_afterUpdateListener != NULL) {
+        Director::getInstance()->getEventDispatcher()->removeEventListener(m_afterUpdateListener);
+        m_afterUpdateListener = NULL;
+    }
+    
+    // デコードするアセットがないため、ワーカースレッドはすぐに終了する
+    for (std::thread &worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    
+    // タイムラインを出力する
+    if (!m_timelineFileName.empty()) {
+        exportTimeline(m_timelineFileName);
+    }
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2015 Akihiro Kaneda.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1.Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   2.Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   3.Neither the name of the Monochrome Soft nor the names of its contributors
+ *     may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!
+ @file AKAssetLoader.h
+ @brief アセット読み込みクラス定義
+ 
+ テクスチャアトラスをワーカースレッドで並列に読み込むクラスを定義する。
+ */
+
+#ifndef AKASSETLOADER_H
+#define AKASSETLOADER_H
+
+#include "AKCommon.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*!
+ @brief アセット読み込みクラス
+ 
+ 起動時に必要なテクスチャアトラスのファイル読み込みと画像のデコードをワーカースレッドで並列に行う。
+ テクスチャの転送とスプライトフレームの登録はメインスレッドで行う。
+ 読み込みが終わったものはフレームの更新処理終了時に登録し、
+ 登録前に使用する場合はそのアセットのデコードが終わるまで待ってから登録する。
+ アセットごとの処理時間はタイムラインとして記録し、ファイルに出力できる。
+ */
+class AKAssetLoader {
+public:
+    /// ワーカースレッドの最大数
+    static const int kAKAssetLoaderMaxWorkers = 3;
+    
+private:
+    /// 時刻
+    typedef std::chrono::steady_clock::time_point Time;
+    
+    /// アセットの状態
+    struct Asset {
+        /// テクスチャアトラス定義ファイル名
+        std::string plistName;
+        /// テクスチャアトラス定義ファイルのフルパス
+        std::string plistPath;
+        /// 画像ファイルのフルパス
+        std::string imagePath;
+        /// テクスチャアトラス定義ファイルの内容
+        std::string plistContent;
+        /// デコードした画像
+        cocos2d::Image *image;
+        /// デコードが終わったかどうか
+        bool isDecoded;
+        /// スプライトフレームの登録が終わったかどうか
+        bool isLoaded;
+        /// 処理したワーカースレッドの番号
+        int worker;
+        /// 読み込み要求時刻
+        Time requestTime;
+        /// デコード開始時刻
+        Time decodeBeginTime;
+        /// デコード終了時刻
+        Time decodeEndTime;
+        /// 登録終了時刻
+        Time loadEndTime;
+    };
+    
+    /// タイムラインの目印
+    struct Milestone {
+        /// 名前
+        std::string name;
+        /// 時刻
+        Time time;
+    };
+    
+    /// アセットの状態
+    std::vector<Asset*> m_assets;
+    /// 次にデコードするアセットの位置
+    int m_nextDecode;
+    /// 登録が終わっていないアセットの数
+    int m_remainCount;
+    /// ワーカースレッド
+    std::vector<std::thread> m_workers;
+    /// ワーカースレッドが処理中かどうか
+    std::vector<bool> m_isWorkerRunning;
+    /// アセットの状態の排他制御
+    std::mutex m_mutex;
+    /// デコード終了の通知
+    std::condition_variable m_condition;
+    /// 更新処理終了イベントのリスナー
+    cocos2d::EventListenerCustom *m_afterUpdateListener;
+    /// タイムラインの基準時刻
+    Time m_startTime;
+    /// タイムラインの目印
+    std::vector<Milestone> m_milestones;
+    /// タイムラインの出力ファイル名(空の場合は出力しない)
+    std::string m_timelineFileName;
+    
+public:
+    // インスタンス取得
+    static AKAssetLoader* getInstance();
+    // デストラクタ
+    ~AKAssetLoader();
+    // テクスチャアトラス読み込み要求
+    void requestSpriteFrames(const char *plistName, const char *imageName);
+    // テクスチャアトラス登録
+    void addSpriteFrames(const char *plistName, const char *imageName);
+    // タイムラインの目印追加
+    void markMilestone(const char *name);
+    // タイムライン出力ファイル名設定
+    void setTimelineFileName(const char *fileName);
+    // タイムライン出力
+    bool exportTimeline(const std::string &fileName) const;
+    
+private:
+    // コンストラクタ
+    AKAssetLoader();
+    // コピーコンストラクタは使用禁止
+    AKAssetLoader(const AKAssetLoader &other);
+    // 代入演算子は使用禁止
+    AKAssetLoader& operator=(const AKAssetLoader &other);
+    // 更新処理終了処理
+    void onAfterUpdate(cocos2d::EventCustom *event);
+    // アセット登録
+    void load(Asset *asset);
+    // アセット検索
+    Asset* findAsset(const char *plistName) const;
+    // ワーカースレッドの処理
+    void run(int worker);
+    // 全アセット登録終了処理
+    void finish();
+};
+
+#endif
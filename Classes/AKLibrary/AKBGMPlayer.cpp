@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2015 Akihiro Kaneda.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1.Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   2.Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   3.Neither the name of the Monochrome Soft nor the names of its contributors
+ *     may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!
+ @file AKBGMPlayer.cpp
+ @brief BGM再生クラス定義
+ 
+ BGMの再生をサウンドエンジン専用スレッドで行うクラスを定義する。
+ */
+
+#include "AKBGMPlayer.h"
+#include "AKSoundThread.h"
+
+using std::string;
+using cocos2d::FileUtils;
+
+/*!
+ @brief インスタンス取得
+ 
+ シングルトンのインスタンスを取得する。
+ @return インスタンス
+ */
+AKBGMPlayer* AKBGMPlayer::getInstance()
+{
+    static AKBGMPlayer instance;
+    return &instance;
+}
+
+/*!
+ @brief コンストラクタ
+ 
+ BGM停止中の状態で作成する。
+ */
+AKBGMPlayer::AKBGMPlayer()
+{
+}
+
+/*!
+ @brief 再生
+ 
+ BGMの再生を開始する。すでに再生中のBGMは停止する。
+ @param fileName ファイル名
+ @param isLoop ループするかどうか
+ */
+void AKBGMPlayer::play(const char *fileName, bool isLoop)
+{
+    // 専用スレッドでフルパスのキャッシュを更新しないように、メインスレッドでフルパスに変換する
+    string path = FileUtils::getInstance()->fullPathForFilename(fileName);
+    if (path.empty()) {
+        AKLog(kAKLogBGMPlayer_0, "ファイルが見つからない:%s", fileName);
+        return;
+    }
+    
+    AKLog(kAKLogBGMPlayer_1, "再生:%s", fileName);
+    
+    AKSoundThread::getInstance()->push(AKSoundThread::kAKSoundCommandPlayBGM, path, isLoop, 0.0f);
+    m_currentPath = path;
+}
+
+/*!
+ @brief 停止
+ 
+ BGMを停止する。
+ */
+void AKBGMPlayer::stop()
+{
+    AKSoundThread::getInstance()->push(AKSoundThread::kAKSoundCommandStopBGM, "", false, 0.0f);
+    m_currentPath.clear();
+}
+
+/*!
+ @brief 一時停止
+ 
+ BGMを一時停止する。
+ */
+void AKBGMPlayer::pause()
+{
+    AKSoundThread::getInstance()->push(AKSoundThread::kAKSoundCommandPauseBGM, "", false, 0.0f);
+}
+
+/*!
+ @brief 再開
+ 
+ 一時停止したBGMを再開する。
+ */
+void AKBGMPlayer::resume()
+{
+    AKSoundThread::getInstance()->push(AKSoundThread::kAKSoundCommandResumeBGM, "", false, 0.0f);
+}
+
+/*!
+ @brief 音量設定
+ 
+ BGMの音量を設定する。
+ @param volume 音量(0.0〜1.0)
+ */
+void AKBGMPlayer::setVolume(float volume)
+{
+    AKSoundThread::getInstance()->push(AKSoundThread::kAKSoundCommandBGMVolume, "", false, volume);
+}
+
+/*!
+ @brief 先読み
+ 
+ 次に再生する予定のBGMのファイルを先読みする。
+ サウンドエンジンはBGMを1曲しか読み込んでおけず、読み込むと再生中のBGMが停止するため、
+ ファイルの内容を少しずつ読み込んでOSのキャッシュに載せておき、再生開始時の読み込みを短くする。
+ 読み込んだ内容はメモリには保持しない。
+ 再生中のBGMと先読み済みのBGMは読み込まない。
+ @param fileName ファイル名
+ */
+void AKBGMPlayer::prefetch(const char *fileName)
+{
+    // 専用スレッドでフルパスのキャッシュを更新しないように、メインスレッドでフルパスに変換する
+    string path = FileUtils::getInstance()->fullPathForFilename(fileName);
+    if (path.empty() || path == m_currentPath || path == m_prefetchedPath) {
+        return;
+    }
+    
+    AKLog(kAKLogBGMPlayer_1, "先読み:%s", fileName);
+    
+    AKSoundThread::getInstance()->push(AKSoundThread::kAKSoundCommandPrefetch, path, false, 0.0f);
+    m_prefetchedPath = path;
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2015 Akihiro Kaneda.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1.Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   2.Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   3.Neither the name of the Monochrome Soft nor the names of its contributors
+ *     may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!
+ @file AKBGMPlayer.h
+ @brief BGM再生クラス定義
+ 
+ BGMの再生をサウンドエンジン専用スレッドで行うクラスを定義する。
+ */
+
+#ifndef AKBGMPLAYER_H
+#define AKBGMPLAYER_H
+
+#include "AKCommon.h"
+
+/*!
+ @brief BGM再生クラス
+ 
+ サウンドエンジンのBGMの処理をサウンドエンジン専用スレッドで順番に実行し、
+ BGMの切り替え時にメインスレッドが止まらないようにする。
+ 次に再生する予定のBGMは先読みしておき、再生開始時のファイル読み込みを短くする。
+ ファイル名のフルパスへの変換はメインスレッドで行う。
+ サウンドエンジンのBGMの処理はすべてこのクラスを通して行うこと。
+ メインスレッドからのみ使用すること。
+ */
+class AKBGMPlayer {
+private:
+    /// 再生中のファイルのフルパス
+    std::string m_currentPath;
+    /// 先読み済みのファイルのフルパス
+    std::string m_prefetchedPath;
+    
+public:
+    // インスタンス取得
+    static AKBGMPlayer* getInstance();
+    // 再生
+    void play(const char *fileName, bool isLoop);
+    // 停止
+    void stop();
+    // 一時停止
+    void pause();
+    // 再開
+    void resume();
+    // 音量設定
+    void setVolume(float volume);
+    // 先読み
+    void prefetch(const char *fileName);
+    
+private:
+    // コンストラクタ
+    AKBGMPlayer();
+    // コピーコンストラクタは使用禁止
+    AKBGMPlayer(const AKBGMPlayer &other);
+    // 代入演算子は使用禁止
+    AKBGMPlayer& operator=(const AKBGMPlayer &other);
+};
+
+#endif
@@ -53,18 +53,38 @@ unsigned long debug_flg = 0;
 // 共通ライブラリ用ログ区分定義
 bool kAKLogAppBankNetworkBanner_0 = true;
 bool kAKLogAppBankNetworkBanner_1 = false;
+bool kAKLogAssetArchive_0 = true;
+bool kAKLogAssetArchive_1 = false;
+bool kAKLogAssetLoader_0 = true;
+bool kAKLogAssetLoader_1 = false;
+bool kAKLogBGMPlayer_0 = true;
+bool kAKLogBGMPlayer_1 = false;
 bool kAKLogFont_0 = true;
 bool kAKLogFont_1 = false;
+bool kAKLogFrameThrottle_0 = true;
+bool kAKLogFrameThrottle_1 = false;
+bool kAKLogInputQueue_0 = true;
+bool kAKLogInputQueue_1 = false;
 bool kAKLogInterface_0 = true;
 bool kAKLogInterface_1 = false;
+bool kAKLogLatencyMonitor_0 = true;
+bool kAKLogLatencyMonitor_1 = false;
 bool kAKLogLabel_0 = true;
 bool kAKLogLabel_1 = false;
 bool kAKLogMenuItem_0 = true;
 bool kAKLogMenuItem_1 = false;
 bool kAKLogNavigationController_0 = true;
 bool kAKLogNavigationController_1 = false;
+bool kAKLogRewindBuffer_0 = true;
+bool kAKLogRewindBuffer_1 = false;
+bool kAKLogScoreSubmitter_0 = true;
+bool kAKLogScoreSubmitter_1 = false;
 bool kAKLogScreenSize_0 = true;
 bool kAKLogScreenSize_1 = false;
+bool kAKLogSEScheduler_0 = true;
+bool kAKLogSEScheduler_1 = false;
+bool kAKLogSoundThread_0 = true;
+bool kAKLogSoundThread_1 = false;
 bool kAKLogTwitterHelper_0 = true;
 bool kAKLogTwitterHelper_1 = false;
 #endif
@@ -262,6 +282,27 @@ std::string MakeOrdinal(int number)
     }
 }
 
+/*!
+ @brief ハッシュ値計算
+ 
+ FNV-1aでハッシュ値を計算する。
+ 前回の計算結果を渡すと、続きのデータとして計算する。
+ 最初はkAKHashOffsetBasisを渡すこと。
+ @param data データ
+ @param size データのサイズ
+ @param hash 前回の計算結果
+ @return ハッシュ値
+ */
+unsigned int AKCalcHash(const void *data, size_t size, unsigned int hash)
+{
+    const unsigned char *bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
 // 経過ミリ秒取得
 unsigned long getMilliSec(struct timeval *prev)
 {
@@ -61,18 +61,38 @@ extern unsigned long debug_flg;
 // ライブラリ用ログ区分
 extern bool kAKLogAppBankNetworkBanner_0;
 extern bool kAKLogAppBankNetworkBanner_1;
+extern bool kAKLogAssetArchive_0;
+extern bool kAKLogAssetArchive_1;
+extern bool kAKLogAssetLoader_0;
+extern bool kAKLogAssetLoader_1;
+extern bool kAKLogBGMPlayer_0;
+extern bool kAKLogBGMPlayer_1;
 extern bool kAKLogFont_0;
 extern bool kAKLogFont_1;
+extern bool kAKLogFrameThrottle_0;
+extern bool kAKLogFrameThrottle_1;
+extern bool kAKLogInputQueue_0;
+extern bool kAKLogInputQueue_1;
 extern bool kAKLogInterface_0;
 extern bool kAKLogInterface_1;
+extern bool kAKLogLatencyMonitor_0;
+extern bool kAKLogLatencyMonitor_1;
 extern bool kAKLogLabel_0;
 extern bool kAKLogLabel_1;
 extern bool kAKLogMenuItem_0;
 extern bool kAKLogMenuItem_1;
 extern bool kAKLogNavigationController_0;
 extern bool kAKLogNavigationController_1;
+extern bool kAKLogRewindBuffer_0;
+extern bool kAKLogRewindBuffer_1;
+extern bool kAKLogScoreSubmitter_0;
+extern bool kAKLogScoreSubmitter_1;
 extern bool kAKLogScreenSize_0;
 extern bool kAKLogScreenSize_1;
+extern bool kAKLogSEScheduler_0;
+extern bool kAKLogSEScheduler_1;
+extern bool kAKLogSoundThread_0;
+extern bool kAKLogSoundThread_1;
 extern bool kAKLogTwitterHelper_0;
 extern bool kAKLogTwitterHelper_1;
 
@@ -175,6 +195,12 @@ cocos2d::LayerColor *AKCreateBackColorLayer(void);
 // 英語の序数詞を作成する
 std::string MakeOrdinal(int number);
 
+/// ハッシュ値計算の初期値(FNV-1a)
+static const unsigned int kAKHashOffsetBasis = 2166136261u;
+
+// ハッシュ値計算
+unsigned int AKCalcHash(const void *data, size_t size, unsigned int hash);
+
 /*!
  @brief 経過ミリ秒取得
  
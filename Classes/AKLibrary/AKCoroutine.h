@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2015 Akihiro Kaneda.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1.Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   2.Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   3.Neither the name of the Monochrome Soft nor the names of its contributors
+ *     may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!
+ @file AKCoroutine.h
+ @brief コルーチン定義
+ 
+ フレーム単位で中断、再開する処理を逐次的に記述するためのマクロを定義する。
+ */
+
+#ifndef AKCOROUTINE_H
+#define AKCOROUTINE_H
+
+/*!
+ @brief コルーチンの実行状態
+ 
+ 中断位置と再開までの待機フレーム数のみを保持する。
+ キャラクターのメンバとして持たせることで、キャラクタープールの領域をそのまま使用し、
+ 生成時にメモリの確保を行わない。
+ 中断をまたいで保持する値はローカル変数ではなく、メンバ変数に保存すること。
+ */
+struct AKCoroutine {
+    int line;   ///< 再開位置(0の場合は先頭から実行)
+    int wait;   ///< 再開までの待機フレーム数
+};
+
+/*!
+ @brief コルーチン初期化
+ 
+ コルーチンを先頭から実行する状態にする。
+ @param co コルーチンの実行状態
+ */
+#define AKCoroutineReset(co) do { (co).line = 0; (co).wait = 0; } while (0)
+
+/*!
+ @brief コルーチン開始
+ 
+ 待機中の場合は待機フレーム数を減らして関数を抜ける。
+ 待機が終わっている場合は前回中断した位置から処理を再開する。
+ AKCoroutineEndと対で使用し、間にswitch文を記述しないこと。
+ @param co コルーチンの実行状態
+ */
+#define AKCoroutineBegin(co) \
+    if ((co).wait > 0 && --(co).wait > 0) { return; } \
+    switch ((co).line) { case 0:
+
+/*!
+ @brief 指定フレーム数待機
+ 
+ 処理を中断し、指定フレーム数経過後にこの位置から再開する。
+ 再開位置に行番号を使用するため、1行に複数記述しないこと。
+ @param co コルーチンの実行状態
+ @param frame 待機フレーム数
+ */
+#define AKCoroutineWait(co, frame) \
+    do { (co).wait = (frame); (co).line = __LINE__; return; case __LINE__:; } while (0)
+
+/*!
+ @brief 1フレーム中断
+ 
+ 処理を中断し、次のフレームでこの位置から再開する。
+ @param co コルーチンの実行状態
+ */
+#define AKCoroutineYield(co) AKCoroutineWait(co, 1)
+
+/*!
+ @brief コルーチン終了
+ 
+ 末尾まで実行した場合は次のフレームで先頭から実行する。
+ @param co コルーチンの実行状態
+ */
+#define AKCoroutineEnd(co) \
+    default: break; } (co).line = 0
+
+#endif
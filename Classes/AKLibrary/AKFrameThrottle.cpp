@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2015 Akihiro Kaneda.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1.Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   2.Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   3.Neither the name of the Monochrome Soft nor the names of its contributors
+ *     may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!
+ @file AKFrameThrottle.cpp
+ @brief フレームレート抑制クラス定義
+ 
+ 入力がない間、画面の更新頻度を下げるクラスを定義する。
+ */
+
+#include "AKFrameThrottle.h"
+#include "base/CCEventListenerController.h"
+
+using cocos2d::Director;
+using cocos2d::EventCustom;
+using cocos2d::EventListenerTouchOneByOne;
+using cocos2d::EventListenerKeyboard;
+using cocos2d::EventListenerController;
+using cocos2d::EventKeyboard;
+using cocos2d::Controller;
+using cocos2d::Touch;
+using cocos2d::Event;
+
+/// 入力がなくなってから抑制するまでの時間(秒)
+const float AKFrameThrottle::kAKFrameThrottleIdleDelay = 1.0f;
+/// アナログキーを入力ありとみなすしきい値
+static const float kAKFrameThrottleAxisThreshold = 0.2f;
+/// 入力イベントのリスナーの優先度(シーンのリスナーより先に受け取り、イベントは消費しない)
+static const int kAKFrameThrottleListenerPriority = -1;
+
+/*!
+ @brief インスタンス取得
+ 
+ シングルトンのインスタンスを取得する。
+ @return インスタンス
+ */
+AKFrameThrottle* AKFrameThrottle::getInstance()
+{
+    static AKFrameThrottle instance;
+    return &instance;
+}
+
+/*!
+ @brief コンストラクタ
+ 
+ メンバを初期化する。
+ */
+AKFrameThrottle::AKFrameThrottle() :
+m_activeInterval(1.0 / 60), m_isEnabled(false), m_isIdle(false), m_idleTime(0.0f),
+m_afterUpdateListener(NULL), m_touchListener(NULL), m_keyboardListener(NULL), m_controllerListener(NULL)
+{
+}
+
+/*!
+ @brief 処理開始
+ 
+ 現在のDirectorの更新間隔を通常時の更新間隔として記憶し、入力イベントの監視を開始する。
+ Directorの更新間隔を設定した後に呼び出すこと。
+ */
+void AKFrameThrottle::start()
+{
+    if (m_afterUpdateListener != NULL) {
+        return;
+    }
+    
+    Director *director = Director::getInstance();
+    cocos2d::EventDispatcher *dispatcher = director->getEventDispatcher();
+    
+    // 通常時の更新間隔を記憶する
+    m_activeInterval = director->getAnimationInterval();
+    
+    // 更新処理終了イベントのリスナーを登録する
+    m_afterUpdateListener = dispatcher->addCustomEventListener(Director::EVENT_AFTER_UPDATE, CC_CALLBACK_1(AKFrameThrottle::onAfterUpdate, this));
+    
+    // タッチイベントのリスナーを登録する
+    // 移動も受け取るためにタッチを要求するが、消費はせずにシーンのリスナーにも渡す
+    m_touchListener = EventListenerTouchOneByOne::create();
+    m_touchListener->setSwallowTouches(false);
+    m_touchListener->onTouchBegan = CC_CALLBACK_2(AKFrameThrottle::onTouchBegan, this);
+    m_touchListener->onTouchMoved = CC_CALLBACK_2(AKFrameThrottle::onTouchMoved, this);
+    dispatcher->addEventListenerWithFixedPriority(m_touchListener, kAKFrameThrottleListenerPriority);
+    
+    // キーイベントのリスナーを登録する
+    m_keyboardListener = EventListenerKeyboard::create();
+    m_keyboardListener->onKeyPressed = CC_CALLBACK_2(AKFrameThrottle::onKeyPressed, this);
+    dispatcher->addEventListenerWithFixedPriority(m_keyboardListener, kAKFrameThrottleListenerPriority);
+    
+    // コントローラーイベントのリスナーを登録する
+    m_controllerListener = EventListenerController::create();
+    m_controllerListener->onKeyDown = CC_CALLBACK_3(AKFrameThrottle::onControllerKeyDown, this);
+    m_controllerListener->onAxisEvent = CC_CALLBACK_3(AKFrameThrottle::onControllerAxisEvent, this);
+    dispatcher->addEventListenerWithFixedPriority(m_controllerListener, kAKFrameThrottleListenerPriority);
+}
+
+/*!
+ @brief 処理終了
+ 
+ 抑制を解除し、イベントの監視を終了する。
+ */
+void AKFrameThrottle::stop()
+{
+    if (m_afterUpdateListener == NULL) {
+        return;
+    }
+    
+    wake();
+    
+    cocos2d::EventDispatcher *dispatcher = Director::getInstance()->getEventDispatcher();
+    dispatcher->removeEventListener(m_afterUpdateListener);
+    dispatcher->removeEventListener(m_touchListener);
+    dispatcher->removeEventListener(m_keyboardListener);
+    dispatcher->removeEventListener(m_controllerListener);
+    m_afterUpdateListener = NULL;
+    m_touchListener = NULL;
+    m_keyboardListener = NULL;
+    m_controllerListener = NULL;
+}
+
+/*!
+ @brief 抑制の有効・無効設定
+ 
+ フレームレートの抑制を行うかどうかを設定する。
+ 無効にした場合は直ちに元の更新間隔に戻す。
+ 有効にした場合も一定時間は元の更新間隔のままとし、画面切替直後の表示を滑らかにする。
+ @param enabled 抑制を行うかどうか
+ */
+void AKFrameThrottle::setEnabled(bool enabled)
+{
+    AKLog(kAKLogFrameThrottle_1 && m_isEnabled != enabled, "enabled=%d", enabled);
+    
+    m_isEnabled = enabled;
+    wake();
+}
+
+/*!
+ @brief 抑制解除
+ 
+ 抑制中の場合は元の更新間隔に戻し、入力がない時間の計測をやり直す。
+ */
+void AKFrameThrottle::wake()
+{
+    m_idleTime = 0.0f;
+    
+    if (m_isIdle) {
+        AKLog(kAKLogFrameThrottle_1, "抑制解除");
+        Director::getInstance()->setAnimationInterval(m_activeInterval);
+        m_isIdle = false;
+    }
+}
+
+/*!
+ @brief 更新処理終了処理
+ 
+ フレームの更新処理終了時に入力がない時間を計測し、一定時間を超えた場合は更新間隔を長くする。
+ @param event イベント
+ */
+void AKFrameThrottle::onAfterUpdate(EventCustom *event)
+{
+    if (!m_isEnabled || m_isIdle) {
+        return;
+    }
+    
+    m_idleTime += Director::getInstance()->getDeltaTime();
+    if (m_idleTime >= kAKFrameThrottleIdleDelay) {
+        AKLog(kAKLogFrameThrottle_1, "抑制開始");
+        Director::getInstance()->setAnimationInterval(1.0 / kAKFrameThrottleIdleFrameRate);
+        m_isIdle = true;
+    }
+}
+
+/*!
+ @brief タッチ開始処理
+ 
+ 抑制を解除する。
+ @param touch タッチ情報
+ @param event イベント
+ @return タッチ移動を受け取るため常にtrue
+ */
+bool AKFrameThrottle::onTouchBegan(Touch *touch, Event *event)
+{
+    wake();
+    return true;
+}
+
+/*!
+ @brief タッチ移動処理
+ 
+ 抑制を解除する。
+ @param touch タッチ情報
+ @param event イベント
+ */
+void AKFrameThrottle::onTouchMoved(Touch *touch, Event *event)
+{
+    wake();
+}
+
+/*!
+ @brief キー入力処理
+ 
+ 抑制を解除する。
+ @param keyCode キーコード
+ @param event イベント
+ */
+void AKFrameThrottle::onKeyPressed(EventKeyboard::KeyCode keyCode, Event *event)
+{
+    wake();
+}
+
+/*!
+ @brief コントローラーのボタン入力処理
+ 
+ 抑制を解除する。
+ @param controller コントローラー
+ @param keyCode キーコード
+ @param event イベント
+ */
+void AKFrameThrottle::onControllerKeyDown(Controller *controller, int keyCode, Event *event)
+{
+    wake();
+}
+
+/*!
+ @brief コントローラーのアナログキー入力処理
+ 
+ アナログキーの入力値がしきい値を超えている場合は抑制を解除する。
+ 中立位置付近の小さな揺れでは解除しない。
+ @param controller コントローラー
+ @param keyCode キーコード
+ @param event イベント
+ */
+void AKFrameThrottle::onControllerAxisEvent(Controller *controller, int keyCode, Event *event)
+{
+    float value = controller->getKeyStatus(keyCode).value;
+    if (value < -kAKFrameThrottleAxisThreshold || value > kAKFrameThrottleAxisThreshold) {
+        wake();
+    }
+}
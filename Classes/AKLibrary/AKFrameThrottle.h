@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2015 Akihiro Kaneda.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1.Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   2.Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   3.Neither the name of the Monochrome Soft nor the names of its contributors
+ *     may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!
+ @file AKFrameThrottle.h
+ @brief フレームレート抑制クラス定義
+ 
+ 入力がない間、画面の更新頻度を下げるクラスを定義する。
+ */
+
+#ifndef AKFRAMETHROTTLE_H
+#define AKFRAMETHROTTLE_H
+
+#include "AKCommon.h"
+
+namespace cocos2d {
+    class Controller;
+    class EventListenerController;
+}
+
+/*!
+ @brief フレームレート抑制クラス
+ 
+ メニュー画面など、入力がなければ表示が変化しない画面で更新頻度を下げる。
+ 抑制が有効な状態で一定時間入力がない場合、Directorの更新間隔を長くする。
+ タッチ、キー、コントローラーの入力があった場合は直ちに元の更新間隔に戻す。
+ 入力によらずにアニメーションを開始する場合はwakeを呼び出すこと。
+ */
+class AKFrameThrottle {
+public:
+    /// 抑制時のフレームレート
+    static const int kAKFrameThrottleIdleFrameRate = 15;
+    /// 入力がなくなってから抑制するまでの時間(秒)
+    static const float kAKFrameThrottleIdleDelay;
+    
+private:
+    /// 通常時の更新間隔
+    double m_activeInterval;
+    /// 抑制が有効かどうか
+    bool m_isEnabled;
+    /// 抑制中かどうか
+    bool m_isIdle;
+    /// 最後の入力からの経過時間(秒)
+    float m_idleTime;
+    /// 更新処理終了イベントのリスナー
+    cocos2d::EventListenerCustom *m_afterUpdateListener;
+    /// タッチイベントのリスナー
+    cocos2d::EventListenerTouchOneByOne *m_touchListener;
+    /// キーイベントのリスナー
+    cocos2d::EventListenerKeyboard *m_keyboardListener;
+    /// コントローラーイベントのリスナー
+    cocos2d::EventListenerController *m_controllerListener;
+    
+public:
+    // インスタンス取得
+    static AKFrameThrottle* getInstance();
+    // 処理開始
+    void start();
+    // 処理終了
+    void stop();
+    // 抑制の有効・無効設定
+    void setEnabled(bool enabled);
+    // 抑制解除
+    void wake();
+    
+private:
+    // コンストラクタ
+    AKFrameThrottle();
+    // コピーコンストラクタは使用禁止
+    AKFrameThrottle(const AKFrameThrottle &other);
+    // 代入演算子は使用禁止
+    AKFrameThrottle& operator=(const AKFrameThrottle &other);
+    // 更新処理終了処理
+    void onAfterUpdate(cocos2d::EventCustom *event);
+    // タッチ開始処理
+    bool onTouchBegan(cocos2d::Touch *touch, cocos2d::Event *event);
+    // タッチ移動処理
+    void onTouchMoved(cocos2d::Touch *touch, cocos2d::Event *event);
+    // キー入力処理
+    void onKeyPressed(cocos2d::EventKeyboard::KeyCode keyCode, cocos2d::Event *event);
+    // コントローラーのボタン入力処理
+    void onControllerKeyDown(cocos2d::Controller *controller, int keyCode, cocos2d::Event *event);
+    // コントローラーのアナログキー入力処理
+    void onControllerAxisEvent(cocos2d::Controller *controller, int keyCode, cocos2d::Event *event);
+};
+
+#endif
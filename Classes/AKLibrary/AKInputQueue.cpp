@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2015 Akihiro Kaneda.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1.Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   2.Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   3.Neither the name of the Monochrome Soft nor the names of its contributors
+ *     may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!
+ @file AKInputQueue.cpp
+ @brief 入力キュークラス定義
+ 
+ タイムスタンプ付きの移動入力を保持するキューを定義する。
+ */
+
+#include "AKInputQueue.h"
+
+using std::memory_order_relaxed;
+using std::memory_order_acquire;
+using std::memory_order_release;
+using std::chrono::steady_clock;
+
+/*!
+ @brief コンストラクタ
+ 
+ 空のキューを作成する。
+ */
+AKInputQueue::AKInputQueue() :
+m_head(0), m_tail(0), m_overflowX(0.0f), m_overflowY(0.0f)
+{
+}
+
+/*!
+ @brief 移動入力追加
+ 
+ 移動量を現在時刻のタイムスタンプ付きでキューの末尾に追加する。
+ キューが満杯の場合は移動量を保持しておき、次に追加できたときの移動量に加える。
+ @param dx x方向の移動量
+ @param dy y方向の移動量
+ */
+void AKInputQueue::push(float dx, float dy)
+{
+    unsigned int tail = m_tail.load(memory_order_relaxed);
+    unsigned int head = m_head.load(memory_order_acquire);
+    
+    // キューが満杯の場合は移動量を保持しておく
+    if (tail - head >= kAKInputQueueSize) {
+        
+        AKLog(kAKLogInputQueue_0, "入力キューが満杯");
+        
+        m_overflowX += dx;
+        m_overflowY += dy;
+        return;
+    }
+    
+    // 保持している移動量と合わせて追加する
+    AKMoveInput &input = m_inputs[tail % kAKInputQueueSize];
+    input.dx = dx + m_overflowX;
+    input.dy = dy + m_overflowY;
+    input.timestamp = steady_clock::now();
+    input.count = 1;
+    
+    m_overflowX = 0.0f;
+    m_overflowY = 0.0f;
+    
+    // 書き込んだ内容が取り出す側から見えるようにしてから末尾を進める
+    m_tail.store(tail + 1, memory_order_release);
+}
+
+/*!
+ @brief 移動入力取り出し
+ 
+ キューに溜まっている移動入力をすべて取り出し、1つの入力にまとめる。
+ 移動量は合計し、タイムスタンプは最も古い入力のものとする。
+ @param result まとめた移動入力
+ @return 移動入力があった場合true
+ */
+bool AKInputQueue::coalesce(AKMoveInput *result)
+{
+    unsigned int head = m_head.load(memory_order_relaxed);
+    unsigned int tail = m_tail.load(memory_order_acquire);
+    
+    // 入力がない場合は処理しない
+    if (head == tail) {
+        return false;
+    }
+    
+    // 最も古い入力の時刻を使用する
+    result->dx = 0.0f;
+    result->dy = 0.0f;
+    result->timestamp = m_inputs[head % kAKInputQueueSize].timestamp;
+    result->count = 0;
+    
+    // すべての入力の移動量を合計する
+    for (; head != tail; head++) {
+        const AKMoveInput &input = m_inputs[head % kAKInputQueueSize];
+        result->dx += input.dx;
+        result->dy += input.dy;
+        result->count++;
+    }
+    
+    AKLog(kAKLogInputQueue_1, "入力数:%d 移動量:(%f, %f)", result->count, result->dx, result->dy);
+    
+    // 読み込みが終わってから先頭を進める
+    m_head.store(head, memory_order_release);
+    
+    return true;
+}
+
+/*!
+ @brief 全入力削除
+ 
+ キューに溜まっている移動入力をすべて破棄する。
+ 取り出す側から呼び出すこと。
+ */
+void AKInputQueue::clear()
+{
+    m_head.store(m_tail.load(memory_order_acquire), memory_order_release);
+}
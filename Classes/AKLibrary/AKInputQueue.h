@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2015 Akihiro Kaneda.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1.Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   2.Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   3.Neither the name of the Monochrome Soft nor the names of its contributors
+ *     may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!
+ @file AKInputQueue.h
+ @brief 入力キュークラス定義
+ 
+ タイムスタンプ付きの移動入力を保持するキューを定義する。
+ */
+
+#ifndef AKINPUTQUEUE_H
+#define AKINPUTQUEUE_H
+
+#include "AKCommon.h"
+#include <atomic>
+#include <chrono>
+
+/// 入力のタイムスタンプ
+typedef std::chrono::steady_clock::time_point AKInputTime;
+
+/// 移動入力
+struct AKMoveInput {
+    /// x方向の移動量
+    float dx;
+    /// y方向の移動量
+    float dy;
+    /// 入力時刻(まとめた場合は最も古い入力の時刻)
+    AKInputTime timestamp;
+    /// まとめた入力の数
+    int count;
+};
+
+/*!
+ @brief 入力キュークラス
+ 
+ 入力イベントで発生した移動量をタイムスタンプ付きで保持し、
+ シミュレーションの1フレームに1回まとめて取り出す。
+ 入力イベントを受け取る側と取り出す側がそれぞれ1つの場合に限り、ロックなしで使用できる。
+ */
+class AKInputQueue {
+public:
+    /// キューの容量
+    static const int kAKInputQueueSize = 64;
+    
+private:
+    /// 入力を格納する配列
+    AKMoveInput m_inputs[kAKInputQueueSize];
+    /// 次に取り出す位置(取り出す側のみ更新する)
+    std::atomic<unsigned int> m_head;
+    /// 次に追加する位置(追加する側のみ更新する)
+    std::atomic<unsigned int> m_tail;
+    /// キューが満杯で追加できなかったx方向の移動量
+    float m_overflowX;
+    /// キューが満杯で追加できなかったy方向の移動量
+    float m_overflowY;
+    
+public:
+    // コンストラクタ
+    AKInputQueue();
+    // 移動入力追加
+    void push(float dx, float dy);
+    // 移動入力取り出し
+    bool coalesce(AKMoveInput *result);
+    // 全入力削除
+    void clear();
+    
+private:
+    // コピーコンストラクタは使用禁止
+    AKInputQueue(const AKInputQueue &other);
+    // 代入演算子は使用禁止
+    AKInputQueue& operator=(const AKInputQueue &other);
+};
+
+#endif
@@ -35,6 +35,9 @@
 
 #include "AKLabel.h"
 #include "AKStringSplitter.h"
+#include "AKNineSlice.h"
+#include "AKAssetLoader.h"
+#include "LocalizedResource.h"
 
 using cocos2d::SpriteBatchNode;
 using cocos2d::Rect;
@@ -44,7 +47,10 @@ using cocos2d::Sprite;
 using cocos2d::Label;
 using cocos2d::TTFConfig;
 using cocos2d::Color3B;
-using cocos2d::SpriteFrameCache;
+using cocos2d::FontAtlas;
+using cocos2d::FontAtlasCache;
+using cocos2d::FontLetterDefinition;
+using cocos2d::FileUtils;
 
 /// ラベル枠テクスチャアトラス設定ファイル名
 static const char LabelFrameTextureDef[] = "LabelFrame.plist";
@@ -90,10 +96,20 @@ static const char Revesese[] = "Reverse";
 static const int FontSize = 16;
 /// 1行の高さ(単位：文字)
 static const float kAKLabelLineHeight = 1.5f;
+/// 事前作成したコントロール用フォントのグリフアトラスのファイル名プレフィックス
+static const char GlyphAtlasControlPrefix[] = "Glyph_Control_";
+/// 事前作成したメッセージ用フォントのグリフアトラスのファイル名プレフィックス
+static const char GlyphAtlasMessagePrefix[] = "Glyph_Message_";
+/// グリフアトラスの拡張子
+static const char GlyphAtlasExtension[] = ".fnt";
+/// 全角スペース
+static const char16_t kAKFullWidthSpace = 0x3000;
+/// 固定幅表示であらかじめテクスチャに書き込んでおく文字
+static const char16_t kAKFixedWidthPreloadCharacters[] = u"０１２３４５６７８９ＡＢＣＤＥＦＧＨＩＪＫＬＭＮＯＰＱＲＳＴＵＶＷＸＹＺ．　−？:";
 
 // バッチノードのz座標(タグ兼用)
 enum {
-    kAKFrameBatchPosZ = 0,  ///< 枠表示用バッチノードのz座標
+    kAKFrameBatchPosZ = 0,  ///< 枠表示用ノードのz座標
     kAKLabelBatchPosZ       ///< 文字表示用バッチノードのz座標
 };
 
@@ -160,9 +176,25 @@ Rect AKLabel::getRect(Vec2 position, int length, int line, bool hasFrame)
                 AKLabel::getHeight(line, hasFrame));
 }
 
+/*!
+ @brief 枠のテクスチャアトラス読み込み要求
+ 
+ ラベルの枠のテクスチャアトラスの読み込みをアセット読み込みクラスに要求する。
+ 起動時に呼び出しておくことで、最初のラベル作成時の読み込みを待たないようにする。
+ */
+void AKLabel::requestFrameTexture()
+{
+    AKAssetLoader::getInstance()->requestSpriteFrames(LabelFrameTextureDef, LabelFrameTextureImage);
+}
+
 // 中央揃え
 void AKLabel::setAlignmentCenter()
 {
+    // 固定幅表示の場合は文字枠の位置が決まっているため処理しない
+    if (m_isFixedWidth) {
+        return;
+    }
+    
     AKAssert(m_text != NULL, "m_text is null.");
     
     m_text->setAlignment(cocos2d::TextHAlignment::CENTER);
@@ -176,9 +208,12 @@ void AKLabel::setAlignmentCenter()
  @param length 1行の文字数
  @param line 表示行数
  @param frame 枠の種類
+ @param font フォントタイプ
+ @param isFixedWidth 固定幅表示かどうか
  */
-AKLabel::AKLabel(const std::string &str, int length, int line, enum AKLabelFrame frame, enum FontType font) :
-m_length(length), m_line(line), m_frame(frame), m_isReverse(false), m_font(font)
+AKLabel::AKLabel(const std::string &str, int length, int line, enum AKLabelFrame frame, enum FontType font, bool isFixedWidth) :
+m_length(length), m_line(line), m_frame(frame), m_isReverse(false), m_font(font),
+m_isFixedWidth(isFixedWidth), m_fontAtlas(NULL), m_glyphBatch(NULL)
 {
     // 文字列が表示可能文字数を超えている場合はエラー
     AKAssert(AKStringSplitter::getStringLength(str.c_str()) <= length * line, "文字列が表示可能文字数を超えている:str.size()=%d, length=%d, line=%d", AKStringSplitter::getStringLength(str.c_str()), length, line);
@@ -191,20 +226,33 @@ m_length(length), m_line(line), m_frame(frame), m_isReverse(false), m_font(font)
     m_text = NULL;
     
     // テクスチャアトラスを読み込む
-    SpriteFrameCache *spriteFrameCache = SpriteFrameCache::getInstance();
-    spriteFrameCache->addSpriteFramesWithFile(LabelFrameTextureDef,
-                                              LabelFrameTextureImage);
+    AKAssetLoader::getInstance()->addSpriteFrames(LabelFrameTextureDef,
+                                                  LabelFrameTextureImage);
     
-    // 枠示用バッチノードを作成する
-    SpriteBatchNode *frameBatchNode = SpriteBatchNode::create(LabelFrameTextureImage, (m_length + 2) * (m_line * 1.5 + 2));
-    AKAssert(frameBatchNode != NULL, "枠表示用バッチノードの作成に失敗");
+    // 枠表示用ノードを作成する
+    AKNineSlice *frameNode = AKNineSlice::create(LabelFrameTextureImage);
+    AKAssert(frameNode != NULL, "枠表示用ノードの作成に失敗");
+    
+    // 文字の領域を内側の矩形とする
+    // 行間に0.5文字分の隙間を空けるため、行数の1.5倍の高さを用意する。
+    float textTop = ((m_line - 1) * kAKLabelLineHeight / 2.0f + 0.5f) * FontSize;
+    float textHeight = (int)(m_line * kAKLabelLineHeight) * FontSize;
+    frameNode->setInnerRect(Rect(-m_length * FontSize / 2.0f,
+                                 textTop - textHeight,
+                                 m_length * FontSize,
+                                 textHeight));
     
-    // バッチノードを配置する
-    this->addChild(frameBatchNode, kAKFrameBatchPosZ, kAKFrameBatchPosZ);
+    // 枠表示用ノードを配置する
+    this->addChild(frameNode, kAKFrameBatchPosZ, kAKFrameBatchPosZ);
 
     // 枠を作成する
     createFrame();
     
+    // 固定幅表示の場合は文字枠を作成する
+    if (m_isFixedWidth) {
+        createGlyphs();
+    }
+    
     // ラベル文字列を設定する
     setString(str.c_str());
 }
@@ -212,11 +260,13 @@ m_length(length), m_line(line), m_frame(frame), m_isReverse(false), m_font(font)
 /*!
  @brief デストラクタ
  
- 無処理。
+ 固定幅表示の場合はフォントテクスチャアトラスを解放する。
  */
 AKLabel::~AKLabel()
 {
-    
+    if (m_fontAtlas != NULL) {
+        FontAtlasCache::releaseFontAtlas(m_fontAtlas);
+    }
 }
 
 /*!
@@ -231,7 +281,32 @@ AKLabel::~AKLabel()
  */
 AKLabel* AKLabel::createLabel(const std::string &str, int length, int line, enum AKLabelFrame frame, enum FontType font)
 {
-    AKLabel *instance = new AKLabel(str, length, line, frame, font);
+    AKLabel *instance = new AKLabel(str, length, line, frame, font, false);
+    if (instance->init()) {
+        instance->autorelease();
+        return instance;
+    }
+    else {
+        CC_SAFE_DELETE(instance);
+        return NULL;
+    }
+}
+
+/*!
+ @brief 固定幅ラベルのコンビニエンスコンストラクタ
+ 
+ 1行の固定幅表示のラベルを生成する。
+ 文字枠ごとにフォントテクスチャアトラスのスプライトを1個ずつ配置し、
+ 文字列の変更時は変化した文字枠の画像範囲のみを変更する。
+ スコア等の頻繁に変わる表示に使用する。フォントはコントロール用フォントとする。
+ @param str 表示文字列
+ @param length 文字数
+ @param frame 枠の種類
+ @return 生成したインスタンス
+ */
+AKLabel* AKLabel::createFixedWidthLabel(const std::string &str, int length, enum AKLabelFrame frame)
+{
+    AKLabel *instance = new AKLabel(str, length, 1, frame, ControlFont, true);
     if (instance->init()) {
         instance->autorelease();
         return instance;
@@ -282,13 +357,30 @@ const std::string& AKLabel::getString() const
  @brief 表示文字列の設定
  
  表示文字列を変更する。
+ 文字列が変わっていない場合は何もしない。
+ ラベルが作成済みの場合はラベルを作り直さずに文字列のみ変更する。
  @param label 表示文字列
  */
 void AKLabel::setString(const std::string &label)
 {
+    // 文字列が変わっていない場合は処理しない
+    if ((m_text != NULL || m_isFixedWidth) && m_labelString == label) {
+        return;
+    }
+    
     // パラメータをメンバに設定する
-    if (m_labelString != label) {
-        m_labelString = label;
+    m_labelString = label;
+    
+    // 固定幅表示の場合は変化した文字枠のみ更新する
+    if (m_isFixedWidth) {
+        updateGlyphs();
+        return;
+    }
+    
+    // ラベルが作成済みの場合は文字列のみ変更する
+    if (m_text != NULL) {
+        m_text->setString(convertHalfCharacter(m_labelString.c_str()));
+        return;
     }
     
     // 表示を更新する
@@ -334,18 +426,18 @@ Rect AKLabel::getRect()
 }
 
 /*!
- @brief 枠表示用バッチノード取得
+ @brief 枠表示用ノード取得
  
- 枠表示用バッチノードを取得する
- @return 枠表示用バッチノード
+ 枠表示用ノードを取得する
+ @return 枠表示用ノード
  */
-SpriteBatchNode* AKLabel::getFrameBatch()
+AKNineSlice* AKLabel::getFrameNode()
 {
-    SpriteBatchNode *frameBatch = static_cast<SpriteBatchNode*>(getChildByTag(kAKFrameBatchPosZ));
+    AKNineSlice *frameNode = static_cast<AKNineSlice*>(getChildByTag(kAKFrameBatchPosZ));
     
-    AKAssert(frameBatch, "枠表示用バッチノードが作成されていない");
+    AKAssert(frameNode, "枠表示用ノードが作成されていない");
     
-    return frameBatch;
+    return frameNode;
 }
 
 /*!
@@ -355,27 +447,42 @@ SpriteBatchNode* AKLabel::getFrameBatch()
  */
 void AKLabel::updateLabel()
 {
+    // 固定幅表示の場合は文字枠の更新のみ行う
+    if (m_isFixedWidth) {
+        updateGlyphs();
+        return;
+    }
+    
     // ラベルを削除する
     if (m_text != NULL) {
         removeChild(m_text);
         m_text = NULL;
     }
     
-    // フォントタイプに応じて使用するフォントを切り替える
-    const char *font = NULL;
-    if (m_font == ControlFont) {
-        font = CONTROL_FONT;
+    // 事前作成したグリフアトラスがある場合はそれを使用してラベルを作成する
+    // ない場合は実行時にTTFフォントから作成する
+    const std::string &glyphAtlas = getGlyphAtlasFileName(m_font);
+    if (!glyphAtlas.empty()) {
+        m_text = Label::createWithBMFont(glyphAtlas, convertHalfCharacter(m_labelString.c_str()));
     }
     else {
-        font = JAPANESE_FONT;
+        
+        // フォントタイプに応じて使用するフォントを切り替える
+        const char *font = NULL;
+        if (m_font == ControlFont) {
+            font = CONTROL_FONT;
+        }
+        else {
+            font = JAPANESE_FONT;
+        }
+        
+        // フォント設定を作成する
+        TTFConfig config(font, FontSize);
+        
+        // ラベルを作成する
+        m_text = Label::createWithTTF(config, convertHalfCharacter(m_labelString.c_str()));
     }
     
-    // フォント設定を作成する
-    TTFConfig config(font, FontSize);
-    
-    // ラベルを作成する
-    m_text = Label::createWithTTF(config, convertHalfCharacter(m_labelString.c_str()));
-    
     // ラベル高さを設定する
     if (m_font == ControlFont) {
         m_text->setHeight((int)(m_line  * kAKLabelLineHeight) * FontSize);
@@ -398,170 +505,267 @@ void AKLabel::updateLabel()
 /*!
  @brief 枠の生成
  
- 枠を生成する。
+ 枠の種類と色反転の有無に応じて、9分割枠の各部分の画像を設定する。
+ 色反転の切り替え時もノードは作り直さず、画像の差し替えのみを行う。
  */
 void AKLabel::createFrame()
 {
-    std::string keyTopLeft;
-    std::string keyTopRight;
-    std::string keyBottomLeft;
-    std::string keyBottomRight;
-    std::string keyTopBar;
-    std::string keyBottomBar;
-    std::string keyLeftBar;
-    std::string keyRightBar;
-    
-    // 反転時は反転画像プレフィックスを先頭につける
-    if (m_isReverse) {
-        keyTopLeft = Revesese;
-        keyTopRight = Revesese;
-        keyBottomLeft = Revesese;
-        keyBottomRight = Revesese;
-        keyTopBar = Revesese;
-        keyBottomBar = Revesese;
-        keyLeftBar = Revesese;
-        keyRightBar = Revesese;
-    }
-    
-    // 枠の幅
-    int framewidth = 0;
+    // 各部分の画像のキー
+    // 枠なしの場合は中央部分のみ表示する
+    std::string keys[kAKNineSlicePartCount];
     
     // 枠の種類に応じてキー文字列を切り替える
     switch (m_frame) {
             
         case kAKLabelFrameMessage:  // メッセージボックス
-            
-            keyTopLeft += TopLeft;
-            keyTopRight += TopRight;
-            keyBottomLeft += BottomLeft;
-            keyBottomRight += BottomRight;
-            keyTopBar += TopBar;
-            keyBottomBar += BottomBar;
-            keyLeftBar += LeftBar;
-            keyRightBar += RightBar;
-            framewidth = 1;
-            
+            keys[kAKNineSliceTopLeft] = TopLeft;
+            keys[kAKNineSliceTop] = TopBar;
+            keys[kAKNineSliceTopRight] = TopRight;
+            keys[kAKNineSliceLeft] = LeftBar;
+            keys[kAKNineSliceRight] = RightBar;
+            keys[kAKNineSliceBottomLeft] = BottomLeft;
+            keys[kAKNineSliceBottom] = BottomBar;
+            keys[kAKNineSliceBottomRight] = BottomRight;
             break;
             
         case kAKLabelFrameButton:   // ボタン
-            keyTopLeft += ButtonTopLeft;
-            keyTopRight += ButtonTopRight;
-            keyBottomLeft += ButtonBottomLeft;
-            keyBottomRight += ButtonBottomRight;
-            keyTopBar += ButtonTopBar;
-            keyBottomBar += ButtonBottomBar;
-            keyLeftBar += ButtonLeftBar;
-            keyRightBar += ButtonRightBar;
-            framewidth = 1;
-
+            keys[kAKNineSliceTopLeft] = ButtonTopLeft;
+            keys[kAKNineSliceTop] = ButtonTopBar;
+            keys[kAKNineSliceTopRight] = ButtonTopRight;
+            keys[kAKNineSliceLeft] = ButtonLeftBar;
+            keys[kAKNineSliceRight] = ButtonRightBar;
+            keys[kAKNineSliceBottomLeft] = ButtonBottomLeft;
+            keys[kAKNineSliceBottom] = ButtonBottomBar;
+            keys[kAKNineSliceBottomRight] = ButtonBottomRight;
             break;
             
         default:
             break;
     }
+    keys[kAKNineSliceCenter] = Blank;
+    
+    // 反転時は反転画像プレフィックスを先頭につける
+    if (m_isReverse) {
+        for (int i = 0; i < kAKNineSlicePartCount; i++) {
+            if (!keys[i].empty()) {
+                keys[i] = Revesese + keys[i];
+            }
+        }
+    }
     
-    // スプライトフレームキャッシュを取得する
-    SpriteFrameCache *spriteFrameCache = SpriteFrameCache::getInstance();
+    AKLog(kAKLogLabel_1, "frame=%d reverse=%d", m_frame, m_isReverse);
     
-    // 行間に0.5文字分の隙間を空けるため、行数の1.5倍の高さを用意する。
-    // 枠を入れるため、上下+-1個分用意する。
-    for (int y = -framewidth; y < (int)(m_line * kAKLabelLineHeight) + framewidth; y++) {
+    // 9分割枠の画像を差し替える
+    getFrameNode()->setSpriteFrames(keys);
+}
+
+/*!
+ @brief 固定幅表示の文字枠の生成
+ 
+ コントロール用フォントのテクスチャアトラスを取得し、文字枠ごとにスプライトを作成する。
+ 事前作成したグリフアトラスがある場合はそれを使用する。
+ よく使う文字はあらかじめテクスチャに書き込んでおく。
+ */
+void AKLabel::createGlyphs()
+{
+    AKAssert(m_line == 1, "固定幅表示は1行のみ:line=%d", m_line);
+    
+    // フォントテクスチャアトラスを取得する
+    // 事前作成したグリフアトラスがある場合はそれを使用する
+    const std::string &glyphAtlas = getGlyphAtlasFileName(ControlFont);
+    if (!glyphAtlas.empty()) {
+        m_fontAtlas = FontAtlasCache::getFontAtlasFNT(glyphAtlas);
+    }
+    else {
+        TTFConfig config(CONTROL_FONT, FontSize);
+        m_fontAtlas = FontAtlasCache::getFontAtlasTTF(&config);
+    }
+    AKAssert(m_fontAtlas != NULL, "フォントテクスチャアトラスの取得に失敗");
+    
+    // よく使う文字をテクスチャに書き込む
+    m_fontAtlas->prepareLetterDefinitions(kAKFixedWidthPreloadCharacters);
+    
+    // 文字表示用バッチノードを作成する
+    m_glyphBatch = SpriteBatchNode::createWithTexture(m_fontAtlas->getTexture(0), m_length);
+    addChild(m_glyphBatch, kAKLabelBatchPosZ, kAKLabelBatchPosZ);
+    
+    // 文字枠ごとにスプライトを作成する
+    for (int i = 0; i < m_length; i++) {
         
-        AKLog(kAKLogLabel_1, "y=%d pos=%f", y, (-y + m_line * kAKLabelLineHeight / 2.0f) * FontSize);
+        // 左上を基準に配置するため、アンカーを左上に設定する
+        Sprite *glyph = Sprite::createWithTexture(m_fontAtlas->getTexture(0), Rect::ZERO);
+        glyph->setAnchorPoint(Vec2(0.0f, 1.0f));
+        glyph->setColor(Color3B(kAKColor[kAKColorDark]));
+        glyph->setVisible(false);
         
-        // 枠を入れるため、左右+-1個分用意する。
-        for (int x = -framewidth; x < m_length + framewidth; x++) {
-            
-            AKLog(kAKLogLabel_1 && y == -1, "x=%d pos=%f", x, (x - m_length / 2.0f) * FontSize);
-            
-            // キー文字列
-            std::string key;
-            
-            // 左上の場合
-            if (y == -1 && x == -1) {
-                AKLog(kAKLogLabel_1, "x=%d y=%d topleft", x, y);
-                key = keyTopLeft;
-            }
-            // 右上の場合
-            else if (y == -1 && x == m_length) {
-                AKLog(kAKLogLabel_1, "x=%d y=%d topright", x, y);
-                key = keyTopRight;
-            }
-            // 左下の場合
-            else if (y == (int)(m_line * 1.5) && x == -1) {
-                AKLog(kAKLogLabel_1, "x=%d y=%d bottomleft", x, y);
-                key = keyBottomLeft;
-            }
-            // 右下の場合
-            else if (y == (int)(m_line * 1.5) && x == m_length) {
-                AKLog(kAKLogLabel_1, "x=%d y=%d bottomright", x, y);
-                key = keyBottomRight;
-            }
-            // 上の場合
-            else if (y == -1) {
-                AKLog(kAKLogLabel_1, "x=%d y=%d topbar", x, y);
-                key = keyTopBar;
-            }
-            // 左の場合
-            else if (x == -1) {
-                AKLog(kAKLogLabel_1, "x=%d y=%d leftbar", x, y);
-                key = keyLeftBar;
-            }
-            // 右の場合
-            else if (x == m_length) {
-                AKLog(kAKLogLabel_1, "x=%d y=%d rightbar", x, y);
-                key = keyRightBar;
-            }
-            // 下の場合
-            else if (y == (int)(m_line * 1.5)) {
-                AKLog(kAKLogLabel_1, "x=%d y=%d bottombar", x, y);
-                key = keyBottomBar;
-            }
-            // 文字の部分の場合
-            else {
-                
-                key = "";
+        m_glyphBatch->addChild(glyph, 0, i);
+        m_glyphs.push_back(glyph);
+    }
+    
+    // 表示中の文字は全角スペースで初期化する
+    m_glyphCharacters.assign(m_length, kAKFullWidthSpace);
+}
 
-                // 反転時はプレフィックスを付ける
-                if (m_isReverse) {
-                    key = Revesese;
-                }
-                
-                key += Blank;
-            }
-            
-            // 先頭からの文字数をタグとする
-            // xとyはそれぞれ-1からスタートしているため、+1して0からスタートするように補正する。
-            int tag = (x + 1) + (y + 1) * (m_length + 1 + 1);
-            AKLog(kAKLogLabel_1, "tag=%d", tag);
-            
-            // スプライトフレームを生成する
-            SpriteFrame *charSpriteFrame = spriteFrameCache->getSpriteFrameByName(key);
-            
-            // バッチノードからスプライトを取り出す
-            Sprite *charSprite = static_cast<Sprite*>(getFrameBatch()->getChildByTag(tag));
-            
-            // 取得できない場合はスプライトを生成する
-            if (charSprite == NULL) {
-                
-                //　スプライトを生成する
-                charSprite = Sprite::createWithSpriteFrame(charSpriteFrame);
-                
-                // 表示位置を設定する。
-                // テキスト領域の中央とバッチノードの中央を一致させるため、
-                // 左に1行の長さの半分、上方向に行数の半分移動する。
-                charSprite->setPosition(Vec2((x - (m_length - 1) / 2.0f) * FontSize,
-                                                (-y + (m_line - 1) * kAKLabelLineHeight / 2.0f) * FontSize));
-                
-                // バッチノードに登録する
-                getFrameBatch()->addChild(charSprite, 0, tag);
-            }
-            else {
-            
-                // スプライトを差し替える
-                charSprite->setSpriteFrame(charSpriteFrame);
+/*!
+ @brief 固定幅表示の文字の更新
+ 
+ 表示文字列の各文字を全角に変換し、表示中の文字から変化した文字枠のみ画像範囲を変更する。
+ 文字幅が変わった場合はそれ以降の文字枠の位置も変更する。
+ 表示文字列は半角文字のみとする。
+ */
+void AKLabel::updateGlyphs()
+{
+    AKAssert(AKStringSplitter::getStringLength(m_labelString.c_str()) == (int)m_labelString.size(),
+             "固定幅表示に半角以外の文字が含まれている:%s", m_labelString.c_str());
+    AKLog(kAKLogLabel_0 && (int)m_labelString.size() > m_length,
+          "文字列が表示可能文字数を超えているため切り捨てる:size=%d, length=%d", (int)m_labelString.size(), m_length);
+    
+    // 1行目の上端の座標
+    float top = getHeight(1, false) / 2.0f;
+    
+    // 文字枠の左端の座標
+    float left = -getWidth(m_length, false) / 2.0f;
+    
+    // 前の文字枠で文字幅が変わり、以降の文字枠の位置がずれたかどうか
+    bool isShifted = false;
+    
+    for (int i = 0; i < m_length; i++) {
+        
+        // 文字列の範囲外の文字枠は全角スペースとする
+        char16_t character = kAKFullWidthSpace;
+        if (i < (int)m_labelString.size()) {
+            character = convertFixedWidthCharacter(m_labelString[i]);
+        }
+        
+        // 文字幅を計算する(全角に変換されなかった文字は半分の幅とする)
+        float advance = getFixedWidthAdvance(character);
+        
+        // 表示中の文字と同じで位置もずれていない場合は処理しない
+        bool isChanged = (character != m_glyphCharacters[i]);
+        if (!isChanged && !isShifted) {
+            left += advance;
+            continue;
+        }
+        
+        // 文字幅が変わった場合は以降の文字枠の位置を更新する
+        if (isChanged && advance != getFixedWidthAdvance(m_glyphCharacters[i])) {
+            isShifted = true;
+        }
+        m_glyphCharacters[i] = character;
+        
+        // 文字の定義を取得する
+        // テクスチャに書き込まれていない場合は書き込んでから取得する
+        FontLetterDefinition letter;
+        if (!m_fontAtlas->getLetterDefinitionForChar(character, letter)) {
+            m_fontAtlas->prepareLetterDefinitions(std::u16string(1, character));
+            if (!m_fontAtlas->getLetterDefinitionForChar(character, letter)) {
+                letter.validDefinition = false;
             }
         }
+        AKAssert(!letter.validDefinition || letter.textureID == 0, "文字が別のテクスチャに書き込まれた:%d", (int)character);
+        
+        // 表示できない文字の場合は非表示にする
+        Sprite *glyph = m_glyphs[i];
+        if (!letter.validDefinition || letter.width <= 0.0f || letter.height <= 0.0f) {
+            glyph->setVisible(false);
+            left += advance;
+            continue;
+        }
+        
+        // 文字が変わった場合は画像範囲を変更する
+        if (isChanged) {
+            glyph->setTextureRect(Rect(letter.U, letter.V, letter.width, letter.height));
+        }
+        
+        // 位置を変更する
+        glyph->setPosition(Vec2(left + letter.offsetX, top - letter.offsetY));
+        glyph->setVisible(true);
+        
+        left += advance;
+    }
+}
+
+/*!
+ @brief 固定幅表示の文字幅取得
+ 
+ 全角に変換されなかった半角文字は半分の幅、それ以外は1文字分の幅とする。
+ @param character 文字
+ @return 文字幅
+ */
+float AKLabel::getFixedWidthAdvance(char16_t character)
+{
+    if (character < 0x80) {
+        return FontSize / 2.0f;
+    }
+    else {
+        return FontSize;
+    }
+}
+
+/*!
+ @brief 事前作成したグリフアトラスのファイル名取得
+ 
+ ビルド時に作成したフォントタイプ、言語ごとのグリフアトラス(BMFont形式)のファイル名を取得する。
+ ファイルがない場合は空文字列を返す。ファイルの有無の確認は初回のみ行う。
+ @param font フォントタイプ
+ @return グリフアトラスのファイル名
+ */
+const std::string& AKLabel::getGlyphAtlasFileName(enum FontType font)
+{
+    // フォントタイプごとのファイル名
+    static std::string fileNames[FontTypeCount];
+    // フォントタイプごとのファイルの有無を確認済みかどうか
+    static bool isChecked[FontTypeCount] = {false, false};
+    
+    if (!isChecked[font]) {
+        
+        // フォントタイプと言語からファイル名を作成する
+        std::string fileName = (font == ControlFont ? GlyphAtlasControlPrefix : GlyphAtlasMessagePrefix);
+        fileName += aklib::LocalizedResource::getInstance().getLanguageCode();
+        fileName += GlyphAtlasExtension;
+        
+        // ファイルがある場合のみファイル名を設定する
+        if (FileUtils::getInstance()->isFileExist(fileName)) {
+            fileNames[font] = fileName;
+        }
+        
+        AKLog(kAKLogLabel_1, "glyph atlas:%s exist=%d", fileName.c_str(), !fileNames[font].empty());
+        
+        isChecked[font] = true;
+    }
+    
+    return fileNames[font];
+}
+
+/*!
+ @brief 固定幅表示の半角文字全角文字変換
+ 
+ convertHalfCharacterと同じ規則で1文字を全角に変換する。
+ @param character 半角文字
+ @return 変換後の文字
+ */
+char16_t AKLabel::convertFixedWidthCharacter(char character)
+{
+    // 数字と英大文字は全角に変換する
+    if (character >= '0' && character <= '9') {
+        return u'０' + (character - '0');
+    }
+    if (character >= 'A' && character <= 'Z') {
+        return u'Ａ' + (character - 'A');
+    }
+    
+    // その他の変換対象の記号を変換する
+    switch (character) {
+        case '.':
+            return u'．';
+        case ' ':
+            return kAKFullWidthSpace;
+        case '-':
+            return u'−';
+        case '?':
+            return u'？';
+        default:
+            return character;
     }
 }
 
@@ -38,6 +38,8 @@
 
 #include "AKCommon.h"
 
+class AKNineSlice;
+
 /// ラベルの枠のタイプ
 enum AKLabelFrame {
     kAKLabelFrameNone = 0,  ///< 枠なし
@@ -55,17 +57,22 @@ public:
     /// フォントタイプ
     enum FontType {
         ControlFont = 0,    ///< コントロール用フォント
-        MessageFont         ///< メッセージ用フォント
+        MessageFont,        ///< メッセージ用フォント
+        FontTypeCount       ///< フォントタイプの数
     };
     
     // コンビニエンスコンストラクタ
     static AKLabel* createLabel(const std::string &str, int length, int line, enum AKLabelFrame frame, enum FontType font);
+    // 固定幅ラベルのコンビニエンスコンストラクタ
+    static AKLabel* createFixedWidthLabel(const std::string &str, int length, enum AKLabelFrame frame);
     // 指定文字数の幅取得
     static int getWidth(int length, bool hasFrame);
     // 指定行数の高さ取得
     static int getHeight(int line, bool hasFrame);
     // 指定文字数、指定行数の指定位置の矩形範囲取得
     static cocos2d::Rect getRect(cocos2d::Vec2 position, int length, int line, bool hasFrame);
+    // 枠のテクスチャアトラス読み込み要求
+    static void requestFrameTexture();
     
     // デストラクタ
     virtual ~AKLabel();
@@ -104,17 +111,37 @@ private:
     cocos2d::Label *m_text;
     /// フォントタイプ
     enum FontType m_font;
+    /// 固定幅表示かどうか
+    bool m_isFixedWidth;
+    /// 固定幅表示のフォントテクスチャアトラス
+    cocos2d::FontAtlas *m_fontAtlas;
+    /// 固定幅表示の文字表示用バッチノード
+    cocos2d::SpriteBatchNode *m_glyphBatch;
+    /// 固定幅表示の各文字枠のスプライト
+    std::vector<cocos2d::Sprite*> m_glyphs;
+    /// 固定幅表示の各文字枠に表示中の文字
+    std::u16string m_glyphCharacters;
     
     // デフォルトコンストラクタは使用禁止にする
     AKLabel();
     // 初期文字列を指定したコンストラクタ
-    AKLabel(const std::string &str, int length, int line, enum AKLabelFrame frame, enum FontType font);
-    // 枠表示用バッチノード取得
-    cocos2d::SpriteBatchNode* getFrameBatch();
+    AKLabel(const std::string &str, int length, int line, enum AKLabelFrame frame, enum FontType font, bool isFixedWidth);
+    // 枠表示用ノード取得
+    AKNineSlice* getFrameNode();
     // 表示更新
     void updateLabel();
     // 枠の生成
     void createFrame();
+    // 固定幅表示の文字枠の生成
+    void createGlyphs();
+    // 固定幅表示の文字の更新
+    void updateGlyphs();
+    // 固定幅表示の半角文字全角文字変換
+    static char16_t convertFixedWidthCharacter(char character);
+    // 固定幅表示の文字幅取得
+    static float getFixedWidthAdvance(char16_t character);
+    // 事前作成したグリフアトラスのファイル名取得
+    static const std::string& getGlyphAtlasFileName(enum FontType font);
     // 半角文字全角文字変換
     std::string convertHalfCharacter(const char *org);
 };
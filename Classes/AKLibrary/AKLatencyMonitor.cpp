@@ -0,0 +1,332 @@
+/*
+ * Copyright (c) 2015 Akihiro Kaneda.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1.Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   2.Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   3.Neither the name of the Monochrome Soft nor the names of its contributors
+ *     may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!
+ @file AKLatencyMonitor.cpp
+ @brief 入力遅延計測クラス定義
+ 
+ 入力イベントから画面表示までの遅延時間を計測するクラスを定義する。
+ */
+
+#include "AKLatencyMonitor.h"
+#include <cstdio>
+
+using std::string;
+using std::chrono::steady_clock;
+using std::chrono::duration_cast;
+using std::chrono::microseconds;
+using cocos2d::Director;
+using cocos2d::EventCustom;
+
+/// 計測区間の名前(CSVの列名に使用する)
+static const char *kAKLatencyStageName[kAKLatencyStageCount] = {
+    "event",
+    "simulation",
+    "frame",
+    "total"
+};
+
+/*!
+ @brief インスタンス取得
+ 
+ シングルトンのインスタンスを取得する。
+ @return インスタンス
+ */
+AKLatencyMonitor* AKLatencyMonitor::getInstance()
+{
+    static AKLatencyMonitor instance;
+    return &instance;
+}
+
+/*!
+ @brief コンストラクタ
+ 
+ 計測停止中の状態で作成する。
+ */
+AKLatencyMonitor::AKLatencyMonitor() :
+m_isRunning(false), m_afterDrawListener(NULL), m_isUpdating(false)
+{
+    reset();
+}
+
+/*!
+ @brief 計測開始
+ 
+ 描画終了イベントの受信を開始し、入力イベントの計測を開始する。
+ 計測結果は初期化せずに、前回の計測結果に追加する。
+ */
+void AKLatencyMonitor::start()
+{
+    // すでに計測中の場合は無処理
+    if (m_isRunning) {
+        return;
+    }
+    
+    AKLog(kAKLogLatencyMonitor_1, "計測開始");
+    
+    // 描画終了イベントのリスナーを登録する
+    m_afterDrawListener = Director::getInstance()->getEventDispatcher()->addCustomEventListener(Director::EVENT_AFTER_DRAW, CC_CALLBACK_1(AKLatencyMonitor::onAfterDraw, this));
+    
+    m_pendingCount = 0;
+    m_updatedCount = 0;
+    m_isUpdating = false;
+    m_isRunning = true;
+}
+
+/*!
+ @brief 計測終了
+ 
+ 描画終了イベントの受信を終了する。
+ 描画まで終わっていない入力イベントは破棄する。
+ */
+void AKLatencyMonitor::stop()
+{
+    // 計測中でない場合は無処理
+    if (!m_isRunning) {
+        return;
+    }
+    
+    AKLog(kAKLogLatencyMonitor_1, "計測終了");
+    
+    // 描画終了イベントのリスナーを削除する
+    Director::getInstance()->getEventDispatcher()->removeEventListener(m_afterDrawListener);
+    m_afterDrawListener = NULL;
+    
+    m_pendingCount = 0;
+    m_updatedCount = 0;
+    m_isUpdating = false;
+    m_isRunning = false;
+}
+
+/*!
+ @brief 計測中かどうか
+ 
+ 計測中かどうかを取得する。
+ @return 計測中かどうか
+ */
+bool AKLatencyMonitor::isRunning() const
+{
+    return m_isRunning;
+}
+
+/*!
+ @brief 計測結果初期化
+ 
+ ヒストグラムと統計値をすべて初期化する。
+ */
+void AKLatencyMonitor::reset()
+{
+    m_pendingCount = 0;
+    m_updatedCount = 0;
+    m_droppedCount = 0;
+    
+    for (int i = 0; i < kAKLatencyStageCount; i++) {
+        for (int j = 0; j < kAKLatencyBinCount; j++) {
+            m_histogram[i][j] = 0;
+        }
+        m_sampleCount[i] = 0;
+        m_totalTime[i] = 0;
+        m_maxTime[i] = 0;
+    }
+}
+
+/*!
+ @brief 入力イベント到着
+ 
+ 入力イベントの到着時刻を記録する。
+ 入力イベントを受け取った時点で呼び出す。
+ */
+void AKLatencyMonitor::markInput()
+{
+    // 計測中でない場合は無処理
+    if (!m_isRunning) {
+        return;
+    }
+    
+    // 保持できる数を超えた場合は数だけ数えて破棄する
+    if (m_pendingCount >= kAKLatencyMaxPending) {
+        m_droppedCount++;
+        return;
+    }
+    
+    m_pendingInputs[m_pendingCount] = steady_clock::now();
+    m_pendingCount++;
+}
+
+/*!
+ @brief 更新処理開始
+ 
+ 更新処理の開始時刻を記録し、到着済みの入力イベントの待ち時間を集計する。
+ 入力イベントを反映する更新処理の直前に呼び出す。
+ */
+void AKLatencyMonitor::markUpdateBegin()
+{
+    // 計測中でない場合、入力イベントがない場合は無処理
+    if (!m_isRunning || m_pendingCount <= 0) {
+        return;
+    }
+    
+    m_updateBegin = steady_clock::now();
+    m_isUpdating = true;
+    
+    // 前回の更新処理の結果がまだ描画されていない場合は、
+    // 描画待ちの入力イベントは今回の更新処理の結果とあわせて描画されるものとして扱う
+    for (int i = 0; i < m_pendingCount; i++) {
+        
+        addSample(kAKLatencyStageEvent, m_pendingInputs[i], m_updateBegin);
+        
+        if (m_updatedCount < kAKLatencyMaxPending) {
+            m_updatedInputs[m_updatedCount] = m_pendingInputs[i];
+            m_updatedCount++;
+        }
+        else {
+            m_droppedCount++;
+        }
+    }
+    
+    m_pendingCount = 0;
+}
+
+/*!
+ @brief 更新処理終了
+ 
+ 入力イベントを反映した更新処理の終了時刻を記録する。
+ */
+void AKLatencyMonitor::markUpdateEnd()
+{
+    // 入力イベントを反映した更新処理でない場合は無処理
+    if (!m_isRunning || !m_isUpdating) {
+        return;
+    }
+    
+    m_updateEnd = steady_clock::now();
+    m_isUpdating = false;
+    
+    addSample(kAKLatencyStageSimulation, m_updateBegin, m_updateEnd);
+}
+
+/*!
+ @brief 計測結果ファイル出力
+ 
+ ヒストグラムと統計値をCSV形式でファイルに出力する。
+ ヒストグラムは1行に1区間とし、各列に計測区間ごとのイベント数を出力する。
+ @param fileName ファイル名(書き込み可能なディレクトリからの相対パス)
+ @return 出力に成功した場合true
+ */
+bool AKLatencyMonitor::exportToFile(const string &fileName) const
+{
+    string path = cocos2d::FileUtils::getInstance()->getWritablePath() + fileName;
+    
+    FILE *fp = fopen(path.c_str(), "w");
+    if (fp == NULL) {
+        AKLog(kAKLogLatencyMonitor_0, "ファイルを開けない:%s", path.c_str());
+        return false;
+    }
+    
+    // 統計値を出力する
+    fprintf(fp, "stage,count,average_us,max_us\n");
+    for (int i = 0; i < kAKLatencyStageCount; i++) {
+        long long average = 0;
+        if (m_sampleCount[i] > 0) {
+            average = m_totalTime[i] / m_sampleCount[i];
+        }
+        fprintf(fp, "%s,%d,%lld,%lld\n", kAKLatencyStageName[i], m_sampleCount[i], average, m_maxTime[i]);
+    }
+    fprintf(fp, "dropped,%d,,\n", m_droppedCount);
+    fprintf(fp, "\n");
+    
+    // ヒストグラムを出力する
+    fprintf(fp, "bin_ms");
+    for (int i = 0; i < kAKLatencyStageCount; i++) {
+        fprintf(fp, ",%s", kAKLatencyStageName[i]);
+    }
+    fprintf(fp, "\n");
+    for (int j = 0; j < kAKLatencyBinCount; j++) {
+        fprintf(fp, "%d", j * kAKLatencyBinWidth / 1000);
+        for (int i = 0; i < kAKLatencyStageCount; i++) {
+            fprintf(fp, ",%d", m_histogram[i][j]);
+        }
+        fprintf(fp, "\n");
+    }
+    
+    fclose(fp);
+    
+    AKLog(kAKLogLatencyMonitor_1, "計測結果出力:%s", path.c_str());
+    
+    return true;
+}
+
+/*!
+ @brief 描画終了処理
+ 
+ 描画終了時刻を記録し、描画待ちの入力イベントの遅延時間を集計する。
+ @param event イベント
+ */
+void AKLatencyMonitor::onAfterDraw(EventCustom *event)
+{
+    // 描画待ちの入力イベントがない場合は無処理
+    if (m_updatedCount <= 0) {
+        return;
+    }
+    
+    Time drawEnd = steady_clock::now();
+    
+    addSample(kAKLatencyStageFrame, m_updateEnd, drawEnd);
+    
+    for (int i = 0; i < m_updatedCount; i++) {
+        addSample(kAKLatencyStageTotal, m_updatedInputs[i], drawEnd);
+    }
+    
+    m_updatedCount = 0;
+}
+
+/*!
+ @brief 計測結果追加
+ 
+ 経過時間を計算し、計測区間のヒストグラムと統計値に追加する。
+ @param stage 計測区間
+ @param begin 開始時刻
+ @param end 終了時刻
+ */
+void AKLatencyMonitor::addSample(enum AKLatencyStage stage, const Time &begin, const Time &end)
+{
+    long long elapsed = duration_cast<microseconds>(end - begin).count();
+    
+    // 範囲外の時間は最後の区間に含める
+    int bin = static_cast<int>(elapsed / kAKLatencyBinWidth);
+    if (bin >= kAKLatencyBinCount) {
+        bin = kAKLatencyBinCount - 1;
+    }
+    
+    m_histogram[stage][bin]++;
+    m_sampleCount[stage]++;
+    m_totalTime[stage] += elapsed;
+    if (elapsed > m_maxTime[stage]) {
+        m_maxTime[stage] = elapsed;
+    }
+}
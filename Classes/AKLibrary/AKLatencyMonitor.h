@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2015 Akihiro Kaneda.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1.Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   2.Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   3.Neither the name of the Monochrome Soft nor the names of its contributors
+ *     may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!
+ @file AKLatencyMonitor.h
+ @brief 入力遅延計測クラス定義
+ 
+ 入力イベントから画面表示までの遅延時間を計測するクラスを定義する。
+ */
+
+#ifndef AKLATENCYMONITOR_H
+#define AKLATENCYMONITOR_H
+
+#include "AKCommon.h"
+#include <chrono>
+
+/// 入力遅延の計測区間
+enum AKLatencyStage {
+    kAKLatencyStageEvent = 0,   ///< 入力イベント到着から更新処理開始まで
+    kAKLatencyStageSimulation,  ///< 更新処理開始から更新処理終了まで
+    kAKLatencyStageFrame,       ///< 更新処理終了から描画終了まで
+    kAKLatencyStageTotal,       ///< 入力イベント到着から描画終了まで
+    kAKLatencyStageCount        ///< 計測区間の数
+};
+
+/*!
+ @brief 入力遅延計測クラス
+ 
+ 入力イベントに到着時刻を記録し、そのイベントを最初に反映した更新処理と、
+ その結果を最初に描画したフレームまでの経過時間を区間ごとにヒストグラムに集計する。
+ 集計結果はCSV形式でファイルに出力できる。
+ 描画終了はDirectorのEVENT_AFTER_DRAWの時刻とし、ディスプレイへの表示までの時間は含まない。
+ */
+class AKLatencyMonitor {
+public:
+    /// ヒストグラムの1区間の幅(マイクロ秒)
+    static const int kAKLatencyBinWidth = 1000;
+    /// ヒストグラムの区間数(最後の区間はそれ以上の時間をすべて含む)
+    static const int kAKLatencyBinCount = 100;
+    /// 1フレームの間に保持する入力イベントの最大数
+    static const int kAKLatencyMaxPending = 64;
+    
+private:
+    /// 時刻
+    typedef std::chrono::steady_clock::time_point Time;
+    
+    /// 計測中かどうか
+    bool m_isRunning;
+    /// 描画終了イベントのリスナー
+    cocos2d::EventListenerCustom *m_afterDrawListener;
+    /// 更新処理待ちの入力イベントの到着時刻
+    Time m_pendingInputs[kAKLatencyMaxPending];
+    /// 更新処理待ちの入力イベントの数
+    int m_pendingCount;
+    /// 描画待ちの入力イベントの到着時刻
+    Time m_updatedInputs[kAKLatencyMaxPending];
+    /// 描画待ちの入力イベントの数
+    int m_updatedCount;
+    /// 更新処理待ちの入力イベントがあふれた数
+    int m_droppedCount;
+    /// 入力イベントを反映する更新処理中かどうか
+    bool m_isUpdating;
+    /// 入力イベントを反映した更新処理の開始時刻
+    Time m_updateBegin;
+    /// 入力イベントを反映した更新処理の終了時刻
+    Time m_updateEnd;
+    /// 区間ごとのヒストグラム
+    int m_histogram[kAKLatencyStageCount][kAKLatencyBinCount];
+    /// 区間ごとの計測数
+    int m_sampleCount[kAKLatencyStageCount];
+    /// 区間ごとの合計時間(マイクロ秒)
+    long long m_totalTime[kAKLatencyStageCount];
+    /// 区間ごとの最大時間(マイクロ秒)
+    long long m_maxTime[kAKLatencyStageCount];
+    
+public:
+    // インスタンス取得
+    static AKLatencyMonitor* getInstance();
+    // 計測開始
+    void start();
+    // 計測終了
+    void stop();
+    // 計測中かどうか
+    bool isRunning() const;
+    // 計測結果初期化
+    void reset();
+    // 入力イベント到着
+    void markInput();
+    // 更新処理開始
+    void markUpdateBegin();
+    // 更新処理終了
+    void markUpdateEnd();
+    // 計測結果ファイル出力
+    bool exportToFile(const std::string &fileName) const;
+    
+private:
+    // コンストラクタ
+    AKLatencyMonitor();
+    // コピーコンストラクタは使用禁止
+    AKLatencyMonitor(const AKLatencyMonitor &other);
+    // 代入演算子は使用禁止
+    AKLatencyMonitor& operator=(const AKLatencyMonitor &other);
+    // 描画終了処理
+    void onAfterDraw(cocos2d::EventCustom *event);
+    // 計測結果追加
+    void addSample(enum AKLatencyStage stage, const Time &begin, const Time &end);
+};
+
+#endif
@@ -48,9 +48,42 @@
 // インターフェースクラス
 #include "AKInterface.h"
 
+// 入力キュークラス
+#include "AKInputQueue.h"
+
+// 入力遅延計測クラス
+#include "AKLatencyMonitor.h"
+
+// サウンドエンジン専用スレッドクラス
+#include "AKSoundThread.h"
+
+// 効果音スケジューラクラス
+#include "AKSEScheduler.h"
+
+// BGM再生クラス
+#include "AKBGMPlayer.h"
+
+// アセット読み込みクラス
+#include "AKAssetLoader.h"
+
+// アセットアーカイブクラス
+#include "AKAssetArchive.h"
+
+// フレームレート抑制クラス
+#include "AKFrameThrottle.h"
+
+// スナップショット読み書きクラス
+#include "AKSnapshot.h"
+
+// 巻き戻し用状態履歴クラス
+#include "AKRewindBuffer.h"
+
 // 角度計算クラス
 #include "AKAngle.h"
 
+// 高速三角関数クラス
+#include "AKFastMath.h"
+
 #include "LocalizedResource.h"
 
 // Twitter管理クラス
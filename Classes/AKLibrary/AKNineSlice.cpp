@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2015 Akihiro Kaneda.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1.Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   2.Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   3.Neither the name of the Monochrome Soft nor the names of its contributors
+ *     may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!
+ @file AKNineSlice.cpp
+ @brief 9分割枠表示クラス定義
+ 
+ 9分割した画像で枠を表示するクラスを定義する。
+ */
+
+#include "AKNineSlice.h"
+
+using cocos2d::Vec2;
+using cocos2d::Rect;
+using cocos2d::Size;
+using cocos2d::Sprite;
+using cocos2d::SpriteFrame;
+using cocos2d::SpriteFrameCache;
+using cocos2d::SpriteBatchNode;
+
+/*!
+ @brief コンビニエンスコンストラクタ
+ 
+ インスタンスを生成し、初期化処理を行い、autoreleaseを行う。
+ @param textureImage テクスチャアトラス画像ファイル名
+ @return 生成したインスタンス
+ */
+AKNineSlice* AKNineSlice::create(const std::string &textureImage)
+{
+    AKNineSlice *instance = new AKNineSlice(textureImage);
+    if (instance->init()) {
+        instance->autorelease();
+        return instance;
+    }
+    else {
+        CC_SAFE_DELETE(instance);
+        return NULL;
+    }
+}
+
+/*!
+ @brief コンストラクタ
+ 
+ バッチノードと各部分のスプライトを作成する。
+ 各部分は画像が設定されるまで非表示とする。
+ @param textureImage テクスチャアトラス画像ファイル名
+ */
+AKNineSlice::AKNineSlice(const std::string &textureImage) :
+m_innerRect(0.0f, 0.0f, 0.0f, 0.0f)
+{
+    // バッチノードを作成する
+    m_batch = SpriteBatchNode::create(textureImage, kAKNineSlicePartCount);
+    AKAssert(m_batch != NULL, "バッチノードの作成に失敗:%s", textureImage.c_str());
+    addChild(m_batch);
+    
+    // 各部分のスプライトを作成する
+    for (int i = 0; i < kAKNineSlicePartCount; i++) {
+        m_parts[i] = Sprite::createWithTexture(m_batch->getTexture(), Rect::ZERO);
+        m_parts[i]->setVisible(false);
+        m_batch->addChild(m_parts[i], 0, i);
+    }
+}
+
+/*!
+ @brief 各部分の画像設定
+ 
+ 各部分のスプライトフレームを差し替える。
+ キーが空文字列の部分は非表示にする。
+ @param keys 各部分のスプライトフレームのキー
+ */
+void AKNineSlice::setSpriteFrames(const std::string keys[kAKNineSlicePartCount])
+{
+    SpriteFrameCache *spriteFrameCache = SpriteFrameCache::getInstance();
+    
+    for (int i = 0; i < kAKNineSlicePartCount; i++) {
+        
+        // キーが指定されていない部分は非表示にする
+        if (keys[i].empty()) {
+            m_parts[i]->setVisible(false);
+            continue;
+        }
+        
+        // スプライトフレームを取得する
+        SpriteFrame *spriteFrame = spriteFrameCache->getSpriteFrameByName(keys[i]);
+        AKAssert(spriteFrame != NULL, "スプライトフレームがない:%s", keys[i].c_str());
+        if (spriteFrame == NULL) {
+            m_parts[i]->setVisible(false);
+            continue;
+        }
+        
+        // スプライトフレームを差し替える
+        m_parts[i]->setSpriteFrame(spriteFrame);
+        m_parts[i]->setVisible(true);
+    }
+    
+    // 画像の大きさが変わる可能性があるため配置を更新する
+    updateLayout();
+}
+
+/*!
+ @brief 内側の矩形設定
+ 
+ 中央部分を表示する矩形を設定する。
+ 四隅と辺はこの矩形の外側に配置する。
+ @param rect 内側の矩形
+ */
+void AKNineSlice::setInnerRect(const Rect &rect)
+{
+    m_innerRect = rect;
+    updateLayout();
+}
+
+/*!
+ @brief 各部分の配置更新
+ 
+ 内側の矩形と各部分の画像の大きさから、各部分の位置と拡大率を設定する。
+ */
+void AKNineSlice::updateLayout()
+{
+    float left = m_innerRect.getMinX();
+    float right = m_innerRect.getMaxX();
+    float bottom = m_innerRect.getMinY();
+    float top = m_innerRect.getMaxY();
+    float centerX = (left + right) / 2.0f;
+    float centerY = (bottom + top) / 2.0f;
+    float width = m_innerRect.size.width;
+    float height = m_innerRect.size.height;
+    
+    // 枠の太さは左右の辺の幅、上下の辺の高さとする
+    float leftWidth = m_parts[kAKNineSliceLeft]->getContentSize().width;
+    float rightWidth = m_parts[kAKNineSliceRight]->getContentSize().width;
+    float topHeight = m_parts[kAKNineSliceTop]->getContentSize().height;
+    float bottomHeight = m_parts[kAKNineSliceBottom]->getContentSize().height;
+    
+    // 各部分の中心座標
+    const Vec2 positions[kAKNineSlicePartCount] = {
+        Vec2(left - leftWidth / 2.0f, top + topHeight / 2.0f),
+        Vec2(centerX, top + topHeight / 2.0f),
+        Vec2(right + rightWidth / 2.0f, top + topHeight / 2.0f),
+        Vec2(left - leftWidth / 2.0f, centerY),
+        Vec2(centerX, centerY),
+        Vec2(right + rightWidth / 2.0f, centerY),
+        Vec2(left - leftWidth / 2.0f, bottom - bottomHeight / 2.0f),
+        Vec2(centerX, bottom - bottomHeight / 2.0f),
+        Vec2(right + rightWidth / 2.0f, bottom - bottomHeight / 2.0f)
+    };
+    
+    // 上下の辺と中央は横方向、左右の辺と中央は縦方向に拡大する
+    const bool isStretchX[kAKNineSlicePartCount] = {
+        false, true, false,
+        false, true, false,
+        false, true, false
+    };
+    const bool isStretchY[kAKNineSlicePartCount] = {
+        false, false, false,
+        true, true, true,
+        false, false, false
+    };
+    
+    for (int i = 0; i < kAKNineSlicePartCount; i++) {
+        
+        Sprite *part = m_parts[i];
+        const Size &size = part->getContentSize();
+        
+        part->setPosition(positions[i]);
+        
+        // 画像の大きさが0の場合は拡大しない
+        if (isStretchX[i] && size.width > 0.0f) {
+            part->setScaleX(width / size.width);
+        }
+        if (isStretchY[i] && size.height > 0.0f) {
+            part->setScaleY(height / size.height);
+        }
+    }
+}
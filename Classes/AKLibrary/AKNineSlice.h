@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2015 Akihiro Kaneda.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1.Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   2.Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   3.Neither the name of the Monochrome Soft nor the names of its contributors
+ *     may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!
+ @file AKNineSlice.h
+ @brief 9分割枠表示クラス定義
+ 
+ 9分割した画像で枠を表示するクラスを定義する。
+ */
+
+#ifndef AKNINESLICE_H
+#define AKNINESLICE_H
+
+#include "AKCommon.h"
+
+/// 9分割枠の各部分
+enum AKNineSlicePart {
+    kAKNineSliceTopLeft = 0,    ///< 左上
+    kAKNineSliceTop,            ///< 上
+    kAKNineSliceTopRight,       ///< 右上
+    kAKNineSliceLeft,           ///< 左
+    kAKNineSliceCenter,         ///< 中央
+    kAKNineSliceRight,          ///< 右
+    kAKNineSliceBottomLeft,     ///< 左下
+    kAKNineSliceBottom,         ///< 下
+    kAKNineSliceBottomRight,    ///< 右下
+    kAKNineSlicePartCount       ///< 部分の数
+};
+
+/*!
+ @brief 9分割枠表示クラス
+ 
+ テクスチャアトラス内の9個の画像で枠を表示する。
+ 四隅は等倍、上下の辺は横方向、左右の辺は縦方向、中央は両方向に拡大して表示する。
+ 1個のバッチノードに9個のスプライトを配置するため、枠の大きさによらず1回の描画で表示できる。
+ 画像の切り替えはスプライトフレームの差し替えのみで行い、ノードは作り直さない。
+ */
+class AKNineSlice : public cocos2d::Node {
+public:
+    // コンビニエンスコンストラクタ
+    static AKNineSlice* create(const std::string &textureImage);
+    
+private:
+    /// 各部分の画像を配置するバッチノード
+    cocos2d::SpriteBatchNode *m_batch;
+    /// 各部分のスプライト
+    cocos2d::Sprite *m_parts[kAKNineSlicePartCount];
+    /// 内側の矩形
+    cocos2d::Rect m_innerRect;
+    
+    // デフォルトコンストラクタは使用禁止にする
+    AKNineSlice();
+    
+public:
+    // コンストラクタ
+    AKNineSlice(const std::string &textureImage);
+    // 各部分の画像設定
+    void setSpriteFrames(const std::string keys[kAKNineSlicePartCount]);
+    // 内側の矩形設定
+    void setInnerRect(const cocos2d::Rect &rect);
+    
+private:
+    // 各部分の配置更新
+    void updateLayout();
+};
+
+#endif
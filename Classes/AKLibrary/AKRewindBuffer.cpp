@@ -0,0 +1,428 @@
+/*
+ * Copyright (c) 2014 Akihiro Kaneda.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1.Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   2.Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   3.Neither the name of the Monochrome Soft nor the names of its contributors
+ *     may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!
+ @file AKRewindBuffer.cpp
+ @brief 巻き戻し用状態履歴クラス定義
+ 
+ 一定間隔で記録したゲーム状態のスナップショットを差分圧縮して保持するクラスを定義する。
+ */
+
+#include "AKRewindBuffer.h"
+#include <string.h>
+
+/// 差分でコピーとする最小の一致バイト数
+static const size_t kAKMinMatch = 8;
+/// 差分作成用のハッシュテーブルのビット数
+static const int kAKHashBits = 14;
+
+/*!
+ @brief ハッシュ値計算
+ 
+ 一致を探すため、指定位置から最小の一致バイト数分のハッシュ値を計算する。
+ @param bytes 計算する位置
+ @return ハッシュ値
+ */
+static unsigned int calcHash(const unsigned char *bytes)
+{
+    unsigned long long value = 0;
+    memcpy(&value, bytes, sizeof(value));
+    return static_cast<unsigned int>((value * 0x9E3779B97F4A7C15ULL) >> (64 - kAKHashBits));
+}
+
+/*!
+ @brief 可変長整数書き込み
+ 
+ 7ビットずつ下位から書き込み、続きがある場合は最上位ビットを立てる。
+ @param value 書き込む値
+ @param out 書き込み先
+ */
+static void writeVarint(unsigned int value, std::vector<unsigned char> *out)
+{
+    while (value >= 0x80) {
+        out->push_back(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+    out->push_back(static_cast<unsigned char>(value));
+}
+
+/*!
+ @brief 可変長整数読み込み
+ 
+ writeVarintで書き込んだ値を読み込む。
+ @param data 読み込むバイト列
+ @param position 読み込む位置(読み込んだ分進める)
+ @param value 読み込んだ値を格納する変数
+ @return 読み込めたかどうか
+ */
+static bool readVarint(const std::vector<unsigned char> &data, size_t *position, unsigned int *value)
+{
+    *value = 0;
+    for (int shift = 0; shift < 32; shift += 7) {
+        if (*position >= data.size()) {
+            return false;
+        }
+        unsigned char byte = data[(*position)++];
+        *value |= static_cast<unsigned int>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*!
+ @brief 上限を指定したコンストラクタ
+ 
+ 記録の上限を設定する。メモリの確保は記録追加時に行う。
+ @param maxBytes 記録に使用する最大メモリサイズ
+ @param maxCount 最大記録数
+ @param keyInterval キーフレームを作成する間隔(記録数)
+ */
+AKRewindBuffer::AKRewindBuffer(size_t maxBytes, int maxCount, int keyInterval) :
+m_maxBytes(maxBytes), m_maxCount(maxCount), m_keyInterval(keyInterval), m_usedBytes(0)
+{
+    AKAssert(maxCount > 0 && keyInterval > 0, "上限が不正:maxCount=%d keyInterval=%d", maxCount, keyInterval);
+}
+
+/*!
+ @brief 記録追加
+ 
+ スナップショットを最新の記録として追加する。
+ キーフレームの間隔に達している場合はそのまま、それ以外は直前の記録との差分を保持する。
+ 上限を超えた場合は古い記録を削除する。最新の記録は削除しない。
+ @param snapshot スナップショット
+ */
+void AKRewindBuffer::push(const std::vector<unsigned char> &snapshot)
+{
+    AKRewindEntry entry;
+    
+    // 最初の記録、またはキーフレームの間隔に達している場合はキーフレームとする
+    entry.isKey = (m_entries.empty() || getCountSinceKey() + 1 >= m_keyInterval);
+    if (entry.isKey) {
+        entry.data = snapshot;
+    }
+    else {
+        encodeDelta(m_latest, snapshot, &m_work);
+        entry.data.assign(m_work.begin(), m_work.end());
+    }
+    
+    AKLog(kAKLogRewindBuffer_1, "記録追加:isKey=%d size=%d delta=%d",
+          entry.isKey, (int)snapshot.size(), (int)entry.data.size());
+    
+    // 次の差分の基準として内容を保持する
+    m_latest = snapshot;
+    
+    // 記録を追加する
+    m_usedBytes += entry.data.size();
+    m_entries.push_back(entry);
+    
+    // 上限を超えている場合は古い記録から削除する
+    while (m_entries.size() > 1 &&
+           (m_usedBytes > m_maxBytes || static_cast<int>(m_entries.size()) > m_maxCount)) {
+        removeOldest();
+    }
+}
+
+/*!
+ @brief 巻き戻し
+ 
+ 最新の記録から指定数さかのぼった記録を取り出す。
+ 0を指定した場合は最新の記録を取り出す。記録数以上の場合は最も古い記録を取り出す。
+ 取り出した記録より新しい記録は削除し、取り出した記録を最新の記録とする。
+ @param count さかのぼる記録数
+ @param snapshot 取り出したスナップショットを格納する変数
+ @return 取り出せたかどうか
+ */
+bool AKRewindBuffer::rewind(int count, std::vector<unsigned char> *snapshot)
+{
+    // 記録がない場合は取り出せない
+    if (m_entries.empty()) {
+        return false;
+    }
+    
+    // 取り出す記録の位置を決める
+    int index = static_cast<int>(m_entries.size()) - 1 - count;
+    if (index < 0) {
+        index = 0;
+    }
+    
+    // 記録を展開する
+    if (!decode(index, snapshot)) {
+        AKLog(kAKLogRewindBuffer_0, "記録の展開に失敗:index=%d", index);
+        clear();
+        return false;
+    }
+    
+    // 取り出した記録より新しい記録を削除する
+    while (static_cast<int>(m_entries.size()) > index + 1) {
+        m_usedBytes -= m_entries.back().data.size();
+        m_entries.pop_back();
+    }
+    
+    // 取り出した記録を次の差分の基準とする
+    m_latest = *snapshot;
+    
+    AKLog(kAKLogRewindBuffer_1, "巻き戻し:index=%d size=%d", index, (int)m_entries.size());
+    
+    return true;
+}
+
+/*!
+ @brief 全記録削除
+ 
+ すべての記録を削除する。
+ */
+void AKRewindBuffer::clear()
+{
+    m_entries.clear();
+    m_latest.clear();
+    m_usedBytes = 0;
+}
+
+/*!
+ @brief 記録数取得
+ 
+ 保持している記録の数を取得する。
+ @return 記録数
+ */
+int AKRewindBuffer::size() const
+{
+    return static_cast<int>(m_entries.size());
+}
+
+/*!
+ @brief 使用メモリサイズ取得
+ 
+ 記録の保持に使用しているメモリサイズを取得する。
+ @return 使用メモリサイズ
+ */
+size_t AKRewindBuffer::getUsedBytes() const
+{
+    return m_usedBytes;
+}
+
+/*!
+ @brief 最も古い記録の削除
+ 
+ 最も古い記録を削除する。最も古い記録は常にキーフレームのため、
+ 次の記録が差分の場合は展開してキーフレームに置き換えてから削除する。
+ */
+void AKRewindBuffer::removeOldest()
+{
+    AKRewindEntry &oldest = m_entries.front();
+    
+    // 次の記録が差分の場合はキーフレームに置き換える
+    if (m_entries.size() >= 2 && !m_entries[1].isKey) {
+        
+        AKRewindEntry &next = m_entries[1];
+        if (decodeDelta(oldest.data, next.data, &m_work)) {
+            m_usedBytes -= next.data.size();
+            next.data.assign(m_work.begin(), m_work.end());
+            next.isKey = true;
+            m_usedBytes += next.data.size();
+        }
+        else {
+            AKLog(kAKLogRewindBuffer_0, "記録の展開に失敗");
+            clear();
+            return;
+        }
+    }
+    
+    m_usedBytes -= oldest.data.size();
+    m_entries.pop_front();
+}
+
+/*!
+ @brief 記録の展開
+ 
+ 指定位置以前の直近のキーフレームから順に差分を適用して、指定位置の記録を展開する。
+ @param index 記録の位置
+ @param snapshot 展開したスナップショットを格納する変数
+ @return 展開できたかどうか
+ */
+bool AKRewindBuffer::decode(int index, std::vector<unsigned char> *snapshot)
+{
+    // 直近のキーフレームを探す
+    int key = index;
+    while (key > 0 && !m_entries[key].isKey) {
+        key--;
+    }
+    
+    // キーフレームから順に差分を適用する
+    *snapshot = m_entries[key].data;
+    for (int i = key + 1; i <= index; i++) {
+        if (!decodeDelta(*snapshot, m_entries[i].data, &m_work)) {
+            return false;
+        }
+        snapshot->swap(m_work);
+    }
+    
+    return true;
+}
+
+/*!
+ @brief 最新のキーフレーム以降の記録数取得
+ 
+ 最新のキーフレームより後に追加した差分の記録数を取得する。
+ @return 記録数
+ */
+int AKRewindBuffer::getCountSinceKey() const
+{
+    int count = 0;
+    for (int i = static_cast<int>(m_entries.size()) - 1; i >= 0 && !m_entries[i].isKey; i--) {
+        count++;
+    }
+    return count;
+}
+
+/*!
+ @brief 差分作成
+ 
+ 基準のバイト列から対象のバイト列を作成するための差分を作成する。
+ 差分は次の命令の並びとする。長さと位置は可変長整数で表す。
+   ・(長さ << 1) | 1, 位置 : 基準のバイト列の位置から長さ分をコピーする
+   ・(長さ << 1) | 0, バイト列 : 続くバイト列をそのまま追加する
+ 一致の検索は、直前のコピーの続きの位置を優先し、見つからない場合はハッシュテーブルで探す。
+ @param base 基準のバイト列
+ @param target 対象のバイト列
+ @param delta 差分を格納する変数
+ */
+void AKRewindBuffer::encodeDelta(const std::vector<unsigned char> &base,
+                                 const std::vector<unsigned char> &target,
+                                 std::vector<unsigned char> *delta)
+{
+    delta->clear();
+    
+    // 基準のバイト列の各位置のハッシュ値を登録する
+    // 同じハッシュ値の場合は前方の位置を優先する
+    m_hashTable.assign(1 << kAKHashBits, -1);
+    for (int i = static_cast<int>(base.size()) - static_cast<int>(kAKMinMatch); i >= 0; i--) {
+        m_hashTable[calcHash(&base[i])] = i;
+    }
+    
+    size_t literalStart = 0;
+    size_t position = 0;
+    size_t expected = 0;
+    while (position + kAKMinMatch <= target.size()) {
+        
+        // 直前のコピーの続きの位置が一致するか調べる
+        long match = -1;
+        if (expected + kAKMinMatch <= base.size() &&
+            memcmp(&base[expected], &target[position], kAKMinMatch) == 0) {
+            match = expected;
+        }
+        // 一致しない場合はハッシュテーブルから探す
+        else {
+            int candidate = m_hashTable[calcHash(&target[position])];
+            if (candidate >= 0 && memcmp(&base[candidate], &target[position], kAKMinMatch) == 0) {
+                match = candidate;
+            }
+        }
+        
+        // 一致しない場合は次の位置へ進める
+        if (match < 0) {
+            position++;
+            continue;
+        }
+        
+        // 一致する長さを延ばす
+        size_t length = kAKMinMatch;
+        while (match + length < base.size() &&
+               position + length < target.size() &&
+               base[match + length] == target[position + length]) {
+            length++;
+        }
+        
+        // それまでのバイト列を追加する命令を書き込む
+        if (position > literalStart) {
+            writeVarint(static_cast<unsigned int>((position - literalStart) << 1), delta);
+            delta->insert(delta->end(), target.begin() + literalStart, target.begin() + position);
+        }
+        
+        // コピーする命令を書き込む
+        writeVarint(static_cast<unsigned int>((length << 1) | 1), delta);
+        writeVarint(static_cast<unsigned int>(match), delta);
+        
+        position += length;
+        literalStart = position;
+        expected = match + length;
+    }
+    
+    // 残りのバイト列を追加する命令を書き込む
+    if (target.size() > literalStart) {
+        writeVarint(static_cast<unsigned int>((target.size() - literalStart) << 1), delta);
+        delta->insert(delta->end(), target.begin() + literalStart, target.end());
+    }
+}
+
+/*!
+ @brief 差分適用
+ 
+ encodeDeltaで作成した差分を基準のバイト列に適用し、対象のバイト列を作成する。
+ @param base 基準のバイト列
+ @param delta 差分
+ @param target 作成したバイト列を格納する変数
+ @return 適用できたかどうか
+ */
+bool AKRewindBuffer::decodeDelta(const std::vector<unsigned char> &base,
+                                 const std::vector<unsigned char> &delta,
+                                 std::vector<unsigned char> *target)
+{
+    target->clear();
+    
+    size_t position = 0;
+    while (position < delta.size()) {
+        
+        // 命令を読み込む
+        unsigned int command = 0;
+        if (!readVarint(delta, &position, &command)) {
+            return false;
+        }
+        size_t length = command >> 1;
+        
+        // 基準のバイト列からコピーする
+        if (command & 1) {
+            unsigned int offset = 0;
+            if (!readVarint(delta, &position, &offset) || offset + length > base.size()) {
+                return false;
+            }
+            target->insert(target->end(), base.begin() + offset, base.begin() + offset + length);
+        }
+        // 続くバイト列を追加する
+        else {
+            if (position + length > delta.size()) {
+                return false;
+            }
+            target->insert(target->end(), delta.begin() + position, delta.begin() + position + length);
+            position += length;
+        }
+    }
+    
+    return true;
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2014 Akihiro Kaneda.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1.Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   2.Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   3.Neither the name of the Monochrome Soft nor the names of its contributors
+ *     may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!
+ @file AKRewindBuffer.h
+ @brief 巻き戻し用状態履歴クラス定義
+ 
+ 一定間隔で記録したゲーム状態のスナップショットを差分圧縮して保持するクラスを定義する。
+ */
+
+#ifndef AKREWINDBUFFER_H
+#define AKREWINDBUFFER_H
+
+#include "AKCommon.h"
+#include <deque>
+
+/*!
+ @brief 巻き戻し用状態履歴クラス
+ 
+ スナップショットのバイト列を記録し、指定した数だけさかのぼったスナップショットを取り出す。
+ 記録は直前の記録との差分として保持し、一定数ごとに差分のないキーフレームを作成する。
+ 差分は直前の記録内の任意の位置からのコピーと、新しいバイト列の組み合わせで表すため、
+ キャラクターの増減で後続のデータの位置がずれても圧縮が効く。
+ 記録数またはメモリサイズが上限を超えた場合は古い記録から削除する。
+ */
+class AKRewindBuffer {
+private:
+    /// 記録
+    struct AKRewindEntry {
+        /// キーフレームかどうか(falseの場合は直前の記録との差分)
+        bool isKey;
+        /// 記録内容
+        std::vector<unsigned char> data;
+    };
+    
+private:
+    /// 記録
+    std::deque<AKRewindEntry> m_entries;
+    /// 記録に使用する最大メモリサイズ
+    size_t m_maxBytes;
+    /// 最大記録数
+    int m_maxCount;
+    /// キーフレームを作成する間隔(記録数)
+    int m_keyInterval;
+    /// 記録に使用しているメモリサイズ
+    size_t m_usedBytes;
+    /// 最新の記録の内容(次の差分の基準とする)
+    std::vector<unsigned char> m_latest;
+    /// 差分作成用のハッシュテーブル
+    std::vector<int> m_hashTable;
+    /// 差分作成、展開用の作業領域
+    std::vector<unsigned char> m_work;
+    
+private:
+    // デフォルトコンストラクタは使用禁止にする
+    AKRewindBuffer();
+    
+public:
+    // 上限を指定したコンストラクタ
+    AKRewindBuffer(size_t maxBytes, int maxCount, int keyInterval);
+    // 記録追加
+    void push(const std::vector<unsigned char> &snapshot);
+    // 巻き戻し
+    bool rewind(int count, std::vector<unsigned char> *snapshot);
+    // 全記録削除
+    void clear();
+    // 記録数取得
+    int size() const;
+    // 使用メモリサイズ取得
+    size_t getUsedBytes() const;
+    
+private:
+    // 最も古い記録の削除
+    void removeOldest();
+    // 記録の展開
+    bool decode(int index, std::vector<unsigned char> *snapshot);
+    // 最新のキーフレーム以降の記録数取得
+    int getCountSinceKey() const;
+    // 差分作成
+    void encodeDelta(const std::vector<unsigned char> &base,
+                     const std::vector<unsigned char> &target,
+                     std::vector<unsigned char> *delta);
+    // 差分適用
+    static bool decodeDelta(const std::vector<unsigned char> &base,
+                            const std::vector<unsigned char> &delta,
+                            std::vector<unsigned char> *target);
+};
+
+#endif
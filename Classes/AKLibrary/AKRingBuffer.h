@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2015 Akihiro Kaneda.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1.Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   2.Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   3.Neither the name of the Monochrome Soft nor the names of its contributors
+ *     may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!
+ @file AKRingBuffer.h
+ @brief リングバッファクラス定義
+ 
+ 固定長のリングバッファを定義する。
+ */
+
+#ifndef AKRINGBUFFER_H
+#define AKRINGBUFFER_H
+
+#include "AKCommon.h"
+
+/*!
+ @brief リングバッファクラス
+ 
+ 要素を固定長の配列に保持するリングバッファ。
+ 追加、取り出し、位置指定による参照はすべて定数時間で行い、メモリの確保を行わない。
+ 移動履歴のような遅延線に使用する。
+ */
+template <class T, int N>
+class AKRingBuffer {
+private:
+    /// 要素を格納する配列
+    T m_items[N];
+    /// 先頭(最も古い要素)の位置
+    int m_head;
+    /// 要素数
+    int m_size;
+    
+public:
+    /*!
+     @brief コンストラクタ
+     
+     空のリングバッファを作成する。
+     */
+    AKRingBuffer() :
+    m_head(0), m_size(0)
+    {
+    }
+    
+    /*!
+     @brief 容量取得
+     
+     格納できる要素数を取得する。
+     @return 容量
+     */
+    int capacity() const
+    {
+        return N;
+    }
+    
+    /*!
+     @brief 要素数取得
+     
+     格納されている要素数を取得する。
+     @return 要素数
+     */
+    int size() const
+    {
+        return m_size;
+    }
+    
+    /*!
+     @brief 空かどうか
+     
+     要素が格納されていないかどうかを取得する。
+     @return 空かどうか
+     */
+    bool empty() const
+    {
+        return m_size <= 0;
+    }
+    
+    /*!
+     @brief 満杯かどうか
+     
+     容量分の要素が格納されているかどうかを取得する。
+     @return 満杯かどうか
+     */
+    bool full() const
+    {
+        return m_size >= N;
+    }
+    
+    /*!
+     @brief 全要素削除
+     
+     格納されている要素をすべて削除する。
+     */
+    void clear()
+    {
+        m_head = 0;
+        m_size = 0;
+    }
+    
+    /*!
+     @brief 末尾に追加
+     
+     要素を末尾に追加する。満杯の場合は最も古い要素を破棄する。
+     @param item 追加する要素
+     */
+    void push(const T &item)
+    {
+        // 満杯の場合は最も古い要素を破棄する
+        if (full()) {
+            pop();
+        }
+        
+        m_items[(m_head + m_size) % N] = item;
+        m_size++;
+    }
+    
+    /*!
+     @brief 先頭を削除
+     
+     最も古い要素を削除する。
+     */
+    void pop()
+    {
+        AKAssert(m_size > 0, "リングバッファが空");
+        
+        m_head = (m_head + 1) % N;
+        m_size--;
+    }
+    
+    /*!
+     @brief 先頭の要素取得
+     
+     最も古い要素を取得する。
+     @return 最も古い要素
+     */
+    const T& front() const
+    {
+        AKAssert(m_size > 0, "リングバッファが空");
+        
+        return m_items[m_head];
+    }
+    
+    /*!
+     @brief 末尾の要素取得
+     
+     最も新しい要素を取得する。
+     @return 最も新しい要素
+     */
+    const T& back() const
+    {
+        AKAssert(m_size > 0, "リングバッファが空");
+        
+        return m_items[(m_head + m_size - 1) % N];
+    }
+    
+    /*!
+     @brief 過去の要素取得
+     
+     最も新しい要素から指定数分さかのぼった要素を取得する。
+     @param index さかのぼる数(0の場合は最も新しい要素)
+     @return 要素
+     */
+    const T& lookback(int index) const
+    {
+        AKAssert(index >= 0 && index < m_size, "位置が範囲外:index=%d size=%d", index, m_size);
+        
+        return m_items[(m_head + m_size - 1 - index) % N];
+    }
+};
+
+#endif
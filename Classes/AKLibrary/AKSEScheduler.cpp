@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2015 Akihiro Kaneda.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1.Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   2.Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   3.Neither the name of the Monochrome Soft nor the names of its contributors
+ *     may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!
+ @file AKSEScheduler.cpp
+ @brief 効果音スケジューラクラス定義
+ 
+ 効果音の再生要求をまとめて、サウンドエンジン専用スレッドから再生するクラスを定義する。
+ */
+
+#include "AKSEScheduler.h"
+#include "AKSoundThread.h"
+#include <algorithm>
+
+using std::string;
+using std::vector;
+using std::chrono::steady_clock;
+using std::chrono::milliseconds;
+using cocos2d::Director;
+using cocos2d::EventCustom;
+using cocos2d::FileUtils;
+
+/// 登録されていない効果音の再生設定
+const AKSEConfig AKSEScheduler::kAKSEDefaultConfig = {2, 200, 50, 0};
+
+/*!
+ @brief 再生要求の優先度比較
+ 
+ 優先度の高い効果音が先になるように比較する。
+ */
+class AKSEPriorityCompare {
+private:
+    /// 効果音の優先度
+    const vector<int> &m_priorities;
+    
+public:
+    /*!
+     @brief コンストラクタ
+     
+     効果音の位置ごとの優先度を指定して作成する。
+     @param priorities 効果音の優先度
+     */
+    AKSEPriorityCompare(const vector<int> &priorities) : m_priorities(priorities)
+    {
+    }
+    
+    /*!
+     @brief 比較
+     
+     優先度の高い効果音が先になるように比較する。
+     @param a 効果音の位置
+     @param b 効果音の位置
+     @return aがbより先の場合true
+     */
+    bool operator()(int a, int b) const
+    {
+        return m_priorities[a] > m_priorities[b];
+    }
+};
+
+/*!
+ @brief インスタンス取得
+ 
+ シングルトンのインスタンスを取得する。
+ @return インスタンス
+ */
+AKSEScheduler* AKSEScheduler::getInstance()
+{
+    static AKSEScheduler instance;
+    return &instance;
+}
+
+/*!
+ @brief コンストラクタ
+ 
+ 処理停止中の状態で作成する。
+ */
+AKSEScheduler::AKSEScheduler() :
+m_globalVoices(kAKSEDefaultGlobalVoices), m_afterUpdateListener(NULL)
+{
+}
+
+/*!
+ @brief 処理開始
+ 
+ フレームの更新処理終了時に再生要求を処理するようにする。
+ 再生はサウンドエンジン専用スレッドで行うため、先にAKSoundThreadの処理を開始しておくこと。
+ */
+void AKSEScheduler::start()
+{
+    // 更新処理終了イベントのリスナーを登録する
+    if (m_afterUpdateListener == NULL) {
+        m_afterUpdateListener = Director::getInstance()->getEventDispatcher()->addCustomEventListener(Director::EVENT_AFTER_UPDATE, CC_CALLBACK_1(AKSEScheduler::onAfterUpdate, this));
+    }
+}
+
+/*!
+ @brief 全体の最大同時発音数設定
+ 
+ すべての効果音を合わせた最大同時発音数を設定する。
+ @param globalVoices 全体の最大同時発音数
+ */
+void AKSEScheduler::setGlobalVoices(int globalVoices)
+{
+    m_globalVoices = globalVoices;
+}
+
+/*!
+ @brief 効果音読み込み
+ 
+ 効果音の再生設定を登録し、サウンドエンジン専用スレッドでファイルを読み込む。
+ @param fileName ファイル名
+ @param config 再生設定
+ */
+void AKSEScheduler::preloadEffect(const char *fileName, const AKSEConfig &config)
+{
+    // 再生設定を登録する
+    int index = getEffectIndex(fileName, config);
+    m_effects[index].config = config;
+    
+    // ファイルが見つからない場合は読み込まない
+    if (m_effects[index].path.empty()) {
+        return;
+    }
+    
+    // 専用スレッドで読み込む
+    AKSoundThread::getInstance()->push(AKSoundThread::kAKSoundCommandPreloadEffect, m_effects[index].path, false, 0.0f);
+}
+
+/*!
+ @brief 効果音再生
+ 
+ 効果音の再生要求を追加する。
+ 実際の再生はフレームの更新処理終了時に、同時発音数の範囲内で行う。
+ 同じフレーム内の同じ効果音の再生要求は1回にまとめる。
+ @param fileName ファイル名
+ */
+void AKSEScheduler::playEffect(const char *fileName)
+{
+    int index = getEffectIndex(fileName, kAKSEDefaultConfig);
+    
+    // すでに再生要求がある場合は無処理
+    if (m_effects[index].isRequested) {
+        return;
+    }
+    
+    m_effects[index].isRequested = true;
+    m_requests.push_back(index);
+}
+
+/*!
+ @brief 再生要求処理
+ 
+ このフレームの再生要求のうち、まとめる時間と同時発音数の範囲内のものをサウンドエンジン専用スレッドに渡す。
+ */
+void AKSEScheduler::flush()
+{
+    // 再生要求がない場合は無処理
+    if (m_requests.empty()) {
+        return;
+    }
+    
+    Time now = steady_clock::now();
+    
+    // 再生が終わった発音を解放し、全体の発音数を数える
+    int activeVoices = 0;
+    for (Effect &effect : m_effects) {
+        Time end = now - milliseconds(effect.config.duration);
+        vector<Time>::iterator it = effect.voices.begin();
+        while (it != effect.voices.end() && *it <= end) {
+            ++it;
+        }
+        effect.voices.erase(effect.voices.begin(), it);
+        activeVoices += effect.voices.size();
+    }
+    
+    // 優先度の高い順に並べる
+    if (m_requests.size() > 1) {
+        vector<int> priorities(m_effects.size());
+        for (int i = 0; i < static_cast<int>(m_effects.size()); i++) {
+            priorities[i] = m_effects[i].config.priority;
+        }
+        std::stable_sort(m_requests.begin(), m_requests.end(), AKSEPriorityCompare(priorities));
+    }
+    
+    vector<AKSoundThread::Command> commands;
+    for (int index : m_requests) {
+        
+        Effect &effect = m_effects[index];
+        effect.isRequested = false;
+        
+        // ファイルが見つからない場合は破棄する
+        if (effect.path.empty()) {
+            continue;
+        }
+        
+        // 前回の再生からまとめる時間が経過していない場合は破棄する
+        if (!effect.voices.empty() && now - effect.voices.back() < milliseconds(effect.config.mergeWindow)) {
+            AKLog(kAKLogSEScheduler_1, "再生要求をまとめる:%s", effect.fileName.c_str());
+            continue;
+        }
+        
+        // 同時発音数を超える場合は破棄する
+        if (static_cast<int>(effect.voices.size()) >= effect.config.maxVoices || activeVoices >= m_globalVoices) {
+            AKLog(kAKLogSEScheduler_1, "同時発音数超過:%s", effect.fileName.c_str());
+            continue;
+        }
+        
+        effect.voices.push_back(now);
+        activeVoices++;
+        
+        AKSoundThread::Command command = {AKSoundThread::kAKSoundCommandPlayEffect, effect.path, false, 0.0f};
+        commands.push_back(command);
+    }
+    m_requests.clear();
+    
+    // 専用スレッドにまとめて渡す
+    AKSoundThread::getInstance()->push(commands);
+}
+
+/*!
+ @brief 更新処理終了処理
+ 
+ フレームの更新処理が終了した時に再生要求を処理する。
+ @param event イベント
+ */
+void AKSEScheduler::onAfterUpdate(EventCustom *event)
+{
+    flush();
+}
+
+/*!
+ @brief 効果音の状態取得
+ 
+ ファイル名に対応する効果音の状態の位置を取得する。
+ 登録されていない場合は指定された再生設定で登録する。
+ 登録時にファイル名をフルパスに変換する。
+ @param fileName ファイル名
+ @param config 登録されていない場合の再生設定
+ @return 効果音の状態の位置
+ */
+int AKSEScheduler::getEffectIndex(const char *fileName, const AKSEConfig &config)
+{
+    // 登録済みの場合はその位置を返す
+    string key(fileName);
+    std::map<string, int>::iterator it = m_effectIndex.find(key);
+    if (it != m_effectIndex.end()) {
+        return it->second;
+    }
+    
+    AKLog(kAKLogSEScheduler_1, "効果音登録:%s", fileName);
+    
+    // 登録されていない場合は追加する
+    Effect effect;
+    effect.fileName = key;
+    effect.path = FileUtils::getInstance()->fullPathForFilename(key);
+    AKLog(kAKLogSEScheduler_0 && effect.path.empty(), "ファイルが見つからない:%s", fileName);
+    effect.config = config;
+    effect.isRequested = false;
+    m_effects.push_back(effect);
+    
+    int index = m_effects.size() - 1;
+    m_effectIndex[key] = index;
+    
+    return index;
+}
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2015 Akihiro Kaneda.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1.Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   2.Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   3.Neither the name of the Monochrome Soft nor the names of its contributors
+ *     may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!
+ @file AKSEScheduler.h
+ @brief 効果音スケジューラクラス定義
+ 
+ 効果音の再生要求をまとめて、サウンドエンジン専用スレッドから再生するクラスを定義する。
+ */
+
+#ifndef AKSESCHEDULER_H
+#define AKSESCHEDULER_H
+
+#include "AKCommon.h"
+#include <chrono>
+#include <map>
+#include <vector>
+
+/// 効果音の再生設定
+struct AKSEConfig {
+    /// 同じ効果音の最大同時発音数
+    int maxVoices;
+    /// 1回の再生で発音数を使用する時間(ミリ秒)
+    int duration;
+    /// 同じ効果音の再生要求をまとめる時間(ミリ秒)
+    int mergeWindow;
+    /// 優先度(全体の発音数を超える場合は優先度の高いものから再生する)
+    int priority;
+};
+
+/*!
+ @brief 効果音スケジューラクラス
+ 
+ 1フレームの間の効果音の再生要求を集めておき、フレームの更新処理の後にまとめて処理する。
+ 同じ効果音の一定時間内の再生要求は1回にまとめ、効果音ごとと全体の同時発音数を超える再生要求は破棄する。
+ 残った再生要求はサウンドエンジン専用スレッド(AKSoundThread)に渡し、メインスレッドがサウンドエンジンの処理を待たないようにする。
+ 効果音のファイル名は登録時にメインスレッドでフルパスに変換しておく。
+ サウンドエンジンの効果音の処理はすべてこのクラスを通して行うこと。
+ */
+class AKSEScheduler {
+public:
+    /// 全体の最大同時発音数の初期値
+    static const int kAKSEDefaultGlobalVoices = 8;
+    /// 登録されていない効果音の再生設定
+    static const AKSEConfig kAKSEDefaultConfig;
+    
+private:
+    /// 時刻
+    typedef std::chrono::steady_clock::time_point Time;
+    
+    /// 効果音の状態
+    struct Effect {
+        /// ファイル名
+        std::string fileName;
+        /// ファイルのフルパス
+        std::string path;
+        /// 再生設定
+        AKSEConfig config;
+        /// 発音中の再生の開始時刻
+        std::vector<Time> voices;
+        /// このフレームで再生要求があったかどうか
+        bool isRequested;
+    };
+    
+    /// 効果音の状態
+    std::vector<Effect> m_effects;
+    /// ファイル名から効果音の状態の位置への対応
+    std::map<std::string, int> m_effectIndex;
+    /// このフレームで再生要求があった効果音の位置
+    std::vector<int> m_requests;
+    /// 全体の最大同時発音数
+    int m_globalVoices;
+    /// 更新処理終了イベントのリスナー
+    cocos2d::EventListenerCustom *m_afterUpdateListener;
+    
+public:
+    // インスタンス取得
+    static AKSEScheduler* getInstance();
+    // 処理開始
+    void start();
+    // 全体の最大同時発音数設定
+    void setGlobalVoices(int globalVoices);
+    // 効果音読み込み
+    void preloadEffect(const char *fileName, const AKSEConfig &config);
+    // 効果音再生
+    void playEffect(const char *fileName);
+    // 再生要求処理
+    void flush();
+    
+private:
+    // コンストラクタ
+    AKSEScheduler();
+    // コピーコンストラクタは使用禁止
+    AKSEScheduler(const AKSEScheduler &other);
+    // 代入演算子は使用禁止
+    AKSEScheduler& operator=(const AKSEScheduler &other);
+    // 更新処理終了処理
+    void onAfterUpdate(cocos2d::EventCustom *event);
+    // 効果音の状態取得
+    int getEffectIndex(const char *fileName, const AKSEConfig &config);
+};
+
+#endif
@@ -35,6 +35,7 @@
 
 #include "AKScreenSize.h"
 #include "AKLogNoDef.h"
+#include "AKAssetArchive.h"
 
 using cocos2d::Size;
 using cocos2d::Vec2;
@@ -73,18 +74,25 @@ void AKScreenSize::init(GLView *view)
     
     // 解像度に応じて画像リソースを切替える
     std::vector<std::string> searchPath;
+    const char *archiveName = NULL;
     if (scale < 2.0f) {
         AKLog(false, "scale=%f 2x", scale);
         searchPath.push_back("pictures/2x");
+        archiveName = "Assets_2x.pak";
     }
     else {
         AKLog(false, "scale=%f 4x", scale);
         searchPath.push_back("pictures/4x");
+        archiveName = "Assets_4x.pak";
         Director::getInstance()->setContentScaleFactor(2.0f);
     }
     
     // 画像リソース検索パスを追加する
     cocos2d::FileUtils::getInstance()->setSearchPaths(searchPath);
+    
+    // 解像度に対応したアセットアーカイブを開く
+    // アーカイブがない場合は個別のファイルを読み込む
+    AKAssetArchive::getInstance()->open(archiveName);
 }
 
 /*!
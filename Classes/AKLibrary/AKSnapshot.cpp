@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2014 Akihiro Kaneda.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1.Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   2.Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   3.Neither the name of the Monochrome Soft nor the names of its contributors
+ *     may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!
+ @file AKSnapshot.cpp
+ @brief スナップショット読み書きクラス定義
+ 
+ ゲーム状態をバイト列へ書き込み、バイト列から読み込むクラスを定義する。
+ */
+
+#include "AKSnapshot.h"
+
+/// 文字列の最大長(不正なデータで大きな領域を確保しないようにする)
+static const unsigned int kAKSnapshotStringMax = 256;
+
+/*!
+ @brief 書き込み先を指定したコンストラクタ
+ 
+ 書き込み先のバイト列を設定する。
+ バイト列の内容は消去せず、末尾に追加していく。
+ @param buffer 書き込み先のバイト列
+ */
+AKSnapshotWriter::AKSnapshotWriter(std::vector<unsigned char> *buffer) :
+m_buffer(buffer)
+{
+}
+
+/*!
+ @brief 文字列書き込み
+ 
+ 文字列の長さに続けて文字列の内容を書き込む。
+ @param value 書き込む文字列
+ */
+void AKSnapshotWriter::writeString(const std::string &value)
+{
+    AKAssert(value.length() <= kAKSnapshotStringMax, "文字列が長すぎる:%s", value.c_str());
+    
+    write(static_cast<unsigned int>(value.length()));
+    m_buffer->insert(m_buffer->end(), value.begin(), value.end());
+}
+
+/*!
+ @brief 書き込んだサイズ取得
+ 
+ 書き込み先のバイト列の現在のサイズを取得する。
+ @return バイト列のサイズ
+ */
+size_t AKSnapshotWriter::getSize() const
+{
+    return m_buffer->size();
+}
+
+/*!
+ @brief 読み込むバイト列を指定したコンストラクタ
+ 
+ 読み込むバイト列を設定する。バイト列の内容はコピーしない。
+ @param data 読み込むバイト列
+ @param size バイト列のサイズ
+ */
+AKSnapshotReader::AKSnapshotReader(const unsigned char *data, size_t size) :
+m_data(data), m_size(size), m_position(0), m_isError(false)
+{
+}
+
+/*!
+ @brief 文字列読み込み
+ 
+ AKSnapshotWriter::writeStringで書き込んだ文字列を読み込む。
+ @param value 読み込んだ文字列を格納する変数
+ @return 読み込めたかどうか
+ */
+bool AKSnapshotReader::readString(std::string *value)
+{
+    // 文字列の長さを読み込む
+    unsigned int length = 0;
+    if (!read(&length)) {
+        return false;
+    }
+    
+    // 長さが不正な場合はエラーとする
+    if (length > kAKSnapshotStringMax || m_size - m_position < length) {
+        m_isError = true;
+        return false;
+    }
+    
+    value->assign(reinterpret_cast<const char*>(m_data + m_position), length);
+    m_position += length;
+    
+    return true;
+}
+
+/*!
+ @brief エラーが発生したかどうか
+ 
+ 読み込み中にエラーが発生したかどうかを取得する。
+ @return エラーが発生したかどうか
+ */
+bool AKSnapshotReader::isError() const
+{
+    return m_isError;
+}
+
+/*!
+ @brief すべて読み込んだかどうか
+ 
+ バイト列の末尾まで読み込んだかどうかを取得する。
+ @return すべて読み込んだかどうか
+ */
+bool AKSnapshotReader::isEnd() const
+{
+    return m_position >= m_size;
+}
+
+/*!
+ @brief エラー状態にする
+ 
+ 読み込んだ値が不正な場合に呼び出し、以降の読み込みを失敗させる。
+ */
+void AKSnapshotReader::setError()
+{
+    m_isError = true;
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2014 Akihiro Kaneda.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1.Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   2.Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   3.Neither the name of the Monochrome Soft nor the names of its contributors
+ *     may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!
+ @file AKSnapshot.h
+ @brief スナップショット読み書きクラス定義
+ 
+ ゲーム状態をバイト列へ書き込み、バイト列から読み込むクラスを定義する。
+ */
+
+#ifndef AKSNAPSHOT_H
+#define AKSNAPSHOT_H
+
+#include "AKCommon.h"
+#include <string.h>
+
+/*!
+ @brief スナップショット書き込みクラス
+ 
+ 値をメモリ上の表現のままバイト列の末尾に追加する。
+ エンディアンや構造体のレイアウトは変換しないため、
+ 同じビルドのアプリケーションで読み込むことを前提とする。
+ */
+class AKSnapshotWriter {
+private:
+    /// 書き込み先のバイト列(弱い参照)
+    std::vector<unsigned char> *m_buffer;
+    
+private:
+    // デフォルトコンストラクタは使用禁止にする
+    AKSnapshotWriter();
+    
+public:
+    // 書き込み先を指定したコンストラクタ
+    AKSnapshotWriter(std::vector<unsigned char> *buffer);
+    // 文字列書き込み
+    void writeString(const std::string &value);
+    // 書き込んだサイズ取得
+    size_t getSize() const;
+    
+    /*!
+     @brief 値書き込み
+     
+     値をメモリ上の表現のまま書き込む。
+     ポインタを含まない、memcpyで複製できる型のみ指定すること。
+     @param value 書き込む値
+     */
+    template<typename T>
+    void write(const T &value)
+    {
+        const unsigned char *bytes = reinterpret_cast<const unsigned char*>(&value);
+        m_buffer->insert(m_buffer->end(), bytes, bytes + sizeof(T));
+    }
+};
+
+/*!
+ @brief スナップショット読み込みクラス
+ 
+ AKSnapshotWriterで書き込んだバイト列を先頭から順に読み込む。
+ バイト列の末尾を超えて読み込もうとした場合はエラー状態になり、
+ 以降の読み込みはすべて失敗する。
+ */
+class AKSnapshotReader {
+private:
+    /// 読み込むバイト列(弱い参照)
+    const unsigned char *m_data;
+    /// バイト列のサイズ
+    size_t m_size;
+    /// 次に読み込む位置
+    size_t m_position;
+    /// エラーが発生したかどうか
+    bool m_isError;
+    
+private:
+    // デフォルトコンストラクタは使用禁止にする
+    AKSnapshotReader();
+    
+public:
+    // 読み込むバイト列を指定したコンストラクタ
+    AKSnapshotReader(const unsigned char *data, size_t size);
+    // 文字列読み込み
+    bool readString(std::string *value);
+    // エラーが発生したかどうか
+    bool isError() const;
+    // すべて読み込んだかどうか
+    bool isEnd() const;
+    // エラー状態にする
+    void setError();
+    
+    /*!
+     @brief 値読み込み
+     
+     AKSnapshotWriter::writeで書き込んだ値を読み込む。
+     @param value 読み込んだ値を格納する変数
+     @return 読み込めたかどうか
+     */
+    template<typename T>
+    bool read(T *value)
+    {
+        // エラー発生後、またはサイズが足りない場合は読み込まない
+        if (m_isError || m_size - m_position < sizeof(T)) {
+            m_isError = true;
+            return false;
+        }
+        
+        memcpy(value, m_data + m_position, sizeof(T));
+        m_position += sizeof(T);
+        
+        return true;
+    }
+};
+
+#endif
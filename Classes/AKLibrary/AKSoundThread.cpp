@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2014 Akihiro Kaneda.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1.Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   2.Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   3.Neither the name of the Monochrome Soft nor the names of its contributors
+ *     may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!
+ @file AKSoundThread.cpp
+ @brief サウンドエンジン専用スレッドクラス定義
+ 
+ サウンドエンジンの処理をすべて1本の専用スレッドで実行するクラスを定義する。
+ */
+
+#include "AKSoundThread.h"
+#include "SimpleAudioEngine.h"
+#include <cstdio>
+
+using std::string;
+using std::vector;
+using std::lock_guard;
+using std::unique_lock;
+using std::mutex;
+using cocos2d::FileUtils;
+using cocos2d::Data;
+using CocosDenshion::SimpleAudioEngine;
+
+/*!
+ @brief インスタンス取得
+ 
+ シングルトンのインスタンスを取得する。
+ @return インスタンス
+ */
+AKSoundThread* AKSoundThread::getInstance()
+{
+    static AKSoundThread instance;
+    return &instance;
+}
+
+/*!
+ @brief コンストラクタ
+ 
+ 処理停止中の状態で作成する。
+ */
+AKSoundThread::AKSoundThread() :
+m_isStopping(false)
+{
+}
+
+/*!
+ @brief デストラクタ
+ 
+ 専用スレッドを終了する。
+ */
+AKSoundThread::~AKSoundThread()
+{
+    // 専用スレッドを終了させて、終了するまで待つ
+    if (m_thread.joinable()) {
+        {
+            lock_guard<mutex> lock(m_mutex);
+            m_isStopping = true;
+        }
+        m_condition.notify_one();
+        m_thread.join();
+    }
+}
+
+/*!
+ @brief 処理開始
+ 
+ サウンドエンジンを作成してから専用スレッドを開始する。
+ サウンドエンジンのインスタンス作成は排他制御されていないため、
+ 他のスレッドから使用される前にメインスレッドで作成しておく。
+ */
+void AKSoundThread::start()
+{
+    if (!m_thread.joinable()) {
+        
+        // サウンドエンジンをメインスレッドで作成する
+        SimpleAudioEngine::getInstance();
+        
+        m_isStopping = false;
+        m_thread = std::thread(&AKSoundThread::run, this);
+    }
+}
+
+/*!
+ @brief コマンド追加
+ 
+ 専用スレッドにコマンドを1件渡す。
+ @param type 種別
+ @param path ファイルのフルパス
+ @param isLoop ループするかどうか
+ @param volume 音量
+ */
+void AKSoundThread::push(enum CommandType type, const string &path, bool isLoop, float volume)
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        Command command = {type, path, isLoop, volume};
+        m_commands.push_back(command);
+    }
+    m_condition.notify_one();
+}
+
+/*!
+ @brief 複数コマンド追加
+ 
+ 専用スレッドにコマンドをまとめて渡す。
+ @param commands コマンド
+ */
+void AKSoundThread::push(const vector<Command> &commands)
+{
+    if (commands.empty()) {
+        return;
+    }
+    
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_commands.insert(m_commands.end(), commands.begin(), commands.end());
+    }
+    m_condition.notify_one();
+}
+
+/*!
+ @brief 専用スレッドの処理
+ 
+ 渡されたコマンドを順番に実行する。
+ */
+void AKSoundThread::run()
+{
+    vector<Command> commands;
+    
+    while (true) {
+        
+        // コマンドが渡されるまで待つ
+        {
+            unique_lock<mutex> lock(m_mutex);
+            while (m_commands.empty() && !m_isStopping) {
+                m_condition.wait(lock);
+            }
+            
+            if (m_isStopping) {
+                break;
+            }
+            
+            // ロックしている時間を短くするため、コマンドを入れ替えてから処理する
+            commands.swap(m_commands);
+        }
+        
+        for (const Command &command : commands) {
+            execute(command);
+        }
+        commands.clear();
+    }
+}
+
+/*!
+ @brief コマンド実行
+ 
+ コマンドの種別に応じてサウンドエンジンの処理を実行する。
+ @param command コマンド
+ */
+void AKSoundThread::execute(const Command &command)
+{
+    SimpleAudioEngine *engine = SimpleAudioEngine::getInstance();
+    
+    switch (command.type) {
+        case kAKSoundCommandPreloadEffect:
+            engine->preloadEffect(command.path.c_str());
+            break;
+            
+        case kAKSoundCommandPlayEffect:
+            engine->playEffect(command.path.c_str());
+            break;
+            
+        case kAKSoundCommandPlayBGM:
+            AKLog(kAKLogSoundThread_1, "BGM再生:%s", command.path.c_str());
+            engine->playBackgroundMusic(command.path.c_str(), command.isLoop);
+            break;
+            
+        case kAKSoundCommandStopBGM:
+            engine->stopBackgroundMusic();
+            break;
+            
+        case kAKSoundCommandPauseBGM:
+            engine->pauseBackgroundMusic();
+            break;
+            
+        case kAKSoundCommandResumeBGM:
+            engine->resumeBackgroundMusic();
+            break;
+            
+        case kAKSoundCommandBGMVolume:
+            engine->setBackgroundMusicVolume(command.volume);
+            break;
+            
+        case kAKSoundCommandPrefetch:
+            readAhead(command.path);
+            break;
+            
+        default:
+            AKAssert(false, "コマンド種別が不正:%d", command.type);
+            break;
+    }
+}
+
+/*!
+ @brief ファイル先読み
+ 
+ ファイルを先頭から最後まで一定サイズずつ読み込み、読み込んだ内容は破棄する。
+ ファイルを直接開けない場合(Androidのapk内のファイル等)は、一度にすべて読み込んで破棄する。
+ フルパスを指定するため、ファイル管理クラスのフルパスのキャッシュは使用しない。
+ @param path ファイルのフルパス
+ */
+void AKSoundThread::readAhead(const string &path)
+{
+    AKLog(kAKLogSoundThread_1, "先読み:%s", path.c_str());
+    
+    // ファイルを直接開ける場合は一定サイズずつ読み込む
+    FILE *fp = fopen(path.c_str(), "rb");
+    if (fp != NULL) {
+        
+        vector<char> buffer(kAKSoundPrefetchChunkSize);
+        while (fread(buffer.data(), 1, buffer.size(), fp) == buffer.size()) {
+        }
+        fclose(fp);
+    }
+    // ファイルを直接開けない場合はファイル管理クラスから読み込む
+    else {
+        Data data = FileUtils::getInstance()->getDataFromFile(path);
+        AKLog(kAKLogSoundThread_0 && data.isNull(), "ファイル読み込み失敗:%s", path.c_str());
+    }
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2014 Akihiro Kaneda.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1.Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   2.Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   3.Neither the name of the Monochrome Soft nor the names of its contributors
+ *     may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!
+ @file AKSoundThread.h
+ @brief サウンドエンジン専用スレッドクラス定義
+ 
+ サウンドエンジンの処理をすべて1本の専用スレッドで実行するクラスを定義する。
+ */
+
+#ifndef AKSOUNDTHREAD_H
+#define AKSOUNDTHREAD_H
+
+#include "AKCommon.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*!
+ @brief サウンドエンジン専用スレッドクラス
+ 
+ サウンドエンジン(SimpleAudioEngine)はスレッドセーフではないため、
+ 効果音とBGMの処理をすべてこのクラスの専用スレッドで順番に実行する。
+ 専用スレッドからファイル管理クラスのフルパスのキャッシュを更新しないように、
+ コマンドにはメインスレッドで解決したフルパスを指定すること。
+ サウンドエンジンを直接使用せず、AKSESchedulerとAKBGMPlayerを通して使用すること。
+ */
+class AKSoundThread {
+public:
+    /// 先読み時に1回に読み込むサイズ
+    static const int kAKSoundPrefetchChunkSize = 64 * 1024;
+    
+    /// コマンドの種別
+    enum CommandType {
+        kAKSoundCommandPreloadEffect = 0,   ///< 効果音読み込み
+        kAKSoundCommandPlayEffect,          ///< 効果音再生
+        kAKSoundCommandPlayBGM,             ///< BGM再生
+        kAKSoundCommandStopBGM,             ///< BGM停止
+        kAKSoundCommandPauseBGM,            ///< BGM一時停止
+        kAKSoundCommandResumeBGM,           ///< BGM再開
+        kAKSoundCommandBGMVolume,           ///< BGM音量変更
+        kAKSoundCommandPrefetch             ///< ファイル先読み
+    };
+    
+    /// コマンド
+    struct Command {
+        /// 種別
+        enum CommandType type;
+        /// ファイルのフルパス
+        std::string path;
+        /// ループするかどうか
+        bool isLoop;
+        /// 音量
+        float volume;
+    };
+    
+private:
+    /// 専用スレッド
+    std::thread m_thread;
+    /// コマンドキューの排他制御
+    std::mutex m_mutex;
+    /// コマンド追加の通知
+    std::condition_variable m_condition;
+    /// 専用スレッドに渡すコマンド
+    std::vector<Command> m_commands;
+    /// 専用スレッドを終了するかどうか
+    bool m_isStopping;
+    
+public:
+    // インスタンス取得
+    static AKSoundThread* getInstance();
+    // デストラクタ
+    ~AKSoundThread();
+    // 処理開始
+    void start();
+    // コマンド追加
+    void push(enum CommandType type, const std::string &path, bool isLoop, float volume);
+    // 複数コマンド追加
+    void push(const std::vector<Command> &commands);
+    
+private:
+    // コンストラクタ
+    AKSoundThread();
+    // コピーコンストラクタは使用禁止
+    AKSoundThread(const AKSoundThread &other);
+    // 代入演算子は使用禁止
+    AKSoundThread& operator=(const AKSoundThread &other);
+    // 専用スレッドの処理
+    void run();
+    // コマンド実行
+    void execute(const Command &command);
+    // ファイル先読み
+    void readAhead(const std::string &path);
+};
+
+#endif
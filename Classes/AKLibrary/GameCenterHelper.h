@@ -48,6 +48,6 @@
 // ランキング画面表示
 +(void)openRanking;
 // スコア送信
-+(void)postHighScore:(int)score;
++(BOOL)postHighScore:(int)score;
 
 @end
@@ -37,6 +37,8 @@
 #import "RootViewController.h"
 
 static NSString* const LEADERBORD_ID = @"toritoma_score";
+/// スコア送信完了を待つ時間(秒)
+static const int64_t POST_SCORE_TIMEOUT = 30;
 
 @implementation GameCenterHelper
 
@@ -105,10 +107,17 @@ static NSString* const LEADERBORD_ID = @"toritoma_score";
  @brief ハイスコア送信
  
  Leaderboardにハイスコアを送信する。
+ 送信が完了するまで待機するため、メインスレッド以外から呼び出すこと。
  @param score スコア
+ @return 送信できたかどうか。ログインしていない場合は送信せずにNOを返す。
  */
-+(void)postHighScore:(int)score
++(BOOL)postHighScore:(int)score
 {
+    // ログインしていない場合は送信しない
+    if (![GKLocalPlayer localPlayer].authenticated) {
+        return NO;
+    }
+    
     // スコアクラスを作成する
     GKScore *scoreReporter = [[GKScore alloc] initWithLeaderboardIdentifier:LEADERBORD_ID];
     scoreReporter.value = score;
@@ -116,12 +125,26 @@ static NSString* const LEADERBORD_ID = @"toritoma_score";
     
     // スコアを送信する
     NSArray *scores = @[scoreReporter];
+    __block BOOL isSucceeded = NO;
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
     [GKScore reportScores:scores withCompletionHandler:^(NSError *error) {
         
         if (error != nil) {
             NSLog(@"error post high score : %@", [error localizedDescription]);
         }
+        else {
+            isSucceeded = YES;
+        }
+        dispatch_semaphore_signal(semaphore);
     }];
+    
+    // 送信完了を待つ
+    if (dispatch_semaphore_wait(semaphore, dispatch_time(DISPATCH_TIME_NOW, POST_SCORE_TIMEOUT * NSEC_PER_SEC)) != 0) {
+        NSLog(@"error post high score : timeout");
+        return NO;
+    }
+    
+    return isSucceeded;
 }
 
 @end
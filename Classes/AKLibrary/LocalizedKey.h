@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2014 Akihiro Kaneda.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1.Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   2.Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   3.Neither the name of the Monochrome Soft nor the names of its contributors
+ *     may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!
+ @file LocalizedKey.h
+ @brief ローカライズ文字列キーID定義
+ 
+ ローカライズ文字列のキーIDを定義する。
+ このファイルはtools/make_localized_bundle.pyで自動生成するため、直接編集しないこと。
+ */
+
+#ifndef LOCALIZEDKEY_H
+#define LOCALIZEDKEY_H
+
+namespace aklib {
+    
+    /// ローカライズ文字列のキーID(連番のキーは番号順に連続する)
+    enum LocalizedKey {
+        kAKLocalizedHowToPlay_1 = 0,             ///< "HowToPlay_1"
+        kAKLocalizedHowToPlay_2 = 1,             ///< "HowToPlay_2"
+        kAKLocalizedHowToPlay_3 = 2,             ///< "HowToPlay_3"
+        kAKLocalizedHowToPlay_4 = 3,             ///< "HowToPlay_4"
+        kAKLocalizedHowToPlay_5 = 4,             ///< "HowToPlay_5"
+        kAKLocalizedHowToPlay_6 = 5,             ///< "HowToPlay_6"
+        kAKLocalizedHowToPlay_Controller_1 = 6,  ///< "HowToPlay_Controller_1"
+        kAKLocalizedHowToPlay_Controller_2 = 7,  ///< "HowToPlay_Controller_2"
+        kAKLocalizedHowToPlay_Controller_3 = 8,  ///< "HowToPlay_Controller_3"
+        kAKLocalizedHowToPlay_Controller_4 = 9,  ///< "HowToPlay_Controller_4"
+        kAKLocalizedHowToPlay_Controller_5 = 10, ///< "HowToPlay_Controller_5"
+        kAKLocalizedHowToPlay_Controller_6 = 11, ///< "HowToPlay_Controller_6"
+        kAKLocalizedTweet1stLoop = 12,           ///< "Tweet1stLoop"
+        kAKLocalizedTweet2ndLoop = 13,           ///< "Tweet2ndLoop"
+        kAKLocalizedCreditName_1 = 14,           ///< "CreditName_1"
+        kAKLocalizedCreditName_2 = 15,           ///< "CreditName_2"
+        kAKLocalizedCreditName_3 = 16,           ///< "CreditName_3"
+        kAKLocalizedCreditName_4 = 17,           ///< "CreditName_4"
+        kAKLocalizedCreditName_5 = 18,           ///< "CreditName_5"
+        kAKLocalizedCreditName_6 = 19,           ///< "CreditName_6"
+        kAKLocalizedCreditLink_1 = 20,           ///< "CreditLink_1"
+        kAKLocalizedCreditLink_2 = 21,           ///< "CreditLink_2"
+        kAKLocalizedCreditLink_3 = 22,           ///< "CreditLink_3"
+        kAKLocalizedCreditLink_4 = 23,           ///< "CreditLink_4"
+        kAKLocalizedCreditLink_5 = 24,           ///< "CreditLink_5"
+        kAKLocalizedCreditLink_6 = 25,           ///< "CreditLink_6"
+        kAKLocalizedStoreMessage = 26,           ///< "StoreMessage"
+        kAKLocalizedStorePurchased = 27,         ///< "StorePurchased"
+        kAKLocalizedKeyCount                     ///< キーIDの数
+    };
+}
+
+#endif
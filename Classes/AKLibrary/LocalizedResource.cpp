@@ -34,11 +34,9 @@
  */
 
 #include "LocalizedResource.h"
+#include "AKAssetArchive.h"
 
 using std::string;
-using std::istringstream;
-using std::pair;
-using std::map;
 using cocos2d::Application;
 using cocos2d::LanguageType;
 using cocos2d::FileUtils;
@@ -46,16 +44,30 @@ using cocos2d::Data;
 
 namespace aklib {
     
-    static const string STRING_FILE_ENGLISH  = "text/Localized_en";
-    static const string STRING_FILE_JAPANESE = "text/Localized_ja";
-    static const string STRING_FILE_CHINESE  = "text/Localized_zh";
-    static const string STRING_FILE_KOREAN   = "text/Localized_ko";
+    static const string STRING_FILE_PREFIX = "text/Localized_";
+    static const string STRING_FILE_EXTENSION = ".bin";
+    
+    static const string LANGUAGE_ENGLISH  = "en";
+    static const string LANGUAGE_JAPANESE = "ja";
+    static const string LANGUAGE_CHINESE  = "zh";
+    static const string LANGUAGE_KOREAN   = "ko";
+    
+    /// バンドルファイルのマジックナンバー
+    static const char BUNDLE_MAGIC[4] = {'A', 'K', 'L', 'B'};
+    /// バンドルファイルのバージョン(tools/make_localized_bundle.pyのVERSIONと合わせる)
+    static const uint32_t BUNDLE_VERSION = 1;
+    /// バンドルファイルのヘッダサイズ(マジックナンバー、バージョン、文字列数)
+    static const size_t BUNDLE_HEADER_SIZE = 12;
+    /// 文字列が取得できない場合に返す空文字列
+    static const char EMPTY_STRING[] = "";
     
     static LocalizedResource& singleton = LocalizedResource::getInstance();
     
     LocalizedResource::LocalizedResource()
     {
         _isInitialized = false;
+        _offsets = NULL;
+        _strings = NULL;
     }
     
     LocalizedResource& LocalizedResource::getInstance()
@@ -64,79 +76,110 @@ namespace aklib {
         return singleton;
     }
     
-    const string& LocalizedResource::getString(const string &key)
+    const char* LocalizedResource::getString(LocalizedKey key)
     {
         if (!_isInitialized) {
             init();
         }
-        return _localizedStrings.at(key);
+        
+        AKAssert(key >= 0 && key < kAKLocalizedKeyCount, "キーIDが範囲外:key=%d", key);
+        
+        // バンドルファイルが読み込めていない場合は空文字列を返す
+        if (_offsets == NULL) {
+            return EMPTY_STRING;
+        }
+        
+        return _strings + _offsets[key];
     }
     
     // 初期化処理
     void LocalizedResource::init()
     {
-        string fileName = getStringFileName();
-        string filePath = FileUtils::getInstance()->fullPathForFilename(fileName);
-        string fileData = FileUtils::getInstance()->getStringFromFile(filePath);
+        // アセットアーカイブに格納されている場合はアーカイブのメモリを直接参照する
+        const unsigned char *bytes = NULL;
+        ssize_t size = 0;
+        if (!AKAssetArchive::getInstance()->find(getStringFileName(), &bytes, &size)) {
+            
+            // アーカイブがない場合はバンドルファイルを読み込む
+            // 文字列はこのデータを直接参照するため、解放せずに保持する
+            _bundle = FileUtils::getInstance()->getDataFromFile(getStringFileName());
+            bytes = _bundle.getBytes();
+            size = _bundle.getSize();
+        }
         
-        // ファイルを読み込む
-        readStringData(fileData, _localizedStrings);
+        // ヘッダを解析する
+        if (!parseBundle(bytes, size)) {
+            AKAssert(false, "ローカライズ文字列バンドルが不正:%s", getStringFileName().c_str());
+            _offsets = NULL;
+            _strings = NULL;
+        }
         
         // 初期化フラグを立てる
         _isInitialized = true;
     }
     
-    string LocalizedResource::getStringFileName() const
+    string LocalizedResource::getLanguageCode() const
     {
         LanguageType lang = Application::getInstance()->getCurrentLanguage();
         
         switch (lang) {
             case cocos2d::LanguageType::ENGLISH:
-                return STRING_FILE_ENGLISH;
+                return LANGUAGE_ENGLISH;
                 
             case cocos2d::LanguageType::JAPANESE:
-                return STRING_FILE_JAPANESE;
+                return LANGUAGE_JAPANESE;
                 
             case cocos2d::LanguageType::CHINESE:
-                return STRING_FILE_CHINESE;
+                return LANGUAGE_CHINESE;
                 
             case cocos2d::LanguageType::KOREAN:
-                return STRING_FILE_KOREAN;
+                return LANGUAGE_KOREAN;
                 
             default:
-                return STRING_FILE_ENGLISH;
+                return LANGUAGE_ENGLISH;
         }
     }
     
-    void LocalizedResource::readStringData(const string &stringData, map<string, string> &localizedStrings) const
+    string LocalizedResource::getStringFileName() const
     {
-        istringstream is(stringData);
-        string line;
-        while (std::getline(is, line)) {
-            
-            AKLog(1, "line=%s", line.c_str());
-            
-            if (line.compare(0, 2, "//") == 0) {
-                continue;
-            }
-            
-            string::size_type sep = line.find("=");
-            if (sep == string::npos) {
-                continue;
+        return STRING_FILE_PREFIX + getLanguageCode() + STRING_FILE_EXTENSION;
+    }
+    
+    bool LocalizedResource::parseBundle(const unsigned char *bytes, size_t size)
+    {
+        // ヘッダを読み込めない場合はエラーとする
+        if (bytes == NULL || size < BUNDLE_HEADER_SIZE) {
+            return false;
+        }
+        
+        // マジックナンバーとバージョンを確認する
+        // 数値はリトルエンディアンで格納されている(対象の端末はすべてリトルエンディアン)
+        const uint32_t *header = reinterpret_cast<const uint32_t*>(bytes);
+        if (memcmp(bytes, BUNDLE_MAGIC, sizeof(BUNDLE_MAGIC)) != 0 || header[1] != BUNDLE_VERSION) {
+            return false;
+        }
+        
+        // 文字列数がキーIDの数と一致しない場合はヘッダファイルと不整合のためエラーとする
+        uint32_t count = header[2];
+        if (count != kAKLocalizedKeyCount || size < BUNDLE_HEADER_SIZE + count * sizeof(uint32_t)) {
+            return false;
+        }
+        
+        // オフセットテーブルと文字列領域の位置を設定する
+        _offsets = reinterpret_cast<const uint32_t*>(bytes + BUNDLE_HEADER_SIZE);
+        _strings = reinterpret_cast<const char*>(bytes + BUNDLE_HEADER_SIZE + count * sizeof(uint32_t));
+        
+        // 文字列がデータの範囲内にあることを確認する
+        size_t stringSize = size - (BUNDLE_HEADER_SIZE + count * sizeof(uint32_t));
+        if (stringSize == 0 || _strings[stringSize - 1] != '\0') {
+            return false;
+        }
+        for (uint32_t i = 0; i < count; i++) {
+            if (_offsets[i] >= stringSize) {
+                return false;
             }
-            
-            string key = line.substr(0, sep - 1);
-            string val = line.substr(sep + 1);
-            
-            key.erase(0, key.find_first_not_of(" \""));
-            key.erase(key.find_last_not_of(" \"") + 1);
-            
-            val.erase(0, val.find_first_not_of(" \""));
-            val.erase(val.find_last_not_of(" \";") + 1);
-            
-            AKLog(1, "key=%s value=%s", key.c_str(), val.c_str());
-            
-            localizedStrings.insert(pair<string, string>(key, val));
         }
+        
+        return true;
     }
-}
\ No newline at end of file
+}
@@ -37,6 +37,7 @@
 #define LOCALIZEDRESOURCE_H
 
 #include "AKCommon.h"
+#include "LocalizedKey.h"
 
 namespace aklib {
     
@@ -53,16 +54,32 @@ namespace aklib {
         /*!
          @brief ローカライズ文字列取得
          
-         キーを指定して、ローカライズされた文字列を取得する。
-         @param key キー
-         @return ローカライズされた文字列
+         キーIDを指定して、ローカライズされた文字列を取得する。
+         文字列はバンドルファイルのデータを直接指しており、コピーは行わない。
+         @param key キーID
+         @return ローカライズされた文字列(終端文字付き)
          */
-        const std::string& getString(const std::string &key);
+        const char* getString(LocalizedKey key);
+        
+        /*!
+         @brief 言語コード取得
+         
+         言語設定に対応した言語コード(en、ja、zh、ko)を取得する。
+         対応していない言語の場合は英語とする。
+         @return 言語コード
+         */
+        std::string getLanguageCode() const;
         
     private:
 
-        /// ローカライズ文字列マップ
-        std::map<std::string, std::string> _localizedStrings;
+        /// ローカライズ文字列バンドルファイルのデータ(アセットアーカイブから参照する場合は空)
+        cocos2d::Data _bundle;
+        
+        /// 各文字列のオフセットテーブル(バンドルファイルのデータ内を指す)
+        const uint32_t *_offsets;
+        
+        /// 文字列領域の先頭(バンドルファイルのデータ内を指す)
+        const char *_strings;
         
         /// 初期化済みかどうか
         bool _isInitialized;
@@ -99,21 +116,22 @@ namespace aklib {
         void init();
         
         /*!
-         @brief ローカライズ文字列ファイル名取得
+         @brief ローカライズ文字列バンドルファイル名取得
          
-         言語設定に対応したローカライズ文字列ファイルのファイル名を取得する。
-         @return ローカライズ文字列ファイル名
+         言語設定に対応したローカライズ文字列バンドルファイルのファイル名を取得する。
+         @return ローカライズ文字列バンドルファイル名
          */
         std::string getStringFileName() const;
         
         /*!
-         @brief ローカライズ文字列読込
+         @brief ローカライズ文字列バンドル解析
          
-         ローカライズ文字列ファイルのテキストファイルを読み込み、キーと文字列のマップを作成する。
-         @param stringData ローカライズ文字列ファイルのデータ
-         @param localizedStrings ローカライズ文字列マップ
+         バンドルファイルのヘッダを検証し、オフセットテーブルと文字列領域の位置を設定する。
+         @param bytes バンドルファイルのデータ
+         @param size バンドルファイルのサイズ
+         @return 正しいバンドルファイルの場合true
          */
-        void readStringData(const std::string &stringData, std::map<std::string, std::string> &localizedStrings) const;
+        bool parseBundle(const unsigned char *bytes, size_t size);
     };
     
 }
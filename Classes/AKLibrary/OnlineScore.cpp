@@ -69,20 +69,22 @@ namespace aklib {
     }
     
     // ハイスコア送信
-    void OnlineScore::postHighScore(int score)
+    bool OnlineScore::postHighScore(int score)
     {
         // ネイティブコードのハイスコア送信関数を取得する
         JniMethodInfo methodInfo;
-        if (!JniHelper::getStaticMethodInfo(methodInfo, JNICLASSNAME, "postHighScore", "(I)V"))
+        if (!JniHelper::getStaticMethodInfo(methodInfo, JNICLASSNAME, "postHighScore", "(I)Z"))
         {
             assert(false);
-            return;
+            return false;
         }
         
         // 関数を呼び出す
-        methodInfo.env->CallStaticVoidMethod(methodInfo.classID, methodInfo.methodID, score);
+        jboolean isSucceeded = methodInfo.env->CallStaticBooleanMethod(methodInfo.classID, methodInfo.methodID, score);
         
         // リソースを解放する
         methodInfo.env->DeleteLocalRef(methodInfo.classID);
+        
+        return isSucceeded == JNI_TRUE;
     }
 }
@@ -64,8 +64,11 @@ namespace aklib {
          @brief ハイスコア送信
          
          ネイティブコードのハイスコア送信処理を実行する。
+         送信処理の完了を待つため、メインスレッド以外から呼び出すこと。
+         @param score スコア
+         @return 送信できたかどうか
          */
-        static void postHighScore(int score);
+        static bool postHighScore(int score);
     };
 }
 
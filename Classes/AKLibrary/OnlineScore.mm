@@ -51,8 +51,8 @@ namespace aklib {
     }
     
     // ハイスコア送信
-    void OnlineScore::postHighScore(int score)
+    bool OnlineScore::postHighScore(int score)
     {
-        [GameCenterHelper postHighScore:score];
+        return [GameCenterHelper postHighScore:score];
     }
 }
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2014 Akihiro Kaneda.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1.Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   2.Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   3.Neither the name of the Monochrome Soft nor the names of its contributors
+ *     may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!
+ @file ScoreBackend.cpp
+ @brief スコア送信先
+ 
+ スコア送信キューから呼び出すスコアの送信先を定義する。
+ */
+
+#include "ScoreBackend.h"
+#include "OnlineScore.h"
+#include "AKCommon.h"
+#include <algorithm>
+
+using std::string;
+using std::vector;
+using cocos2d::FileUtils;
+
+namespace aklib {
+    
+    // スコア送信
+    bool OnlineScoreBackend::submit(const vector<int> &scores)
+    {
+        if (scores.empty()) {
+            return true;
+        }
+        
+        // 最高値のみを送信する
+        int score = *std::max_element(scores.begin(), scores.end());
+        
+        AKLog(kAKLogScoreSubmitter_1, "オンラインスコア送信:%d(%d件)", score, static_cast<int>(scores.size()));
+        
+        // 未ログインなどで送信できなかった場合は失敗を返し、再送させる
+        bool isSucceeded = OnlineScore::postHighScore(score);
+        
+        AKLog(kAKLogScoreSubmitter_1, "オンラインスコア送信結果:%d", isSucceeded);
+        
+        return isSucceeded;
+    }
+    
+    // コンストラクタ
+    LocalScoreBackend::LocalScoreBackend(const string &fileName)
+    {
+        _path = FileUtils::getInstance()->getWritablePath() + fileName;
+    }
+    
+    // スコア送信
+    bool LocalScoreBackend::submit(const vector<int> &scores)
+    {
+        FILE *fp = fopen(_path.c_str(), "a");
+        if (fp == NULL) {
+            AKLog(kAKLogScoreSubmitter_0, "ファイルを開けない:%s", _path.c_str());
+            return false;
+        }
+        
+        bool isSucceeded = true;
+        for (int score : scores) {
+            if (fprintf(fp, "%d\n", score) < 0) {
+                isSucceeded = false;
+            }
+        }
+        
+        if (fclose(fp) != 0) {
+            isSucceeded = false;
+        }
+        
+        AKLog(kAKLogScoreSubmitter_1, "ローカルファイルに送信:%d件 result=%d", static_cast<int>(scores.size()), isSucceeded);
+        
+        return isSucceeded;
+    }
+}
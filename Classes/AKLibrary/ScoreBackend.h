@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2014 Akihiro Kaneda.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1.Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   2.Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   3.Neither the name of the Monochrome Soft nor the names of its contributors
+ *     may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!
+ @file ScoreBackend.h
+ @brief スコア送信先
+ 
+ スコア送信キューから呼び出すスコアの送信先を定義する。
+ */
+
+#ifndef SCOREBACKEND_H
+#define SCOREBACKEND_H
+
+#include <string>
+#include <vector>
+
+namespace aklib {
+    
+    /*!
+     @brief スコア送信先
+     
+     スコア送信キューから専用スレッドで呼び出される送信先のインターフェース。
+     */
+    class ScoreBackend {
+    public:
+        /*!
+         @brief デストラクタ
+         
+         派生クラスのデストラクタを呼び出すため、仮想関数とする。
+         */
+        virtual ~ScoreBackend(){}
+        
+        /*!
+         @brief スコア送信
+         
+         溜まっているスコアをまとめて送信する。
+         専用スレッドから呼び出されるため、メインスレッドでの処理が必要な場合は実装側で切り替えること。
+         @param scores 送信するスコア(古い順)
+         @return 送信に成功した場合true、失敗して再送が必要な場合false
+         */
+        virtual bool submit(const std::vector<int> &scores) = 0;
+    };
+    
+    /*!
+     @brief オンラインスコア管理サービスへの送信先
+     
+     OnlineScoreを通してネイティブコードのハイスコア送信処理を呼び出す。
+     ランキングには最高値だけが残るため、まとめて送信する時は最高値のみを送信する。
+     */
+    class OnlineScoreBackend : public ScoreBackend {
+    public:
+        /*!
+         @brief スコア送信
+         
+         スコアの最高値をオンラインスコア管理サービスに送信する。
+         ネイティブコード側で再送を行うため、常に成功とする。
+         @param scores 送信するスコア(古い順)
+         @return 常にtrue
+         */
+        virtual bool submit(const std::vector<int> &scores);
+    };
+    
+    /*!
+     @brief ローカルファイルへの送信先
+     
+     オンラインスコア管理サービスの代わりにローカルファイルにスコアを追記する。
+     ネットワークに接続しない状態でスコア送信キューの動作を確認するために使用する。
+     */
+    class LocalScoreBackend : public ScoreBackend {
+    public:
+        /*!
+         @brief コンストラクタ
+         
+         出力先のファイル名を設定する。
+         @param fileName ファイル名(書き込み可能なディレクトリからの相対パス)
+         */
+        explicit LocalScoreBackend(const std::string &fileName);
+        
+        /*!
+         @brief スコア送信
+         
+         スコアを1行に1個ずつファイルに追記する。
+         @param scores 送信するスコア(古い順)
+         @return ファイルへの追記に成功した場合true
+         */
+        virtual bool submit(const std::vector<int> &scores);
+        
+    private:
+        
+        /// 出力先のファイルのパス
+        std::string _path;
+    };
+}
+
+#endif
@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2014 Akihiro Kaneda.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1.Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   2.Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   3.Neither the name of the Monochrome Soft nor the names of its contributors
+ *     may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!
+ @file ScoreSubmitter.cpp
+ @brief スコア送信キュー
+ 
+ スコアの送信を専用スレッドで行うキューを定義する。
+ */
+
+#include "ScoreSubmitter.h"
+#include "AKCommon.h"
+#include <algorithm>
+#include <cstdlib>
+
+using std::string;
+using std::vector;
+using std::mutex;
+using std::lock_guard;
+using std::unique_lock;
+using std::cv_status;
+using std::chrono::steady_clock;
+using std::chrono::seconds;
+using cocos2d::FileUtils;
+
+namespace aklib {
+    
+    /// 送信キューのファイル名
+    static const char *QUEUE_FILE_NAME = "ScoreQueue.txt";
+    /// 送信キューのファイル書き込み時の一時ファイル名
+    static const char *TEMPORARY_FILE_NAME = "ScoreQueue.txt.tmp";
+    /// スコアが追加されてから送信するまでの待ち時間(この間に追加されたスコアはまとめて送信する)
+    static const seconds BATCH_DELAY(5);
+    /// 最初の再送間隔
+    static const seconds RETRY_INTERVAL_MIN(10);
+    /// 最大の再送間隔
+    static const seconds RETRY_INTERVAL_MAX(600);
+    
+    static ScoreSubmitter& singleton = ScoreSubmitter::getInstance();
+    
+    // インスタンス取得
+    ScoreSubmitter& ScoreSubmitter::getInstance()
+    {
+        static ScoreSubmitter singleton;
+        return singleton;
+    }
+    
+    // コンストラクタ
+    ScoreSubmitter::ScoreSubmitter() :
+    _backend(NULL), _isSaving(false), _isStopping(false), _retryInterval(RETRY_INTERVAL_MIN)
+    {
+    }
+    
+    // デストラクタ
+    ScoreSubmitter::~ScoreSubmitter()
+    {
+        if (_thread.joinable()) {
+            {
+                lock_guard<mutex> lock(_mutex);
+                _isStopping = true;
+            }
+            _requestCondition.notify_one();
+            _thread.join();
+        }
+        
+        delete _backend;
+    }
+    
+    // 処理開始
+    void ScoreSubmitter::start(ScoreBackend *backend)
+    {
+        AKAssert(backend != NULL, "送信先が指定されていない");
+        
+        // 2回目以降は送信先を解放して何もしない
+        if (_thread.joinable()) {
+            delete backend;
+            return;
+        }
+        
+        _backend = backend;
+        
+        // ファイルのパスを作成する
+        string writablePath = FileUtils::getInstance()->getWritablePath();
+        _queueFilePath = writablePath + QUEUE_FILE_NAME;
+        _temporaryFilePath = writablePath + TEMPORARY_FILE_NAME;
+        
+        // 前回送信できなかったスコアを読み込む
+        loadQueue();
+        _nextSendTime = steady_clock::now() + BATCH_DELAY;
+        
+        // 専用スレッドを開始する
+        _thread = std::thread(&ScoreSubmitter::run, this);
+    }
+    
+    // スコア送信
+    void ScoreSubmitter::post(int score)
+    {
+        AKLog(kAKLogScoreSubmitter_1, "score=%d", score);
+        
+        {
+            lock_guard<mutex> lock(_mutex);
+            _pendingScores.push_back(score);
+        }
+        _requestCondition.notify_one();
+    }
+    
+    // 保存完了待ち
+    void ScoreSubmitter::flush()
+    {
+        // 専用スレッドが開始していない場合は何もしない
+        if (!_thread.joinable()) {
+            return;
+        }
+        
+        unique_lock<mutex> lock(_mutex);
+        while (!_pendingScores.empty() || _isSaving) {
+            _flushCondition.wait(lock);
+        }
+    }
+    
+    // 専用スレッドの処理
+    void ScoreSubmitter::run()
+    {
+        vector<int> scores;
+        
+        while (true) {
+            
+            // スコアが追加されるか、送信時刻になるまで待つ
+            // 送信キューが空の場合は送信時刻を待たない
+            {
+                unique_lock<mutex> lock(_mutex);
+                while (_pendingScores.empty() && !_isStopping) {
+                    if (_queue.empty()) {
+                        _requestCondition.wait(lock);
+                    }
+                    else if (_requestCondition.wait_until(lock, _nextSendTime) == cv_status::timeout) {
+                        break;
+                    }
+                }
+                
+                if (_isStopping) {
+                    break;
+                }
+                
+                // ロックしている時間を短くするため、スコアを入れ替えてから処理する
+                scores.swap(_pendingScores);
+                _isSaving = !scores.empty();
+            }
+            
+            // 追加されたスコアを送信キューに移してファイルに保存する
+            if (!scores.empty()) {
+                
+                // 送信キューが空だった場合は、まとめて送信するために一定時間後を送信時刻とする
+                if (_queue.empty()) {
+                    _nextSendTime = steady_clock::now() + BATCH_DELAY;
+                }
+                
+                _queue.insert(_queue.end(), scores.begin(), scores.end());
+                scores.clear();
+                saveQueue();
+                
+                // 保存完了を通知する
+                {
+                    lock_guard<mutex> lock(_mutex);
+                    _isSaving = false;
+                }
+                _flushCondition.notify_all();
+                continue;
+            }
+            
+            // 送信時刻になっている場合は送信する
+            if (!_queue.empty() && steady_clock::now() >= _nextSendTime) {
+                submitQueue();
+            }
+        }
+    }
+    
+    // 送信キュー送信
+    void ScoreSubmitter::submitQueue()
+    {
+        if (_backend->submit(_queue)) {
+            
+            // 送信したスコアを削除する
+            _queue.clear();
+            saveQueue();
+            
+            _retryInterval = RETRY_INTERVAL_MIN;
+        }
+        else {
+            
+            AKLog(kAKLogScoreSubmitter_0, "送信失敗、%d秒後に再送する", static_cast<int>(_retryInterval.count()));
+            
+            // 再送間隔を倍にしながら再送する
+            _nextSendTime = steady_clock::now() + _retryInterval;
+            _retryInterval = std::min(_retryInterval * 2, RETRY_INTERVAL_MAX);
+        }
+    }
+    
+    // 送信キュー読み込み
+    void ScoreSubmitter::loadQueue()
+    {
+        FILE *fp = fopen(_queueFilePath.c_str(), "r");
+        if (fp == NULL) {
+            return;
+        }
+        
+        // 1行に1個のスコアが書かれている
+        // 書き込み途中のファイルは名前を変更しないため、壊れた行はないものとする
+        int score = 0;
+        while (fscanf(fp, "%d", &score) == 1) {
+            _queue.push_back(score);
+        }
+        fclose(fp);
+        
+        AKLog(kAKLogScoreSubmitter_1, "前回送信できなかったスコア:%d件", static_cast<int>(_queue.size()));
+    }
+    
+    // 送信キュー保存
+    void ScoreSubmitter::saveQueue()
+    {
+        // 送信キューが空の場合はファイルを削除する
+        if (_queue.empty()) {
+            remove(_queueFilePath.c_str());
+            return;
+        }
+        
+        // 一時ファイルに書き込む
+        FILE *fp = fopen(_temporaryFilePath.c_str(), "w");
+        if (fp == NULL) {
+            AKLog(kAKLogScoreSubmitter_0, "一時ファイルを開けない:%s", _temporaryFilePath.c_str());
+            return;
+        }
+        
+        bool isSucceeded = true;
+        for (int score : _queue) {
+            if (fprintf(fp, "%d\n", score) < 0) {
+                isSucceeded = false;
+            }
+        }
+        
+        if (fclose(fp) != 0) {
+            isSucceeded = false;
+        }
+        
+        if (!isSucceeded) {
+            AKLog(kAKLogScoreSubmitter_0, "一時ファイルの書き込みに失敗");
+            remove(_temporaryFilePath.c_str());
+            return;
+        }
+        
+        // 送信キューのファイルに名前を変更する
+#if CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
+        // Windowsでは変更先のファイルがあると名前を変更できないため、先に削除する
+        remove(_queueFilePath.c_str());
+#endif
+        if (rename(_temporaryFilePath.c_str(), _queueFilePath.c_str()) != 0) {
+            AKLog(kAKLogScoreSubmitter_0, "送信キューのファイルへの名前の変更に失敗");
+        }
+    }
+}
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2014 Akihiro Kaneda.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1.Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   2.Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   3.Neither the name of the Monochrome Soft nor the names of its contributors
+ *     may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!
+ @file ScoreSubmitter.h
+ @brief スコア送信キュー
+ 
+ スコアの送信を専用スレッドで行うキューを定義する。
+ */
+
+#ifndef SCORESUBMITTER_H
+#define SCORESUBMITTER_H
+
+#include "ScoreBackend.h"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace aklib {
+    
+    /*!
+     @brief スコア送信キュー
+     
+     渡されたスコアをファイルに保存してから専用スレッドで送信する。
+     送信は一定時間待ってからまとめて行い、失敗した場合は間隔を延ばしながら再送する。
+     送信できなかったスコアは次回起動時に再送する。
+     */
+    class ScoreSubmitter {
+    public:
+        /*!
+         @brief インスタンス取得
+         
+         シングルトンオブジェクトを取得する。
+         @return シングルトンオブジェクト
+         */
+        static ScoreSubmitter& getInstance();
+        
+        /*!
+         @brief デストラクタ
+         
+         専用スレッドを終了し、送信先を解放する。
+         送信できていないスコアはファイルに残し、次回起動時に送信する。
+         */
+        ~ScoreSubmitter();
+        
+        /*!
+         @brief 処理開始
+         
+         前回送信できなかったスコアをファイルから読み込み、専用スレッドを開始する。
+         @param backend 送信先(解放はこのクラスで行う)
+         */
+        void start(ScoreBackend *backend);
+        
+        /*!
+         @brief スコア送信
+         
+         スコアを送信キューに追加する。送信の完了は待たない。
+         @param score スコア
+         */
+        void post(int score);
+        
+        /*!
+         @brief 保存完了待ち
+         
+         送信キューに追加したスコアがファイルに保存されるまで待つ。
+         アプリがバックグラウンドに移行する時など、プロセスが終了される可能性がある時に使用する。
+         */
+        void flush();
+        
+    private:
+        
+        /// 送信先
+        ScoreBackend *_backend;
+        
+        /// 送信キューのファイルのパス
+        std::string _queueFilePath;
+        
+        /// 送信キューのファイル書き込み時の一時ファイルのパス
+        std::string _temporaryFilePath;
+        
+        /// 専用スレッド
+        std::thread _thread;
+        
+        /// 追加されたスコアの排他制御
+        std::mutex _mutex;
+        
+        /// スコア追加の通知
+        std::condition_variable _requestCondition;
+        
+        /// ファイル保存完了の通知
+        std::condition_variable _flushCondition;
+        
+        /// 追加されたスコア(専用スレッドが送信キューに移す)
+        std::vector<int> _pendingScores;
+        
+        /// ファイルに保存中かどうか
+        bool _isSaving;
+        
+        /// 専用スレッドを終了するかどうか
+        bool _isStopping;
+        
+        /// 送信キュー(専用スレッドのみ使用する)
+        std::vector<int> _queue;
+        
+        /// 次に送信する時刻(専用スレッドのみ使用する)
+        std::chrono::steady_clock::time_point _nextSendTime;
+        
+        /// 次に失敗した時の再送間隔(専用スレッドのみ使用する)
+        std::chrono::seconds _retryInterval;
+        
+        /*!
+         @brief コンストラクタ
+         
+         シングルトンのため、外部からの使用を禁止する。
+         */
+        ScoreSubmitter();
+        
+        /*!
+         @brief コピーコンストラクタ
+         
+         シングルトンのため、外部からの使用を禁止する。
+         @param other コピー元インスタンス
+         */
+        ScoreSubmitter(const ScoreSubmitter &other){}
+        
+        /*!
+         @brief オペレータ =
+         
+         シングルトンのため、外部からの使用を禁止する。
+         @param other コピー元インスタンス
+         @return 自インスタンス
+         */
+        ScoreSubmitter& operator=(const ScoreSubmitter &other){ return *this; }
+        
+        /*!
+         @brief 専用スレッドの処理
+         
+         追加されたスコアを送信キューに移してファイルに保存し、送信時刻になったらまとめて送信する。
+         */
+        void run();
+        
+        /*!
+         @brief 送信キュー送信
+         
+         送信キューのスコアを送信先にまとめて送信する。
+         失敗した場合は再送間隔を延ばして次の送信時刻を設定する。
+         */
+        void submitQueue();
+        
+        /*!
+         @brief 送信キュー読み込み
+         
+         前回送信できなかったスコアをファイルから読み込む。
+         */
+        void loadQueue();
+        
+        /*!
+         @brief 送信キュー保存
+         
+         送信キューを一時ファイルに書き込んでから名前を変更し、書き込み途中で終了しても壊れないようにする。
+         送信キューが空の場合はファイルを削除する。
+         */
+        void saveQueue();
+    };
+}
+
+#endif
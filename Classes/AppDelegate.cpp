@@ -2,11 +2,35 @@
 #include "AKTitleScene.h"
 #include "AKPlayingScene.h"
 #include "AKScreenSize.h"
+#include "AKArchiveFileUtils.h"
 #include "OnlineScore.h"
 #include "Advertisement.h"
+#include "SettingFileIO.h"
+#include "ScoreSubmitter.h"
 
 USING_NS_CC;
 using CocosDenshion::SimpleAudioEngine;
+
+#ifdef DEBUG_MODE_STARTUP_TIMELINE
+/// 起動時のタイムラインのファイル名
+static const char *kAKStartupTimelineFileName = "startup_timeline.csv";
+#endif
+#ifdef DEBUG_MODE_LOCAL_SCORE
+/// スコアのローカル送信先ファイル名
+static const char *kAKLocalScoreFileName = "local_score.txt";
+#endif
+
+/// メニュー操作の効果音の再生設定(連打されても鳴るように同時発音数を多めにする)
+static const AKSEConfig kAKMenuSEConfig = {2, 200, 30, 3};
+/// 爆発(小)効果音の再生設定(雑魚敵が続けて破壊された時に重なりすぎないようにする)
+static const AKSEConfig kAKBombMinSEConfig = {3, 400, 50, 1};
+/// 爆発(大)効果音の再生設定
+static const AKSEConfig kAKBombBigSEConfig = {1, 1000, 100, 2};
+/// 弾衝突効果音の再生設定(連射中は毎フレーム要求されるため、間引いて発音数を抑える)
+static const AKSEConfig kAKHitSEConfig = {2, 150, 70, 0};
+/// 自機死亡、1Up時の効果音の再生設定(必ず鳴らす)
+static const AKSEConfig kAKEventSEConfig = {1, 1000, 100, 4};
+
 //static cocos2d::Size designResolutionSize = cocos2d::Size(568, 320);
 //static cocos2d::Size smallResolutionSize = cocos2d::Size(480, 320);
 //static cocos2d::Size mediumResolutionSize = cocos2d::Size(1024, 768);
@@ -39,6 +63,18 @@ static int register_all_packages()
 }
 
 bool AppDelegate::applicationDidFinishLaunching() {
+    // 起動時間の計測を開始する
+    AKAssetLoader::getInstance()->markMilestone("launch");
+#ifdef DEBUG_MODE_STARTUP_TIMELINE
+    AKAssetLoader::getInstance()->setTimelineFileName(kAKStartupTimelineFileName);
+#endif
+    
+#if CC_TARGET_PLATFORM == CC_PLATFORM_ANDROID
+    // リソースファイルをアセットアーカイブから読み込むようにする
+    // 検索パスを設定する前にFileUtilsを置き換える
+    AKArchiveFileUtils::install();
+#endif
+    
     // initialize director
     auto director = Director::getInstance();
     auto glview = director->getOpenGLView();
@@ -60,10 +96,32 @@ bool AppDelegate::applicationDidFinishLaunching() {
     
     // 解像度を調整する
     AKScreenSize::init(glview);
+    
+    // テクスチャアトラスの読み込みを開始する
+    // 検索パスが決まってから要求し、デコードが終わるまでの間に他の初期化処理を進める
+    preloadTexture();
 
     // set FPS. the default value is 1.0/60 if you don't call this
     director->setAnimationInterval(1.0 / 60);
+    
+    // 入力がない間のフレームレート抑制の処理を開始する
+    AKFrameThrottle::getInstance()->start();
 
+    // サウンドエンジン専用スレッドと効果音スケジューラの処理を開始する
+    // サウンドエンジンはここでメインスレッドで作成する
+    AKSoundThread::getInstance()->start();
+    AKSEScheduler::getInstance()->start();
+    
+    // 設定データを読み込み、書き込みスレッドを開始する
+    SettingFileIO::GetInstance().ReadFile();
+    
+    // スコア送信キューの処理を開始する
+#ifdef DEBUG_MODE_LOCAL_SCORE
+    aklib::ScoreSubmitter::getInstance().start(new aklib::LocalScoreBackend(kAKLocalScoreFileName));
+#else
+    aklib::ScoreSubmitter::getInstance().start(new aklib::OnlineScoreBackend());
+#endif
+    
     // サウンドファイルを読み込む
     preloadSound();
     
@@ -90,6 +148,7 @@ bool AppDelegate::applicationDidFinishLaunching() {
 
     // create a scene. it's an autorelease object
     auto scene = AKTitleScene::create();
+    AKAssetLoader::getInstance()->markMilestone("title");
 
     // run
     director->runWithScene(scene);
@@ -104,6 +163,16 @@ bool AppDelegate::applicationDidFinishLaunching() {
 void AppDelegate::applicationDidEnterBackground() {
     Director::getInstance()->stopAnimation();
 
+    // バックグラウンドで終了される可能性があるため、設定データと送信待ちのスコアの書き込みを完了させる
+    SettingFileIO::GetInstance().Flush();
+    aklib::ScoreSubmitter::getInstance().flush();
+
+    // ゲームプレイシーンの場合は次回起動時に再開できるようにゲームの状態を保存する
+    AKPlayingScene *playingScene = dynamic_cast<AKPlayingScene*>(Director::getInstance()->getRunningScene());
+    if (playingScene != NULL) {
+        playingScene->saveSnapshot();
+    }
+
     // if you use SimpleAudioEngine, it must be pause
     // SimpleAudioEngine::getInstance()->pauseBackgroundMusic();
 }
@@ -124,6 +193,24 @@ void AppDelegate::applicationWillEnterForeground() {
     // SimpleAudioEngine::getInstance()->resumeBackgroundMusic();
 }
 
+/*!
+ @brief テクスチャアトラスのプリロード
+ 
+ 起動時に使用するテクスチャアトラスの読み込みを要求する。
+ ファイル読み込みと画像のデコードはワーカースレッドで並列に行う。
+ タイトル画面で使用するものを先に要求する。
+ */
+void AppDelegate::preloadTexture()
+{
+    AKAssetLoader *assetLoader = AKAssetLoader::getInstance();
+    // コントロールのテクスチャアトラスを読み込む
+    assetLoader->requestSpriteFrames(kAKControlTextureAtlasDefFile, kAKControlTextureAtlasFile);
+    // ラベル枠のテクスチャアトラスを読み込む
+    AKLabel::requestFrameTexture();
+    // キャラクターのテクスチャアトラスを読み込む
+    assetLoader->requestSpriteFrames(kAKCharacterTextureAtlasDefFile, kAKCharacterTextureAtlasFile);
+}
+
 /*!
  @brief サウンドファイルのプリロード
 
@@ -131,37 +218,27 @@ void AppDelegate::applicationWillEnterForeground() {
  */
 void AppDelegate::preloadSound()
 {
-    // ステージのBGMを読み込む
-    for (int i = 0; i < kAKStageBGMCount; i++) {
-
-        // ファイル名を作成する
-        char fileName[32] = "";
-        snprintf(fileName, sizeof(fileName), kAKStageBGMFileName, i + 1);
-
-        // ファイルを読み込む
-        SimpleAudioEngine::getInstance()->preloadBackgroundMusic(fileName);
-    }
-    // ステージクリアジングルのファイルを読み込む
-    SimpleAudioEngine::getInstance()->preloadBackgroundMusic(kAKClearJingleFileName);
-    // ゲームクリアジングルのファイルを読み込む
-    SimpleAudioEngine::getInstance()->preloadBackgroundMusic(kAKGameClearJingleFileName);
+    // BGMは起動時には読み込まず、ステージ読み込み時に使用するものだけを先読みする
+    
+    // 効果音は効果音スケジューラの専用スレッドで読み込む
+    AKSEScheduler *seScheduler = AKSEScheduler::getInstance();
     // ボタン選択効果音のファイルを読み込む
-    SimpleAudioEngine::getInstance()->preloadEffect(kAKSelectSEFileName);
+    seScheduler->preloadEffect(kAKSelectSEFileName, kAKMenuSEConfig);
     // ポーズ効果音のファイルを読み込む
-    SimpleAudioEngine::getInstance()->preloadEffect(kAKPauseSEFileName);
+    seScheduler->preloadEffect(kAKPauseSEFileName, kAKMenuSEConfig);
     // 爆発(小)効果音のファイルを読み込む
-    SimpleAudioEngine::getInstance()->preloadEffect(kAKBombMinSEFileName);
+    seScheduler->preloadEffect(kAKBombMinSEFileName, kAKBombMinSEConfig);
     // 爆発(大)効果音のファイルを読み込む
-    SimpleAudioEngine::getInstance()->preloadEffect(kAKBombBigSEFileName);
+    seScheduler->preloadEffect(kAKBombBigSEFileName, kAKBombBigSEConfig);
     // 弾衝突効果音のファイルを読み込む
-    SimpleAudioEngine::getInstance()->preloadEffect(kAKHitSEFileName);
+    seScheduler->preloadEffect(kAKHitSEFileName, kAKHitSEConfig);
     // 自機死亡時の効果音のファイルを読み込む
-    SimpleAudioEngine::getInstance()->preloadEffect(kAKMissSEFileName);
+    seScheduler->preloadEffect(kAKMissSEFileName, kAKEventSEConfig);
     // 1Up時の効果音のファイルを読み込む
-    SimpleAudioEngine::getInstance()->preloadEffect(kAK1UpSEFileName);
+    seScheduler->preloadEffect(kAK1UpSEFileName, kAKEventSEConfig);
     // カーソル移動時の効果音のファイルを読み込む
-    SimpleAudioEngine::getInstance()->preloadEffect(kAKCursorSEFileName);
+    seScheduler->preloadEffect(kAKCursorSEFileName, kAKMenuSEConfig);
     
     // 音量を調整する
-    SimpleAudioEngine::getInstance()->setBackgroundMusicVolume(0.2f);
+    AKBGMPlayer::getInstance()->setVolume(0.2f);
 }
@@ -35,6 +35,8 @@ public:
     */
     virtual void applicationWillEnterForeground();
 
+    // テクスチャアトラスのプリロード
+    void preloadTexture();
     // サウンドファイルのプリロード
     void preloadSound();
 };
@@ -34,6 +34,7 @@
  */
 
 #include "AKAngle.h"
+#include "AKFastMath.h"
 
 using cocos2d::Vec2;
 
@@ -123,7 +124,7 @@ float AKAngle::calcDestAngle(const Vec2 &src, const Vec2 &dest)
     float vy = dest.y - src.y;
     
     // 角度を計算する
-    float angle = atan2f(vy, vx);
+    float angle = AKFastMath::calcAtan2(vy, vx);
     
     return angle;
 }
@@ -141,7 +142,7 @@ int AKAngle::calcRotationDirection(float srcAngle, float destAngle)
     // 現在の角度から見て入力角度が時計回りの側か反時計回りの側か調べる
     // sin(目的角度 - 現在の角度) > 0の場合は反時計回り
     // sin(目的角度 - 現在の角度) < 0の場合は時計回り
-    float destsin = sin(destAngle - srcAngle);
+    float destsin = AKFastMath::calcSin(destAngle - srcAngle);
     
     // 回転方向を設定する
     int rotdirect = 0;
@@ -156,7 +157,7 @@ int AKAngle::calcRotationDirection(float srcAngle, float destAngle)
         // 同じ向きか反対向きか調べる
         // cos(入力角度 - 現在角度) < 0の場合は反対向き
         // 反対向きの場合は反時計回りとする
-        float destcos = cos(destAngle - srcAngle);
+        float destcos = AKFastMath::calcCos(destAngle - srcAngle);
         if (destcos < 0.0f) {
             rotdirect = 1;
         }
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2015 Akihiro Kaneda.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1.Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   2.Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   3.Neither the name of the Monochrome Soft nor the names of its contributors
+ *     may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!
+ @file AKFastMath.cpp
+ @brief 高速三角関数クラス定義
+ 
+ ゲーム処理用の近似三角関数を計算するクラスを定義する。
+ */
+
+#include "AKFastMath.h"
+#include "AKLogNoDef.h"
+
+/// π
+static const float kAKPi = 3.14159265358979f;
+/// π/2
+static const float kAKHalfPi = 1.57079632679490f;
+/// 2π
+static const float kAKTwoPi = 6.28318530717959f;
+/// 1/2π
+static const float kAKInvTwoPi = 0.159154943091895f;
+
+#ifdef DEBUG_MODE_FAST_MATH_CHECK
+/// 標準ライブラリとの許容誤差
+static const double kAKFastMathTolerance = 1.0e-5;
+#endif
+
+/*!
+ @brief -πから+πの間への角度変換
+ 
+ 角度を2πの整数倍ずらして-πから+πの間に変換する。
+ @param angle 角度
+ @return 変換後の角度
+ */
+static inline float reduceAngle(float angle)
+{
+    return angle - kAKTwoPi * floorf(angle * kAKInvTwoPi + 0.5f);
+}
+
+/*!
+ @brief -π/2から+π/2の間のsin計算
+ 
+ テイラー展開の9次までの多項式で計算する。誤差は4.0e-6以下となる。
+ @param x 角度(-π/2から+π/2)
+ @return sin値
+ */
+static inline float calcSinPolynomial(float x)
+{
+    float x2 = x * x;
+    return x * (1.0f + x2 * (-1.0f / 6.0f + x2 * (1.0f / 120.0f + x2 * (-1.0f / 5040.0f + x2 * (1.0f / 362880.0f)))));
+}
+
+/*!
+ @brief 0から1の間のatan計算
+ 
+ 11次の多項式で計算する。誤差は2.0e-6以下となる。
+ @param z 値(0から1)
+ @return atan値
+ */
+static inline float calcAtanPolynomial(float z)
+{
+    float z2 = z * z;
+    return z * (0.99997726f + z2 * (-0.33262347f + z2 * (0.19354346f + z2 * (-0.11643287f + z2 * (0.05265332f + z2 * (-0.01172120f))))));
+}
+
+/*!
+ @brief sin、cos計算本体
+ 
+ -πから+πの間に変換したあと、sinはπ/2を軸に折り返し、
+ cosはsin(π/2 - |x|)として計算する。
+ @param angle 角度
+ @param sinValue sin値
+ @param cosValue cos値
+ */
+static inline void calcSinCosBody(float angle, float *sinValue, float *cosValue)
+{
+    // -πから+πの間に変換する
+    float x = reduceAngle(angle);
+    
+    // sinは-π/2から+π/2の範囲外の場合は折り返す
+    float folded = (x >= 0.0f ? kAKPi : -kAKPi) - x;
+    float sinX = (fabsf(x) > kAKHalfPi ? folded : x);
+    
+    *sinValue = calcSinPolynomial(sinX);
+    *cosValue = calcSinPolynomial(kAKHalfPi - fabsf(x));
+}
+
+#ifdef DEBUG_MODE_FAST_MATH_CHECK
+/*!
+ @brief 標準ライブラリとの比較
+ 
+ 近似値と標準ライブラリの計算結果を比較し、許容誤差を超えている場合はエラーを出力する。
+ @param name 関数名
+ @param input 入力値
+ @param value 近似値
+ @param expect 標準ライブラリの計算結果
+ */
+static void checkResult(const char *name, float input, float value, double expect)
+{
+    double error = fabs(value - expect);
+    
+    // atan2の±πの境界は同じ角度とみなす
+    if (error > M_PI) {
+        error = fabs(error - 2 * M_PI);
+    }
+    
+    AKLog(kAKLogFastMath_0 && error > kAKFastMathTolerance,
+          "%s(%f) error=%e fast=%f libm=%f", name, input, error, value, expect);
+}
+#endif
+
+/*!
+ @brief sin計算
+ 
+ sinを近似計算する。
+ @param angle 角度(rad)
+ @return sin値
+ */
+float AKFastMath::calcSin(float angle)
+{
+    float sinValue = 0.0f;
+    float cosValue = 0.0f;
+    calcSinCos(angle, &sinValue, &cosValue);
+    return sinValue;
+}
+
+/*!
+ @brief cos計算
+ 
+ cosを近似計算する。
+ @param angle 角度(rad)
+ @return cos値
+ */
+float AKFastMath::calcCos(float angle)
+{
+    float sinValue = 0.0f;
+    float cosValue = 0.0f;
+    calcSinCos(angle, &sinValue, &cosValue);
+    return cosValue;
+}
+
+/*!
+ @brief sin、cos同時計算
+ 
+ sinとcosを同時に近似計算する。角度の変換を共通化できるため、
+ 両方の値が必要な場合は個別に計算するよりも高速となる。
+ @param angle 角度(rad)
+ @param sinValue sin値
+ @param cosValue cos値
+ */
+void AKFastMath::calcSinCos(float angle, float *sinValue, float *cosValue)
+{
+    calcSinCosBody(angle, sinValue, cosValue);
+    
+#ifdef DEBUG_MODE_FAST_MATH_CHECK
+    checkResult("sin", angle, *sinValue, sin(angle));
+    checkResult("cos", angle, *cosValue, cos(angle));
+#endif
+}
+
+/*!
+ @brief atan2計算
+ 
+ atan2を近似計算する。x、yがともに0の場合は標準ライブラリと同様に0を返す。
+ @param y y方向の値
+ @param x x方向の値
+ @return 角度(-πから+π)
+ */
+float AKFastMath::calcAtan2(float y, float x)
+{
+    float absX = fabsf(x);
+    float absY = fabsf(y);
+    
+    // 原点の場合は0とする
+    if (absX <= 0.0f && absY <= 0.0f) {
+        return 0.0f;
+    }
+    
+    // 第1象限の0からπ/4の範囲に変換して計算する
+    float angle = 0.0f;
+    if (absY <= absX) {
+        angle = calcAtanPolynomial(absY / absX);
+    }
+    else {
+        angle = kAKHalfPi - calcAtanPolynomial(absX / absY);
+    }
+    
+    // xが負の場合は第2象限に移動する
+    if (x < 0.0f) {
+        angle = kAKPi - angle;
+    }
+    
+    // yが負の場合は下側に移動する
+    if (y < 0.0f) {
+        angle = -angle;
+    }
+    
+#ifdef DEBUG_MODE_FAST_MATH_CHECK
+    checkResult("atan2", y / x, angle, atan2(y, x));
+#endif
+    
+    return angle;
+}
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013 Akihiro Kaneda.
+ * Copyright (c) 2015 Akihiro Kaneda.
  * All rights reserved.
  *
  * Redistribution and use in source and binary forms, with or without
@@ -27,35 +27,37 @@
  * POSSIBILITY OF SUCH DAMAGE.
  */
 /*!
- @file AKCharacterPool.cpp
- @brief キャラクタープールクラス定義
+ @file AKFastMath.h
+ @brief 高速三角関数クラス定義
  
- 複数のキャラクターのメモリ管理を行うクラスを定義する。
+ ゲーム処理用の近似三角関数を計算するクラスを定義する。
  */
 
-#include "AKCharacterPool.h"
+#ifndef AKFASTMATH_H
+#define AKFASTMATH_H
+
+#include "AKCommon.h"
 
 /*!
- @brief 全キャラクター削除
+ @brief 高速三角関数クラス
  
- すべてのキャラクターを画面から取り除く。
+ ゲーム処理用の三角関数を多項式近似で計算するクラス。
+ 標準ライブラリとの誤差はsin、cosが±20rad以内の角度で4.0e-6以下、
+ atan2が全域で2.0e-6以下となる。
+ 固定の多項式で計算するため、コンパイラや端末によらず同じ結果となる。
+ DEBUG_MODE_FAST_MATH_CHECKを定義してビルドした場合は、
+ 計算のたびに標準ライブラリの結果と比較し、許容誤差を超えた場合はエラーとする。
  */
-template<class T> void AKCharacterPool<T>::reset()
-{
-    // 各キャラクターを画面から取り除く
-    for (T *character : m_pool) {
-        
-        // 画面上に配置されている場合は削除する
-        if (character->isStaged()) {
-            
-            // 配置フラグを落とす
-            character->setIsStaged(false);
-            
-            // 親ノードから取り除く
-            character->getImage()->removeFromParentAndCleanup(true);
-        }
-    }
-    
-    // インデックスを初期化する
-    m_next = 0;
-}
\ No newline at end of file
+class AKFastMath {
+public:
+    // sin計算
+    static float calcSin(float angle);
+    // cos計算
+    static float calcCos(float angle);
+    // sin、cos同時計算
+    static void calcSinCos(float angle, float *sinValue, float *cosValue);
+    // atan2計算
+    static float calcAtan2(float y, float x);
+};
+
+#endif
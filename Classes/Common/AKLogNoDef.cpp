@@ -55,9 +55,12 @@ bool kAKLogEnemy_0 = true;
 bool kAKLogEnemy_1 = false;
 bool kAKLogEnemy_2 = false;
 bool kAKLogEnemy_3 = false;
+bool kAKLogEnemyScript_0 = true;
+bool kAKLogEnemyScript_1 = false;
 bool kAKLogEnemyShot_0 = true;
 bool kAKLogEnemyShot_1 = false;
 bool kAKLogEnemyShot_2 = false;
+bool kAKLogFastMath_0 = true;
 bool kAKLogGameCenterHelper_0 = true;
 bool kAKLogGameCenterHelper_1 = false;
 bool kAKLogGauge_0 = true;
@@ -71,6 +74,8 @@ bool kAKLogOption_1 = false;
 bool kAKLogOption_2 = false;
 bool kAKLogOptionScene_0 = true;
 bool kAKLogOptionScene_1 = false;
+bool kAKLogPageScene_0 = true;
+bool kAKLogPageScene_1 = false;
 bool kAKLogPlayData_0 = true;
 bool kAKLogPlayData_1 = false;
 bool kAKLogPlayData_2 = false;
@@ -95,6 +100,8 @@ bool kAKLogTileMap_3 = false;
 bool kAKLogTileMap_4 = false;
 bool kAKLogScriptData_0 = true;
 bool kAKLogScriptData_1 = false;
+bool kAKLogSettingFileIO_0 = true;
+bool kAKLogSettingFileIO_1 = false;
 bool kAKLogTitleScene_0 = true;
 bool kAKLogTitleScene_1 = false;
 #endif
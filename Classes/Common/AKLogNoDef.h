@@ -58,9 +58,12 @@ extern bool kAKLogEnemy_0;
 extern bool kAKLogEnemy_1;
 extern bool kAKLogEnemy_2;
 extern bool kAKLogEnemy_3;
+extern bool kAKLogEnemyScript_0;
+extern bool kAKLogEnemyScript_1;
 extern bool kAKLogEnemyShot_0;
 extern bool kAKLogEnemyShot_1;
 extern bool kAKLogEnemyShot_2;
+extern bool kAKLogFastMath_0;
 extern bool kAKLogGameCenterHelper_0;
 extern bool kAKLogGameCenterHelper_1;
 extern bool kAKLogGauge_0;
@@ -74,6 +77,8 @@ extern bool kAKLogOption_1;
 extern bool kAKLogOption_2;
 extern bool kAKLogOptionScene_0;
 extern bool kAKLogOptionScene_1;
+extern bool kAKLogPageScene_0;
+extern bool kAKLogPageScene_1;
 extern bool kAKLogPlayData_0;
 extern bool kAKLogPlayData_1;
 extern bool kAKLogPlayData_2;
@@ -98,6 +103,8 @@ extern bool kAKLogTileMap_3;
 extern bool kAKLogTileMap_4;
 extern bool kAKLogScriptData_0;
 extern bool kAKLogScriptData_1;
+extern bool kAKLogSettingFileIO_0;
+extern bool kAKLogSettingFileIO_1;
 extern bool kAKLogTitleScene_0;
 extern bool kAKLogTitleScene_1;
 #endif
@@ -52,6 +52,10 @@ const char *kAKSpotID = "40141";
 const char *kAKControlTextureAtlasDefFile = "Control.plist";
 /// コントロールテクスチャアトラスファイル名
 const char *kAKControlTextureAtlasFile = "Control.png";
+/// キャラクターテクスチャアトラス定義ファイル名
+const char *kAKCharacterTextureAtlasDefFile = "Character.plist";
+/// キャラクターテクスチャアトラスファイル名
+const char *kAKCharacterTextureAtlasFile = "Character.png";
 /// カーソル画像のファイル名
 const char *CursorImageFileName = "Cursor.png";
 /// Bボタン画像のファイル名
@@ -63,8 +67,6 @@ const char *RButtonImageFileName = "RButton.png";
 // コントローラー操作のしきい値
 const float kAKControllerAxisThreshold = 0.2f;
 
-/// ステージBGMの種類数
-const int kAKStageBGMCount = 8;
 /// ステージBGMのファイル名
 const char *kAKStageBGMFileName = "sound/stage%d.mp3";
 /// ステージクリアジングルのファイル名
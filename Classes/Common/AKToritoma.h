@@ -44,6 +44,10 @@
 extern const char *kAKControlTextureAtlasDefFile;
 // コントロールテクスチャアトラスファイル名
 extern const char *kAKControlTextureAtlasFile;
+// キャラクターテクスチャアトラス定義ファイル名
+extern const char *kAKCharacterTextureAtlasDefFile;
+// キャラクターテクスチャアトラスファイル名
+extern const char *kAKCharacterTextureAtlasFile;
 // カーソル画像のファイル名
 extern const char *CursorImageFileName;
 // Bボタン画像のファイル名
@@ -55,8 +59,6 @@ extern const char *RButtonImageFileName;
 // コントローラー操作のしきい値
 extern const float kAKControllerAxisThreshold;
 
-// ステージBGMの種類数
-extern const int kAKStageBGMCount;
 // ステージBGMのファイル名
 extern const char *kAKStageBGMFileName;
 // ステージクリアジングルのファイル名
@@ -88,6 +90,14 @@ extern const char *kAKUDKeyHighScore;
 
 /// 自機当たり判定無効化
 //#define DEBUG_MODE_PLAYER_INVINCIBLE
+/// 起動時のアセット読み込みのタイムライン出力(書き込み可能ディレクトリのstartup_timeline.csvに出力する)
+//#define DEBUG_MODE_STARTUP_TIMELINE
+/// 入力遅延計測(結果は書き込み可能ディレクトリのinput_latency.csvに出力する)
+//#define DEBUG_MODE_INPUT_LATENCY
+/// オンラインスコアの代わりにローカルファイルにスコアを送信する(書き込み可能ディレクトリのlocal_score.txtに出力する)
+//#define DEBUG_MODE_LOCAL_SCORE
+/// プレイ中の状態を記録し、コントローラーのLボタンで数秒前に巻き戻す(練習用)
+//#define DEBUG_MODE_REWIND
 /// 開始周回数
 #define DEBUG_MODE_START_LOOP 1
 /// 開始ステージ番号
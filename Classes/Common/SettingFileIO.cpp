@@ -36,11 +36,42 @@
 #include "SettingFileIO.h"
 #include "cocos2d.h"
 #include "ID.h"
+#include "AKCommon.h"
+#include "AKLogNoDef.h"
+#include <cstddef>
+#if CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
 
+using std::string;
+using std::vector;
+using std::mutex;
+using std::lock_guard;
+using std::unique_lock;
 using cocos2d::UserDefault;
+using cocos2d::FileUtils;
 
 /// UserDefaultのハイスコアのキー
 const char *SettingFileIO::UDKeyHighScore = "HighScore";
+/// 設定ファイル名
+const char *SettingFileIO::SettingFileName = "Setting.dat";
+/// 設定ファイル書き込み時の一時ファイル名
+const char *SettingFileIO::TemporaryFileName = "Setting.dat.tmp";
+/// ジャーナルファイル名
+const char *SettingFileIO::JournalFileName = "Setting.jnl";
+/// 設定ファイルの識別子("AKST")
+const unsigned int SettingFileIO::SettingFileMagic = 0x54534b41;
+/// 設定ファイルのバージョン
+const unsigned int SettingFileIO::SettingFileVersion = 1;
+/// 設定ファイルにまとめるジャーナルのレコード数
+const int SettingFileIO::CompactionRecordCount = 32;
+
+/// チェックサムの初期値(FNV-1a)
+static const unsigned int kChecksumOffsetBasis = 2166136261u;
+/// チェックサムの乗数(FNV-1a)
+static const unsigned int kChecksumPrime = 16777619u;
 
 // スレッドセーフにするため、グローバル変数初期化処理でインスタンスの生成を行う
 static SettingFileIO &_instance = SettingFileIO::GetInstance();
@@ -59,36 +90,85 @@ SettingFileIO& SettingFileIO::GetInstance()
     return instance;
 }
 
+/*!
+ @brief デストラクタ
+ 
+ 書き込み待ちのレコードをすべて書き込んでから書き込みスレッドを終了する。
+ */
+SettingFileIO::~SettingFileIO()
+{
+    if (_thread.joinable()) {
+        {
+            lock_guard<mutex> lock(_mutex);
+            _isStopping = true;
+        }
+        _requestCondition.notify_one();
+        _thread.join();
+    }
+}
+
 /*!
  @brief ファイルを読み込む
  
- ファイルを読み込んでメンバ変数に取り込む。
+ 設定ファイルを読み込み、ジャーナルファイルの変更内容を反映してメンバ変数に取り込む。
+ どちらのファイルもない場合は、以前のバージョンでUserDefaultに保存した値を取り込む。
+ 読み込み後に書き込みスレッドを開始する。
  */
 void SettingFileIO::ReadFile()
 {
-    // UserDefaultインスタンスを取得する
-    UserDefault *ud = UserDefault::getInstance();
-
-    // ハイスコアを読み込む
-    _highScore = ud->getIntegerForKey(UDKeyHighScore, 0);
+    // 2回目以降は何もしない
+    if (_thread.joinable()) {
+        return;
+    }
+    
+    // ファイルのパスを作成する
+    string writablePath = FileUtils::getInstance()->getWritablePath();
+    _settingFilePath = writablePath + SettingFileName;
+    _temporaryFilePath = writablePath + TemporaryFileName;
+    _journalFilePath = writablePath + JournalFileName;
+    
+    // 設定ファイルとジャーナルファイルを読み込む
+    bool isSettingFileRead = ReadSettingFile();
+    _journalRecordCount = ReadJournalFile(&_isJournalBroken);
+    
+    // ファイルに書き込まれている値を記憶する
+    for (int i = 0; i < KeyCount; i++) {
+        _savedValues[i] = _values[i];
+    }
+    
+    // ジャーナルファイルの末尾が壊れている場合、そのまま追記すると以降のレコードが読めなくなるため、
+    // 追記を受け付ける前に設定ファイルにまとめてジャーナルファイルを削除する
+    if (_isJournalBroken && Compact()) {
+        _journalRecordCount = 0;
+        _isJournalBroken = false;
+    }
+    
+    // 書き込みスレッドを開始する
+    _thread = std::thread(&SettingFileIO::Run, this);
+    
+    // どちらのファイルもない場合はUserDefaultから値を移行する
+    if (!isSettingFileRead && _journalRecordCount == 0) {
+        
+        // UserDefaultインスタンスを取得する
+        UserDefault *ud = UserDefault::getInstance();
+        
+        // ハイスコアを読み込む
+        SetValue(KeyHighScore, ud->getIntegerForKey(UDKeyHighScore, 0));
+    }
+    
+    AKLog(kAKLogSettingFileIO_1, "highScore=%d journal=%d", _values[KeyHighScore], _journalRecordCount);
 }
 
 /*!
  @brief ハイスコアをファイルに書き込む
  
- ハイスコアをファイルに書き込む。
+ ハイスコアを変更し、ファイルへの書き込みを書き込みスレッドに依頼する。
+ 書き込みの完了は待たない。
  @param hiScore ハイスコア
  */
 void SettingFileIO::WriteHighScore(int highScore)
 {
-    // UserDefaultインスタンスを取得する
-    UserDefault *ud = UserDefault::getInstance();
-    
-    // ハイスコアを書き込む
-    ud->setIntegerForKey(UDKeyHighScore, highScore);
-
-    // メンバ変数の内容を変更する
-    _highScore = highScore;
+    SetValue(KeyHighScore, highScore);
 }
 
 /*!
@@ -99,7 +179,26 @@ void SettingFileIO::WriteHighScore(int highScore)
  */
 int SettingFileIO::GetHighScore()
 {
-    return _highScore;
+    return _values[KeyHighScore];
+}
+
+/*!
+ @brief 書き込み完了を待つ
+ 
+ 書き込み待ちのレコードがすべてファイルに書き込まれるまで待つ。
+ アプリがバックグラウンドに移行する時など、プロセスが終了される可能性がある時に使用する。
+ */
+void SettingFileIO::Flush()
+{
+    // 書き込みスレッドが開始していない場合は何もしない
+    if (!_thread.joinable()) {
+        return;
+    }
+    
+    unique_lock<mutex> lock(_mutex);
+    while (!_pendingRecords.empty() || _isWriting) {
+        _flushCondition.wait(lock);
+    }
 }
 
 /*!
@@ -107,8 +206,336 @@ int SettingFileIO::GetHighScore()
  
  メンバ変数を初期化する。
  */
-SettingFileIO::SettingFileIO()
+SettingFileIO::SettingFileIO() :
+_isWriting(false), _isStopping(false), _journalRecordCount(0), _isJournalBroken(false)
 {
     // メンバ変数を初期化する
-    _highScore = 0;
-}
\ No newline at end of file
+    for (int i = 0; i < KeyCount; i++) {
+        _values[i] = 0;
+        _savedValues[i] = 0;
+    }
+}
+
+/*!
+ @brief 設定値を変更する
+ 
+ メモリ上の設定値を変更し、ジャーナルファイルへの追記を書き込みスレッドに依頼する。
+ 値が変わらない場合は何もしない。
+ @param key 設定項目
+ @param value 設定値
+ */
+void SettingFileIO::SetValue(SettingKey key, int value)
+{
+    AKAssert(key >= 0 && key < KeyCount, "設定項目が不正:%d", key);
+    
+    if (_values[key] == value) {
+        return;
+    }
+    
+    // メンバ変数の内容を変更する
+    _values[key] = value;
+    
+    // ジャーナルファイルのレコードを作成する
+    JournalRecord record;
+    record.key = key;
+    record.value = value;
+    record.checksum = CalcChecksum(&record, offsetof(JournalRecord, checksum), kChecksumOffsetBasis);
+    
+    // 書き込みスレッドに渡す
+    {
+        lock_guard<mutex> lock(_mutex);
+        _pendingRecords.push_back(record);
+    }
+    _requestCondition.notify_one();
+}
+
+/*!
+ @brief 設定ファイルを読み込む
+ 
+ 設定ファイルを読み込んでメンバ変数に取り込む。
+ 識別子、バージョン、チェックサムが一致しない場合は読み込まない。
+ @return 読み込んだ場合true
+ */
+bool SettingFileIO::ReadSettingFile()
+{
+    FILE *fp = fopen(_settingFilePath.c_str(), "rb");
+    if (fp == NULL) {
+        AKLog(kAKLogSettingFileIO_1, "設定ファイルなし:%s", _settingFilePath.c_str());
+        return false;
+    }
+    
+    // ヘッダを読み込む
+    // 項目数が設定項目の数に比べて極端に大きい場合は壊れているものとする
+    unsigned int header[3] = {0, 0, 0};
+    if (fread(header, sizeof(header), 1, fp) != 1 ||
+        header[0] != SettingFileMagic ||
+        header[1] != SettingFileVersion ||
+        header[2] > KeyCount * 16) {
+        
+        AKLog(kAKLogSettingFileIO_0, "設定ファイルのヘッダが不正");
+        fclose(fp);
+        return false;
+    }
+    unsigned int checksum = CalcChecksum(header, sizeof(header), kChecksumOffsetBasis);
+    
+    // 設定値を読み込む
+    // 知らない設定項目は無視する
+    vector<int> values(header[2] * 2);
+    unsigned int fileChecksum = 0;
+    if ((header[2] > 0 && fread(values.data(), sizeof(int) * values.size(), 1, fp) != 1) ||
+        fread(&fileChecksum, sizeof(fileChecksum), 1, fp) != 1) {
+        
+        AKLog(kAKLogSettingFileIO_0, "設定ファイルが途中で終わっている");
+        fclose(fp);
+        return false;
+    }
+    fclose(fp);
+    
+    checksum = CalcChecksum(values.data(), sizeof(int) * values.size(), checksum);
+    if (checksum != fileChecksum) {
+        AKLog(kAKLogSettingFileIO_0, "設定ファイルのチェックサムが不一致");
+        return false;
+    }
+    
+    for (unsigned int i = 0; i < header[2]; i++) {
+        unsigned int key = static_cast<unsigned int>(values[i * 2]);
+        if (key < KeyCount) {
+            _values[key] = values[i * 2 + 1];
+        }
+    }
+    
+    return true;
+}
+
+/*!
+ @brief ジャーナルファイルを読み込む
+ 
+ ジャーナルファイルのレコードを先頭から順番にメンバ変数に反映する。
+ 書き込み途中で終了した場合など、チェックサムが一致しないレコード以降は無視する。
+ 読み込めなかったデータが残っている場合は末尾が壊れているものとする。
+ @param isBroken 末尾が壊れているかどうかを格納する変数
+ @return 読み込んだレコード数
+ */
+int SettingFileIO::ReadJournalFile(bool *isBroken)
+{
+    *isBroken = false;
+    
+    FILE *fp = fopen(_journalFilePath.c_str(), "rb");
+    if (fp == NULL) {
+        return 0;
+    }
+    
+    // ファイルサイズを取得する
+    long fileSize = -1;
+    if (fseek(fp, 0, SEEK_END) == 0) {
+        fileSize = ftell(fp);
+    }
+    rewind(fp);
+    
+    int count = 0;
+    JournalRecord record;
+    while (fread(&record, sizeof(record), 1, fp) == 1) {
+        
+        if (record.checksum != CalcChecksum(&record, offsetof(JournalRecord, checksum), kChecksumOffsetBasis)) {
+            AKLog(kAKLogSettingFileIO_0, "ジャーナルのチェックサムが不一致:%d", count);
+            break;
+        }
+        
+        if (record.key < KeyCount) {
+            _values[record.key] = record.value;
+        }
+        count++;
+    }
+    fclose(fp);
+    
+    // 読み込んだレコードのサイズとファイルサイズが一致しない場合は末尾が壊れている
+    if (fileSize != static_cast<long>(sizeof(JournalRecord) * count)) {
+        AKLog(kAKLogSettingFileIO_0, "ジャーナルの末尾が壊れている:size=%ld count=%d", fileSize, count);
+        *isBroken = true;
+    }
+    
+    return count;
+}
+
+/*!
+ @brief 書き込みスレッドの処理
+ 
+ 渡されたレコードをジャーナルファイルに追記する。
+ ジャーナルのレコード数が一定数を超えたら設定ファイルにまとめる。
+ 終了時は書き込み待ちのレコードをすべて書き込んでから終了する。
+ */
+void SettingFileIO::Run()
+{
+    vector<JournalRecord> records;
+    
+    while (true) {
+        
+        // レコードが渡されるまで待つ
+        {
+            unique_lock<mutex> lock(_mutex);
+            while (_pendingRecords.empty() && !_isStopping) {
+                _requestCondition.wait(lock);
+            }
+            
+            if (_pendingRecords.empty()) {
+                break;
+            }
+            
+            // ロックしている時間を短くするため、レコードを入れ替えてから処理する
+            records.swap(_pendingRecords);
+            _isWriting = true;
+        }
+        
+        // ファイルに書き込んだ値を更新する
+        for (const JournalRecord &record : records) {
+            _savedValues[record.key] = record.value;
+        }
+        
+        // ジャーナルファイルに追記する
+        // 末尾が壊れている場合は追記しても読めないため、追記せずに設定ファイルにまとめる
+        // 追記に失敗した場合は途中まで書き込まれている可能性があるため、末尾が壊れているものとする
+        bool isAppended = false;
+        if (!_isJournalBroken) {
+            isAppended = AppendJournal(records);
+            _isJournalBroken = !isAppended;
+        }
+        _journalRecordCount += records.size();
+        
+        // 追記できなかった場合、ジャーナルが一定数溜まった場合は設定ファイルにまとめる
+        if (!isAppended || _journalRecordCount >= CompactionRecordCount) {
+            if (Compact()) {
+                _journalRecordCount = 0;
+                _isJournalBroken = false;
+            }
+        }
+        records.clear();
+        
+        // 書き込み完了を通知する
+        {
+            lock_guard<mutex> lock(_mutex);
+            _isWriting = false;
+        }
+        _flushCondition.notify_all();
+    }
+}
+
+/*!
+ @brief ジャーナルファイルに追記する
+ 
+ レコードをジャーナルファイルの末尾に追記する。
+ @param records 追記するレコード
+ @return 追記に成功した場合true
+ */
+bool SettingFileIO::AppendJournal(const vector<JournalRecord> &records)
+{
+    FILE *fp = fopen(_journalFilePath.c_str(), "ab");
+    if (fp == NULL) {
+        AKLog(kAKLogSettingFileIO_0, "ジャーナルファイルを開けない:%s", _journalFilePath.c_str());
+        return false;
+    }
+    
+    bool isSucceeded = (fwrite(records.data(), sizeof(JournalRecord) * records.size(), 1, fp) == 1);
+    isSucceeded = CloseFile(fp) && isSucceeded;
+    
+    AKLog(kAKLogSettingFileIO_1, "ジャーナル追記:%d件 result=%d", static_cast<int>(records.size()), isSucceeded);
+    
+    return isSucceeded;
+}
+
+/*!
+ @brief 設定ファイルにまとめる
+ 
+ ファイルに書き込んだ値を一時ファイルに書き込み、設定ファイルに名前を変更してからジャーナルファイルを削除する。
+ 名前の変更前に終了した場合は元の設定ファイルとジャーナルファイルが残り、
+ ジャーナルファイルの削除前に終了した場合は同じ値を再度反映するだけのため、どの時点で終了しても値は失われない。
+ @return 成功した場合true
+ */
+bool SettingFileIO::Compact()
+{
+    // ヘッダと設定値を作成する
+    unsigned int header[3] = {SettingFileMagic, SettingFileVersion, KeyCount};
+    int values[KeyCount * 2];
+    for (int i = 0; i < KeyCount; i++) {
+        values[i * 2] = i;
+        values[i * 2 + 1] = _savedValues[i];
+    }
+    unsigned int checksum = CalcChecksum(header, sizeof(header), kChecksumOffsetBasis);
+    checksum = CalcChecksum(values, sizeof(values), checksum);
+    
+    // 一時ファイルに書き込む
+    FILE *fp = fopen(_temporaryFilePath.c_str(), "wb");
+    if (fp == NULL) {
+        AKLog(kAKLogSettingFileIO_0, "一時ファイルを開けない:%s", _temporaryFilePath.c_str());
+        return false;
+    }
+    
+    bool isSucceeded = (fwrite(header, sizeof(header), 1, fp) == 1 &&
+                        fwrite(values, sizeof(values), 1, fp) == 1 &&
+                        fwrite(&checksum, sizeof(checksum), 1, fp) == 1);
+    isSucceeded = CloseFile(fp) && isSucceeded;
+    
+    if (!isSucceeded) {
+        AKLog(kAKLogSettingFileIO_0, "一時ファイルの書き込みに失敗");
+        remove(_temporaryFilePath.c_str());
+        return false;
+    }
+    
+    // 設定ファイルに名前を変更する
+#if CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
+    // Windowsでは変更先のファイルがあると名前を変更できないため、先に削除する
+    remove(_settingFilePath.c_str());
+#endif
+    if (rename(_temporaryFilePath.c_str(), _settingFilePath.c_str()) != 0) {
+        AKLog(kAKLogSettingFileIO_0, "設定ファイルへの名前の変更に失敗");
+        return false;
+    }
+    
+    // ジャーナルファイルを削除する
+    remove(_journalFilePath.c_str());
+    
+    AKLog(kAKLogSettingFileIO_1, "設定ファイルにまとめた");
+    
+    return true;
+}
+
+/*!
+ @brief チェックサムを計算する
+ 
+ FNV-1aでチェックサムを計算する。
+ 前回の計算結果を渡すと、続きのデータとして計算する。
+ @param data データ
+ @param size データのサイズ
+ @param checksum 前回の計算結果
+ @return チェックサム
+ */
+unsigned int SettingFileIO::CalcChecksum(const void *data, size_t size, unsigned int checksum)
+{
+    const unsigned char *bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        checksum ^= bytes[i];
+        checksum *= kChecksumPrime;
+    }
+    return checksum;
+}
+
+/*!
+ @brief ファイルを閉じる
+ 
+ 書き込んだ内容をストレージまで反映してからファイルを閉じる。
+ @param fp ファイル
+ @return 成功した場合true
+ */
+bool SettingFileIO::CloseFile(FILE *fp)
+{
+    bool isSucceeded = (fflush(fp) == 0);
+    
+#if CC_TARGET_PLATFORM == CC_PLATFORM_WIN32
+    isSucceeded = (_commit(_fileno(fp)) == 0) && isSucceeded;
+#else
+    isSucceeded = (fsync(fileno(fp)) == 0) && isSucceeded;
+#endif
+    
+    isSucceeded = (fclose(fp) == 0) && isSucceeded;
+    
+    return isSucceeded;
+}
@@ -36,21 +36,89 @@
 #ifndef __toritoma__SettingFileIO__
 #define __toritoma__SettingFileIO__
 
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
 /*!
  @brief 設定データファイル入出力
  
  設定データをファイル入出力する。
+ 設定値はメモリ上の値をすぐに変更し、ファイルへの書き込みは専用スレッドで行う。
+ 変更内容はジャーナルファイルに追記していき、一定数溜まったら設定ファイルにまとめる。
+ 設定ファイルは一時ファイルに書き込んでから名前を変更し、書き込み途中で終了しても壊れないようにする。
  */
 class SettingFileIO {
+public:
+    /// 設定項目
+    enum SettingKey {
+        KeyHighScore = 0,   ///< ハイスコア
+        KeyCount            ///< 設定項目の数
+    };
+    
 private:
+    /// ジャーナルファイルのレコード
+    struct JournalRecord {
+        /// 設定項目
+        unsigned int key;
+        /// 設定値
+        int value;
+        /// チェックサム
+        unsigned int checksum;
+    };
+    
     // UserDefaultのハイスコアのキー
     static const char *UDKeyHighScore;
-    // ハイスコア
-    int _highScore;
+    // 設定ファイル名
+    static const char *SettingFileName;
+    // 設定ファイル書き込み時の一時ファイル名
+    static const char *TemporaryFileName;
+    // ジャーナルファイル名
+    static const char *JournalFileName;
+    // 設定ファイルの識別子
+    static const unsigned int SettingFileMagic;
+    // 設定ファイルのバージョン
+    static const unsigned int SettingFileVersion;
+    // 設定ファイルにまとめるジャーナルのレコード数
+    static const int CompactionRecordCount;
+    
+    // 設定値
+    int _values[KeyCount];
+    // 設定ファイルのパス
+    std::string _settingFilePath;
+    // 一時ファイルのパス
+    std::string _temporaryFilePath;
+    // ジャーナルファイルのパス
+    std::string _journalFilePath;
+    // 書き込みスレッド
+    std::thread _thread;
+    // 書き込み要求の排他制御
+    std::mutex _mutex;
+    // 書き込み要求の通知
+    std::condition_variable _requestCondition;
+    // 書き込み完了の通知
+    std::condition_variable _flushCondition;
+    // 書き込み待ちのレコード
+    std::vector<JournalRecord> _pendingRecords;
+    // 書き込み中かどうか
+    bool _isWriting;
+    // 書き込みスレッドを終了するかどうか
+    bool _isStopping;
+    // ファイルに書き込んだ設定値(書き込みスレッドのみ使用する)
+    int _savedValues[KeyCount];
+    // ジャーナルファイルのレコード数(書き込みスレッドのみ使用する)
+    int _journalRecordCount;
+    // ジャーナルファイルの末尾が壊れているかどうか(書き込みスレッドのみ使用する)
+    bool _isJournalBroken;
 
 public:
     // インスタンス取得
     static SettingFileIO& GetInstance();
+    // デストラクタ
+    ~SettingFileIO();
     
     // ファイルを読み込む
     void ReadFile();
@@ -58,10 +126,32 @@ public:
     void WriteHighScore(int hiScore);
     // ハイスコアを取得する
     int GetHighScore();
+    // 書き込み完了を待つ
+    void Flush();
     
 private:
     // コンストラクタ
     SettingFileIO();
+    // コピーコンストラクタは使用禁止
+    SettingFileIO(const SettingFileIO &other);
+    // 代入演算子は使用禁止
+    SettingFileIO& operator=(const SettingFileIO &other);
+    // 設定値を変更する
+    void SetValue(SettingKey key, int value);
+    // 設定ファイルを読み込む
+    bool ReadSettingFile();
+    // ジャーナルファイルを読み込む
+    int ReadJournalFile(bool *isBroken);
+    // 書き込みスレッドの処理
+    void Run();
+    // ジャーナルファイルに追記する
+    bool AppendJournal(const std::vector<JournalRecord> &records);
+    // 設定ファイルにまとめる
+    bool Compact();
+    // チェックサムを計算する
+    static unsigned int CalcChecksum(const void *data, size_t size, unsigned int checksum);
+    // ファイルを閉じる
+    static bool CloseFile(FILE *fp);
 };
 
 #endif /* defined(__toritoma__SettingFileIO__) */
@@ -38,7 +38,7 @@
 #include "base/CCEventListenerController.h"
 
 using cocos2d::Sprite;
-using cocos2d::SpriteFrameCache;
+using cocos2d::Node;
 using cocos2d::Controller;
 
 /// 遊び方説明画像テクスチャアトラス定義ファイル名
@@ -80,7 +80,7 @@ AKHowToPlayScene* AKHowToPlayScene::create()
  
  初期化処理を行う。
  */
-AKHowToPlayScene::AKHowToPlayScene() : PageScene(kAKHowToPageCount)
+AKHowToPlayScene::AKHowToPlayScene() : PageScene(kAKHowToPageCount), m_isControllerConnected(false)
 {
     
 }
@@ -89,18 +89,10 @@ AKHowToPlayScene::AKHowToPlayScene() : PageScene(kAKHowToPageCount)
 bool AKHowToPlayScene::initSub()
 {
     // テクスチャアトラスを読み込む
-    SpriteFrameCache::getInstance()->addSpriteFramesWithFile(kAKHowToTextureAtlasDefFile, kAKHowToTextureAtlasFile);
-
-    // メッセージボックスを作成する
-    _messageLabel = AKLabel::createLabel("", kAKHowToMsgLength, kAKHowToMsgLineCount, kAKLabelFrameMessage, AKLabel::MessageFont);
+    AKAssetLoader::getInstance()->addSpriteFrames(kAKHowToTextureAtlasDefFile, kAKHowToTextureAtlasFile);
     
-    // 配置位置を設定する
-    float x = AKScreenSize::center().x;
-    float y = AKScreenSize::positionFromBottomPoint(kAKHowToMsgPosBottomPoint);
-    _messageLabel->setPosition(x, y);
-    
-    // シーンに配置する
-    addChild(_messageLabel, ZPositionItem);
+    // コントローラーの接続状態を記憶する
+    m_isControllerConnected = (Controller::getAllController().size() > 0);
 
     return true;
 }
@@ -108,19 +100,39 @@ bool AKHowToPlayScene::initSub()
 // ページ表示内容更新
 unsigned int AKHowToPlayScene::updatePageContents(int pageNo)
 {
-    // 表示文字列のキーを生成する
-    char key[32] = "";
+    // コントローラーの接続状態が変わった場合はメッセージが変わるため、作成済みのページを破棄する
+    bool isControllerConnected = (Controller::getAllController().size() > 0);
+    if (isControllerConnected != m_isControllerConnected) {
+        m_isControllerConnected = isControllerConnected;
+        clearPageNodes();
+    }
+    
+    return 0;
+}
+
+// ページ表示ノード作成
+Node* AKHowToPlayScene::createPageNode(int pageNo)
+{
+    Node *node = Node::create();
     
+    // 表示文字列のキーを生成する
     // コントローラが接続されている場合はメッセージを切り替える
-    if (Controller::getAllController().size() > 0) {
-        snprintf(key, sizeof(key), "HowToPlay_Controller_%d", pageNo);
-    }
-    else {
-        snprintf(key, sizeof(key), "HowToPlay_%d", pageNo);
+    int firstKey = aklib::kAKLocalizedHowToPlay_1;
+    if (m_isControllerConnected) {
+        firstKey = aklib::kAKLocalizedHowToPlay_Controller_1;
     }
+    aklib::LocalizedKey key = static_cast<aklib::LocalizedKey>(firstKey + pageNo - 1);
     
-    // 表示文字列を変更する
-    _messageLabel->setString(aklib::LocalizedResource::getInstance().getString(key));
+    // メッセージボックスを作成する
+    AKLabel *messageLabel = AKLabel::createLabel(aklib::LocalizedResource::getInstance().getString(key), kAKHowToMsgLength, kAKHowToMsgLineCount, kAKLabelFrameMessage, AKLabel::MessageFont);
+    
+    // 配置位置を設定する
+    float x = AKScreenSize::center().x;
+    float y = AKScreenSize::positionFromBottomPoint(kAKHowToMsgPosBottomPoint);
+    messageLabel->setPosition(x, y);
+    
+    // ノードに配置する
+    node->addChild(messageLabel);
     
     // 表示ファイル名を作成する
     char fileName[16] = "";
@@ -128,21 +140,16 @@ unsigned int AKHowToPlayScene::updatePageContents(int pageNo)
     
     AKLog(kAKLogHowToPlayScene_1, "画像ファイル名:%s", fileName);
     
-    // すでに画像を読み込んでいるときは画像を解放する
-    if (m_image != NULL) {
-        removeChild(m_image, true);
-    }
-    
     // ファイルからスプライトを作成する
-    m_image = Sprite::createWithSpriteFrameName(fileName);
+    Sprite *image = Sprite::createWithSpriteFrameName(fileName);
     
     // 表示位置を設定する
-    float x = AKScreenSize::center().x;
-    float y = AKScreenSize::positionFromBottomPoint(kAKHowToImagePosBottomPoint);
-    m_image->setPosition(x, y);
+    x = AKScreenSize::center().x;
+    y = AKScreenSize::positionFromBottomPoint(kAKHowToImagePosBottomPoint);
+    image->setPosition(x, y);
     
-    // シーンに追加する
-    addChild(m_image, ZPositionItem);
+    // ノードに配置する
+    node->addChild(image);
     
-    return 0;
+    return node;
 }
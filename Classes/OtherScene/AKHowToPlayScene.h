@@ -80,13 +80,20 @@ protected:
      @return 有効にするインターフェースタグ
      */
     virtual unsigned int updatePageContents(int pageNo);
+    
+    /*!
+     @brief ページ表示ノード作成
+     
+     ページに表示する説明画像とメッセージボックスを作成する。
+     @param pageNo ページ番号
+     @return ページ表示ノード
+     */
+    virtual cocos2d::Node* createPageNode(int pageNo);
 
 private:
     
-    /// 説明画像
-    cocos2d::Sprite *m_image;
-    /// メッセージラベル
-    AKLabel *_messageLabel;
+    /// ページ表示ノード作成時のコントローラー接続状態
+    bool m_isControllerConnected;
 };
 
 #endif
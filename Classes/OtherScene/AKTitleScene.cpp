@@ -48,12 +48,10 @@ using cocos2d::Blink;
 using cocos2d::CallFunc;
 using cocos2d::Node;
 using cocos2d::Sprite;
-using cocos2d::SpriteFrameCache;
 using cocos2d::Sequence;
 using cocos2d::EventListenerController;
 using cocos2d::Controller;
 using cocos2d::Event;
-using CocosDenshion::SimpleAudioEngine;
 using aklib::OnlineScore;
 
 // メニュー項目のタグ
@@ -295,7 +293,7 @@ void AKTitleScene::onAxisEvent(Controller* controller, int keyCode, Event* event
                 }
                 
                 // カーソル移動時の効果音を鳴らす
-                SimpleAudioEngine::getInstance()->playEffect(kAKCursorSEFileName);
+                AKSEScheduler::getInstance()->playEffect(kAKCursorSEFileName);
 
                 // メニュー項目を選択する
                 selectMenuItem((MenuItem)menuNumber);
@@ -320,7 +318,7 @@ void AKTitleScene::onAxisEvent(Controller* controller, int keyCode, Event* event
                 }
                 
                 // カーソル移動時の効果音を鳴らす
-                SimpleAudioEngine::getInstance()->playEffect(kAKCursorSEFileName);
+                AKSEScheduler::getInstance()->playEffect(kAKCursorSEFileName);
 
                 // メニュー項目を選択する
                 selectMenuItem((MenuItem)menuNumber);
@@ -419,8 +417,7 @@ AKTitleScene::AKTitleScene()
                               true);
     
     // テクスチャアトラスを読み込む
-    SpriteFrameCache *spriteFrameCache = SpriteFrameCache::getInstance();
-    spriteFrameCache->addSpriteFramesWithFile(kAKControlTextureAtlasDefFile, kAKControlTextureAtlasFile);
+    AKAssetLoader::getInstance()->addSpriteFrames(kAKControlTextureAtlasDefFile, kAKControlTextureAtlasFile);
     
     // カーソル画像を読み込む。
     m_cursor = Sprite::createWithSpriteFrameName(CursorImageFileName);
@@ -472,9 +469,13 @@ bool AKTitleScene::init()
  @brief 画面遷移終了時処理
  
  画面遷移終了時に広告を表示する。
+ 入力がない間はフレームレートを抑制する。
  */
 void AKTitleScene::onEnterTransitionDidFinish()
 {
+    // 入力待ちの間はフレームレートを抑制する
+    AKFrameThrottle::getInstance()->setEnabled(true);
+    
     // バナー広告を表示する
     aklib::Advertisement::viewBanner();
         
@@ -484,6 +485,20 @@ void AKTitleScene::onEnterTransitionDidFinish()
     }
 }
 
+/*!
+ @brief 画面遷移開始時処理
+ 
+ 他の画面への遷移開始時にフレームレートの抑制を解除する。
+ */
+void AKTitleScene::onExitTransitionDidStart()
+{
+    // フレームレートの抑制を解除する
+    AKFrameThrottle::getInstance()->setEnabled(false);
+    
+    // スーパークラスの処理を実行する
+    Scene::onExitTransitionDidStart();
+}
+
 /*!
  @brief 更新処理
  
@@ -571,7 +586,7 @@ void AKTitleScene::touchCreditButton()
 void AKTitleScene::selectButton(int tag)
 {
     // メニュー選択時の効果音を鳴らす
-    SimpleAudioEngine::getInstance()->playEffect(kAKSelectSEFileName);
+    AKSEScheduler::getInstance()->playEffect(kAKSelectSEFileName);
     
     // ボタンのブリンクアクションを作成する
     Blink *action = Blink::create(0.2f, 2);
@@ -631,7 +646,7 @@ void AKTitleScene::selectMenuItem(MenuItem item)
 void AKTitleScene::selectLeaderboard()
 {
     // メニュー選択時の効果音を鳴らす
-    SimpleAudioEngine::getInstance()->playEffect(kAKSelectSEFileName);
+    AKSEScheduler::getInstance()->playEffect(kAKSelectSEFileName);
     
     // ボタンのブリンクアクションを作成する。
     // ブリンクアクション終了後にLeaderboardを表示する。
@@ -57,6 +57,8 @@ public:
     virtual bool init();
     // 画面遷移終了時処理
     virtual void onEnterTransitionDidFinish();
+    // 画面遷移開始時処理
+    virtual void onExitTransitionDidStart();
     // 更新処理
     virtual void update(float delta);
     // インタースティシャル広告表示を行う
@@ -34,14 +34,23 @@
  */
 
 #include "ActivityIndicator.h"
+#include "AKCommon.h"
 
 using cocos2d::Node;
 using cocos2d::Sprite;
+using cocos2d::LayerColor;
+using cocos2d::Rect;
 
 // インジケータ画像ファイル名
 const char *ActivityIndicator::IndicatorFileName = "Indicator.png";
 /// インジケータの回転速度
 const float ActivityIndicator::RotateSpeed = 360.0f / 12.0f;
+/// 進捗ゲージの幅
+const float ActivityIndicator::ProgressGaugeWidth = 96.0f;
+/// 進捗ゲージの高さ
+const float ActivityIndicator::ProgressGaugeHeight = 4.0f;
+/// 進捗ゲージの位置(インジケータの中心からのy座標)
+const float ActivityIndicator::ProgressGaugePosY = -40.0f;
 
 // コンビニエンスコンストラクタ
 ActivityIndicator* ActivityIndicator::create()
@@ -72,6 +81,18 @@ bool ActivityIndicator::init()
     // ノードに追加する
     addChild(_indicator);
     
+    // 進捗ゲージを作成する
+    // 進捗率が設定されるまでは非表示にしておく
+    Rect gaugeRect(-ProgressGaugeWidth / 2.0f, ProgressGaugePosY, ProgressGaugeWidth, ProgressGaugeHeight);
+    _progressBack = AKCreateColorLayer(kAKColorLittleLight, gaugeRect);
+    _progressBack->setVisible(false);
+    addChild(_progressBack);
+    
+    _progressBar = AKCreateColorLayer(kAKColorDark, gaugeRect);
+    _progressBar->setContentSize(cocos2d::Size(0.0f, ProgressGaugeHeight));
+    _progressBar->setVisible(false);
+    addChild(_progressBar);
+    
     // インジケータ回転アニメーションのため、スケジュール登録する
     schedule(CC_SCHEDULE_SELECTOR(ActivityIndicator::update), 0.1f);
     
@@ -83,4 +104,18 @@ void ActivityIndicator::update(float delta)
 {
     // インジケータ画像を回転させる
     _indicator->setRotation(_indicator->getRotation() + RotateSpeed);
-}
\ No newline at end of file
+}
+
+// 進捗率設定
+void ActivityIndicator::setProgress(float progress)
+{
+    // 範囲外の値は範囲内に収める
+    progress = MAX(0.0f, MIN(progress, 1.0f));
+    
+    // 進捗率に応じてゲージの幅を変更する
+    _progressBar->setContentSize(cocos2d::Size(ProgressGaugeWidth * progress, ProgressGaugeHeight));
+    
+    // 進捗ゲージを表示する
+    _progressBack->setVisible(true);
+    _progressBar->setVisible(true);
+}
@@ -65,15 +65,34 @@ public:
      */
     virtual void update(float delta);
     
+    /*!
+     @brief 進捗率設定
+     
+     インジケータの下に進捗ゲージを表示し、進捗率を設定する。
+     進捗率を設定するまでは進捗ゲージは表示しない。
+     @param progress 進捗率(0.0〜1.0)
+     */
+    void setProgress(float progress);
+    
 private:
     
     /// インジケータ画像ファイル名
     static const char *IndicatorFileName;
     /// インジケータの回転速度
     static const float RotateSpeed;
+    /// 進捗ゲージの幅
+    static const float ProgressGaugeWidth;
+    /// 進捗ゲージの高さ
+    static const float ProgressGaugeHeight;
+    /// 進捗ゲージの位置(インジケータの中心からのy座標)
+    static const float ProgressGaugePosY;
     
     /// インジケータ画像
     cocos2d::Sprite *_indicator;
+    /// 進捗ゲージの背景
+    cocos2d::LayerColor *_progressBack;
+    /// 進捗ゲージ
+    cocos2d::LayerColor *_progressBar;
 };
 
 #endif /* ActivityIndicator_h */
@@ -47,7 +47,7 @@ using cocos2d::EventListenerController;
 using cocos2d::Controller;
 using cocos2d::Event;
 using cocos2d::Sprite;
-using CocosDenshion::SimpleAudioEngine;
+using cocos2d::Node;
 using aklib::OpenUrl;
 
 /// カーソル画像の位置のボタンとの重なりの幅
@@ -60,10 +60,6 @@ const float CreditScene::CreditPosLeftRatio = 0.35f;
 const int CreditScene::CreditLineNum = 3;
 /// クレジットラベルの1行の文字数
 const int CreditScene::CreditLineLength = 14;
-/// クレジットラベルテキストのキー
-const char *CreditScene::CreditTextKey = "CreditName_%d";
-/// クレジットラベルテキストのキー
-const char *CreditScene::UrlTextKey = "CreditLink_%d";
 /// 最大ページ番号
 const int CreditScene::MaxPageNum = (LinkNum - 1) / LinkNumOfPage + 1;
 /// リンクボタンのキャプション
@@ -110,18 +106,6 @@ bool CreditScene::initSub()
                                                  LinkTag[i],
                                                  true);
     }
-    
-    // クレジットラベルをシーンに配置する
-    for (int i = 0; i < LinkNumOfPage; i++) {
-        
-        m_creditLabel[i] = AKLabel::createLabel("", CreditLineLength, CreditLineNum, kAKLabelFrameNone, AKLabel::MessageFont);
-        
-        float x = AKScreenSize::positionFromLeftRatio(CreditPosLeftRatio);
-        float y = AKScreenSize::positionFromTopRatio(LinkPosTopRatio[i]);
-        m_creditLabel[i]->setPosition(Vec2(x, y));
-        
-        addChild(m_creditLabel[i], ZPositionBack);
-    }
 
     return true;
 }
@@ -163,13 +147,35 @@ unsigned int CreditScene::updatePageContents(int pageNo)
     
     // リンクボタンの表示を更新する
     enableTag = updateLinkButton(pageNo);
-
-    // クレジットラベルを更新する
-    updateCreditLabel(pageNo);
     
     return enableTag;
 }
 
+// ページ表示ノード作成
+Node* CreditScene::createPageNode(int pageNo)
+{
+    Node *node = Node::create();
+    
+    // 1ページの各項目のラベルを作成する
+    // 表示個数の範囲外の項目はラベルを作成しない
+    for (int i = 0; i < getLinkNum(pageNo); i++) {
+        
+        // 表示文字列のキーを生成する
+        aklib::LocalizedKey key = static_cast<aklib::LocalizedKey>(aklib::kAKLocalizedCreditName_1 + i + (pageNo - 1) * LinkNumOfPage);
+        
+        // リソースからテキストを取得してラベルを作成する
+        AKLabel *label = AKLabel::createLabel(aklib::LocalizedResource::getInstance().getString(key), CreditLineLength, CreditLineNum, kAKLabelFrameNone, AKLabel::MessageFont);
+        
+        float x = AKScreenSize::positionFromLeftRatio(CreditPosLeftRatio);
+        float y = AKScreenSize::positionFromTopRatio(LinkPosTopRatio[i]);
+        label->setPosition(Vec2(x, y));
+        
+        node->addChild(label);
+    }
+    
+    return node;
+}
+
 // カーソル表示有無取得
 bool CreditScene::isVisibleCursor(int pageNo)
 {
@@ -194,7 +200,7 @@ Vec2 CreditScene::getCursorPosition(int pageNo, int positionID)
 int CreditScene::onLStickUp(int pageNo, int cursorPosition)
 {
     // カーソル移動時の効果音を鳴らす
-    SimpleAudioEngine::getInstance()->playEffect(kAKCursorSEFileName);
+    AKSEScheduler::getInstance()->playEffect(kAKCursorSEFileName);
     
     // 選択位置をひとつ減らす
     // 下限を超える場合は末尾へ移動する
@@ -210,7 +216,7 @@ int CreditScene::onLStickUp(int pageNo, int cursorPosition)
 int CreditScene::onLStickDown(int pageNo, int cursorPosition)
 {
     // カーソル移動時の効果音を鳴らす
-    SimpleAudioEngine::getInstance()->playEffect(kAKCursorSEFileName);
+    AKSEScheduler::getInstance()->playEffect(kAKCursorSEFileName);
     
     // 選択位置をひとつ増やす
     // 上限を超える場合は先頭へ移動する
@@ -226,14 +232,13 @@ int CreditScene::onLStickDown(int pageNo, int cursorPosition)
 void CreditScene::openLink(int pageNo, int linkNumber)
 {
     // メニュー選択時の効果音を鳴らす
-    SimpleAudioEngine::getInstance()->playEffect(kAKSelectSEFileName);
+    AKSEScheduler::getInstance()->playEffect(kAKSelectSEFileName);
     
     // URL文字列のキーを生成する
-    char key[16] = "";
-    snprintf(key, sizeof(key), UrlTextKey, linkNumber + (pageNo - 1) * LinkNumOfPage);
+    aklib::LocalizedKey key = static_cast<aklib::LocalizedKey>(aklib::kAKLocalizedCreditLink_1 + linkNumber + (pageNo - 1) * LinkNumOfPage - 1);
     
     // URLを開く
-    OpenUrl::open(aklib::LocalizedResource::getInstance().getString(key).c_str());
+    OpenUrl::open(aklib::LocalizedResource::getInstance().getString(key));
 }
 
 // リンクボタン表示更新
@@ -258,30 +263,6 @@ unsigned int CreditScene::updateLinkButton(int pageNo)
     return enableTag;
 }
 
-// クレジットラベル表示更新
-void CreditScene::updateCreditLabel(int pageNo)
-{
-    // 1ページの各項目のラベルを更新する
-    for (int i = 0; i < LinkNumOfPage; i++) {
-
-        // 表示個数の範囲内ならば、リソースからテキストを取得してラベルに設定する
-        if (i + (pageNo - 1) * LinkNumOfPage + 1 <= LinkNum) {
-            
-            // 表示文字列のキーを生成する
-            char key[16] = "";
-            snprintf(key, sizeof(key), CreditTextKey, i + (pageNo - 1) * LinkNumOfPage + 1);
-            
-            // 表示文字列を変更する
-            m_creditLabel[i]->setString(aklib::LocalizedResource::getInstance().getString(key));
-        }
-        else {
-            
-            // 表示文字列を変更する
-            m_creditLabel[i]->setString("");
-        }
-    }
-}
-
 // ページ内項目数計算
 int CreditScene::getLinkNum(int pageNo)
 {
@@ -118,6 +118,15 @@ protected:
      @return 有効にするインターフェースタグ
      */
     virtual unsigned int updatePageContents(int pageNo);
+    
+    /*!
+     @brief ページ表示ノード作成
+     
+     ページに表示するクレジットラベルを作成する。
+     @param pageNo ページ番号
+     @return ページ表示ノード
+     */
+    virtual cocos2d::Node* createPageNode(int pageNo);
 
     /*!
      @brief カーソル表示有無取得
@@ -164,10 +173,6 @@ private:
     static const int CreditLineNum;
     // クレジットラベルの1行の文字数
     static const int CreditLineLength;
-    // クレジットラベルテキストのキー
-    static const char *CreditTextKey;
-    /// クレジットURLテキストのキー
-    static const char *UrlTextKey;
     // リンクボタンのキャプション
     static const char *LinkCaption;
     // リンクボタンの位置、左からの比率
@@ -177,8 +182,6 @@ private:
     // リンクボタンのタグ
     static const unsigned int LinkTag[];
     
-    /// クレジットラベル
-    AKLabel *m_creditLabel[LinkNumOfPage];
     /// リンクボタン
     AKLabel *m_link[LinkNumOfPage];
     
@@ -200,14 +203,6 @@ private:
      */
     unsigned int updateLinkButton(int pageNo);
     
-    /*!
-     @brief クレジットラベル表示更新
-     
-     表示しているページに合わせてクレジットラベルの表示内容を更新する。
-     @param pageNo ページ番号
-     */
-    void updateCreditLabel(int pageNo);
-    
     /*!
      @brief ページ内項目数計算
      
@@ -42,11 +42,11 @@ using cocos2d::Director;
 using cocos2d::Event;
 using cocos2d::EventListenerController;
 using cocos2d::LayerColor;
+using cocos2d::Node;
 using cocos2d::Sprite;
 using cocos2d::SpriteFrameCache;
 using cocos2d::TransitionFade;
 using cocos2d::Vec2;
-using CocosDenshion::SimpleAudioEngine;
 
 // ページ表示のフォーマット
 const char *PageScene::PageFormat = "%d / %d";
@@ -104,7 +104,7 @@ bool PageScene::init()
     }
     
     // テクスチャアトラスを読み込む
-    SpriteFrameCache::getInstance()->addSpriteFramesWithFile(kAKControlTextureAtlasDefFile, kAKControlTextureAtlasFile);
+    AKAssetLoader::getInstance()->addSpriteFrames(kAKControlTextureAtlasDefFile, kAKControlTextureAtlasFile);
     
     // 背景を作成する
     createBackground();
@@ -138,9 +138,52 @@ bool PageScene::init()
     // 初期ページ番号を設定する
     setPageNo(1);
     
+    // 前後のページの先読みのため、更新処理を開始する
+    scheduleUpdate();
+    
     return true;
 }
 
+// 画面遷移終了時処理
+void PageScene::onEnterTransitionDidFinish()
+{
+    // スーパークラスの処理を実行する
+    Scene::onEnterTransitionDidFinish();
+    
+    // 入力待ちの間はフレームレートを抑制する
+    AKFrameThrottle::getInstance()->setEnabled(true);
+}
+
+// 画面遷移開始時処理
+void PageScene::onExitTransitionDidStart()
+{
+    // フレームレートの抑制を解除する
+    AKFrameThrottle::getInstance()->setEnabled(false);
+    
+    // スーパークラスの処理を実行する
+    Scene::onExitTransitionDidStart();
+}
+
+// 更新処理
+void PageScene::update(float delta)
+{
+    // ページを切り替えたフレームでは先読みを行わない
+    if (_isPageNodeCreated) {
+        _isPageNodeCreated = false;
+        return;
+    }
+    
+    // 次のページ、前のページの順に未作成のものを1ページ分だけ作成する
+    const int candidates[] = {_pageNo + 1, _pageNo - 1};
+    for (int pageNo : candidates) {
+        if (pageNo >= 1 && pageNo <= _maxPage && _pageNodes[pageNo - 1] == NULL) {
+            AKLog(kAKLogPageScene_1, "ページ先読み:%d", pageNo);
+            getPageNode(pageNo);
+            break;
+        }
+    }
+}
+
 // イベント処理
 void PageScene::execEvent(const AKMenuItem *item)
 {
@@ -361,6 +404,10 @@ PageScene::PageScene(int maxPage)
     
     // 操作が無効かどうかを初期化する
     _isDisabled = false;
+    
+    // ページ表示ノードは表示時か先読み時に作成する
+    _pageNodes.resize(maxPage, NULL);
+    _isPageNodeCreated = false;
 }
 
 // 派生クラスの初期化処理
@@ -423,6 +470,14 @@ unsigned int PageScene::updatePageContents(int pageNo)
     return 0;
 }
 
+// ページ表示ノード作成
+Node* PageScene::createPageNode(int pageNo)
+{
+    // 継承先で処理を実装する
+    
+    return Node::create();
+}
+
 // カーソル表示有無取得
 bool PageScene::isVisibleCursor(int pageNo)
 {
@@ -454,7 +509,11 @@ float PageScene::getCursorPositionMargin()
 // ページ数設定
 void PageScene::setMaxPage(int maxPage)
 {
+    // ページ数が変わるため、作成済みのページ表示ノードを破棄する
+    clearPageNodes();
+    
     _maxPage = maxPage;
+    _pageNodes.resize(maxPage, NULL);
 }
 
 // 操作を無効化する
@@ -476,6 +535,55 @@ void PageScene::updateView()
     setPageNo(_pageNo);    
 }
 
+// ページ表示ノードのキャッシュ破棄
+void PageScene::clearPageNodes()
+{
+    for (Node *&node : _pageNodes) {
+        if (node != NULL) {
+            node->removeFromParentAndCleanup(true);
+            node = NULL;
+        }
+    }
+}
+
+// ページ表示ノード取得
+Node* PageScene::getPageNode(int pageNo)
+{
+    AKAssert(pageNo > 0 && pageNo <= _maxPage, "ページ番号が範囲外:pageNo=%d", pageNo);
+    
+    // 作成済みの場合はキャッシュしたノードを返す
+    Node *node = _pageNodes[pageNo - 1];
+    if (node != NULL) {
+        return node;
+    }
+    
+    // ノードを作成し、非表示の状態でシーンに配置する
+    node = createPageNode(pageNo);
+    AKAssert(node != NULL, "ページ表示ノードの作成に失敗:pageNo=%d", pageNo);
+    node->setVisible(false);
+    addChild(node, ZPositionItem);
+    _pageNodes[pageNo - 1] = node;
+    
+    // このフレームでは先読みを行わないようにする
+    _isPageNodeCreated = true;
+    
+    return node;
+}
+
+// ページ表示ノード表示切替
+void PageScene::showPageNode(int pageNo)
+{
+    // 表示するページのノードを取得する(未作成の場合はここで作成する)
+    Node *visibleNode = getPageNode(pageNo);
+    
+    // 表示するページのノードのみ表示する
+    for (Node *node : _pageNodes) {
+        if (node != NULL) {
+            node->setVisible(node == visibleNode);
+        }
+    }
+}
+
 // デフォルトコンストラクタ
 PageScene::PageScene()
 {
@@ -682,6 +790,9 @@ void PageScene::setPageNo(int pageNo)
     // ページ表示内容を更新する
     enableTag |= updatePageContents(_pageNo);
     
+    // ページ表示ノードを切り替える
+    showPageNode(_pageNo);
+    
     // 有効タグをインターフェースに反映する
     _interface->setEnableTag(enableTag);
 }
@@ -779,7 +890,7 @@ void PageScene::goPrevPage()
     if (_pageNo > 1) {
 
         // メニュー選択時の効果音を鳴らす
-        SimpleAudioEngine::getInstance()->playEffect(kAKSelectSEFileName);
+        AKSEScheduler::getInstance()->playEffect(kAKSelectSEFileName);
         
         // 1減らしたページ番号を設定する
         setPageNo(_pageNo - 1);
@@ -793,7 +904,7 @@ void PageScene::goNextPage()
     if (_pageNo < _maxPage) {
         
         // メニュー選択時の効果音を鳴らす
-        SimpleAudioEngine::getInstance()->playEffect(kAKSelectSEFileName);
+        AKSEScheduler::getInstance()->playEffect(kAKSelectSEFileName);
         
         // 1増やしたページ番号を設定する
         setPageNo(_pageNo + 1);
@@ -804,7 +915,7 @@ void PageScene::goNextPage()
 void PageScene::backToTitle()
 {
     // メニュー選択時の効果音を鳴らす
-    SimpleAudioEngine::getInstance()->playEffect(kAKSelectSEFileName);
+    AKSEScheduler::getInstance()->playEffect(kAKSelectSEFileName);
     
     // タイトルシーンへの遷移を作成する
     TransitionFade *transition = TransitionFade::create(0.5f,
@@ -57,6 +57,29 @@ public:
      */
     virtual bool init();
     
+    /*!
+     @brief 画面遷移終了時処理
+     
+     画面遷移終了後、入力がない間はフレームレートを抑制する。
+     */
+    virtual void onEnterTransitionDidFinish();
+    
+    /*!
+     @brief 画面遷移開始時処理
+     
+     他の画面への遷移開始時にフレームレートの抑制を解除する。
+     */
+    virtual void onExitTransitionDidStart();
+    
+    /*!
+     @brief 更新処理
+     
+     前後のページのページ表示ノードを先読みする。
+     1フレームで作成するのは1ページ分のみとし、ページを切り替えたフレームでは作成しない。
+     @param delta フレーム更新間隔
+     */
+    virtual void update(float delta);
+    
     /*!
      @brief イベント処理
      
@@ -220,6 +243,17 @@ protected:
      */
     virtual unsigned int updatePageContents(int pageNo);
     
+    /*!
+     @brief ページ表示ノード作成
+     
+     ページに固定で表示する項目をまとめたノードを作成する。
+     作成したノードはシーンに配置したままキャッシュし、ページ切替時は表示・非表示を切り替える。
+     ページを表示するたびに変わる項目はupdatePageContentsで更新する。
+     @param pageNo ページ番号
+     @return ページ表示ノード
+     */
+    virtual cocos2d::Node* createPageNode(int pageNo);
+    
     /*!
      @brief カーソル表示有無取得
      
@@ -284,6 +318,15 @@ protected:
      */
     void updateView();
     
+    /*!
+     @brief ページ表示ノードのキャッシュ破棄
+     
+     作成済みのページ表示ノードをすべて破棄する。
+     ページ表示ノードの内容の前提が変わった場合に呼び出す。
+     破棄したノードは次に表示する時か先読み時に作成し直す。
+     */
+    void clearPageNodes();
+    
 private:
     
     /// ページ表示のフォーマット
@@ -347,6 +390,10 @@ private:
     cocos2d::Sprite *_cursorImage;
     /// 操作が無効かどうか
     bool _isDisabled;
+    /// ページ表示ノード(ページ番号-1の位置に格納する、未作成の場合はNULL)
+    std::vector<cocos2d::Node*> _pageNodes;
+    /// このフレームでページ表示ノードを作成したかどうか
+    bool _isPageNodeCreated;
     
     /*!
      @brief デフォルトコンストラクタ
@@ -355,6 +402,23 @@ private:
      */
     PageScene();
     
+    /*!
+     @brief ページ表示ノード取得
+     
+     ページ表示ノードを取得する。未作成の場合は作成し、非表示の状態でシーンに配置する。
+     @param pageNo ページ番号
+     @return ページ表示ノード
+     */
+    cocos2d::Node* getPageNode(int pageNo);
+    
+    /*!
+     @brief ページ表示ノード表示切替
+     
+     指定したページのページ表示ノードを表示し、それ以外のページ表示ノードを非表示にする。
+     @param pageNo ページ番号
+     */
+    void showPageNode(int pageNo);
+    
     /*!
      @brief 背景作成
      
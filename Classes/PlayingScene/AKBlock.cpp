@@ -278,6 +278,23 @@ void AKBlock::destroyCharacter(AKCharacter *character)
     character->setHitPoint(0);
 }
 
+/*!
+ @brief 移動処理
+ 
+ キャラクター共通の移動処理を行い、続けて障害物固有の動作を行う。
+ 固有の動作は仮想関数を経由せずに呼び出し、インライン展開できるようにする。
+ @param data ゲームデータ
+ */
+void AKBlock::move(AKPlayDataInterface *data)
+{
+    // キャラクター共通の移動処理を行う
+    if (moveCommon(data)) {
+        
+        // 障害物固有の動作を行う
+        AKBlock::action(data);
+    }
+}
+
 /*!
  @brief キャラクター固有の動作
  
@@ -56,6 +56,8 @@ struct AKBlcokDef {
  */
 class AKBlock : public AKCharacter {
 public:
+    // 移動処理
+    virtual void move(AKPlayDataInterface *data);
     // 衝突処理
     virtual void hit(AKCharacter *character, AKPlayDataInterface *data);
     // キャラクター固有の動作
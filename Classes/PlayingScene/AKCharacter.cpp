@@ -59,7 +59,8 @@ m_image(NULL), m_size(0.0f, 0.0f), m_position(0.0f, 0.0f), m_prevPosition(0.0f,
 m_speedX(0.0f), m_speedY(0.0f), m_hitPoint(0), m_power(1), m_defence(0), m_isStaged(false),
 m_animationPattern(1), m_animationInterval(kAKDefaultAnimationInterval), m_animationFrame(0),
 m_animationRepeat(0), m_animationInitPattern(1), m_imageName(""), m_scrollSpeed(0.0f),
-m_blockHitAction(kAKBlockHitNone), m_blockHitSide(0), m_offset(0.0f, 0.0f), m_outThreshold(kAKDefaultOutThreshold)
+m_blockHitAction(kAKBlockHitNone), m_blockHitSide(0), m_offset(0.0f, 0.0f), m_outThreshold(kAKDefaultOutThreshold),
+m_linearBase(0.0f, 0.0f), m_linearVelocity(0.0f, 0.0f), m_linearStep(0), m_linearEndStep(-1)
 {
 }
 
@@ -320,6 +321,177 @@ void AKCharacter::removeCharacter()
     m_image = NULL;
 }
 
+/*!
+ @brief 等速直線移動の再計算要求
+ 
+ 次の移動時に現在位置を基準として等速直線移動の速度と画面外に出るまでの移動回数を再計算する。
+ 生成時とスクロールスピード変更時に呼び出す。
+ */
+void AKCharacter::resetLinearMove()
+{
+    m_linearEndStep = -1;
+}
+
+/*!
+ @brief スナップショット書き込み
+ 
+ キャラクター共通の状態をスナップショットに書き込む。
+ 画面に配置されていない場合は配置状態のみを書き込む。
+ スプライトは画像名、アニメーションの状態、回転角度、表示有無から復元する。
+ @param writer 書き込み先
+ */
+void AKCharacter::writeSnapshot(AKSnapshotWriter *writer)
+{
+    // 配置状態を書き込む
+    writer->write(m_isStaged);
+    
+    // 画面に配置されていない場合はここで終了する
+    if (!m_isStaged) {
+        return;
+    }
+    
+    // 画像の状態を書き込む
+    writer->writeString(m_imageName);
+    writer->write(m_animationInitPattern);
+    writer->write(m_image != NULL ? m_image->getRotation() : 0.0f);
+    writer->write(m_image != NULL ? m_image->isVisible() : false);
+    
+    // 等速直線移動の状態を書き込む
+    writer->write(m_linearBase);
+    writer->write(m_linearVelocity);
+    writer->write(m_linearStep);
+    writer->write(m_linearEndStep);
+    
+    // 位置、速度、ヒットポイント等を書き込む
+    writer->write(m_size);
+    writer->write(m_position);
+    writer->write(m_prevPosition);
+    writer->write(m_speedX);
+    writer->write(m_speedY);
+    writer->write(m_hitPoint);
+    writer->write(m_power);
+    writer->write(m_defence);
+    
+    // アニメーションの状態を書き込む
+    writer->write(m_animationPattern);
+    writer->write(m_animationInterval);
+    writer->write(m_animationFrame);
+    writer->write(m_animationRepeat);
+    
+    // その他の状態を書き込む
+    writer->write(m_scrollSpeed);
+    writer->write(static_cast<int>(m_blockHitAction));
+    writer->write(m_blockHitSide);
+    writer->write(m_offset);
+    writer->write(m_outThreshold);
+}
+
+/*!
+ @brief スナップショット読み込み
+ 
+ writeSnapshotで書き込んだキャラクター共通の状態を読み込む。
+ 親ノードを指定した場合はプールのキャラクターとして扱い、現在の画像を取り除いてから
+ スプライトを作り直して親ノードに配置する。
+ 親ノードを指定しない場合は自機・オプションのように常に画像を持つキャラクターとして扱い、
+ 現在のスプライトの表示を切り替える。
+ @param reader 読み込み元
+ @param parent 画像を配置する親ノード(常に画像を持つキャラクターの場合はNULL)
+ @return 読み込めたかどうか
+ */
+bool AKCharacter::readSnapshot(AKSnapshotReader *reader, cocos2d::Node *parent)
+{
+    // 配置状態を読み込む
+    bool isStaged = false;
+    if (!reader->read(&isStaged)) {
+        return false;
+    }
+    
+    // プールのキャラクターの場合は現在の画像を取り除く
+    if (parent != NULL && m_image != NULL) {
+        m_image->removeFromParentAndCleanup(true);
+        m_image = NULL;
+    }
+    
+    // 画面に配置されていない場合は画像を非表示にして終了する
+    m_isStaged = false;
+    if (!isStaged) {
+        if (m_image != NULL) {
+            m_image->setVisible(false);
+        }
+        return true;
+    }
+    
+    // 画像の状態を読み込む
+    std::string imageName;
+    float rotation = 0.0f;
+    bool isVisible = false;
+    reader->readString(&imageName);
+    reader->read(&m_animationInitPattern);
+    reader->read(&rotation);
+    reader->read(&isVisible);
+    
+    // 等速直線移動の状態を読み込む
+    reader->read(&m_linearBase);
+    reader->read(&m_linearVelocity);
+    reader->read(&m_linearStep);
+    reader->read(&m_linearEndStep);
+    
+    // 位置、速度、ヒットポイント等を読み込む
+    reader->read(&m_size);
+    reader->read(&m_position);
+    reader->read(&m_prevPosition);
+    reader->read(&m_speedX);
+    reader->read(&m_speedY);
+    reader->read(&m_hitPoint);
+    reader->read(&m_power);
+    reader->read(&m_defence);
+    
+    // アニメーションの状態を読み込む
+    reader->read(&m_animationPattern);
+    reader->read(&m_animationInterval);
+    reader->read(&m_animationFrame);
+    reader->read(&m_animationRepeat);
+    
+    // その他の状態を読み込む
+    int blockHitAction = kAKBlockHitNone;
+    reader->read(&m_scrollSpeed);
+    reader->read(&blockHitAction);
+    reader->read(&m_blockHitSide);
+    reader->read(&m_offset);
+    reader->read(&m_outThreshold);
+    m_blockHitAction = static_cast<enum AKBlockHitAction>(blockHitAction);
+    
+    // 読み込みに失敗した場合は配置しない
+    if (reader->isError() || imageName.length() == 0 || m_animationInterval <= 0) {
+        AKLog(kAKLogCharacter_1, "スナップショットの読み込みに失敗");
+        reader->setError();
+        return false;
+    }
+    
+    // スプライトを作成、または画像を切り替える
+    m_isStaged = true;
+    setImageName(imageName);
+    
+    // 経過フレーム数に応じたアニメーションパターンを表示する
+    if (m_animationPattern >= 2) {
+        setPatternImage(m_animationFrame / m_animationInterval + m_animationInitPattern);
+    }
+    
+    // 回転角度、表示有無を復元する
+    m_image->setRotation(rotation);
+    m_image->setVisible(isVisible);
+    
+    // プールのキャラクターの場合は親ノードに配置する
+    if (parent != NULL) {
+        parent->addChild(m_image);
+    }
+    
+    // 画像表示位置の更新を行う
+    updateImagePosition();
+    
+    return true;
+}
+
 /*!
  @brief 画像名の設定
  
@@ -407,22 +579,40 @@ void AKCharacter::setAnimationInitPattern(int animationInitPattern)
 /*!
  @brief 移動処理
 
+ キャラクター共通の移動処理を行い、続けてキャラクター固有の動作を行う。
+ @param data ゲームデータ
+ */
+void AKCharacter::move(AKPlayDataInterface *data)
+{
+    // キャラクター共通の移動処理を行う
+    if (moveCommon(data)) {
+        
+        // キャラクター固有の動作を行う
+        action(data);
+    }
+}
+
+/*!
+ @brief キャラクター共通の移動処理
+
  速度によって位置を移動する。
  アニメーションを行う。
+ 破壊された場合や画面から取り除かれた場合はキャラクター固有の動作は行わない。
  @param data ゲームデータ
+ @return キャラクター固有の動作を行うかどうか
  */
-void AKCharacter::move(AKPlayDataInterface *data)
+bool AKCharacter::moveCommon(AKPlayDataInterface *data)
 {
     // 画面に配置されていない場合は無処理
     if (!m_isStaged) {
-        return;
+        return false;
     }
         
     // HPが0になった場合は破壊処理を行う
     if (m_hitPoint <= 0) {
         AKLog(kAKLogCharacter_1, "HP0により消滅");
         destroy(data);
-        return;
+        return false;
     }
     
     // 画面外に出た場合は削除する
@@ -436,7 +626,7 @@ void AKCharacter::move(AKPlayDataInterface *data)
         m_image->removeFromParentAndCleanup(true);
         m_image = NULL;
         
-        return;
+        return false;
     }
     
     // 移動前の座標を記憶する
@@ -454,11 +644,11 @@ void AKCharacter::move(AKPlayDataInterface *data)
             break;
             
         case kAKBlockHitMove:       // 移動
-            checkHit(*data->getBlocks(), data, &AKCharacter::moveOfBlockHit);
+            checkHit(*data->getBlocks(), data, AKMoveOfBlockHit());
             break;
             
         case kAKBlockHitDisappear:  // 消滅
-            checkHit(*data->getBlocks(), data, &AKCharacter::disappearOfBlockHit);
+            checkHit(*data->getBlocks(), data, AKDisappearOfBlockHit());
             break;
             
         default:
@@ -506,28 +696,123 @@ void AKCharacter::move(AKPlayDataInterface *data)
                     m_image->removeFromParentAndCleanup(true);
                     m_image = NULL;
                     
-                    return;
+                    return false;
                 }
             }
         }
         
-        // アニメーションパターンに応じて画像ファイル名を作成する
-        char imageFileName[32] = "";
-        snprintf(imageFileName,
-                 sizeof(imageFileName),
-                 kAKImageFileFormat,
-                 m_imageName.c_str(),
-                 pattern);
+        // アニメーションパターンに応じて表示スプライトを変更する
+        setPatternImage(pattern);
+    }
+    
+    return true;
+}
+
+/*!
+ @brief 等速直線移動
+ 
+ 基準位置と速度から現在位置を計算して移動する。
+ 画面外に出るまでの移動回数は移動開始時に一度だけ計算し、毎フレームの画面外判定は行わない。
+ アニメーションを行わず、途中で速度の変わらない弾に使用する。
+ スクロールスピードが変わった場合はresetLinearMoveで再計算を要求すること。
+ @param data ゲームデータ
+ @return キャラクター固有の動作を行うかどうか
+ */
+bool AKCharacter::moveLinear(AKPlayDataInterface *data)
+{
+    // 画面に配置されていない場合は無処理
+    if (!m_isStaged) {
+        return false;
+    }
+    
+    // HPが0になった場合は破壊処理を行う
+    if (m_hitPoint <= 0) {
+        AKLog(kAKLogCharacter_1, "HP0により消滅");
+        destroy(data);
+        return false;
+    }
+    
+    // 未計算の場合は現在位置を基準に移動を開始する
+    if (m_linearEndStep < 0) {
+        startLinearMove(data);
+    }
+    
+    // 画面外に出る移動回数に到達した場合は削除する
+    if (m_linearStep >= m_linearEndStep) {
+        AKLog(kAKLogCharacter_1, "画面外移動により消滅");
         
-        AKLog(false, "imageFileName=%s", imageFileName);
+        // ステージ配置フラグを落とす
+        m_isStaged = false;
         
-        // 表示スプライトを変更する
-        SpriteFrameCache *spriteFrameCache = SpriteFrameCache::getInstance();
-        m_image->setSpriteFrame(spriteFrameCache->getSpriteFrameByName(imageFileName));
+        // 画面から取り除く
+        m_image->removeFromParentAndCleanup(true);
+        m_image = NULL;
+        
+        return false;
+    }
+    
+    // 移動前の座標を記憶する
+    savePosition();
+    
+    // 基準位置からの移動回数によって座標を計算する
+    m_linearStep++;
+    m_position.x = m_linearBase.x + m_linearVelocity.x * m_linearStep;
+    m_position.y = m_linearBase.y + m_linearVelocity.y * m_linearStep;
+    
+    // 障害物との衝突判定を行う
+    if (m_blockHitAction == kAKBlockHitDisappear) {
+        checkHit(*data->getBlocks(), data, AKDisappearOfBlockHit());
+    }
+    
+    // 画像表示位置の更新を行う
+    updateImagePosition();
+    
+    return true;
+}
+
+/*!
+ @brief 等速直線移動の開始
+ 
+ 現在位置を基準位置とし、スクロールの影響を含めた速度と画面外に出るまでの移動回数を計算する。
+ 画面外判定の条件はisOutOfStageと同じものとする。
+ @param data ゲームデータ
+ */
+void AKCharacter::startLinearMove(AKPlayDataInterface *data)
+{
+    // 画面外判定の範囲
+    const float left = -m_outThreshold;
+    const float right = AKScreenSize::stageSize().width + m_outThreshold;
+    const float bottom = -m_outThreshold;
+    const float top = AKScreenSize::stageSize().height + m_outThreshold;
+    // 移動回数の上限(画面外に出ない場合に使用する)
+    const float kAKMaxStep = 1000000.0f;
+    
+    // 基準位置を設定する
+    m_linearBase = m_position;
+    m_linearStep = 0;
+    
+    // スクロールの影響を含めた速度を計算する
+    m_linearVelocity.x = m_speedX - data->getScrollSpeedX() * m_scrollSpeed;
+    m_linearVelocity.y = m_speedY - data->getScrollSpeedY() * m_scrollSpeed;
+    
+    // 各方向について範囲を超える最小の移動回数を求める
+    float endStep = kAKMaxStep;
+    if (m_linearVelocity.x < 0.0f) {
+        endStep = MIN(endStep, m_position.x < left ? 0.0f : floorf((left - m_position.x) / m_linearVelocity.x) + 1.0f);
+    }
+    else if (m_linearVelocity.x > 0.0f) {
+        endStep = MIN(endStep, m_position.x > right ? 0.0f : floorf((right - m_position.x) / m_linearVelocity.x) + 1.0f);
+    }
+    if (m_linearVelocity.y < 0.0f) {
+        endStep = MIN(endStep, m_position.y < bottom ? 0.0f : floorf((bottom - m_position.y) / m_linearVelocity.y) + 1.0f);
     }
+    else if (m_linearVelocity.y > 0.0f) {
+        endStep = MIN(endStep, m_position.y > top ? 0.0f : floorf((top - m_position.y) / m_linearVelocity.y) + 1.0f);
+    }
+    m_linearEndStep = (int)endStep;
     
-    // キャラクター固有の動作を行う
-    action(data);
+    AKLog(kAKLogCharacter_2, "等速直線移動開始:position=(%f,%f) velocity=(%f,%f) endStep=%d",
+          m_position.x, m_position.y, m_linearVelocity.x, m_linearVelocity.y, m_linearEndStep);
 }
 
 /*!
@@ -791,6 +1076,29 @@ bool AKCharacter::isOutOfStage(AKPlayDataInterface *data)
     }
 }
 
+/*!
+ @brief アニメーションパターンの画像表示
+ 
+ アニメーションパターンに応じて表示スプライトを変更する。
+ @param pattern アニメーションパターン
+ */
+void AKCharacter::setPatternImage(int pattern)
+{
+    // アニメーションパターンに応じて画像ファイル名を作成する
+    char imageFileName[32] = "";
+    snprintf(imageFileName,
+             sizeof(imageFileName),
+             kAKImageFileFormat,
+             m_imageName.c_str(),
+             pattern);
+    
+    AKLog(false, "imageFileName=%s", imageFileName);
+    
+    // 表示スプライトを変更する
+    SpriteFrameCache *spriteFrameCache = SpriteFrameCache::getInstance();
+    m_image->setSpriteFrame(spriteFrameCache->getSpriteFrameByName(imageFileName));
+}
+
 /*!
  @brief 画像表示位置更新
  
@@ -802,8 +1110,11 @@ void AKCharacter::updateImagePosition()
     float angle = AKAngle::convertAngleScr2Rad(m_image->getRotation());
     
     // 回転している方向に合わせて画像をずらす距離を計算する
-    float dx = m_offset.x * sinf(angle) + m_offset.y * cosf(angle);
-    float dy = - m_offset.x * cosf(angle) + m_offset.y * sinf(angle);
+    float sinValue = 0.0f;
+    float cosValue = 0.0f;
+    AKFastMath::calcSinCos(angle, &sinValue, &cosValue);
+    float dx = m_offset.x * sinValue + m_offset.y * cosValue;
+    float dy = - m_offset.x * cosValue + m_offset.y * sinValue;
     
     // 移動後の座標を計算する
     float x = AKScreenSize::xOfStage(m_position.x + dx);
@@ -61,9 +61,33 @@ enum AKBlockHitSide {
  当たり判定を持つオブジェクトの基本クラス。
  */
 class AKCharacter {
-public:
-    /// 衝突処理関数の型
-    using AKHitFunc = void (AKCharacter::*)(AKCharacter *character, AKPlayDataInterface *data);
+protected:
+    /// 衝突時処理なし
+    struct AKHitNone {
+        void operator()(AKCharacter *self, AKCharacter *character, AKPlayDataInterface *data) const {}
+    };
+    /// 衝突処理(自キャラの型を指定し、仮想関数を経由せずに呼び出す)
+    template<class S>
+    struct AKHit {
+        void operator()(AKCharacter *self, AKCharacter *character, AKPlayDataInterface *data) const
+        {
+            static_cast<S*>(self)->S::hit(character, data);
+        }
+    };
+    /// 障害物との衝突による移動
+    struct AKMoveOfBlockHit {
+        void operator()(AKCharacter *self, AKCharacter *character, AKPlayDataInterface *data) const
+        {
+            self->moveOfBlockHit(character, data);
+        }
+    };
+    /// 障害物との衝突による消滅
+    struct AKDisappearOfBlockHit {
+        void operator()(AKCharacter *self, AKCharacter *character, AKPlayDataInterface *data) const
+        {
+            self->disappearOfBlockHit(character, data);
+        }
+    };
     
 private:
     /// 画像
@@ -72,6 +96,14 @@ private:
     std::string m_imageName;
     /// アニメーション初期パターン
     int m_animationInitPattern;
+    /// 等速直線移動の基準位置
+    cocos2d::Vec2 m_linearBase;
+    /// 等速直線移動の速度(スクロールの影響を含む)
+    cocos2d::Vec2 m_linearVelocity;
+    /// 等速直線移動の基準位置からの移動回数
+    int m_linearStep;
+    /// 画面外に出るまでの移動回数(負の場合は未計算)
+    int m_linearEndStep;
     
 protected:
     /// 当たり判定サイズ幅
@@ -164,6 +196,12 @@ public:
     void setAnimationFrame(int frame);
     // キャラクターの削除
     void removeCharacter();
+    // 等速直線移動の再計算要求
+    void resetLinearMove();
+    // スナップショット書き込み
+    void writeSnapshot(AKSnapshotWriter *writer);
+    // スナップショット読み込み
+    bool readSnapshot(AKSnapshotReader *reader, cocos2d::Node *parent);
     
     /*!
      @brief 衝突判定(動作なし)
@@ -176,20 +214,23 @@ public:
     template<typename T>
     bool checkHitNoFunc(const std::vector<T*> &characters, AKPlayDataInterface *data)
     {
-        return checkHit(characters, data, NULL);
+        return checkHit(characters, data, AKHitNone());
     }
     
     /*!
      @brief キャラクター衝突判定
      
      キャラクターが衝突しているか調べ、衝突しているときはHPを減らす。
+     衝突処理は自キャラの型Sを指定して呼び出すため、仮想関数を経由せずに判定ループ内に展開される。
+     Sには自キャラの実際の型を指定すること。
      @param characters 判定対象のキャラクター群
      @param data ゲームデータ
+     @return 衝突したかどうか
      */
-    template<typename T>
+    template<class S, typename T>
     bool checkHit(const std::vector<T*> &characters, AKPlayDataInterface *data)
     {
-        return checkHit(characters, data, &AKCharacter::hit);
+        return checkHit(characters, data, AKHit<S>());
     }
      /*!
      @brief 障害物回避のための距離を調べる
@@ -318,6 +359,10 @@ protected:
     void setImageName(const std::string &imageName);
     // アニメーション初期パターンの設定
     void setAnimationInitPattern(int animationPattern);
+    // キャラクター共通の移動処理
+    bool moveCommon(AKPlayDataInterface *data);
+    // 等速直線移動
+    bool moveLinear(AKPlayDataInterface *data);
     // キャラクター固有の動作
     virtual void action(AKPlayDataInterface *data);
     // 破壊処理
@@ -337,13 +382,14 @@ protected:
      @brief 衝突判定(汎用)
      
      衝突判定を行う。衝突時にどのような処理を行うかをパラメータで指定する。
+     衝突時処理は関数オブジェクトで指定し、判定ループ内に展開できるようにする。
      @param characters 判定対象のキャラクター群
      @param data ゲームデータ
      @param func 衝突時処理
      @return 衝突したかどうか
      */
-    template<typename T>
-    bool checkHit(const std::vector<T*> &characters, AKPlayDataInterface *data, AKHitFunc func)
+    template<typename T, typename F>
+    bool checkHit(const std::vector<T*> &characters, AKPlayDataInterface *data, F func)
     {
         // 画面に配置されていない場合は処理しない
         if (!m_isStaged) {
@@ -414,17 +460,15 @@ protected:
                 (targetbottom < mytop)) {
                 
                 // 衝突処理を行う
-                if (func != NULL) {
-                    (this->*func)(target, data);
-                    
-                    // 衝突処理で位置が移動している可能性があるので位置情報を更新する
-                    myleft = m_position.x - m_size.width / 2.0f;
-                    myright = m_position.x + m_size.width / 2.0f;
-                    mytop = m_position.y + m_size.height / 2.0f;
-                    mybottom = m_position.y - m_size.height / 2.0f;
-                    
-//                    AKLog(AKGetDebugFlg(), "self (l, t)=(%.0f, %.0f) (r, b)=(%.0f, %.0f)", myleft, mytop, myright, mybottom);
-                }
+                func(this, target, data);
+                
+                // 衝突処理で位置が移動している可能性があるので位置情報を更新する
+                myleft = m_position.x - m_size.width / 2.0f;
+                myright = m_position.x + m_size.width / 2.0f;
+                mytop = m_position.y + m_size.height / 2.0f;
+                mybottom = m_position.y - m_size.height / 2.0f;
+                
+//                AKLog(AKGetDebugFlg(), "self (l, t)=(%.0f, %.0f) (r, b)=(%.0f, %.0f)", myleft, mytop, myright, mybottom);
                 
                 // 衝突したかどうかを記憶する
                 isHit = true;
@@ -434,7 +478,12 @@ protected:
         // 衝突したかどうかを返す
         return isHit;
     }
-
+    
+private:
+    // 等速直線移動の開始
+    void startLinearMove(AKPlayDataInterface *data);
+    // アニメーションパターンの画像表示
+    void setPatternImage(int pattern);
 };
 
 #endif
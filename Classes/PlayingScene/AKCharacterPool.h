@@ -62,16 +62,14 @@ public:
      @brief サイズを指定したコンストラクタ
      
      管理するプールのサイズを指定したコンストラクタ。
+     キャラクターの作成はcreateCharactersで行う。
      @param size 管理するプールのサイズ
      */
     AKCharacterPool(int size) :
     m_size(size), m_next(0)
     {
-        // キャラクターをあらかじめ作成しておく
-        for (int i = 0; i < m_size; i++) {
-            T *character = new T();
-            m_pool.push_back(character);
-        }
+        // 配列の領域のみ確保しておく
+        m_pool.reserve(m_size);
     }
     
     /*!
@@ -87,8 +85,54 @@ public:
         }
     }
     
-    // 全キャラクター削除
-    void reset();
+    /*!
+     @brief キャラクター作成
+     
+     プールのサイズに達するまで、指定数を上限にキャラクターを作成する。
+     シーン構築を複数フレームに分けるため、一度に作成する数を制限できるようにする。
+     @param count 作成する数の上限
+     @return 作成した数
+     */
+    int createCharacters(int count)
+    {
+        // 作成した数
+        int created = 0;
+        
+        // プールのサイズに達するか上限数に達するまでキャラクターを作成する
+        while (static_cast<int>(m_pool.size()) < m_size && created < count) {
+            T *character = new T();
+            m_pool.push_back(character);
+            created++;
+        }
+        
+        return created;
+    }
+    
+    /*!
+     @brief キャラクター作成完了判定
+     
+     プールのサイズ分のキャラクターを作成し終えたかどうかを判定する。
+     @return 作成し終えたかどうか
+     */
+    bool isCreated()
+    {
+        return static_cast<int>(m_pool.size()) >= m_size;
+    }
+    
+    /*!
+     @brief 全キャラクター削除
+     
+     配置中のキャラクターをすべて画面から取り除く。
+     */
+    void reset()
+    {
+        for (T *character : m_pool) {
+            if (character->isStaged()) {
+                character->removeCharacter();
+            }
+        }
+        m_next = 0;
+    }
 
     /*!
      @brief キャラクター配列取得
@@ -101,6 +145,67 @@ public:
         return &m_pool;
     }
     
+    /*!
+     @brief 配置中キャラクターの移動処理
+     
+     配置中のキャラクターの移動処理を行う。
+     プールには型Tのインスタンスのみが格納されているため、
+     仮想関数を経由せずにT::moveを直接呼び出す。
+     T::moveは固有の動作も型を指定して呼び出すため、
+     キャラクター固有の動作も仮想関数を経由せずに実行される。
+     @param data ゲームデータ
+     */
+    void update(AKPlayDataInterface *data)
+    {
+        for (T *character : m_pool) {
+            if (character->isStaged()) {
+                character->T::move(data);
+            }
+        }
+    }
+    
+    /*!
+     @brief スナップショット書き込み
+     
+     次にキャラクターを追加するインデックスと、すべてのキャラクターの状態を書き込む。
+     未使用のキャラクターは配置状態のみを書き込むため、配置数に比例したサイズになる。
+     @param writer 書き込み先
+     */
+    void writeSnapshot(AKSnapshotWriter *writer)
+    {
+        writer->write(m_next);
+        for (T *character : m_pool) {
+            character->writeSnapshot(writer);
+        }
+    }
+    
+    /*!
+     @brief スナップショット読み込み
+     
+     writeSnapshotで書き込んだ状態を読み込む。
+     配置中のキャラクターの画像は指定された親ノードに配置し直す。
+     @param reader 読み込み元
+     @param parent 画像を配置する親ノード
+     @return 読み込めたかどうか
+     */
+    bool readSnapshot(AKSnapshotReader *reader, cocos2d::Node *parent)
+    {
+        int next = 0;
+        if (!reader->read(&next) || next < 0 || next >= m_size) {
+            reader->setError();
+            return false;
+        }
+        m_next = next;
+        
+        for (T *character : m_pool) {
+            if (!character->readSnapshot(reader, parent)) {
+                return false;
+            }
+        }
+        
+        return true;
+    }
+    
     /*!
      @brief 未使用キャラクター取得
      
@@ -132,6 +237,39 @@ public:
         
         return ret;
     }
+    
+    /*!
+     @brief 未使用キャラクターの一括取得
+     
+     キャラクタープールの中から未使用のキャラクターを指定数分検索して返す。
+     プールの走査は1周のみ行い、見つかった分だけ配列に格納する。
+     @param count 取得する数
+     @param characters 取得したキャラクターを格納する配列
+     @return 取得できた数
+     */
+    int getNext(int count, T **characters)
+    {
+        // 取得できた数
+        int found = 0;
+        
+        // 未使用のキャラクターを検索する
+        for (int i = 0; i < m_size && found < count; i++) {
+            
+            // キャラクターを取得する
+            T *work = m_pool[m_next];
+            
+            // インデックスを進める
+            m_next = (m_next + 1) % m_size;
+            
+            // 使用中でなければ戻り値に追加する
+            if (!work->isStaged()) {
+                characters[found] = work;
+                found++;
+            }
+        }
+        
+        return found;
+    }
 };
 
 #endif
\ No newline at end of file
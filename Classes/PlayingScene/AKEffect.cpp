@@ -90,6 +90,56 @@ void AKEffect::createEffect(int type, const Vec2 &position, Node *parent)
     parent->addChild(getImage());
 }
 
+/*!
+ @brief スナップショット書き込み
+ 
+ キャラクター共通の状態に続けて生存フレーム数を書き込む。
+ @param writer 書き込み先
+ */
+void AKEffect::writeSnapshot(AKSnapshotWriter *writer)
+{
+    AKCharacter::writeSnapshot(writer);
+    if (m_isStaged) {
+        writer->write(m_lifeFrame);
+    }
+}
+
+/*!
+ @brief スナップショット読み込み
+ 
+ writeSnapshotで書き込んだ状態を読み込む。
+ @param reader 読み込み元
+ @param parent 画面効果を配置する親ノード
+ @return 読み込めたかどうか
+ */
+bool AKEffect::readSnapshot(AKSnapshotReader *reader, Node *parent)
+{
+    if (!AKCharacter::readSnapshot(reader, parent)) {
+        return false;
+    }
+    if (m_isStaged) {
+        return reader->read(&m_lifeFrame);
+    }
+    return true;
+}
+
+/*!
+ @brief 移動処理
+ 
+ キャラクター共通の移動処理を行い、続けて画面効果固有の動作を行う。
+ 固有の動作は仮想関数を経由せずに呼び出し、インライン展開できるようにする。
+ @param data ゲームデータ
+ */
+void AKEffect::move(AKPlayDataInterface *data)
+{
+    // キャラクター共通の移動処理を行う
+    if (moveCommon(data)) {
+        
+        // 画面効果固有の動作を行う
+        AKEffect::action(data);
+    }
+}
+
 /*!
  @brief キャラクター固有の動作
  
@@ -64,8 +64,14 @@ protected:
     // キャラクター固有の動作
     virtual void action(AKPlayDataInterface *data);
 public:
+    // 移動処理
+    virtual void move(AKPlayDataInterface *data);
     // 画面効果開始
     void createEffect(int type, const cocos2d::Vec2 &position, cocos2d::Node *parent);
+    // スナップショット書き込み
+    void writeSnapshot(AKSnapshotWriter *writer);
+    // スナップショット読み込み
+    bool readSnapshot(AKSnapshotReader *reader, cocos2d::Node *parent);
 };
 
 #endif
@@ -33,6 +33,7 @@
  敵キャラクターのクラスの定義をする。
  */
 
+#include <chrono>
 #include "AKEnemy.h"
 #include "AKEnemyShot.h"
 #include "AKBlock.h"
@@ -40,7 +41,11 @@
 using cocos2d::Vec2;
 using cocos2d::Size;
 using cocos2d::Node;
-using CocosDenshion::SimpleAudioEngine;
+#ifdef DEBUG
+using std::chrono::steady_clock;
+using std::chrono::duration_cast;
+using std::chrono::nanoseconds;
+#endif
 
 /// 敵種別定義
 struct AKEnemyDef {
@@ -92,29 +97,29 @@ enum AKEnemyType {
 /// 敵の定義
 const struct AKEnemyDef AKEnemy::kAKEnemyDef[kAKEnemyDefCount] = {
     // 動作,破壊,画像,フレーム数,フレーム間隔,幅,高さ,オフセットX,オフセットY,移動履歴,HP,防御力,スコア,ボスフラグ
-    {&AKEnemy::actionOfDragonfly, &AKEnemy::destroyNormal, 1, 2, 30, 32, 32, 0, 0, 0, 3, 0, 100, 0},    // トンボ
-    {&AKEnemy::actionOfAnt, &AKEnemy::destroyNormal, 2, 2, 30, 32, 16, 0, 0, 0, 7, 0, 200, 0},          // アリ
-    {&AKEnemy::actionOfButterfly, &AKEnemy::destroyNormal, 3, 2, 30, 32, 32, 0, 0, 0, 10, 0, 200, 0},   // チョウ
-    {&AKEnemy::actionOfLadybug, &AKEnemy::destroyNormal, 4, 2, 6, 32, 32, 0, 0, 0, 18, 0, 200, 0},      // テントウムシ
+    {&AKEnemy::actionOfScript, &AKEnemy::destroyNormal, 1, 2, 30, 32, 32, 0, 0, 0, 3, 0, 100, 0},       // トンボ
+    {&AKEnemy::actionOfScript, &AKEnemy::destroyNormal, 2, 2, 30, 32, 16, 0, 0, 0, 7, 0, 200, 0},       // アリ
+    {&AKEnemy::actionOfScript, &AKEnemy::destroyNormal, 3, 2, 30, 32, 32, 0, 0, 0, 10, 0, 200, 0},      // チョウ
+    {&AKEnemy::actionOfScript, &AKEnemy::destroyNormal, 4, 2, 6, 32, 32, 0, 0, 0, 18, 0, 200, 0},       // テントウムシ
     {NULL, NULL, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},   // 予備5
     {NULL, NULL, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},   // 予備6
     {NULL, NULL, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},   // 予備7
     {NULL, NULL, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},   // 予備8
     {NULL, NULL, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},   // 予備9
     {NULL, NULL, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},   // 予備10
-    {&AKEnemy::actionOfBagworm, &AKEnemy::destroyNormal, 11, 1, 0, 32, 32, 0, 0, 0, 30, 0, 300, 0},     // ミノムシ
-    {&AKEnemy::actionOfCicada, &AKEnemy::destroyNormal, 12, 1, 0, 32, 32, 0, 0, 0, 20, 0, 200, 0},      // セミ
-    {&AKEnemy::actionOfGrasshopper, &AKEnemy::destroyNormal, 13, 1, 0, 32, 32, 0, 0, 0, 9, 0, 200, 0},  // バッタ
-    {&AKEnemy::actionOfHornet, &AKEnemy::destroyNormal, 14, 2, 6, 32, 32, 0, 0, 0, 12, 0, 200, 0},      // ハチ
+    {&AKEnemy::actionOfScript, &AKEnemy::destroyNormal, 11, 1, 0, 32, 32, 0, 0, 0, 30, 0, 300, 0},      // ミノムシ
+    {&AKEnemy::actionOfScript, &AKEnemy::destroyNormal, 12, 1, 0, 32, 32, 0, 0, 0, 20, 0, 200, 0},      // セミ
+    {&AKEnemy::actionOfScript, &AKEnemy::destroyNormal, 13, 1, 0, 32, 32, 0, 0, 0, 9, 0, 200, 0},       // バッタ
+    {&AKEnemy::actionOfScript, &AKEnemy::destroyNormal, 14, 2, 6, 32, 32, 0, 0, 0, 12, 0, 200, 0},      // ハチ
     {NULL, NULL, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},   // 予備15
     {NULL, NULL, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},   // 予備16
     {NULL, NULL, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},   // 予備17
     {NULL, NULL, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},   // 予備18
     {NULL, NULL, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},   // 予備19
     {NULL, NULL, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},   // 予備20
-    {&AKEnemy::actionOfCockroach, &AKEnemy::destroyNormal, 21, 2, 6, 32, 32, 0, 0, 0, 15, 0, 300, 0},   // ゴキブリ
-    {&AKEnemy::actionOfSnail, &AKEnemy::destroyNormal, 22, 2, 30, 32, 32, 0, 0, 0, 13, 0, 200, 0},      // カタツムリ
-    {&AKEnemy::actionOfStagBeetle, &AKEnemy::destroyNormal, 23, 2, 6, 32, 32, 0, 0, 0, 20, 0, 300, 0},  // クワガタ
+    {&AKEnemy::actionOfScript, &AKEnemy::destroyNormal, 21, 2, 6, 32, 32, 0, 0, 0, 15, 0, 300, 0},      // ゴキブリ
+    {&AKEnemy::actionOfScript, &AKEnemy::destroyNormal, 22, 2, 30, 32, 32, 0, 0, 0, 13, 0, 200, 0},     // カタツムリ
+    {&AKEnemy::actionOfScript, &AKEnemy::destroyNormal, 23, 2, 6, 32, 32, 0, 0, 0, 20, 0, 300, 0},      // クワガタ
     {NULL, NULL, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},   // 予備24
     {NULL, NULL, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},   // 予備25
     {NULL, NULL, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},   // 予備26
@@ -150,29 +155,12 @@ void AKEnemy::fireNWay(Vec2 position,
                        float speed,
                        AKPlayDataInterface *data)
 {
-    // n-way弾の各弾の角度を計算する
-    AKNWayAngle nWayAngle(position,
-                          *data->getPlayerPosition(),
-                          count,
-                          interval);
+    // 自機狙いの弾発射パターンを作成する
+    struct AKShotPattern pattern = AKShotEmitter::makePattern(count, interval, speed);
+    pattern.aim = kAKShotAimPlayer;
     
     // 各弾を発射する
-    for (float angle : *nWayAngle.getAngles()) {
-        
-        // 敵弾インスタンスを取得する
-        AKEnemyShot *enemyShot = data->getEnemyShot();
-        
-        // 取得できない場合は処理しない
-        if (enemyShot == NULL) {
-            break;
-        }
-        
-        // 通常弾を生成する
-        enemyShot->createNormalShot(position,
-                                    angle,
-                                    speed,
-                                    data->getEnemyShotParent());
-    }
+    AKShotEmitter::fire(pattern, position, data);
 }
 
 /*!
@@ -195,38 +183,13 @@ void AKEnemy::fireNWay(float angle,
                        bool isScroll,
                        AKPlayDataInterface *data)
 {
-    // n-way弾の各弾の角度を計算する
-    AKNWayAngle nWayAngle(angle,
-                          count,
-                          interval);
+    // 角度指定の弾発射パターンを作成する
+    struct AKShotPattern pattern = AKShotEmitter::makePattern(count, interval, speed);
+    pattern.angle = angle;
+    pattern.isScroll = isScroll;
     
     // 各弾を発射する
-    for (float angle : *nWayAngle.getAngles()) {
-
-        // 敵弾インスタンスを取得する
-        AKEnemyShot *enemyShot = data->getEnemyShot();
-        
-        // 取得できない場合は処理しない
-        if (enemyShot == NULL) {
-            break;
-        }
-        
-        // スクロールの影響を受けるかどうかで弾の種別を変える
-        if (isScroll) {
-            // スクロール影響弾を生成する
-            enemyShot->createScrollShot(position,
-                                        angle,
-                                        speed,
-                                        data->getEnemyShotParent());
-        }
-        else {
-            // 通常弾を生成する
-            enemyShot->createNormalShot(position,
-                                        angle,
-                                        speed,
-                                        data->getEnemyShotParent());
-        }
-    }
+    AKShotEmitter::fire(pattern, position, data);
 }
 
 /*!
@@ -246,31 +209,13 @@ void AKEnemy::fireGroupShot(Vec2 position,
                             float speed,
                             AKPlayDataInterface *data)
 {
-    // 弾の角度を計算する
-    AKNWayAngle nWayAngle(position,
-                          *data->getPlayerPosition(),
-                          1,
-                          0.0f);
+    // 弾の間の角度を0とし、各弾の位置をずらした自機狙いの弾発射パターンを作成する
+    struct AKShotPattern pattern = AKShotEmitter::makePattern(count, 0.0f, speed);
+    pattern.aim = kAKShotAimPlayer;
+    pattern.offset = distance;
     
-    // 各弾の位置に通常弾を生成する
-    for (int i = 0; i < count; i++) {
-
-        // 敵弾インスタンスを取得する
-        AKEnemyShot *enemyShot = data->getEnemyShot();
-        
-        // 取得できない場合は処理しない
-        if (enemyShot == NULL) {
-            break;
-        }
-        
-        // 通常弾を生成する
-        Vec2 shotPosition(position.x + distance[i][0],
-                             position.y + distance[i][1]);
-        enemyShot->createNormalShot(shotPosition,
-                                    nWayAngle.getTopAngle(),
-                                    speed,
-                                    data->getEnemyShotParent());
-    }
+    // 各弾を発射する
+    AKShotEmitter::fire(pattern, position, data);
 }
 
 /*!
@@ -296,38 +241,16 @@ void AKEnemy::fireBurstShot(Vec2 position,
     // 中心点からの弾の距離
     const float kAKDistance = 4.0f;
     
-    // 破裂弾弾全体の角度を計算する
-    AKNWayAngle centerAngle(position,
-                            *data->getPlayerPosition(),
-                            1,
-                            0.0f);
-    
-    // 個別の弾の角度を計算する
-    AKNWayAngle burstAngle(M_PI, count, interval);
+    // 自機に向かって一塊で進み、破裂後に散開する弾発射パターンを作成する
+    struct AKShotPattern pattern = AKShotEmitter::makePattern(count, interval, speed);
+    pattern.aim = kAKShotAimPlayer;
+    pattern.angle = M_PI;
+    pattern.distance = kAKDistance;
+    pattern.delay = burstInterval;
+    pattern.delaySpeed = burstSpeed;
     
     // 各弾を発射する
-    for (float angle : *burstAngle.getAngles()) {
-        
-        // 敵弾インスタンスを取得する
-        AKEnemyShot *enemyShot = data->getEnemyShot();
-        
-        // 取得できない場合は処理しない
-        if (enemyShot == NULL) {
-            break;
-        }
-        
-        // 破裂弾を生成する
-        Vec2 shotPosition(position.x + cosf(angle) * kAKDistance,
-                             position.y + sinf(angle) * kAKDistance);
-        enemyShot->createChangeSpeedShot(shotPosition,
-                                        centerAngle.getTopAngle(),
-                                        speed,
-                                        burstInterval,
-                                        angle,
-                                        burstSpeed,
-                                        data->getEnemyShotParent());
-
-    }
+    AKShotEmitter::fire(pattern, position, data);
 }
 
 /*!
@@ -571,6 +494,7 @@ void AKEnemy::createEnemy(int type,
     AKLog(kAKLogEnemy_1, "start createEnemy():type=%d", type); 
 
     // パラメータの内容をメンバに設定する
+    m_type = type;
     m_position = position;
     m_progress = progress;
     
@@ -589,14 +513,20 @@ void AKEnemy::createEnemy(int type,
     m_parentEnemy = NULL;
     m_childEnemy = NULL;
     m_blockHitAction = kAKBlockHitNone;
-    while (!m_moveHistory.empty()) {
-        m_moveHistory.pop();
-    }
+    m_moveHistory.clear();
     m_isDead = false;
     m_destroyframe = 0;
     setAnimationInitPattern(1);
     m_isFlippedX = false;
     m_isFlippedY = false;
+    m_scriptPC = 0;
+    m_scriptWait = 0;
+    m_scriptLoop = 0;
+    m_scriptMode = kAKScriptModeNone;
+    m_scriptAccel = Vec2::ZERO;
+    m_scriptTimerInterval = 0;
+    m_scriptTimerPC = 0;
+    AKCoroutineReset(m_coroutine);
     
     AKAssert(type > 0 && type <= kAKEnemyDefCount, "敵の種類の値が範囲外:%d", type);
     
@@ -605,6 +535,9 @@ void AKEnemy::createEnemy(int type,
     
     // 破壊処理を設定する
     m_destroy = kAKEnemyDef[type - 1].destroy;
+    
+    // 動作スクリプトを設定する
+    m_script = AKEnemyScriptTable::getScript(type);
         
     // 画像名を作成する
     char imageName[16] = "";
@@ -627,6 +560,7 @@ void AKEnemy::createEnemy(int type,
     
     // 移動履歴を保存する個数を設定する
     m_historyCount = kAKEnemyDef[type - 1].historyCount;
+    AKAssert(m_historyCount <= kAKEnemyHistoryMax, "移動履歴の保存数が最大値を超えている:%d", m_historyCount);
     
     // ヒットポイントを設定する
     m_hitPoint = kAKEnemyDef[type - 1].hitPoint;
@@ -655,6 +589,17 @@ void AKEnemy::createEnemy(int type,
     parent->addChild(getImage());
 }
 
+/*!
+ @brief 親キャラクター取得
+ 
+ 親キャラクターを取得する。
+ @return 親キャラクター
+ */
+AKEnemy* AKEnemy::getParentEnemy()
+{
+    return m_parentEnemy;
+}
+
 /*!
  @brief 親キャラクター設定
  
@@ -666,6 +611,17 @@ void AKEnemy::setParentEnemy(AKEnemy *parent)
     m_parentEnemy = parent;
 }
 
+/*!
+ @brief 子キャラクター取得
+ 
+ 子キャラクターを取得する。
+ @return 子キャラクター
+ */
+AKEnemy* AKEnemy::getChildEnemy()
+{
+    return m_childEnemy;
+}
+
 /*!
  @brief 小キャラクター設定
  
@@ -694,7 +650,7 @@ void AKEnemy::setState(int state)
  移動履歴を取得する。
  @return 移動履歴
  */
-const std::queue<cocos2d::Vec2>* AKEnemy::getMoveHistory()
+const AKEnemy::AKMoveHistory* AKEnemy::getMoveHistory()
 {
     return &m_moveHistory;
 }
@@ -710,6 +666,185 @@ bool AKEnemy::isBoss() const
     return m_boss;
 }
 
+/*!
+ @brief スナップショットのビルド識別子取得
+ 
+ コルーチンの再開位置はこのファイルの行番号、動作スクリプトの実行位置は命令列の位置のため、
+ いずれかが変わると以前のスナップショットは正しく復元できない。
+ このファイルのビルド日時と動作スクリプトの内容からハッシュ値を計算し、
+ スナップショットが同じビルドで書き込まれたものかを判定する識別子とする。
+ @return ビルド識別子
+ */
+unsigned int AKEnemy::getSnapshotBuildId()
+{
+    // ビルド日時のハッシュ値の計算は初回のみ行う
+    static const unsigned int buildHash = AKCalcHash(__DATE__ " " __TIME__,
+                                                     sizeof(__DATE__ " " __TIME__),
+                                                     kAKHashOffsetBasis);
+    
+    // 動作スクリプトはファイルから読み込むため、読み込んだ内容のハッシュ値と組み合わせる
+    unsigned int scriptHash = AKEnemyScriptTable::getHash();
+    return AKCalcHash(&scriptHash, sizeof(scriptHash), buildHash);
+}
+
+/*!
+ @brief スナップショット書き込み
+ 
+ キャラクター共通の状態に続けて、敵固有の状態を書き込む。
+ 動作処理、破壊処理、動作スクリプトは敵種別から復元するため書き込まない。
+ 親キャラクター、子キャラクターはプール内の位置で表すため、プールを持つ側で書き込む。
+ コルーチンの再開位置は行番号のため、同じビルドでのみ復元できる。
+ ビルドの判定はgetSnapshotBuildIdの値をプールを持つ側で書き込んで行う。
+ @param writer 書き込み先
+ */
+void AKEnemy::writeSnapshot(AKSnapshotWriter *writer)
+{
+    AKCharacter::writeSnapshot(writer);
+    if (!m_isStaged) {
+        return;
+    }
+    
+    // 敵種別と動作状態を書き込む
+    writer->write(m_type);
+    writer->write(m_frame);
+    writer->write(m_state);
+    writer->write(m_work);
+    writer->write(m_destroyframe);
+    writer->write(m_score);
+    writer->write(m_progress);
+    
+    // 移動履歴を古い順に書き込む
+    writer->write(m_historyCount);
+    writer->write(m_moveHistory.size());
+    for (int i = m_moveHistory.size() - 1; i >= 0; i--) {
+        writer->write(m_moveHistory.lookback(i));
+    }
+    
+    // 動作スクリプト、コルーチンの実行状態を書き込む
+    writer->write(m_scriptPC);
+    writer->write(m_scriptWait);
+    writer->write(m_scriptLoop);
+    writer->write(m_scriptMode);
+    writer->write(m_scriptAccel);
+    writer->write(m_scriptTimerInterval);
+    writer->write(m_scriptTimerPC);
+    writer->write(m_coroutine);
+    
+    // フラグを書き込む
+    writer->write(m_boss);
+    writer->write(m_isDead);
+    writer->write(m_isFlippedX);
+    writer->write(m_isFlippedY);
+}
+
+/*!
+ @brief スナップショット読み込み
+ 
+ writeSnapshotで書き込んだ状態を読み込む。
+ 親キャラクター、子キャラクターはクリアするため、読み込み後にプールを持つ側で設定すること。
+ @param reader 読み込み元
+ @param parent 配置する親ノード
+ @return 読み込めたかどうか
+ */
+bool AKEnemy::readSnapshot(AKSnapshotReader *reader, Node *parent)
+{
+    m_parentEnemy = NULL;
+    m_childEnemy = NULL;
+    
+    if (!AKCharacter::readSnapshot(reader, parent)) {
+        return false;
+    }
+    if (!m_isStaged) {
+        return true;
+    }
+    
+    // 敵種別と動作状態を読み込む
+    reader->read(&m_type);
+    reader->read(&m_frame);
+    reader->read(&m_state);
+    reader->read(&m_work);
+    reader->read(&m_destroyframe);
+    reader->read(&m_score);
+    reader->read(&m_progress);
+    
+    // 移動履歴を読み込む
+    int historySize = 0;
+    reader->read(&m_historyCount);
+    reader->read(&historySize);
+    if (historySize < 0 || historySize > kAKEnemyHistoryMax) {
+        reader->setError();
+    }
+    m_moveHistory.clear();
+    for (int i = 0; i < historySize && !reader->isError(); i++) {
+        Vec2 position;
+        reader->read(&position);
+        m_moveHistory.push(position);
+    }
+    
+    // 動作スクリプト、コルーチンの実行状態を読み込む
+    reader->read(&m_scriptPC);
+    reader->read(&m_scriptWait);
+    reader->read(&m_scriptLoop);
+    reader->read(&m_scriptMode);
+    reader->read(&m_scriptAccel);
+    reader->read(&m_scriptTimerInterval);
+    reader->read(&m_scriptTimerPC);
+    reader->read(&m_coroutine);
+    
+    // フラグを読み込む
+    reader->read(&m_boss);
+    reader->read(&m_isDead);
+    reader->read(&m_isFlippedX);
+    reader->read(&m_isFlippedY);
+    
+    // 敵種別が範囲外の場合はエラーとする
+    if (m_type <= 0 || m_type > kAKEnemyDefCount) {
+        reader->setError();
+    }
+    if (reader->isError()) {
+        AKLog(kAKLogEnemy_1, "スナップショットの読み込みに失敗:type=%d", m_type);
+        return false;
+    }
+    
+    // 敵種別から動作処理、破壊処理、動作スクリプトを設定する
+    m_action = kAKEnemyDef[m_type - 1].action;
+    m_destroy = kAKEnemyDef[m_type - 1].destroy;
+    m_script = AKEnemyScriptTable::getScript(m_type);
+    
+    // スクリプトの実行位置が命令列の範囲外の場合はエラーとする
+    // スクリプトを使用しない敵種別の場合は実行位置は先頭のままのはずである
+    int codeCount = (m_script != NULL ? m_script->codeCount : 1);
+    if (m_scriptPC < 0 || m_scriptPC >= codeCount || m_scriptWait < 0 || m_scriptLoop < 0 ||
+        (m_scriptMode & ~kAKScriptModeAll) != 0 || m_scriptTimerInterval < 0 ||
+        m_scriptTimerPC < 0 || m_scriptTimerPC >= codeCount) {
+        AKLog(kAKLogEnemy_1, "スクリプトの実行状態が不正:type=%d pc=%d wait=%d loop=%d mode=%d timer=%d,%d",
+              m_type, m_scriptPC, m_scriptWait, m_scriptLoop, m_scriptMode,
+              m_scriptTimerInterval, m_scriptTimerPC);
+        reader->setError();
+        return false;
+    }
+    
+    return true;
+}
+
+/*!
+ @brief 移動処理
+ 
+ キャラクター共通の移動処理を行い、続けて敵キャラ固有の動作を行う。
+ 固有の動作は仮想関数を経由せずに呼び出す。
+ 動作内容は敵種別ごとに異なるため、その先は動作処理のメンバ関数ポインタを経由する。
+ @param data ゲームデータ
+ */
+void AKEnemy::move(AKPlayDataInterface *data)
+{
+    // キャラクター共通の移動処理を行う
+    if (moveCommon(data)) {
+        
+        // 敵キャラ固有の動作を行う
+        AKEnemy::action(data);
+    }
+}
+
 /*!
  @brief キャラクター固有の動作
 
@@ -779,932 +914,296 @@ void AKEnemy::destroy(AKPlayDataInterface *data)
 }
 
 /*!
- @brief トンボの動作処理
- 
- まっすぐ進む。一定間隔で左方向へ1-way弾発射。
- @param data ゲームデータ
- */
-void AKEnemy::actionOfDragonfly(AKPlayDataInterface *data)
-{
-    // 弾のスピード
-    const float kAKShotSpeed = 1.5f;
-    // 移動スピード
-    const float kAKMoveSpeed = -1.0f;
-    // 弾発射間隔
-    const int kAKShotInterval = data->is2ndLoop() ? 60 : 120;
-
-    // 左へ直進する
-    m_speedX = kAKMoveSpeed;
-    m_speedY = 0.0f;
-    
-    // 一定時間経過しているときは左方向へ1-way弾を発射する
-    if ((m_frame + 1) % kAKShotInterval == 0) {
-        
-        // 左へ弾を発射する
-        AKEnemy::fireNWay(M_PI,
-                          Vec2(m_position.x, m_position.y),
-                          1,
-                          0.0f,
-                          kAKShotSpeed,
-                          false,
-                          data);
-    }
-}
-
-/*!
- @brief アリの動作処理
- 
- 天井または地面に張り付いて歩く。
- 
- 初期状態:上下どちらに張り付くか判定する。距離の近い方に張り付く。
- 天井に張り付く場合は画像を上下反転する。
- 
- 左移動:左方向への移動。一定時間経過後に弾発射に遷移する。
- 
- 弾発射:停止して弾の発射。自機に向かって1-wayを一定数発射する。
- 一定時間経過後に右移動に遷移する。
- 
- 右移動:地面右方向への移動。一定時間経過後に弾発射に遷移する。
- 
- @param data ゲームデータ
- */
-void AKEnemy::actionOfAnt(AKPlayDataInterface *data)
-{
-    // 弾のスピード
-    const float kAKShotSpeed = 1.0f;
-    // 移動スピード
-    const float kAKMoveSpeed = 1.0f;
-    // 移動するフレーム数
-    const int kAKMoveFrame = 120;
-    // 弾発射間隔
-    const int kAKShotInterval = 30;
-    // 弾発射時間
-    const int kAKShotFrame = 120;
-    
-    // 状態
-    enum STATE {
-        kAKStateInit = 0,           // 初期状態
-        kAKStateLeftMove,           // 左移動
-        kAKStateRightMove,          // 右移動
-        kAKStateFire                // 弾発射
-    };
-
-    // 縦方向の速度は状態にかかわらず0とする
-    m_speedY = 0.0f;
-    
-    // スクロールに合わせて移動する
-    m_scrollSpeed = 1.0f;
-    
-    // 状態によって処理を分岐する
-    switch (m_state) {
-        case kAKStateInit:     // 初期状態
-            
-            // 逆さま判定を行う
-            checkReverse(*data->getBlocks());
-            
-            // 左移動に遷移する
-            m_state = kAKStateLeftMove;
-            
-            break;
-            
-        case kAKStateLeftMove:  // 左移動
-            
-            // スピードをマイナスにして、左右反転はなしにする
-            m_speedX = -kAKMoveSpeed;
-            m_isFlippedX = false;
-            setAnimationInitPattern(getInitPatternByIsFlipped(m_isFlippedX, m_isFlippedY));
-            
-            // 移動フレーム数が経過したら弾発射に遷移する
-            if ((m_frame - m_work[0] + 1) % kAKMoveFrame == 0) {
-
-                m_state = kAKStateFire;
-                
-                // 作業領域に状態遷移した時のフレーム数を保存する
-                m_work[0] = m_frame;
-            }
-
-            break;
-
-        case kAKStateRightMove: // 右移動
-            
-            // スピードをプラスにして、左右反転はありにする
-            m_speedX = kAKMoveSpeed;
-            m_isFlippedX = true;
-            setAnimationInitPattern(getInitPatternByIsFlipped(m_isFlippedX, m_isFlippedY));
-            
-            // 移動フレーム数が経過したら弾発射に遷移する
-            if ((m_frame - m_work[0] + 1) % kAKMoveFrame == 0) {
-
-                m_state = kAKStateFire;
-                
-                // 作業領域に状態遷移した時のフレーム数を保存する
-                m_work[0] = m_frame;
-            }
-            
-            break;
-                        
-        case kAKStateFire:  // 弾発射
-            
-            // 自分より右側に自機がいれば左右反転する
-            if (m_position.x < data->getPlayerPosition()->x) {
-                m_isFlippedX = true;
-                setAnimationInitPattern(getInitPatternByIsFlipped(m_isFlippedX, m_isFlippedY));
-            }
-            else {
-                m_isFlippedX = false;
-                setAnimationInitPattern(getInitPatternByIsFlipped(m_isFlippedX, m_isFlippedY));
-            }
-
-            // 待機する
-            m_speedX = 0.0f;
-            
-            // 弾発射時間が経過している場合は右移動へ遷移する
-            if ((m_frame - m_work[0] + 1) % kAKShotFrame == 0) {
-                
-                m_state = kAKStateRightMove;
-                
-                // 作業領域に状態遷移した時のフレーム数を保存する
-                m_work[0] = m_frame;
-                
-            }
-            // 弾発射間隔が経過している場合は弾を発射する
-            else if ((m_frame - m_work[0] + 1) % kAKShotInterval == 0) {
-                
-                // 自機へ向けて弾を発射する
-                AKEnemy::fireNWay(m_position,
-                                  1,
-                                  0.0f,
-                                  kAKShotSpeed,
-                                  data);
-                
-                // 2周めの場合は画面中央に向けて3-Way弾を発射する
-                if (data->is2ndLoop()) {
-                    
-                    AKEnemy::fireNWay(m_isFlippedY ? 3 * M_PI / 2.0f : M_PI / 2.0f,
-                                      Vec2(m_position.x, m_position.y),
-                                      3,
-                                      M_PI / 8.0f,
-                                      kAKShotSpeed,
-                                      true,
-                                      data);
-
-                }
-            }
-            
-            break;
-            
-        default:
-            AKAssert(false, "状態が異常:m_state=%d", m_state);
-            break;
-    }
-        
-    // 障害物との衝突判定を行う
-    m_position = AKEnemy::checkBlockPosition(m_position,
-                                             getImage()->getContentSize(),
-                                             m_isFlippedY,
-                                             data);
-    
-    // 画像表示位置の更新を行う
-    updateImagePosition();
-}
-
-
-/*!
- @brief チョウの動作処理
- 
- 上下に斜めに移動しながら左へ進む。
- 定周期で左方向へ3-way弾を発射する。
- @param data ゲームデータ
- */
-void AKEnemy::actionOfButterfly(AKPlayDataInterface *data)
-{
-    // 状態
-    enum STATE {
-        kAKStateInit = 0,   // 初期状態
-        kAKStateUpMove,     // 上移動
-        kAKStateDownMove    // 下移動
-    };
-
-    // 上下方向転換の間隔
-    const int kAKChangeDirectionInterval = 50;
-    // 弾発射間隔
-    const int kAKShotInterval = 60;
-    // x方向の移動スピード
-    const float kAKMoveSpeedX = -1.0f;
-    // y方向の移動スピード
-    const float kAKMoveSpeedY = 1.5f;
-    // 弾のスピード
-    const float kAKShotSpeed = 1.5f;
-    
-    // 初期状態の場合
-    if (m_state == kAKStateInit) {
-
-        // 左方向への速度を決める
-        m_speedX = kAKMoveSpeedX;
-        
-        // 最初は上向きの移動とする
-        m_state = kAKStateUpMove;
-    }
-    
-    // 上下方向転換の間隔経過している場合は上下の移動方向の状態を逆にする
-    if ((m_frame + 1) % kAKChangeDirectionInterval == 0) {
-        
-        if (m_state == kAKStateUpMove) {
-            m_state = kAKStateDownMove;
-        }
-        else {
-            m_state = kAKStateUpMove;
-        }
-    }
-    
-    // 状態に応じて上下の移動方向を決める
-    if (m_state == kAKStateUpMove) {
-        m_speedY = kAKMoveSpeedY;
-    }
-    else {
-        m_speedY = -kAKMoveSpeedY;
-    }
-    
-    // 弾発射間隔経過しているときは左方向へ弾を発射する
-    if ((m_frame + 1) % kAKShotInterval == 0) {
-        
-        // 1周目は3-Way弾を発射する
-        // 2周目は5-Way弾を発射する
-        if (!data->is2ndLoop()) {
-            
-            AKEnemy::fireNWay(M_PI,
-                              m_position,
-                              3,
-                              M_PI / 8.0f,
-                              kAKShotSpeed,
-                              false,
-                              data);
-        }
-        else {
-
-            AKEnemy::fireNWay(M_PI,
-                              m_position,
-                              5,
-                              M_PI / 16.0f,
-                              kAKShotSpeed,
-                              false,
-                              data);
-        }
-    }
-}
-
-/*!
- @brief テントウムシの動作処理
- 
- まっすぐ進む。一定間隔で自機を狙う1-way弾発射。
- @param data ゲームデータ
- */
-void AKEnemy::actionOfLadybug(AKPlayDataInterface *data)
-{
-    // 弾発射間隔
-    const int kAKShotInterval = 60;
-    // 移動スピード
-    const float kAKMoveSpeed = -1.3f;
-    // 弾のスピード
-    const float kAKShotSpeed = 1.5f;
-
-    // 左へ直進する
-    m_speedX = kAKMoveSpeed;
-    m_speedY = 0.0f;
-    
-    // 弾発射間隔経過しているときは自機を狙う弾を発射する
-    if ((m_frame + 1) % kAKShotInterval == 0) {
-        
-        // 1周目は1-Way弾を発射する
-        // 2周目は3-Way弾を発射する
-        if (!data->is2ndLoop()) {
-            AKEnemy::fireNWay(m_position,
-                          1,
-                          0.0f,
-                          kAKShotSpeed,
-                          data);
-        }
-        else {
-            AKEnemy::fireNWay(m_position,
-                              3,
-                              M_PI / 16.0f,
-                              kAKShotSpeed,
-                              data);
-        }
-    }
-}
-
-/*!
- @brief ミノムシの動作処理
- 
- スクロールスピードに合わせて移動する。一定時間で全方位に12-way弾を発射する。
- @param data ゲームデータ
- */
-void AKEnemy::actionOfBagworm(AKPlayDataInterface *data)
-{
-    // 弾発射間隔
-    const int kAKShotInterval = 60;
-    // 弾のスピード
-    const float kAKShotSpeed = 1.0f;
-
-    // スクロールに合わせて移動する
-    m_scrollSpeed = 1.0f;
-    
-    // 弾発射間隔経過しているときは全方位に弾を発射する
-    if ((m_frame + 1) % kAKShotInterval == 0) {
-        
-        // 全方位に 12-way弾を発射する
-        AKEnemy::fireNWay(M_PI,
-                          m_position,
-                          12,
-                          M_PI / 6.0f,
-                          kAKShotSpeed,
-                          true,
-                          data);
-    }
-    
-    // 2周目は方向と間隔をずらして全方位に弾を発射する
-    if (data->is2ndLoop() && (m_frame + 1 + kAKShotInterval / 2) % kAKShotInterval == 0) {
-        
-        AKEnemy::fireNWay(M_PI + M_PI / 12.0f,
-                          m_position,
-                          12,
-                          M_PI / 6.0f,
-                          kAKShotSpeed,
-                          true,
-                          data);
-    }
-}
-
-/*!
- @brief セミの動作処理
+ @brief 動作スクリプトによる動作処理
  
- 自機に向かって一定時間飛ぶ。その後待機して自機に向かって3-way弾を発射する。
+ 敵種別ごとの動作スクリプトを解釈して実行する。
+ 加速度と着地判定を処理した後に、待機中でなければ命令を実行する。
+ 命令の実行後に定周期発射、向きの変更、足元の障害物に合わせた移動を行う。
+ 実行状態は実行位置、待機フレーム数、ループカウンタ、常時処理の設定のみでメモリの確保は行わない。
  @param data ゲームデータ
  */
-void AKEnemy::actionOfCicada(AKPlayDataInterface *data)
+void AKEnemy::actionOfScript(AKPlayDataInterface *data)
 {
-    // 移動スピード
-    const float kAKSpeed = 1.5f;
-    // 移動間隔
-    const int kAKMoveInterval = 60;
-    // 弾発射間隔
-    const int kAKShotInterval = 20;
-    // 待機間隔
-    const int kAKWaitInterval = 70;
-    // 弾のスピード
-    const float kAKShotSpeed = 1.0f;
-
-    // 状態
-    enum STATE {
-        kAKStateInit = 0,           // 初期状態
-        kAKStateLeftMove,           // 左移動
-        kAKStateFire                // 弾発射
-    };
-
-    // 状態によって処理を分岐する
-    switch (m_state) {
-        case kAKStateInit:     // 初期状態
-        {
-            // 自機との角度を求める
-            float angle = AKAngle::calcDestAngle(m_position, *data->getPlayerPosition());
-            
-            // 縦横の速度を決定する
-            m_speedX = kAKSpeed * cosf(angle);
-            m_speedY = kAKSpeed * sinf(angle);
-            
-            // 移動中はアニメーションを設定する
-            m_animationPattern = 2;
-            m_animationInterval = 6;
-            setAnimationInitPattern(11);
-            
-            // 左移動の状態へ遷移する
-            m_state = kAKStateLeftMove;            
-        }
-            break;
-            
-        case kAKStateLeftMove:     // 左へ移動
-            
-            // 移動間隔経過したら次の状態へ進める
-            if ((m_frame + 1) % kAKMoveInterval == 0) {
-                
-                // 弾発射の状態へ遷移する
-                m_state= kAKStateFire;
-                
-                // 停止する（スクロールスピードに合わせる）
-                m_speedX = -data->getScrollSpeedX();
-                m_speedY = -data->getScrollSpeedY();
-                
-                // 待機中はアニメーションを無効化
-                m_animationPattern = 1;
-                m_animationInterval = 0.0f;
-                setAnimationInitPattern(1);
-                
-                // 経過フレーム数を初期化する
-                m_frame = 0;
-            }
-            break;
-            
-        case kAKStateFire:  // 弾発射
-            
-            // 弾発射間隔経過で自機に向かって3-way弾を発射する
-            if ((m_frame + 1) % kAKShotInterval == 0) {
-                
-                AKEnemy::fireNWay(m_position,
-                                  3,
-                                  M_PI / 8.0f,
-                                  kAKShotSpeed,
-                                  data);
-                
-                // 2周目の場合は追加で2-way弾を発射する
-                if (data->is2ndLoop()) {
-                    
-                    AKEnemy::fireNWay(m_position,
-                                      2,
-                                      M_PI / 8.0f,
-                                      kAKShotSpeed * 1.5f,
-                                      data);
-
-                }
-            }
-            
-            // 待機間隔経過で初期状態に戻る
-            if ((m_frame + 1) % kAKWaitInterval == 0) {
-                
-                // 初期状態へ遷移する
-                m_state = kAKStateInit;
-                
-                // 経過フレーム数を初期化する
-                m_frame = 0;
-            }
-            
-            break;
-            
-        default:
-            AKAssert(false, "状態が異常:m_state=%d", m_state);
-            break;
-    }
-}
-
-/*!
- @brief バッタの動作処理
- 
- 地面または天井を移動する。左方向へジャンプ、着地して弾発射を繰り返す。
- @param data ゲームデータ
- */
-void AKEnemy::actionOfGrasshopper(AKPlayDataInterface *data)
-{
-    // 移動スピード
-    const float kAKMoveSpeed = -1.0f;
-    // ジャンプのスピード
-    const float kAKJumpSpeed = 4.0f;
-    // 重力加速度
-    const float kAKGravitationAlacceleration = 0.15f;
-    // 左移動間隔
-    const int kAKLeftMoveInterval = 60;
-    // 待機間隔
-    const int kAKWaitInterval = 60;
-    // 弾発射間隔
-    const int kAKShotInterval = 30;
-    // 弾のスピード
-    const float kAKShotSpeed = 1.5f;
-    
-    // 状態
-    enum STATE {
-        kAKStateInit = 0,           // 初期状態
-        kAKStateLeftMove,           // 左移動
-        kAKStateWait                // 待機
-    };
-
-    // スクロールに合わせて移動する
-    m_scrollSpeed = 1.0f;
-    
-    // 障害物との当たり判定を有効にする
-    m_blockHitAction = kAKBlockHitMove;
-
-    // 初期状態の時は逆さま判定を行う
-    if (m_state == kAKStateInit) {
-        checkReverse(*data->getBlocks());
-    }
-    
-    // 左移動中の場合
-    if (m_state == kAKStateLeftMove) {
-
-        // 重力加速度をかけて減速する
-        if (!m_isFlippedY) {
-            m_speedY -= kAKGravitationAlacceleration;
-        }
-        else {
-            m_speedY += kAKGravitationAlacceleration;
-        }
-
-        // 一定時間経過したら次の状態へ進める
-        if (m_frame - m_work[0] > kAKLeftMoveInterval) {
-            
-            // 弾発射の状態へ遷移する
-            m_state = kAKStateWait;
-            
-            // 停止する
-            m_speedX = 0;
-            
-            // 作業領域に状態遷移した時のフレーム数を保存する
-            m_work[0] = m_frame;
-        }
-    }
+    AKAssert(m_script != NULL, "動作スクリプトが設定されていない");
     
-    // 落ちていく方向の障害物に接触している場合、着地したとしてスピードを0にする。
-    if ((!m_isFlippedY && (m_blockHitSide & kAKHitSideBottom)) ||
-        (m_isFlippedY && (m_blockHitSide & kAKHitSideTop))) {
-        
-        m_speedX = 0.0f;
-        m_speedY = 0.0f;
-        
-        // 着地時の画像に切替える
-        setAnimationInitPattern(getInitPatternByIsFlipped(m_isFlippedX, m_isFlippedY));
-    }
-    
-    // 初期状態または待機中で待機時間が経過している場合
-    if ((m_state == kAKStateInit) || (m_state == kAKStateWait && (m_frame - m_work[0] > kAKWaitInterval))) {
-        
-        AKLog(kAKLogEnemy_3, "ジャンプ:frame=%d work[0]=%d", m_frame, m_work[0]);
-        
-        // 左方向へのスピードを設定する
-        m_speedX = kAKMoveSpeed;
-        
-        // ジャンプする方向へ加速する
-        if (!m_isFlippedY) {
-            m_speedY = kAKJumpSpeed;
-        }
-        else {
-            m_speedY = -kAKJumpSpeed;
-        }
-        
-        // 左移動の状態へ遷移する
-        m_state = kAKStateLeftMove;
-        
-        // 作業領域に状態遷移した時のフレーム数を保存する
-        m_work[0] = m_frame;
-        
-        // ジャンプ時の画像に切替える
-        setAnimationInitPattern(getInitPatternByIsFlipped(m_isFlippedX, m_isFlippedY) + 1);
-    }
-
-    // 弾発射間隔経過で自機に向かって1-way弾を発射する
-    if ((m_frame + 1) % kAKShotInterval == 0) {
-        
-        AKEnemy::fireNWay(m_position,
-                          1,
-                          0.0f,
-                          kAKShotSpeed,
-                          data);
-        
-        // 2周めの場合は画面中央に向けて3-Way弾を発射する
-        if (data->is2ndLoop()) {
-            
-            AKEnemy::fireNWay(m_isFlippedY ? 3 * M_PI / 2.0f : M_PI / 2.0f,
-                              m_position,
-                              3,
-                              M_PI / 8.0f,
-                              kAKShotSpeed,
-                              true,
-                              data);
-            
-        }
-    }
-    
-    AKLog(kAKLogEnemy_3, "speed=(%f, %f)", m_speedX, m_speedY);
-    
-    // 画像表示位置の更新を行う
-    updateImagePosition();
-}
-
-/*!
- @brief ハチの動作処理
- 
- 画面上半分から登場するときは左下に向かって一定時間進み、一時停止して弾を発射、その後左上に向かって飛んで行く。
- 画面下半分から登城するときは左上に向かって一定時間進み、あとの処理は同じ。
- 弾は5種類のスピードの弾を左方向に発射する。
- @param data ゲームデータ
- */
-void AKEnemy::actionOfHornet(AKPlayDataInterface *data)
-{
-    // 弾の数
-    const int kAKShotCount = 5;
-    // 弾のスピード
-    const float kAKShotSpeed[kAKShotCount] = {1.5f, 1.7f, 1.9f, 2.1f, 2.3f};
-    // 登場時のx方向の移動スピード
-    const float kAKMoveInSpeedX = -2.0f;
-    // 退場時のx方向の移動スピード
-    const float kAKMoveOutSpeedX = -2.6f;
-    // 退場時のy方向の移動スピード
-    const float kAKMoveOutSpeedY = 0.5f;
-    // 登場時移動フレーム数
-    const int kAKMoveInFrame = 30;
-    // 弾発射までの待機フレーム数
-    const int kAKWaitForFireFrame = 6;
-    // 退場までの待機フレーム数
-    const int kAKWaitForMoveOutFrame = 12;
-    
-    // 状態
-    enum STATE {
-        kAKStateInit = 0,   // 初期状態
-        kAKStateMoveIn,     // 登場
-        kAKStateFire,       // 弾発射
-        kAKStateMoveOut     // 退場
-    };
-    
-    // 状態によって処理を分岐する
-    switch (m_state) {
-        case kAKStateInit:      // 初期状態
-            
-            // 左方向へ移動する
-            m_speedX = kAKMoveInSpeedX;
-            
-            // 自機に向かってy軸方向は移動する
-            m_speedY = (data->getPlayerPosition()->y - m_position.y) / kAKMoveInFrame;
-            
-            // 登場の状態へ遷移する
-            m_state = kAKStateMoveIn;
-            
-            break;
-            
-        case kAKStateMoveIn:    // 登場
-            
-            // 登場移動時間が経過している場合
-            if (m_frame > kAKMoveInFrame) {
-                
-                // 停止する
-                m_speedX = 0.0f;
-                m_speedY = 0.0f;
-                
-                // 弾発射の状態へ遷移する
-                m_state = kAKStateFire;
-                
-                // 経過フレーム数を初期化する
-                m_frame = 0;
-            }
-            
-            break;
-            
-        case kAKStateFire:      // 弾発射
-            
-            // 待機時間が経過している場合
-            if (m_frame > kAKWaitForFireFrame) {
-                
-                // 左へ5種類の弾を発射する
-                for (int i = 0; i < kAKShotCount; i++) {
-                    
-                    AKEnemy::fireNWay(M_PI,
-                                      m_position,
-                                      3,
-                                      M_PI / 32.0f,
-                                      kAKShotSpeed[i],
-                                      false,
-                                      data);
-                    
-                    // 2周目のときは追加で2-wayを発射する
-                    if (data->is2ndLoop()) {
-                        
-                        AKEnemy::fireNWay(M_PI,
-                                          m_position,
-                                          2,
-                                          M_PI / 32.0f,
-                                          kAKShotSpeed[i],
-                                          false,
-                                          data);
-                    }
-                }
-
-                // 退場の状態へ遷移する
-                m_state = kAKStateMoveOut;
-                
-                // 経過フレーム数を初期化する
-                m_frame = 0;
-            }
-            break;
-            
-        case kAKStateMoveOut:   // 退場
-            
-            // 待機時間が経過している場合
-            if (m_frame > kAKWaitForMoveOutFrame) {
-                // 左上へ移動する
-                m_speedX = kAKMoveOutSpeedX;
-                m_speedY = kAKMoveOutSpeedY;
-            }
-            
-            break;
-            
-        default:
-            AKAssert(false, "状態が異常:m_state=%d", m_state);
-            break;
-    }
-}
-
-/*!
- @brief ゴキブリの動作処理
- 
- 自機に向かって体当たりをしてくる。定周期で自機に向かって2-way弾を発射する。
- @param data ゲームデータ
- */
-void AKEnemy::actionOfCockroach(AKPlayDataInterface *data)
-{
-    // 移動スピード
-    const float kAKMoveSpeed = 1.5f;
-    // 弾のスピード
-    const float kAKShotSpeed = 1.5f;
-    // 弾発射間隔
-    const int kAKShotInterval = 40;
-
-    // 障害物との当たり判定を有効にする
-    m_blockHitAction = kAKBlockHitMove;
-
-    // 自機との角度を求める
-    float angle = AKAngle::calcDestAngle(m_position, *data->getPlayerPosition());
-    
-    // 縦横の速度を決定する
-    m_speedX = kAKMoveSpeed * cosf(angle);
-    m_speedY = kAKMoveSpeed * sinf(angle);
-    
-    // 画像を回転させる
-    getImage()->setRotation(AKAngle::convertAngleRad2Scr(angle));
-    
-    // 一定時間経過しているときは自機を狙う2-way弾を発射する
-    if ((m_frame + 1) % kAKShotInterval == 0) {
-        
-        // 自機へ向けて弾を発射する
-        AKEnemy::fireNWay(m_position,
-                          2,
-                          M_PI / 16.0f,
-                          kAKShotSpeed,
-                          data);
-        
-        // 2周目の場合は追加で左方向に弾を発射する
-        if (data->is2ndLoop()) {
-            
-            AKEnemy::fireNWay(M_PI,
-                              m_position,
-                              1,
-                              0.0f,
-                              kAKShotSpeed,
-                              false,
-                              data);
-
-        }
-    }
-}
-
-/*! 
- @brief カタツムリの動作処理
- 
- 天井または地面に張り付いて歩く。
- 左方向へゆっくり移動しながら、自機に向かって3-way弾を発射する。
- @param data ゲームデータ
- */
-void AKEnemy::actionOfSnail(AKPlayDataInterface *data)
-{
-    // 弾のスピード
-    const float kAKShotSpeed = 1.0f;
-    // 移動スピード
-    const float kAKMoveSpeed = 0.2f;
-    // 弾発射間隔
-    const int kAKShotInterval = data->is2ndLoop() ? 60 : 90;
+    // スクリプトを読み込めていない場合は何もしない
+    if (m_script == NULL) {
+        return;
+    }
     
-    // 状態
-    enum STATE {
-        kAKStateInit = 0,           // 初期状態
-        kAKStateLeftMove            // 左移動
-    };
+    // 加速度を加える(逆さまの場合は上下反転する)
+    m_speedX += m_scriptAccel.x;
+    m_speedY += (m_isFlippedY ? -m_scriptAccel.y : m_scriptAccel.y);
     
-    // 縦方向の速度は状態にかかわらず0とする
-    m_speedY = 0.0f;
+    // 落ちていく方向の障害物に接触している場合、着地したとしてスピードを0にする
+    if ((m_scriptMode & kAKScriptModeLand) &&
+        ((!m_isFlippedY && (m_blockHitSide & kAKHitSideBottom)) ||
+         (m_isFlippedY && (m_blockHitSide & kAKHitSideTop)))) {
+        
+        m_speedX = 0.0f;
+        m_speedY = 0.0f;
+        
+        // 着地時の画像に切替える
+        setAnimationInitPattern(getInitPatternByIsFlipped(m_isFlippedX, m_isFlippedY));
+    }
     
-    // スクロールに合わせて移動する
-    m_scrollSpeed = 1.0f;
+    // 待機中の場合は待機フレーム数を減らし、待機が終わっていれば命令を実行する
+    if (m_scriptWait > 0) {
+        m_scriptWait--;
+    }
+    if (m_scriptWait == 0) {
+        executeScript(data);
+    }
     
-    // 状態によって処理を分岐する
-    switch (m_state) {
-        case kAKStateInit:     // 初期状態
-            
-            // 逆さま判定を行う
-            checkReverse(*data->getBlocks());
-            
-            // 左方向へ移動する
-            m_speedX = -kAKMoveSpeed;
-            
-            // 左移動の状態に遷移する
-            m_state = kAKStateLeftMove;
-            
-            break;
-            
-        case kAKStateLeftMove:  // 左移動
-                        
-            // 一定時間経過したら弾を発射する
-            if ((m_frame + 1) % kAKShotInterval == 0) {
-
-                // 自機へ向けて弾を発射する
-                AKEnemy::fireNWay(m_position,
-                                  3,
-                                  M_PI / 8.0f,
-                                  kAKShotSpeed,
-                                  data);
-            }
-            
-            break;
-        default:
-            AKAssert(false, "状態が異常:m_state=%d", m_state);
-            break;
+    // 定周期発射の間隔が経過している場合は指定位置から続く弾発射命令を実行する
+    if (m_scriptTimerInterval > 0 && (m_frame + 1) % m_scriptTimerInterval == 0) {
+        for (int pc = m_scriptTimerPC;
+             pc < m_script->codeCount && m_script->code[pc].op == kAKScriptOpFire;
+             pc++) {
+            fireByScript(m_script->code[pc], data);
+        }
     }
     
-    // 障害物との衝突判定を行う
-    m_position = AKEnemy::checkBlockPosition(m_position,
-                                             getImage()->getContentSize(),
-                                             m_isFlippedY,
-                                             data);
+    // 移動方向へ向く。停止中は自機の方を向く
+    if (m_scriptMode & kAKScriptModeFace) {
+        
+        if (m_speedX > 0.0f) {
+            m_isFlippedX = true;
+        }
+        else if (m_speedX < 0.0f) {
+            m_isFlippedX = false;
+        }
+        else {
+            m_isFlippedX = (m_position.x < data->getPlayerPosition()->x);
+        }
+        setAnimationInitPattern(getInitPatternByIsFlipped(m_isFlippedX, m_isFlippedY));
+    }
     
-    // 画像表示位置の更新を行う
-    updateImagePosition();
+    // 足元の障害物に合わせて移動する
+    if (m_scriptMode & kAKScriptModeBlock) {
+        
+        // 障害物との衝突判定を行う
+        m_position = AKEnemy::checkBlockPosition(m_position,
+                                                 getImage()->getContentSize(),
+                                                 m_isFlippedY,
+                                                 data);
+        
+        // 画像表示位置の更新を行う
+        updateImagePosition();
+    }
 }
 
 /*!
- @brief クワガタの動作処理
+ @brief 動作スクリプトの命令実行
  
- 登場時に自機の方向へ進行方向を決めて真っ直ぐ飛ぶ。定周期で3-way弾を発射する。
- 途中で方向転換を行い、自機の方向へ向き直す。ただし、後ろの方向には戻らないようにx方向は常に左にする。
+ 待機命令か終了命令に到達するまで命令を順に実行し、次のフレームでは続きから実行する。
+ 逆さまの場合は速度のy方向を上下反転する。
  @param data ゲームデータ
  */
-void AKEnemy::actionOfStagBeetle(AKPlayDataInterface *data)
+void AKEnemy::executeScript(AKPlayDataInterface *data)
 {
-    // 弾のスピード
-    const float kAKShotSpeed = 1.5f;
-    // 移動スピード
-    const float kAKMoveSpeed = 1.3f;
-    // 弾発射間隔
-    const int kAKShotInterval = 60;
-    // 方向転換を行うまでの間隔
-    const int kAKChangeDirectionInterval = 120;
-
-    // 状態
-    enum STATE {
-        kAKStateInit = 0,           // 初期状態
-        kAKStateLeftMove            // 左移動
-    };
+    // 1フレームで実行する命令数の上限
+    const int kAKMaxStep = 64;
     
-    // 状態によって処理を分岐する
-    switch (m_state) {
-        case kAKStateInit:              // 初期状態
-        {
-            // 自機との角度を求める
-            float angle = AKAngle::calcDestAngle(m_position,
-                                                 *data->getPlayerPosition());
-            
-            // 縦横の速度を決定する
-            // ただし、後ろには戻らないようにx方向は絶対値とする
-            m_speedX = -1.0 * fabsf(kAKMoveSpeed * cosf(angle));
-            m_speedY = kAKMoveSpeed * sinf(angle);
-            
-            // 左移動の状態へ遷移する
-            m_state = kAKStateLeftMove;
-        }
-            break;
-            
-        case kAKStateLeftMove:     // 左へ移動
-            
-            // 弾発射間隔時間経過したら弾を発射する
-            if ((m_frame + 1) % kAKShotInterval == 0) {
+    // 待機命令か終了命令に到達するまで命令を実行する
+    for (int step = 0; step < kAKMaxStep; step++) {
+        
+        AKAssert(m_scriptPC >= 0 && m_scriptPC < m_script->codeCount, "実行位置が範囲外:%d", m_scriptPC);
+        
+        const struct AKEnemyCode &code = m_script->code[m_scriptPC];
+        
+#ifdef DEBUG
+        // 処理時間計測のため、命令実行開始時のシステム時刻を取得する
+        auto begin = steady_clock::now();
+#endif
+        
+        // 実行位置を次の命令に進める
+        m_scriptPC++;
+        
+        // 処理を中断するかどうか
+        bool isYield = false;
+        
+        // 命令種別によって処理を分岐する
+        switch (code.op) {
+            case kAKScriptOpEnd:            // 終了
                 
-                // 自機へ向けて弾を発射する
-                AKEnemy::fireNWay(m_position,
-                                  3,
-                                  M_PI / 8.0f,
-                                  kAKShotSpeed,
-                                  data);
+                // 実行位置を終了命令に留めて処理を中断する
+                m_scriptPC--;
+                isYield = true;
+                break;
                 
-                // 2周目の場合は追加で左方向に弾を発射する
+            case kAKScriptOpWait:           // 待機
+                
+                // 待機フレーム数を設定して処理を中断する
+                m_scriptWait = (int)code.arg[0];
+                isYield = true;
+                break;
+                
+            case kAKScriptOpJump:           // ジャンプ
+                m_scriptPC = (int)code.arg[0];
+                break;
+                
+            case kAKScriptOpLoopSet:        // ループ回数設定
+                m_scriptLoop = (int)code.arg[0];
+                break;
+                
+            case kAKScriptOpLoop:           // ループ
+                
+                // カウンタを減らし、残っている場合は飛び先へ戻る
+                m_scriptLoop--;
+                if (m_scriptLoop > 0) {
+                    m_scriptPC = (int)code.arg[0];
+                }
+                break;
+                
+            case kAKScriptOpBranch2ndLoop:  // 周回分岐
                 if (data->is2ndLoop()) {
-                    
-                    AKEnemy::fireNWay(M_PI,
-                                      m_position,
-                                      3,
-                                      M_PI / 8.0f,
-                                      kAKShotSpeed / 1.5f,
-                                      false,
-                                      data);
-                    
+                    m_scriptPC = (int)code.arg[0];
                 }
-            }
-            
-            // 方向転換間隔経過したら初期状態に遷移して角度を設定し直す
-            if ((m_frame + 1) % kAKChangeDirectionInterval == 0) {
+                break;
                 
-                m_state = kAKStateInit;
+            case kAKScriptOpBranchHitPoint: // HP分岐
+                if (m_hitPoint <= (int)code.arg[1]) {
+                    m_scriptPC = (int)code.arg[0];
+                }
+                break;
+                
+            case kAKScriptOpSpeed:          // 速度設定
+                m_speedX = code.arg[0];
+                m_speedY = (m_isFlippedY ? -code.arg[1] : code.arg[1]);
+                break;
+                
+            case kAKScriptOpStop:           // 停止
+                
+                // スクロールスピードに合わせる
+                m_speedX = -data->getScrollSpeedX();
+                m_speedY = -data->getScrollSpeedY();
+                break;
+                
+            case kAKScriptOpScroll:         // スクロール影響設定
+                m_scrollSpeed = code.arg[0];
+                break;
+                
+            case kAKScriptOpAim:            // 自機へ向かって移動
+            {
+                // 自機との角度を求める
+                float angle = AKAngle::calcDestAngle(m_position, *data->getPlayerPosition());
+                
+                // 縦横の速度を決定する
+                m_speedX = code.arg[0] * AKFastMath::calcCos(angle);
+                m_speedY = code.arg[0] * AKFastMath::calcSin(angle);
+                
+                // 後ろには戻らないようにする場合はx方向は常に左にする
+                if ((int)code.arg[1] & kAKScriptAimForward) {
+                    m_speedX = -fabsf(m_speedX);
+                }
+                
+                // 画像を回転させる
+                if ((int)code.arg[1] & kAKScriptAimRotate) {
+                    getImage()->setRotation(AKAngle::convertAngleRad2Scr(angle));
+                }
             }
-            break;
-            
-        default:
-            AKAssert(false, "状態が異常:m_state=%d", m_state);
-            break;
+                break;
+                
+            case kAKScriptOpAnimation:      // アニメーション設定
+                
+                // 初期パターンは反転の向きに応じてずらす
+                m_animationPattern = (int)code.arg[0];
+                m_animationInterval = (int)code.arg[1];
+                setAnimationInitPattern(getInitPatternByIsFlipped(m_isFlippedX, m_isFlippedY) + (int)code.arg[2] - 1);
+                break;
+                
+            case kAKScriptOpFire:           // 弾発射
+                fireByScript(code, data);
+                break;
+                
+            case kAKScriptOpSpawn:          // 敵生成
+                data->createEnemy((int)code.arg[0],
+                                  Vec2(m_position.x + code.arg[1], m_position.y + code.arg[2]),
+                                  0);
+                break;
+                
+            case kAKScriptOpReverse:        // 逆さま判定
+                checkReverse(*data->getBlocks());
+                break;
+                
+            case kAKScriptOpMode:           // 常時処理設定
+                m_scriptMode = (int)code.arg[0];
+                break;
+                
+            case kAKScriptOpAccel:          // 加速度設定
+                m_scriptAccel = Vec2(code.arg[0], code.arg[1]);
+                break;
+                
+            case kAKScriptOpBlockHit:       // 障害物衝突時の処理設定
+                m_blockHitAction = (enum AKBlockHitAction)(int)code.arg[0];
+                break;
+                
+            case kAKScriptOpChase:          // 自機のy座標へ向かって移動
+                
+                // 指定フレーム数で自機のy座標に到達する速度とする
+                m_speedX = code.arg[0];
+                m_speedY = (data->getPlayerPosition()->y - m_position.y) / code.arg[1];
+                break;
+                
+            case kAKScriptOpEvery:          // 定周期発射設定
+                m_scriptTimerInterval = (int)code.arg[0];
+                m_scriptTimerPC = (int)code.arg[1];
+                break;
+                
+            default:
+                AKAssert(false, "命令種別が異常:op=%d", code.op);
+                isYield = true;
+                break;
+        }
+        
+#ifdef DEBUG
+        // 命令種別ごとの処理時間を記録する
+        AKEnemyScriptTable::addProfile(code.op,
+                                       duration_cast<nanoseconds>(steady_clock::now() - begin).count());
+#endif
+        
+        // 待機命令か終了命令の場合は処理を終了する
+        if (isYield) {
+            return;
+        }
+    }
+    
+    AKAssert(false, "1フレームに実行する命令数が上限を超えた:m_scriptPC=%d", m_scriptPC);
+}
+
+/*!
+ @brief 動作スクリプトによる弾発射
+ 
+ 弾発射命令で指定された弾発射パターンで弾を発射する。
+ 発射する周回が指定されている場合は、その周回の場合のみ発射する。
+ 逆さまの場合は角度指定の弾の角度を上下反転する。
+ @param code 弾発射命令
+ @param data ゲームデータ
+ */
+void AKEnemy::fireByScript(const struct AKEnemyCode &code, AKPlayDataInterface *data)
+{
+    // 発射する周回でない場合は処理しない
+    int loop = (int)code.arg[1];
+    if ((loop == kAKScriptLoop2nd && !data->is2ndLoop()) ||
+        (loop == kAKScriptLoop1st && data->is2ndLoop())) {
+        return;
     }
     
+    AKAssert((int)code.arg[0] >= 0 && (int)code.arg[0] < m_script->patternCount,
+             "弾発射パターン番号が範囲外:%d", (int)code.arg[0]);
+    
+    const struct AKShotPattern &pattern = m_script->patterns[(int)code.arg[0]];
+    
+    // 逆さまの場合は角度を上下反転したパターンで発射する
+    if (m_isFlippedY && pattern.aim == kAKShotAimAngle) {
+        struct AKShotPattern flipped = pattern;
+        flipped.angle = -pattern.angle;
+        AKShotEmitter::fire(flipped, m_position, data);
+    }
+    else {
+        AKShotEmitter::fire(pattern, m_position, data);
+    }
 }
 
 /*!
@@ -2231,28 +1730,16 @@ void AKEnemy::actionOfMantis(AKPlayDataInterface *data)
  攻撃パターン2:全方位弾を角度を変えながら発射する
  
  攻撃パターン3:地面から上方向に画面全体に弾を発射する
+ 
+ 攻撃パターンの遷移はコルーチンで逐次的に記述する。
  @param data ゲームデータ
  */
 void AKEnemy::actionOfHoneycomb(AKPlayDataInterface *data)
 {
-    // 状態
-    enum STATE {
-        kAKStateInit = 0,           // 初期状態
-        kAKState5WayShot,           // 5-way弾発射
-        kAKStateAllDirectionShot,   // 全方位弾発射
-        kAKStateAllRangeShot,       // 地面からの画面全体の弾発射
-        kAKStateCount               // 状態の種類の数
-    };
-    // 状態遷移間隔
-    const int kAKStateInterval[kAKStateCount] = {340, 900, 900, 900};
-    // ハチを呼び出す間隔
-    const int kAKCallHornetInterval = data->is2ndLoop() ? 90 : 120;
-    // ハチの登場位置の数
-    const int kAKCallHornetPositionCount = 3;
-    // ハチの登場位置x座標
-    const float kAKHornetXPosition = 384.0f;
-    // ハチの登場位置y座標
-    const float kAKHornetYPosition[kAKCallHornetPositionCount] = {200.0f, 144.0f, 88.0f};
+    // 登場時の待機時間
+    const int kAKAppearInterval = 340;
+    // 攻撃パターンの継続時間
+    const int kAKAttackInterval = 900;
     // 5-way弾発射間隔
     const int kAK5WayInterval = 40;
     // 5-way弾スピード
@@ -2277,20 +1764,25 @@ void AKEnemy::actionOfHoneycomb(AKPlayDataInterface *data)
     const int kAK1WayInterval = 40;
     // 1-way弾スピード
     const float kAK1WayShotSpeed = 1.5f;
-    // 2周目追加ショット発射間隔
-    const int kAK2ndLoopShotInterval = 120;
-    // 2周目追加ショットスピード
-    const float kAK2ndLoopShotSpeed = 1.0f;
     
-    // 状態によって処理を分岐する
-    switch (m_state) {
-        case kAKStateInit:      // 初期状態
-            
-            // スクロールに合わせて移動する
-            m_scrollSpeed = 1.0f;
-            break;
-            
-        case kAKState5WayShot:  // 5-way弾発射
+    AKCoroutineBegin(m_coroutine);
+    
+    // 初期状態はスクロールに合わせて移動する
+    m_scrollSpeed = 1.0f;
+    
+    // 登場時の待機時間が経過するまで待機する
+    AKCoroutineWait(m_coroutine, kAKAppearInterval);
+    
+    // 登場時は無敵状態なので攻撃開始時に防御力を0にする
+    m_defence = 0;
+    
+    // 攻撃パターン1から3を繰り返す
+    for (;;) {
+        
+        // 攻撃パターン1:5-way弾発射
+        m_frame = 0;
+        do {
+            AKCoroutineYield(m_coroutine);
             
             // 弾発射間隔時間経過したら弾を発射する
             if ((m_frame + 1) % kAK5WayInterval == 0) {
@@ -2303,9 +1795,17 @@ void AKEnemy::actionOfHoneycomb(AKPlayDataInterface *data)
                                   data);
             }
             
-            break;
+            // 攻撃パターン共通の処理を行う
+            attackCommonOfHoneycomb(data);
             
-        case kAKStateAllDirectionShot:  // 全方位弾発射
+        } while (m_frame <= kAKAttackInterval);
+        
+        AKLog(kAKLogEnemy_3, "全方位弾発射へ遷移");
+        
+        // 攻撃パターン2:全方位弾発射
+        m_frame = 0;
+        do {
+            AKCoroutineYield(m_coroutine);
             
             // 全方位弾の発射間隔が経過している場合は弾を発射する
             if ((m_frame + 1) % kAKAllDirectionInterval == 0) {
@@ -2324,14 +1824,22 @@ void AKEnemy::actionOfHoneycomb(AKPlayDataInterface *data)
                                   true,
                                   data);
             }
-
-            break;
             
-        case kAKStateAllRangeShot:  // 地面からの画面全体の弾発射
+            // 攻撃パターン共通の処理を行う
+            attackCommonOfHoneycomb(data);
+            
+        } while (m_frame <= kAKAttackInterval);
+        
+        AKLog(kAKLogEnemy_3, "画面全体弾発射へ遷移");
+        
+        // 攻撃パターン3:地面からの画面全体の弾発射
+        m_frame = 0;
+        do {
+            AKCoroutineYield(m_coroutine);
             
             // 画面全体弾の発射間隔が経過している場合は弾を発射する
             if ((m_frame + 1) % kAKAllRangeInterval == 0) {
-
+                
                 // 左端の弾の座標を計算する
                 float x = AKScreenSize::stageSize().width / (kAKAllRangeCount + 1);
                 
@@ -2358,17 +1866,41 @@ void AKEnemy::actionOfHoneycomb(AKPlayDataInterface *data)
                                   kAK1WayShotSpeed,
                                   data);
             }
-
             
-            break;
+            // 攻撃パターン共通の処理を行う
+            attackCommonOfHoneycomb(data);
             
-        default:
-            AKAssert(false, "状態が異常:m_state=%d", m_state);
-            break;
+        } while (m_frame <= kAKAttackInterval);
+        
+        AKLog(kAKLogEnemy_3, "5-way弾発射へ遷移");
     }
     
-    // 初期状態以外の場合は定周期にハチを呼ぶ
-    if (m_state != kAKStateInit && (m_frame + 1) % kAKCallHornetInterval == 0) {
+    AKCoroutineEnd(m_coroutine);
+}
+
+/*!
+ @brief ハチの巣の攻撃パターン共通処理
+ 
+ 攻撃中は定周期にハチを呼ぶ。2周目は追加で3-way弾を発射する。
+ @param data ゲームデータ
+ */
+void AKEnemy::attackCommonOfHoneycomb(AKPlayDataInterface *data)
+{
+    // ハチを呼び出す間隔
+    const int kAKCallHornetInterval = data->is2ndLoop() ? 90 : 120;
+    // ハチの登場位置の数
+    const int kAKCallHornetPositionCount = 3;
+    // ハチの登場位置x座標
+    const float kAKHornetXPosition = 384.0f;
+    // ハチの登場位置y座標
+    const float kAKHornetYPosition[kAKCallHornetPositionCount] = {200.0f, 144.0f, 88.0f};
+    // 2周目追加ショット発射間隔
+    const int kAK2ndLoopShotInterval = 120;
+    // 2周目追加ショットスピード
+    const float kAK2ndLoopShotSpeed = 1.0f;
+    
+    // 定周期にハチを呼ぶ
+    if ((m_frame + 1) % kAKCallHornetInterval == 0) {
         
         // ハチの位置を呼ぶたびに切り替える
         int position = ((m_frame + 1) / kAKCallHornetInterval) % kAKCallHornetPositionCount;
@@ -2377,47 +1909,16 @@ void AKEnemy::actionOfHoneycomb(AKPlayDataInterface *data)
         data->createEnemy(kAKEnemyHornet,
                           Vec2(kAKHornetXPosition, kAKHornetYPosition[position]),
                           0);
-
-    }
-
-    // 2周目時は3-way弾を発射する
-    if (data->is2ndLoop()) {
-        
-        // 弾発射状態の場合
-        if (m_state != kAKStateInit) {
-            
-            // 2周目追加ショット発射間隔が経過している場合は弾を発射する
-            if ((m_frame + 1) % kAK2ndLoopShotInterval == 0) {
-                
-                AKEnemy::fireNWay(m_position,
-                                  3,
-                                  M_PI / 8.0f,
-                                  kAK2ndLoopShotSpeed,
-                                  data);
-            }
-        }
     }
     
-    // 状態遷移間隔が経過している場合は次の状態へ進める
-    if (m_frame > kAKStateInterval[m_state]) {
-        
-        // 登場時は無敵状態なので状態遷移時に防御力を0にする
-        m_defence = 0;
+    // 2周目時は2周目追加ショット発射間隔が経過している場合に3-way弾を発射する
+    if (data->is2ndLoop() && (m_frame + 1) % kAK2ndLoopShotInterval == 0) {
         
-        // 次の状態へ進める
-        m_state++;
-        
-        // 状態が最大を超える場合は最初の状態へループする
-        if (m_state >= kAKStateCount) {
-            m_state = kAKStateInit + 1;
-        }
-        
-        // 経過フレーム数と作業領域を初期化する
-        m_work[0] = 0.0f;
-        m_work[1] = 0.0f;
-        m_frame = 0.0f;
-        
-        AKLog(kAKLogEnemy_3, "m_state=%d", m_state);
+        AKEnemy::fireNWay(m_position,
+                          3,
+                          M_PI / 8.0f,
+                          kAK2ndLoopShotSpeed,
+                          data);
     }
 }
 
@@ -2742,8 +2243,8 @@ void AKEnemy::actionOfSpider(AKPlayDataInterface *data)
         float moveAngle = AKAngle::calcDestAngle(m_position, nextPosition);
     
         // 移動スピードを設定する
-        m_speedX = kAKMoveSpeed * cosf(moveAngle);
-        m_speedY = kAKMoveSpeed * sinf(moveAngle);
+        m_speedX = kAKMoveSpeed * AKFastMath::calcCos(moveAngle);
+        m_speedY = kAKMoveSpeed * AKFastMath::calcSin(moveAngle);
     
         // x方向の移動距離がスピードより小さい場合は通り過ぎないように移動先座標をセットする
         if (fabs(m_position.x - nextPosition.x) < m_speedX) {
@@ -3022,7 +2523,7 @@ void AKEnemy::actionOfCentipedeHead(AKPlayDataInterface *data)
         m_speedY = kAKMoveSpeed * m_work[kAKWorkMoveY];
         
         // 移動方向の角度を計算する
-        float angle = atan2f(m_speedY, m_speedX);
+        float angle = AKFastMath::calcAtan2(m_speedY, m_speedX);
         
         // 画像を回転させる
         getImage()->setRotation(AKAngle::convertAngleRad2Scr(angle));
@@ -3100,7 +2601,7 @@ void AKEnemy::actionOfCentipedeBody(AKPlayDataInterface *data)
     }
     
     // 一つ前の体の移動履歴を取得する
-    const std::queue<Vec2> *history = m_parentEnemy->getMoveHistory();
+    const AKMoveHistory *history = m_parentEnemy->getMoveHistory();
     
     // 履歴がない場合は処理を終了する
     if (history->size() <= 0) {
@@ -3113,7 +2614,7 @@ void AKEnemy::actionOfCentipedeBody(AKPlayDataInterface *data)
     // 前回位置との差から体の向きを決める
     float dx = m_position.x - m_prevPosition.x;
     float dy = m_position.y - m_prevPosition.y;
-    float angle = atan2f(dy, dx);
+    float angle = AKFastMath::calcAtan2(dy, dx);
     
     // 画像を回転させる
     getImage()->setRotation(AKAngle::convertAngleRad2Scr(angle));
@@ -3173,7 +2674,7 @@ void AKEnemy::actionOfCentipedeTail(AKPlayDataInterface *data)
     }
     
     // 一つ前の体の移動履歴を取得する
-    const std::queue<Vec2> *history = m_parentEnemy->getMoveHistory();
+    const AKMoveHistory *history = m_parentEnemy->getMoveHistory();
     
     // 履歴がない場合は処理を終了する
     if (history->size() <= 0) {
@@ -3186,7 +2687,7 @@ void AKEnemy::actionOfCentipedeTail(AKPlayDataInterface *data)
     // 前回位置との差から体の向きを決める
     float dx = m_position.x - m_prevPosition.x;
     float dy = m_position.y - m_prevPosition.y;
-    float angle = atan2f(dy, dx);
+    float angle = AKFastMath::calcAtan2(dy, dx);
     
     // 画像を回転させる
     getImage()->setRotation(AKAngle::convertAngleRad2Scr(angle));
@@ -3429,8 +2930,8 @@ void AKEnemy::actionOfFly(AKPlayDataInterface *data)
                 // 爆発発生位置を決める
                 int w = kAKEnemyDef[kAKEnemyFly - 1].hitWidth;
                 int h = kAKEnemyDef[kAKEnemyFly - 1].hitHeight;
-                int x = rand() % (w * 2) - w;
-                int y = rand() % (h * 2) - h;
+                int x = data->getRandom() % (w * 2) - w;
+                int y = data->getRandom() % (h * 2) - h;
                 
                 // 画面効果を生成する
                 data->createEffect(1, Vec2(m_position.x + x, m_position.y + y));           
@@ -3683,8 +3184,8 @@ void AKEnemy::actionOfFly(AKPlayDataInterface *data)
             getImage()->setRotation(AKAngle::convertAngleRad2Scr(nextAngle));
             
             // 速度を向きから決定する
-            m_speedX = cosf(nextAngle) * kAKMoveSpeed;
-            m_speedY = sinf(nextAngle) * kAKMoveSpeed;
+            m_speedX = AKFastMath::calcCos(nextAngle) * kAKMoveSpeed;
+            m_speedY = AKFastMath::calcSin(nextAngle) * kAKMoveSpeed;
         }
         
     }
@@ -3751,7 +3252,7 @@ void AKEnemy::destroyNormal(AKPlayDataInterface *data)
     data->createEffect(1, m_position);
     
     // 破壊の効果音を鳴らす
-    SimpleAudioEngine::getInstance()->playEffect(kAKBombMinSEFileName);
+    AKSEScheduler::getInstance()->playEffect(kAKBombMinSEFileName);
 }
 
 /*!
@@ -3773,14 +3274,14 @@ void AKEnemy::destroyOfBoss(AKPlayDataInterface *data)
         // 爆発発生位置を決める
         int w = kAKEnemyDef[kAKEnemyFly - 1].hitWidth;
         int h = kAKEnemyDef[kAKEnemyFly - 1].hitHeight;
-        int x = rand() % (w * 2) - w;
-        int y = rand() % (h * 2) - h;
+        int x = data->getRandom() % (w * 2) - w;
+        int y = data->getRandom() % (h * 2) - h;
         
         // 画面効果を生成する
         data->createEffect(1, Vec2(m_position.x + x, m_position.y + y));
         
         // 破壊の効果音を鳴らす
-        SimpleAudioEngine::getInstance()->playEffect(kAKBombMinSEFileName);
+        AKSEScheduler::getInstance()->playEffect(kAKBombMinSEFileName);
     }
     
     // 状態遷移間隔を経過するまでは死亡フラグを立てない
@@ -36,9 +36,10 @@
 #ifndef AKENEMY_H
 #define AKENEMY_H
 
-#include <queue>
 #include "AKCharacter.h"
-#include "AKNWayAngle.h"
+#include "AKRingBuffer.h"
+#include "AKEnemyScript.h"
+#include "AKCoroutine.h"
 
 /*!
  @brief 敵クラス
@@ -51,6 +52,14 @@ public:
     using AKActionFunc = void (AKEnemy::*)(AKPlayDataInterface *data);
     /// 作業領域の要素数
     static const int kAKEnemyWorkCount = 5;
+    /// 移動履歴の最大保存数
+    static const int kAKEnemyHistoryMax = 16;
+    /// 移動履歴
+    using AKMoveHistory = AKRingBuffer<cocos2d::Vec2, kAKEnemyHistoryMax>;
+
+public:
+    // スナップショットのビルド識別子取得
+    static unsigned int getSnapshotBuildId();
 
 private:
     /// 敵の種類の数
@@ -101,6 +110,8 @@ private:
                                        const std::vector<AKBlock*> &blocks);
 
 private:
+    /// 敵種別
+    int m_type;
     /// 動作開始からの経過フレーム数(各敵種別で使用)
     int m_frame;
     /// 動作状態(各敵種別で使用)
@@ -124,7 +135,25 @@ private:
     /// 移動履歴を保存する個数
     int m_historyCount;
     /// 移動履歴
-    std::queue<cocos2d::Vec2> m_moveHistory;
+    AKMoveHistory m_moveHistory;
+    /// 動作スクリプト(スクリプトを使用しない場合はNULL)
+    const struct AKEnemyScript *m_script;
+    /// 動作スクリプトの実行位置
+    int m_scriptPC;
+    /// 動作スクリプトの待機フレーム数
+    int m_scriptWait;
+    /// 動作スクリプトのループカウンタ
+    int m_scriptLoop;
+    /// 動作スクリプトの常時処理のフラグ
+    int m_scriptMode;
+    /// 動作スクリプトで設定した加速度
+    cocos2d::Vec2 m_scriptAccel;
+    /// 動作スクリプトの定周期発射の間隔(0の場合は発射しない)
+    int m_scriptTimerInterval;
+    /// 動作スクリプトの定周期発射で実行する命令の位置
+    int m_scriptTimerPC;
+    /// コルーチンの実行状態
+    struct AKCoroutine m_coroutine;
     /// ボスキャラかどうか
     bool m_boss;
     /// 死亡しているかどうか
@@ -135,18 +164,28 @@ private:
     bool m_isFlippedY;
     
 public:
+    // 移動処理
+    virtual void move(AKPlayDataInterface *data);
     // 生成処理
     void createEnemy(int type, const cocos2d::Vec2 &position, int progress, cocos2d::Node *parent);
+    // 親キャラクター取得
+    AKEnemy* getParentEnemy();
     // 親キャラクター設定
     void setParentEnemy(AKEnemy *parent);
+    // 子キャラクター取得
+    AKEnemy* getChildEnemy();
     // 小キャラクター設定
     void setChildEnemy(AKEnemy *child);
     // 状態設定
     void setState(int state);
     // 移動履歴取得
-    const std::queue<cocos2d::Vec2>* getMoveHistory();
+    const AKMoveHistory* getMoveHistory();
     // ボスキャラかどうかを取得する
     bool isBoss() const;
+    // スナップショット書き込み
+    void writeSnapshot(AKSnapshotWriter *writer);
+    // スナップショット読み込み
+    bool readSnapshot(AKSnapshotReader *reader, cocos2d::Node *parent);
 
 protected:
     // キャラクター固有の動作
@@ -155,34 +194,20 @@ protected:
     virtual void destroy(AKPlayDataInterface *data);
 
 private:
-    // トンボの動作処理
-    void actionOfDragonfly(AKPlayDataInterface *data);
-    // アリの動作処理
-    void actionOfAnt(AKPlayDataInterface *data);
-    // チョウの動作処理
-    void actionOfButterfly(AKPlayDataInterface *data);
-    // テントウムシの動作処理
-    void actionOfLadybug(AKPlayDataInterface *data);
-    // ミノムシの動作処理
-    void actionOfBagworm(AKPlayDataInterface *data);
-    // セミの動作処理
-    void actionOfCicada(AKPlayDataInterface *data);
-    // バッタの動作処理
-    void actionOfGrasshopper(AKPlayDataInterface *data);
-    // ハチの動作処理
-    void actionOfHornet(AKPlayDataInterface *data);
-    // ゴキブリの動作処理
-    void actionOfCockroach(AKPlayDataInterface *data);
-    // カタツムリの動作処理
-    void actionOfSnail(AKPlayDataInterface *data);
-    // クワガタの動作処理
-    void actionOfStagBeetle(AKPlayDataInterface *data);
+    // 動作スクリプトによる動作処理
+    void actionOfScript(AKPlayDataInterface *data);
+    // 動作スクリプトの命令実行
+    void executeScript(AKPlayDataInterface *data);
+    // 動作スクリプトによる弾発射
+    void fireByScript(const struct AKEnemyCode &code, AKPlayDataInterface *data);
     // カブトムシの動作処理
     void actionOfRhinocerosBeetle(AKPlayDataInterface *data);
     // カマキリの動作処理
     void actionOfMantis(AKPlayDataInterface *data);
     // ハチの巣の動作処理
     void actionOfHoneycomb(AKPlayDataInterface *data);
+    // ハチの巣の攻撃パターン共通処理
+    void attackCommonOfHoneycomb(AKPlayDataInterface *data);
     // クモの動作処理
     void actionOfSpider(AKPlayDataInterface *data);
     // ムカデ（頭）の動作処理
@@ -0,0 +1,625 @@
+/*
+ * Copyright (c) 2015 Akihiro Kaneda.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1.Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   2.Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   3.Neither the name of the Monochrome Soft nor the names of its contributors
+ *     may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!
+ @file AKEnemyScript.cpp
+ @brief 敵動作スクリプト定義
+ 
+ 敵の動作を記述するスクリプトの命令と、敵種別ごとのスクリプトテーブルを定義する。
+ スクリプトはリソースのテキストファイルに記述し、起動後に一度だけ読み込む。
+ */
+
+#include <cctype>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "AKEnemyScript.h"
+#include "AKCharacter.h"
+#include "AKAssetArchive.h"
+
+using std::string;
+using std::vector;
+using cocos2d::Data;
+using cocos2d::FileUtils;
+
+/// 動作スクリプトファイル名
+static const char *kAKEnemyScriptFile = "text/EnemyScript.txt";
+
+/// 命令の定義
+struct AKEnemyOpDef {
+    const char *name;   ///< 命令名(スクリプトファイルでの表記)
+    int target;         ///< 飛び先を指定する引数の位置(飛び先がない場合は-1)
+};
+
+/// 命令の定義(命令種別の順に並べる)
+static const struct AKEnemyOpDef kAKOpDef[kAKScriptOpCount] = {
+    {"End", -1}, {"Wait", -1}, {"Jump", 0}, {"LoopSet", -1}, {"Loop", 0},
+    {"Branch2ndLoop", 0}, {"BranchHitPoint", 0}, {"Speed", -1}, {"Stop", -1},
+    {"Scroll", -1}, {"Aim", -1}, {"Animation", -1}, {"Fire", -1}, {"Spawn", -1},
+    {"Reverse", -1}, {"Mode", -1}, {"Accel", -1}, {"BlockHit", -1}, {"Chase", -1},
+    {"Every", 1}
+};
+
+/// 引数に指定できるキーワード
+struct AKEnemyScriptKeyword {
+    const char *name;   ///< キーワード
+    int value;          ///< 値
+};
+
+/// 引数に指定できるキーワードの定義
+static const struct AKEnemyScriptKeyword kAKKeyword[] = {
+    {"none", 0},                            // なし
+    {"block", kAKScriptModeBlock},          // 常時処理:足元の障害物に合わせて移動する
+    {"face", kAKScriptModeFace},            // 常時処理:移動方向へ向く
+    {"land", kAKScriptModeLand},            // 常時処理:着地判定
+    {"rotate", kAKScriptAimRotate},         // 自機狙い移動:画像を回転する
+    {"forward", kAKScriptAimForward},       // 自機狙い移動:後ろには戻らない
+    {"2nd", kAKScriptLoop2nd},              // 弾発射:2周目のみ
+    {"1st", kAKScriptLoop1st},              // 弾発射:1周目のみ
+    {"move", kAKBlockHitMove},              // 障害物衝突時:移動
+    {"disappear", kAKBlockHitDisappear},    // 障害物衝突時:消滅
+    {"angle", kAKShotAimAngle},             // 弾発射パターン:角度指定
+    {"player", kAKShotAimPlayer}            // 弾発射パターン:自機狙い
+};
+
+/// 敵種別とスクリプトの対応
+struct AKEnemyScriptDef {
+    int type;                       ///< 敵種別
+    int codeStart;                  ///< 命令列の開始位置
+    int patternStart;               ///< 弾発射パターンの開始位置
+    struct AKEnemyScript script;    ///< 動作スクリプト
+};
+
+/// ラベル
+struct AKEnemyScriptLabel {
+    string name;    ///< ラベル名
+    int position;   ///< 命令列の位置
+    int line;       ///< 参照している行番号(定義の場合は0)
+};
+
+/// 敵種別とスクリプトの対応表
+static vector<struct AKEnemyScriptDef> _scriptDefs;
+/// すべてのスクリプトの命令列
+static vector<struct AKEnemyCode> _codes;
+/// すべてのスクリプトの弾発射パターン
+static vector<struct AKShotPattern> _patterns;
+/// スクリプトファイルを読み込んだかどうか
+static bool _isLoaded = false;
+/// スクリプト内容のハッシュ値
+static unsigned int _hash = kAKHashOffsetBasis;
+
+#ifdef DEBUG
+/// 命令種別ごとの実行回数
+static int _opCount[kAKScriptOpCount] = {0};
+/// 命令種別ごとの処理時間(ナノ秒)
+static long long _opTime[kAKScriptOpCount] = {0};
+#endif
+
+/*!
+ @brief 行の分割
+ 
+ 1行を空白区切りで分割する。#以降はコメントとして読み飛ばす。
+ @param line 行
+ @param tokens 分割結果
+ */
+static void splitLine(const string &line, vector<string> *tokens)
+{
+    tokens->clear();
+    
+    size_t pos = 0;
+    while (pos < line.size() && line[pos] != '#') {
+        
+        // 空白を読み飛ばす
+        if (isspace((unsigned char)line[pos])) {
+            pos++;
+            continue;
+        }
+        
+        // 空白かコメントまでを切り出す
+        size_t end = pos;
+        while (end < line.size() && !isspace((unsigned char)line[end]) && line[end] != '#') {
+            end++;
+        }
+        tokens->push_back(line.substr(pos, end - pos));
+        pos = end;
+    }
+}
+
+/*!
+ @brief 引数の値の解析
+ 
+ 数値またはキーワードを値に変換する。
+ キーワードは"|"で区切って複数指定でき、それぞれの値の論理和とする。
+ @param token 引数の文字列
+ @param value 値
+ @return 解析できたかどうか
+ */
+static bool parseValue(const string &token, float *value)
+{
+    // 数値として解釈できる場合は数値とする
+    char *end = NULL;
+    double number = strtod(token.c_str(), &end);
+    if (end != token.c_str() && *end == '\0') {
+        *value = (float)number;
+        return true;
+    }
+    
+    // キーワードの論理和を計算する
+    int flags = 0;
+    size_t pos = 0;
+    while (pos <= token.size()) {
+        
+        size_t sep = token.find('|', pos);
+        if (sep == string::npos) {
+            sep = token.size();
+        }
+        string name = token.substr(pos, sep - pos);
+        
+        bool isFound = false;
+        for (const struct AKEnemyScriptKeyword &keyword : kAKKeyword) {
+            if (name == keyword.name) {
+                flags |= keyword.value;
+                isFound = true;
+                break;
+            }
+        }
+        if (!isFound) {
+            return false;
+        }
+        pos = sep + 1;
+    }
+    
+    *value = (float)flags;
+    return true;
+}
+
+/*!
+ @brief ラベルの解決
+ 
+ スクリプト内で参照しているラベルを命令列の位置に置き換え、飛び先が命令列の範囲内かを確認する。
+ @param def 対象のスクリプト
+ @param labels 定義されたラベル
+ @param references 参照しているラベル(位置は参照している命令の位置)
+ @return 解決できたかどうか
+ */
+static bool resolveLabels(const struct AKEnemyScriptDef &def,
+                          const vector<struct AKEnemyScriptLabel> &labels,
+                          const vector<struct AKEnemyScriptLabel> &references)
+{
+    for (const struct AKEnemyScriptLabel &reference : references) {
+        
+        // 定義されたラベルを検索する
+        int position = -1;
+        for (const struct AKEnemyScriptLabel &label : labels) {
+            if (label.name == reference.name) {
+                position = label.position;
+                break;
+            }
+        }
+        if (position < 0) {
+            AKLog(kAKLogEnemyScript_1, "%d行目:ラベルが未定義:%s", reference.line, reference.name.c_str());
+            return false;
+        }
+        
+        // 飛び先は命令列の先頭からの位置とする
+        struct AKEnemyCode &code = _codes[def.codeStart + reference.position];
+        code.arg[kAKOpDef[code.op].target] = (float)(position - def.codeStart);
+    }
+    
+    return true;
+}
+
+/*!
+ @brief スクリプトの検証
+ 
+ 命令列の内容が実行時に範囲外を参照しないかを確認する。
+ @param def 対象のスクリプト
+ @return 正しいかどうか
+ */
+static bool checkScript(const struct AKEnemyScriptDef &def)
+{
+    int codeCount = (int)_codes.size() - def.codeStart;
+    int patternCount = (int)_patterns.size() - def.patternStart;
+    
+    // 命令が1つもない場合はエラーとする
+    if (codeCount <= 0) {
+        AKLog(kAKLogEnemyScript_1, "命令がない:type=%d", def.type);
+        return false;
+    }
+    
+    for (int i = 0; i < codeCount; i++) {
+        
+        const struct AKEnemyCode &code = _codes[def.codeStart + i];
+        
+        // 飛び先が命令列の範囲外の場合はエラーとする
+        int target = kAKOpDef[code.op].target;
+        if (target >= 0 && (code.arg[target] < 0.0f || code.arg[target] >= codeCount)) {
+            AKLog(kAKLogEnemyScript_1, "飛び先が範囲外:type=%d pc=%d", def.type, i);
+            return false;
+        }
+        
+        // 弾発射パターン番号が範囲外の場合はエラーとする
+        if (code.op == kAKScriptOpFire &&
+            (code.arg[0] < 0.0f || code.arg[0] >= patternCount)) {
+            AKLog(kAKLogEnemyScript_1, "弾発射パターン番号が範囲外:type=%d pc=%d", def.type, i);
+            return false;
+        }
+        
+        // 定周期発射の飛び先が弾発射命令でない場合はエラーとする
+        if (code.op == kAKScriptOpEvery && code.arg[0] > 0.0f &&
+            _codes[def.codeStart + (int)code.arg[1]].op != kAKScriptOpFire) {
+            AKLog(kAKLogEnemyScript_1, "定周期発射の飛び先が弾発射命令でない:type=%d pc=%d", def.type, i);
+            return false;
+        }
+        
+        // 到達までのフレーム数が0以下の場合はエラーとする
+        if (code.op == kAKScriptOpChase && code.arg[1] < 1.0f) {
+            AKLog(kAKLogEnemyScript_1, "到達までのフレーム数が不正:type=%d pc=%d", def.type, i);
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+/*!
+ @brief スクリプトファイル読み込み
+ 
+ スクリプトファイルを読み込み、命令列と弾発射パターンの配列に展開する。
+ アセットアーカイブに格納されている場合はアーカイブのメモリから読み込む。
+ 読み込みは初回のみ行い、読み込みに失敗した場合はスクリプトを空にする。
+ */
+void AKEnemyScriptTable::load()
+{
+    // 読み込み済みの場合は処理しない
+    if (_isLoaded) {
+        return;
+    }
+    _isLoaded = true;
+    
+    // アセットアーカイブに格納されている場合はアーカイブのメモリを直接参照する
+    const unsigned char *bytes = NULL;
+    ssize_t size = 0;
+    Data file;
+    if (!AKAssetArchive::getInstance()->find(kAKEnemyScriptFile, &bytes, &size)) {
+        
+        // アーカイブがない場合はファイルを読み込む
+        file = FileUtils::getInstance()->getDataFromFile(kAKEnemyScriptFile);
+        bytes = file.getBytes();
+        size = file.getSize();
+    }
+    
+    // ファイルの内容を解析する
+    if (bytes == NULL || !parse(reinterpret_cast<const char*>(bytes), size)) {
+        AKAssert(false, "動作スクリプトファイルが不正:%s", kAKEnemyScriptFile);
+        _scriptDefs.clear();
+        _codes.clear();
+        _patterns.clear();
+    }
+    
+    // 展開した内容のハッシュ値を計算する
+    _hash = calcHash();
+}
+
+/*!
+ @brief 敵種別に対応するスクリプト取得
+ 
+ 敵種別に対応する動作スクリプトを取得する。
+ 生成時に一度だけ呼ばれるため、対応表は線形に検索する。
+ @param type 敵種別
+ @return 動作スクリプト(スクリプトを使用しない敵種別の場合はNULL)
+ */
+const struct AKEnemyScript* AKEnemyScriptTable::getScript(int type)
+{
+    // 読み込んでいない場合は読み込む
+    load();
+    
+    for (const struct AKEnemyScriptDef &def : _scriptDefs) {
+        if (def.type == type) {
+            return &def.script;
+        }
+    }
+    return NULL;
+}
+
+/*!
+ @brief スクリプト内容のハッシュ値取得
+ 
+ 読み込んだスクリプトの内容から計算したハッシュ値を取得する。
+ スナップショットに保存した実行位置が同じスクリプトに対するものかを判定するために使用する。
+ @return ハッシュ値
+ */
+unsigned int AKEnemyScriptTable::getHash()
+{
+    // 読み込んでいない場合は読み込む
+    load();
+    
+    return _hash;
+}
+
+/*!
+ @brief スクリプトファイル解析
+ 
+ スクリプトファイルの内容を1行ずつ解析し、命令列と弾発射パターンの配列に展開する。
+ 
+ enemy 敵種別:以降の行を指定した敵種別のスクリプトとする。
+ 
+ pattern 弾数 間隔 速度 狙い方 角度 [スクロール [距離 [速度変更フレーム数 変更後速度]]]:
+ 弾発射パターンを定義する。先頭から0,1,2…の番号を振る。間隔と角度は度で指定する。
+ 各弾の発射位置のずれは指定できない。
+ 
+ ラベル名::次の命令の位置にラベルを定義する。ラベルはスクリプトごとに有効とする。
+ 
+ 命令名 引数…:命令を追加する。引数は数値、キーワード、@ラベル名で指定する。
+ 
+ すべての行を解析した後に各スクリプトの命令列と弾発射パターンの位置を設定するため、
+ 解析後は配列の要素を追加しないこと。
+ @param text ファイルの内容
+ @param size ファイルのサイズ
+ @return 解析できたかどうか
+ */
+bool AKEnemyScriptTable::parse(const char *text, size_t size)
+{
+    _scriptDefs.clear();
+    _codes.clear();
+    _patterns.clear();
+    
+    // 解析中のスクリプトのラベル
+    vector<struct AKEnemyScriptLabel> labels;
+    vector<struct AKEnemyScriptLabel> references;
+    
+    vector<string> tokens;
+    int line = 0;
+    size_t pos = 0;
+    while (pos < size) {
+        
+        // 1行切り出して分割する
+        size_t end = pos;
+        while (end < size && text[end] != '\n') {
+            end++;
+        }
+        splitLine(string(text + pos, end - pos), &tokens);
+        pos = end + 1;
+        line++;
+        
+        // 空行は読み飛ばす
+        if (tokens.empty()) {
+            continue;
+        }
+        
+        const string &name = tokens[0];
+        
+        // スクリプトの開始の場合
+        if (name == "enemy") {
+            
+            // 前のスクリプトのラベルを解決して内容を確認する
+            if (!_scriptDefs.empty() &&
+                (!resolveLabels(_scriptDefs.back(), labels, references) || !checkScript(_scriptDefs.back()))) {
+                return false;
+            }
+            labels.clear();
+            references.clear();
+            
+            struct AKEnemyScriptDef def;
+            def.type = (tokens.size() == 2 ? atoi(tokens[1].c_str()) : 0);
+            def.codeStart = (int)_codes.size();
+            def.patternStart = (int)_patterns.size();
+            if (def.type <= 0) {
+                AKLog(kAKLogEnemyScript_1, "%d行目:敵種別が不正", line);
+                return false;
+            }
+            for (const struct AKEnemyScriptDef &other : _scriptDefs) {
+                if (other.type == def.type) {
+                    AKLog(kAKLogEnemyScript_1, "%d行目:敵種別が重複:%d", line, def.type);
+                    return false;
+                }
+            }
+            _scriptDefs.push_back(def);
+            continue;
+        }
+        
+        // スクリプトの開始前に命令がある場合はエラーとする
+        if (_scriptDefs.empty()) {
+            AKLog(kAKLogEnemyScript_1, "%d行目:enemyの前に命令がある", line);
+            return false;
+        }
+        
+        // 弾発射パターンの場合
+        if (name == "pattern") {
+            
+            // 省略された項目は0とする
+            float value[9] = {0.0f};
+            if (tokens.size() < 6 || tokens.size() > 10) {
+                AKLog(kAKLogEnemyScript_1, "%d行目:弾発射パターンの項目数が不正", line);
+                return false;
+            }
+            for (size_t i = 1; i < tokens.size(); i++) {
+                if (!parseValue(tokens[i], &value[i - 1])) {
+                    AKLog(kAKLogEnemyScript_1, "%d行目:値が不正:%s", line, tokens[i].c_str());
+                    return false;
+                }
+            }
+            
+            struct AKShotPattern pattern;
+            pattern.count = (int)value[0];
+            pattern.interval = value[1] * M_PI / 180.0f;
+            pattern.speed = value[2];
+            pattern.aim = (enum AKShotAim)(int)value[3];
+            pattern.angle = value[4] * M_PI / 180.0f;
+            pattern.isScroll = !AKIsEqualFloat(value[5], 0.0f);
+            pattern.distance = value[6];
+            pattern.offset = NULL;
+            pattern.delay = (int)value[7];
+            pattern.delaySpeed = value[8];
+            _patterns.push_back(pattern);
+            continue;
+        }
+        
+        // ラベルの場合
+        if (tokens.size() == 1 && name.size() > 1 && name[name.size() - 1] == ':') {
+            struct AKEnemyScriptLabel label = {name.substr(0, name.size() - 1), (int)_codes.size(), 0};
+            labels.push_back(label);
+            continue;
+        }
+        
+        // 命令名から命令種別を検索する
+        struct AKEnemyCode code = {kAKScriptOpCount, {0.0f, 0.0f, 0.0f}};
+        for (int i = 0; i < kAKScriptOpCount; i++) {
+            if (name == kAKOpDef[i].name) {
+                code.op = (enum AKEnemyScriptOp)i;
+                break;
+            }
+        }
+        if (code.op == kAKScriptOpCount) {
+            AKLog(kAKLogEnemyScript_1, "%d行目:命令名が不正:%s", line, name.c_str());
+            return false;
+        }
+        
+        // 引数を解析する
+        if (tokens.size() > 4) {
+            AKLog(kAKLogEnemyScript_1, "%d行目:引数が多すぎる", line);
+            return false;
+        }
+        for (size_t i = 1; i < tokens.size(); i++) {
+            
+            // 飛び先のラベルはスクリプトの終わりで解決する
+            if (tokens[i][0] == '@' && (int)i - 1 == kAKOpDef[code.op].target) {
+                struct AKEnemyScriptLabel reference = {tokens[i].substr(1), (int)_codes.size() - _scriptDefs.back().codeStart, line};
+                references.push_back(reference);
+                continue;
+            }
+            
+            if (!parseValue(tokens[i], &code.arg[i - 1])) {
+                AKLog(kAKLogEnemyScript_1, "%d行目:値が不正:%s", line, tokens[i].c_str());
+                return false;
+            }
+        }
+        _codes.push_back(code);
+    }
+    
+    // 最後のスクリプトのラベルを解決して内容を確認する
+    if (!_scriptDefs.empty() &&
+        (!resolveLabels(_scriptDefs.back(), labels, references) || !checkScript(_scriptDefs.back()))) {
+        return false;
+    }
+    
+    // 配列の要素数が確定したため、各スクリプトの命令列と弾発射パターンの位置を設定する
+    for (size_t i = 0; i < _scriptDefs.size(); i++) {
+        
+        struct AKEnemyScriptDef &def = _scriptDefs[i];
+        int codeEnd = (i + 1 < _scriptDefs.size() ? _scriptDefs[i + 1].codeStart : (int)_codes.size());
+        int patternEnd = (i + 1 < _scriptDefs.size() ? _scriptDefs[i + 1].patternStart : (int)_patterns.size());
+        
+        def.script.code = &_codes[def.codeStart];
+        def.script.codeCount = codeEnd - def.codeStart;
+        def.script.patterns = (patternEnd > def.patternStart ? &_patterns[def.patternStart] : NULL);
+        def.script.patternCount = patternEnd - def.patternStart;
+    }
+    
+    AKLog(kAKLogEnemyScript_1, "動作スクリプト読み込み:script=%d code=%d pattern=%d",
+          (int)_scriptDefs.size(), (int)_codes.size(), (int)_patterns.size());
+    
+    return true;
+}
+
+/*!
+ @brief スクリプト内容のハッシュ値計算
+ 
+ すべての動作スクリプトの命令列と弾発射パターンの内容からハッシュ値を計算する。
+ 弾発射パターンは構造体の詰め物を含めないように、メンバごとに計算する。
+ @return ハッシュ値
+ */
+unsigned int AKEnemyScriptTable::calcHash()
+{
+    unsigned int hash = kAKHashOffsetBasis;
+    
+    for (const struct AKEnemyScriptDef &def : _scriptDefs) {
+        
+        const struct AKEnemyScript *script = &def.script;
+        hash = AKCalcHash(&def.type, sizeof(def.type), hash);
+        hash = AKCalcHash(&script->codeCount, sizeof(script->codeCount), hash);
+        
+        // 命令列
+        for (int i = 0; i < script->codeCount; i++) {
+            const struct AKEnemyCode &code = script->code[i];
+            hash = AKCalcHash(&code.op, sizeof(code.op), hash);
+            hash = AKCalcHash(code.arg, sizeof(code.arg), hash);
+        }
+        
+        // 弾発射パターン
+        hash = AKCalcHash(&script->patternCount, sizeof(script->patternCount), hash);
+        for (int i = 0; i < script->patternCount; i++) {
+            const struct AKShotPattern &pattern = script->patterns[i];
+            hash = AKCalcHash(&pattern.count, sizeof(pattern.count), hash);
+            hash = AKCalcHash(&pattern.interval, sizeof(pattern.interval), hash);
+            hash = AKCalcHash(&pattern.speed, sizeof(pattern.speed), hash);
+            hash = AKCalcHash(&pattern.aim, sizeof(pattern.aim), hash);
+            hash = AKCalcHash(&pattern.angle, sizeof(pattern.angle), hash);
+            hash = AKCalcHash(&pattern.isScroll, sizeof(pattern.isScroll), hash);
+            hash = AKCalcHash(&pattern.distance, sizeof(pattern.distance), hash);
+            hash = AKCalcHash(&pattern.delay, sizeof(pattern.delay), hash);
+            hash = AKCalcHash(&pattern.delaySpeed, sizeof(pattern.delaySpeed), hash);
+        }
+    }
+    return hash;
+}
+
+#ifdef DEBUG
+/*!
+ @brief 命令実行の記録
+ 
+ 命令種別ごとの実行回数と処理時間を加算する。
+ @param op 命令種別
+ @param nanoseconds 処理時間(ナノ秒)
+ */
+void AKEnemyScriptTable::addProfile(enum AKEnemyScriptOp op, long long nanoseconds)
+{
+    AKAssert(op >= 0 && op < kAKScriptOpCount, "命令種別が範囲外:%d", op);
+    
+    _opCount[op]++;
+    _opTime[op] += nanoseconds;
+}
+
+/*!
+ @brief 命令実行の集計結果出力
+ 
+ 命令種別ごとの実行回数と処理時間をログに出力し、集計結果をリセットする。
+ */
+void AKEnemyScriptTable::outputProfile()
+{
+    for (int i = 0; i < kAKScriptOpCount; i++) {
+        
+        AKLog(kAKLogEnemyScript_1 && _opCount[i] > 0,
+              "%s: count=%d time=%lldns",
+              kAKOpDef[i].name, _opCount[i], _opTime[i]);
+        
+        _opCount[i] = 0;
+        _opTime[i] = 0;
+    }
+}
+#endif
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2015 Akihiro Kaneda.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1.Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   2.Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   3.Neither the name of the Monochrome Soft nor the names of its contributors
+ *     may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!
+ @file AKEnemyScript.h
+ @brief 敵動作スクリプト定義
+ 
+ 敵の動作を記述するスクリプトの命令と、敵種別ごとのスクリプトテーブルを定義する。
+ スクリプトはリソースのテキストファイルに記述し、起動後に一度だけ読み込む。
+ */
+
+#ifndef AKENEMYSCRIPT_H
+#define AKENEMYSCRIPT_H
+
+#include "AKToritoma.h"
+#include "AKShotPattern.h"
+
+/// 敵動作スクリプトの命令種別
+enum AKEnemyScriptOp {
+    kAKScriptOpEnd = 0,         ///< 終了(以降は何もしない)
+    kAKScriptOpWait,            ///< 待機(arg0:待機フレーム数)
+    kAKScriptOpJump,            ///< ジャンプ(arg0:飛び先)
+    kAKScriptOpLoopSet,         ///< ループ回数設定(arg0:回数)
+    kAKScriptOpLoop,            ///< ループ(カウンタを減らし、0でなければarg0へジャンプ)
+    kAKScriptOpBranch2ndLoop,   ///< 周回分岐(2周目の場合arg0へジャンプ)
+    kAKScriptOpBranchHitPoint,  ///< HP分岐(HPがarg1以下の場合arg0へジャンプ)
+    kAKScriptOpSpeed,           ///< 速度設定(arg0:x方向の速度、arg1:y方向の速度)
+    kAKScriptOpStop,            ///< 停止(スクロールスピードに合わせて停止する)
+    kAKScriptOpScroll,          ///< スクロール影響設定(arg0:スクロールの影響の割合)
+    kAKScriptOpAim,             ///< 自機へ向かって移動(arg0:速さ、arg1:自機狙い移動のフラグ)
+    kAKScriptOpAnimation,       ///< アニメーション設定(arg0:パターン数、arg1:間隔、arg2:初期パターン)
+    kAKScriptOpFire,            ///< 弾発射(arg0:弾発射パターン番号、arg1:発射する周回)
+    kAKScriptOpSpawn,           ///< 敵生成(arg0:敵種別、arg1:x方向のずれ、arg2:y方向のずれ)
+    kAKScriptOpReverse,         ///< 逆さま判定(天井と地面の近い方に張り付く)
+    kAKScriptOpMode,            ///< 常時処理設定(arg0:常時処理のフラグ)
+    kAKScriptOpAccel,           ///< 加速度設定(arg0:x方向の加速度、arg1:y方向の加速度)
+    kAKScriptOpBlockHit,        ///< 障害物衝突時の処理設定(arg0:衝突時の処理)
+    kAKScriptOpChase,           ///< 自機のy座標へ向かって移動(arg0:x方向の速度、arg1:到達までのフレーム数)
+    kAKScriptOpEvery,           ///< 定周期発射設定(arg0:間隔、arg1:実行する弾発射命令の位置)
+    kAKScriptOpCount            ///< 命令種別の数
+};
+
+/// 常時処理のフラグ(毎フレーム行う処理)
+enum AKEnemyScriptMode {
+    kAKScriptModeNone = 0,      ///< なし
+    kAKScriptModeBlock = 1,     ///< 足元の障害物に合わせて移動する
+    kAKScriptModeFace = 2,      ///< 移動方向へ向く(停止中は自機の方を向く)
+    kAKScriptModeLand = 4,      ///< 落ちていく方向の障害物に接触したら着地して停止する
+    kAKScriptModeAll = 7        ///< すべてのフラグ
+};
+
+/// 自機狙い移動のフラグ
+enum AKEnemyScriptAim {
+    kAKScriptAimRotate = 1,     ///< 画像を移動方向へ回転する
+    kAKScriptAimForward = 2     ///< 後ろには戻らないようにx方向は常に左にする
+};
+
+/// 弾を発射する周回
+enum AKEnemyScriptLoop {
+    kAKScriptLoopAll = 0,       ///< すべての周回
+    kAKScriptLoop2nd,           ///< 2周目のみ
+    kAKScriptLoop1st            ///< 1周目のみ
+};
+
+/*!
+ @brief 敵動作スクリプトの命令
+ 
+ 引数はすべてfloatで保持し、飛び先や回数は整数に変換して使用する。
+ */
+struct AKEnemyCode {
+    enum AKEnemyScriptOp op;    ///< 命令種別
+    float arg[3];               ///< 引数
+};
+
+/*!
+ @brief 敵動作スクリプト
+ 
+ 命令列と命令列から参照する弾発射パターンの組み合わせ。
+ */
+struct AKEnemyScript {
+    const struct AKEnemyCode *code;         ///< 命令列
+    int codeCount;                          ///< 命令数
+    const struct AKShotPattern *patterns;   ///< 弾発射パターン
+    int patternCount;                       ///< 弾発射パターン数
+};
+
+/*!
+ @brief 敵動作スクリプトテーブルクラス
+ 
+ 敵種別ごとの動作スクリプトを管理する。
+ スクリプトファイルは起動後に一度だけ解析して命令列と弾発射パターンの配列に展開し、
+ 実行中はその配列を参照するのみでメモリの確保は行わない。
+ デバッグ時は命令種別ごとの実行回数と処理時間を集計する。
+ */
+class AKEnemyScriptTable {
+public:
+    // スクリプトファイル読み込み
+    static void load();
+    // 敵種別に対応するスクリプト取得
+    static const struct AKEnemyScript* getScript(int type);
+    // スクリプト内容のハッシュ値取得
+    static unsigned int getHash();
+    
+#ifdef DEBUG
+    // 命令実行の記録
+    static void addProfile(enum AKEnemyScriptOp op, long long nanoseconds);
+    // 命令実行の集計結果出力
+    static void outputProfile();
+#endif
+    
+private:
+    // スクリプトファイル解析
+    static bool parse(const char *text, size_t size);
+    // スクリプト内容のハッシュ値計算
+    static unsigned int calcHash();
+};
+
+#endif
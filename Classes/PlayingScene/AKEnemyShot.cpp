@@ -66,8 +66,8 @@ static const struct AKEnemyShotImageDef kAKEnemyShotImageDef[kAKEnemyShotImageDe
 
 /// 敵弾の定義
 const struct AKEnemyShot::AKEnemyShotDef AKEnemyShot::kAKEnemyShotDef[AKEnemyShot::kAKEnemyShotTypeDefCount] = {
-    {&AKEnemyShot::actionNone, 1, 6, 6, 20},            // 標準弾
-    {&AKEnemyShot::actionChangeSpeed, 1, 6, 6, 20}      // 速度変更弾
+    {1, 6, 6, 20},  // 標準弾
+    {1, 6, 6, 20}   // 速度変更弾
 };
 
 /*!
@@ -93,45 +93,39 @@ void AKEnemyShot::setGrazePoint(float grazePoint)
 }
 
 /*!
- @brief 通常弾生成
+ @brief 速度指定による通常弾生成
  
- 通常弾を生成する。
+ x方向とy方向の速度を指定して通常弾を生成する。
  @param position 生成位置
- @param angle 進行方向
- @param speed スピード
+ @param speed 速度
  @param parent 配置する親ノード
  */
 void AKEnemyShot::createNormalShot(const Vec2 &position,
-                                   float angle,
-                                   float speed,
+                                   const Vec2 &speed,
                                    Node *parent)
 {
     // 種別に通常弾を指定して生成を行う
     createEnemyShot(kAKEnemyShotTypeNormal,
                     position,
-                    angle,
                     speed,
                     parent);
 }
 
 /*!
- @brief スクロール影響弾生成
+ @brief 速度指定によるスクロール影響弾生成
  
- スクリールスピードの影響を受ける弾を生成する。
+ x方向とy方向の速度を指定してスクロールスピードの影響を受ける弾を生成する。
  @param position 生成位置
- @param angle 進行方向
- @param speed スピード
+ @param speed 速度
  @param parent 配置する親ノード
  */
 void AKEnemyShot::createScrollShot(const Vec2 &position,
-                                   float angle,
-                                   float speed,
+                                   const Vec2 &speed,
                                    Node *parent)
 {
     // 種別に通常弾を指定して生成を行う
     createEnemyShot(kAKEnemyShotTypeNormal,
                     position,
-                    angle,
                     speed,
                     parent);
     
@@ -140,29 +134,24 @@ void AKEnemyShot::createScrollShot(const Vec2 &position,
 }
 
 /*!
- @brief 速度変更弾生成
-
- 途中で速度を変更する弾を生成する。
+ @brief 速度指定による速度変更弾生成
+ 
+ x方向とy方向の速度を指定して途中で速度を変更する弾を生成する。
  @param position 生成位置
- @param angle 進行方向
- @param speed スピード
+ @param speed 速度
  @param changeInterval 変更までの間隔
- @param changeAngle 変更後の角度
- @param changeSpeed 変更後のスピード
+ @param changeSpeed 変更後の速度
  @param parent 配置する親ノード
  */
 void AKEnemyShot::createChangeSpeedShot(const Vec2 &position,
-                                        float angle,
-                                        float speed,
+                                        const Vec2 &speed,
                                         int changeInterval,
-                                        float changeAngle,
-                                        float changeSpeed,
+                                        const Vec2 &changeSpeed,
                                         Node *parent)
 {
     // 種別に速度変更弾を指定して生成を行う
     createEnemyShot(kAKEnemyShotTypeChangeSpeed,
                     position,
-                    angle,
                     speed,
                     parent);
     
@@ -170,8 +159,8 @@ void AKEnemyShot::createChangeSpeedShot(const Vec2 &position,
     m_changeInterval = changeInterval;
     
     // 変更後のスピードを設定する
-    m_changeSpeedX = cosf(changeAngle) * changeSpeed;
-    m_changeSpeedY = sinf(changeAngle) * changeSpeed;
+    m_changeSpeedX = changeSpeed.x;
+    m_changeSpeedY = changeSpeed.y;
 }
 
 /*!
@@ -202,8 +191,8 @@ void AKEnemyShot::createReflectShot(AKEnemyShot *base, Node *parent)
     // 状態をクリアする
     m_state = 0;
     
-    // 動作処理をなしにする
-    m_action = &AKEnemyShot::actionNone;
+    // 等速直線移動は次の移動時に計算する
+    resetLinearMove();
     
     // 画像名を作成する
     setImageName(*base->getImageName());
@@ -231,19 +220,87 @@ void AKEnemyShot::createReflectShot(AKEnemyShot *base, Node *parent)
 }
 
 /*!
- @brief キャラクター固有の動作
+ @brief 通常弾の移動処理
+ 
+ スピード一定のまま進める。
+ 通常弾、スクロール影響弾、反射弾は種別ごとの分岐を行わずにこの処理で移動する。
+ 速度が変わらないため、毎フレームの積算と画面外判定を行わない等速直線移動を使用する。
+ @param data ゲームデータ
+ */
+void AKEnemyShot::moveNormal(AKPlayDataInterface *data)
+{
+    // 等速直線移動を行う
+    if (moveLinear(data)) {
+        
+        // 動作開始からのフレーム数をカウントする
+        m_frame++;
+    }
+}
+
+/*!
+ @brief 速度変更弾の移動処理
  
- 生成時に指定されたセレクタを呼び出す。
- @param dt フレーム更新間隔
+ 途中で速度を変更する。
  @param data ゲームデータ
  */
-void AKEnemyShot::action(AKPlayDataInterface *data)
+void AKEnemyShot::moveChangeSpeed(AKPlayDataInterface *data)
 {
-    // 動作開始からのフレーム数をカウントする
-    m_frame++;
+    // キャラクター共通の移動処理を行う
+    if (moveCommon(data)) {
+        
+        // 動作開始からのフレーム数をカウントする
+        m_frame++;
+        
+        // 速度変更までの間隔が経過している場合は速度を変更する
+        if (m_frame >= m_changeInterval) {
+            
+            m_speedX = m_changeSpeedX;
+            m_speedY = m_changeSpeedY;
+        }
+    }
+}
+
+/*!
+ @brief スナップショット書き込み
+ 
+ キャラクター共通の状態に続けて、敵弾固有の状態を書き込む。
+ @param writer 書き込み先
+ */
+void AKEnemyShot::writeSnapshot(AKSnapshotWriter *writer)
+{
+    AKCharacter::writeSnapshot(writer);
+    if (m_isStaged) {
+        writer->write(m_frame);
+        writer->write(m_state);
+        writer->write(m_grazePoint);
+        writer->write(m_changeInterval);
+        writer->write(m_changeSpeedX);
+        writer->write(m_changeSpeedY);
+    }
+}
 
-    // 敵弾種別ごとの処理を実行
-    (this->*m_action)(data);
+/*!
+ @brief スナップショット読み込み
+ 
+ writeSnapshotで書き込んだ状態を読み込む。
+ @param reader 読み込み元
+ @param parent 配置する親ノード
+ @return 読み込めたかどうか
+ */
+bool AKEnemyShot::readSnapshot(AKSnapshotReader *reader, Node *parent)
+{
+    if (!AKCharacter::readSnapshot(reader, parent)) {
+        return false;
+    }
+    if (m_isStaged) {
+        reader->read(&m_frame);
+        reader->read(&m_state);
+        reader->read(&m_grazePoint);
+        reader->read(&m_changeInterval);
+        reader->read(&m_changeSpeedX);
+        reader->read(&m_changeSpeedY);
+    }
+    return !reader->isError();
 }
 
 /*!
@@ -252,22 +309,20 @@ void AKEnemyShot::action(AKPlayDataInterface *data)
  敵の弾を生成する。
  @para, type 種別
  @param position 生成位置
- @param angle 進行方向
- @param speed スピード
+ @param speed 速度
  @param parent 配置する親ノード
  */
 void AKEnemyShot::createEnemyShot(int type,
                                   const Vec2 &position,
-                                  float angle,
-                                  float speed,
+                                  const Vec2 &speed,
                                   Node *parent)
 {
     // パラメータの内容をメンバに設定する
     m_position = position;
     
-    // スピードをxとyに分割して設定する
-    m_speedX = cos(angle) * speed;
-    m_speedY = sin(angle) * speed;
+    // スピードを設定する
+    m_speedX = speed.x;
+    m_speedY = speed.y;
     
     // 配置フラグを立てる
     m_isStaged = true;
@@ -278,8 +333,8 @@ void AKEnemyShot::createEnemyShot(int type,
     // 状態をクリアする
     m_state = 0;
     
-    // 動作処理を設定する
-    m_action = kAKEnemyShotDef[type].action;
+    // 等速直線移動は次の移動時に計算する
+    resetLinearMove();
     
     // 画像定義を取得する
     const struct AKEnemyShotImageDef *imageDef = &kAKEnemyShotImageDef[kAKEnemyShotDef[type].image - 1];
@@ -314,30 +369,3 @@ void AKEnemyShot::createEnemyShot(int type,
     // レイヤーに配置する
     parent->addChild(getImage());
 }
-
-/*!
- @brief 動作処理なし
- 
- スピード一定のまま進めるため、無処理。
- @param data ゲームデータ
- */
-void AKEnemyShot::actionNone(AKPlayDataInterface *data)
-{
-    
-}
-
-/*!
- @brief 速度変更
- 
- 途中で速度を変更する。
- @param data ゲームデータ
- */
-void AKEnemyShot::actionChangeSpeed(AKPlayDataInterface *data)
-{
-    // 速度変更までの間隔が経過している場合は速度を変更する
-    if (m_frame >= m_changeInterval) {
-        
-        m_speedX = m_changeSpeedX;
-        m_speedY = m_changeSpeedY;
-    }
-}
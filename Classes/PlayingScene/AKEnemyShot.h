@@ -41,12 +41,8 @@
 // 敵の発射する弾のクラス
 class AKEnemyShot : public AKCharacter {
 private:
-    /// 動作処理関数
-    typedef void (AKEnemyShot::*ACTION_FUNC)(AKPlayDataInterface *data);
-        
     /// 敵弾種別定義
     struct AKEnemyShotDef {
-        AKEnemyShot::ACTION_FUNC action; ///< 動作処理
         int image;          ///< 画像ID
         int hitWidth;       ///< 当たり判定の幅
         int hitHeight;      ///< 当たり判定の高さ
@@ -68,8 +64,6 @@ private:
     int m_frame;
     /// 動作状態(各敵種別で使用)
     int m_state;
-    /// 動作処理
-    ACTION_FUNC m_action;
     /// かすりポイント
     float m_grazePoint;
     /// 速度変更までの間隔
@@ -84,44 +78,37 @@ public:
     float getGrazePoint();
     // かすりポイント設定
     void setGrazePoint(float grazePoint);
-    // 通常弾生成
+    // 速度指定による通常弾生成
     void createNormalShot(const cocos2d::Vec2 &position,
-                          float angle,
-                          float speed,
+                          const cocos2d::Vec2 &speed,
                           cocos2d::Node *parent);
-    // スクロール影響弾生成
+    // 速度指定によるスクロール影響弾生成
     void createScrollShot(const cocos2d::Vec2 &position,
-                          float angle,
-                          float speed,
+                          const cocos2d::Vec2 &speed,
                           cocos2d::Node *parent);
-    // 速度変更弾生成
+    // 速度指定による速度変更弾生成
     void createChangeSpeedShot(const cocos2d::Vec2 &position,
-                               float angle,
-                               float speed,
+                               const cocos2d::Vec2 &speed,
                                int changeInterval,
-                               float changeAngle,
-                               float changeSpeed,
+                               const cocos2d::Vec2 &changeSpeed,
                                cocos2d::Node *parent);
     // 反射弾生成
     void createReflectShot(AKEnemyShot *base, cocos2d::Node *parent);
+    // 通常弾の移動処理
+    void moveNormal(AKPlayDataInterface *data);
+    // 速度変更弾の移動処理
+    void moveChangeSpeed(AKPlayDataInterface *data);
+    // スナップショット書き込み
+    void writeSnapshot(AKSnapshotWriter *writer);
+    // スナップショット読み込み
+    bool readSnapshot(AKSnapshotReader *reader, cocos2d::Node *parent);
 
-protected:
-    // キャラクター固有の動作
-    virtual void action(AKPlayDataInterface *data);
-    
 private:
     // 敵弾生成
     void createEnemyShot(int type,
                          const cocos2d::Vec2 &position,
-                         float angle,
-                         float speed,
+                         const cocos2d::Vec2 &speed,
                          cocos2d::Node *parent);
-    // 種別から動作処理を判定
-    ACTION_FUNC getActionOfType(int type);
-    // 動作処理なし
-    void actionNone(AKPlayDataInterface *data);
-    // 速度変更
-    void actionChangeSpeed(AKPlayDataInterface *data);
 };
 
 #endif
@@ -88,7 +88,8 @@ m_fullFileName(fullFileName),
 m_imageWidth(width),
 m_imageHeight(height),
 m_isHorizontal(isHorizontal),
-m_percent(0.0f)
+m_percent(0.0f),
+m_displayLength(-1)
 {
     // 空画像を読み込む
     m_emptyImage = Sprite::create(m_emptyFileName);
@@ -141,6 +142,7 @@ AKGauge::~AKGauge()
  
  ゲージの溜まっている比率を設定する。
  満ゲージの幅を更新する。
+ 非表示の場合は比率の保存のみ行い、画像は表示に切り替えた時に更新する。
  @param parcent ゲージの溜まっている比率
  */
 void AKGauge::setPercent(float percent)
@@ -148,21 +150,48 @@ void AKGauge::setPercent(float percent)
     // メンバに設定する。
     m_percent = percent;
     
+    // 非表示の場合は画像を更新しない
+    if (!m_fullImage->isVisible()) {
+        return;
+    }
+    
+    // 満ゲージの画像を更新する
+    updateFullImage();
+}
+
+/*!
+ @brief 満ゲージ画像の更新
+ 
+ ゲージの溜まっている比率に合わせて満ゲージの画像の範囲を更新する。
+ 表示上の長さがドット単位で変わらない場合は画像の更新を行わない。
+ */
+void AKGauge::updateFullImage()
+{
+    // 表示上のゲージの長さを計算する
+    float length = (m_isHorizontal ? m_imageWidth : m_imageHeight) * m_percent / 100.0f;
+    int displayLength = (int)roundf(AKScreenSize::deviceLength(length));
+    
+    // 表示上の長さが変わっていない場合は画像を更新しない
+    if (displayLength == m_displayLength) {
+        return;
+    }
+    m_displayLength = displayLength;
+    
     // 水平方向の場合、満ゲージの幅を更新する。
     // 垂直方向の場合、満ゲージの高さを更新する。
     Rect rect;
     if (m_isHorizontal) {
         rect = AKScreenSize::deviceRect(0.0f,
                                         0.0f,
-                                        m_imageWidth * percent / 100.0f,
+                                        m_imageWidth * m_percent / 100.0f,
                                         m_imageHeight);
     }
     else {
         rect = AKScreenSize::deviceRect(0.0f,
-                                        m_imageHeight * (100.0f - percent) / 100.0f,
+                                        m_imageHeight * (100.0f - m_percent) / 100.0f,
                                         m_imageWidth,
-                                        m_imageHeight * percent / 100.0f);
-        AKLog(kAKLogGauge_1, "percent=%f y=%f h=%f", percent, rect.origin.y, rect.size.height);
+                                        m_imageHeight * m_percent / 100.0f);
+        AKLog(kAKLogGauge_1, "percent=%f y=%f h=%f", m_percent, rect.origin.y, rect.size.height);
     }
     m_fullImage->setTextureRect(rect);
 }
@@ -171,10 +200,16 @@ void AKGauge::setPercent(float percent)
  @brief 表示非表示切替
  
  表示非表示を切り替える。
+ 表示に切り替えた場合は非表示中に設定された比率を画像に反映する。
  @param 表示非表示
  */
 void AKGauge::setVisible(bool visible)
 {
     m_emptyImage->setVisible(visible);
     m_fullImage->setVisible(visible);
+    
+    // 表示に切り替えた場合は満ゲージの画像を更新する
+    if (visible) {
+        updateFullImage();
+    }
 }
\ No newline at end of file
@@ -67,10 +67,14 @@ private:
     int m_imageHeight;
     /// ゲージの溜まっている比率
     float m_percent;
+    /// 表示中のゲージの長さ(ドット数)
+    int m_displayLength;
     /// 水平方向かどうか
     bool m_isHorizontal;
     // デフォルトコンストラクタは使用不可とする
     AKGauge();
+    // 満ゲージ画像の更新
+    void updateFullImage();
     
 public:
     // コンストラクタ
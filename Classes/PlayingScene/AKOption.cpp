@@ -47,8 +47,6 @@ static const int kAKOptionAnimationCountOfShieldOff = 2;
 static const int kAKOptionAnimationCountOfShieldOn = 1;
 /// 弾発射の間隔
 static const int kAKOptionShotInterval = 12;
-/// オプション間の距離
-static const int kAKOptionSpace = 20;
 /// オプションの当たり判定
 static const int kAKOptionSize = 32;
 
@@ -214,12 +212,12 @@ void AKOption::setOptionCount(int count, const Vec2 &position)
 void AKOption::movePosition(const Vec2 &position, const cocos2d::Vec2 &distance)
 {
     // 移動先座標が間隔分溜まっている場合は先頭の座標を削除する
-    if (m_movePositions.size() >= kAKOptionSpace) {
-        m_movePositions.erase(m_movePositions.begin());
+    if (m_movePositions.full()) {
+        m_movePositions.pop();
     }
     
     // 移動先座標の配列の末尾に追加する
-    m_movePositions.push_back(position);
+    m_movePositions.push(position);
     
     // 次のオプションが存在する場合は次のオプションも移動する
     if (m_next != NULL && m_next->isStaged()) {
@@ -247,18 +245,17 @@ void AKOption::setPosition(const Vec2 &position)
     }
     
     // 移動先座標が間隔分溜まっている場合は先頭の座標に移動する
-    if (m_movePositions.size() >= kAKOptionSpace) {
+    if (m_movePositions.full()) {
         
         // 先頭の要素を取得し、座標を移動する
-        std::vector<Vec2>::iterator start = m_movePositions.begin();
-        m_position = *start;
+        m_position = m_movePositions.front();
         
-        // 取得した要素を配列から取り除く
-        m_movePositions.erase(start);
+        // 取得した要素を取り除く
+        m_movePositions.pop();
     }
     
     // 移動先座標の配列の末尾に追加する
-    m_movePositions.push_back(position);
+    m_movePositions.push(position);
 }
 
 /*!
@@ -284,6 +281,82 @@ AKOption* AKOption::getNext()
     return m_next;
 }
 
+/*!
+ @brief スナップショット書き込み
+ 
+ キャラクター共通の状態に続けて、弾発射までのフレーム数と移動座標を書き込む。
+ 次のオプションに対しても同様に書き込む。
+ シールド有無は自機側で設定し直すため書き込まない。
+ @param writer 書き込み先
+ */
+void AKOption::writeSnapshot(AKSnapshotWriter *writer)
+{
+    AKCharacter::writeSnapshot(writer);
+    if (m_isStaged) {
+        
+        // 弾発射までの残りフレーム数を書き込む
+        writer->write(m_shootFrame);
+        
+        // 移動座標を古い順に書き込む
+        writer->write(m_movePositions.size());
+        for (int i = m_movePositions.size() - 1; i >= 0; i--) {
+            writer->write(m_movePositions.lookback(i));
+        }
+    }
+    
+    // 次のオプションの状態を書き込む
+    if (m_next != NULL) {
+        m_next->writeSnapshot(writer);
+    }
+}
+
+/*!
+ @brief スナップショット読み込み
+ 
+ writeSnapshotで書き込んだ状態を読み込む。
+ 画像は常に親ノードに配置されているため、表示の切り替えのみ行う。
+ @param reader 読み込み元
+ @return 読み込めたかどうか
+ */
+bool AKOption::readSnapshot(AKSnapshotReader *reader)
+{
+    if (!AKCharacter::readSnapshot(reader, NULL)) {
+        return false;
+    }
+    
+    // 移動座標をクリアする
+    m_movePositions.clear();
+    
+    if (m_isStaged) {
+        
+        // 弾発射までの残りフレーム数を読み込む
+        reader->read(&m_shootFrame);
+        
+        // 移動座標を読み込む
+        int count = 0;
+        reader->read(&count);
+        if (count < 0 || count > kAKOptionSpace) {
+            reader->setError();
+        }
+        for (int i = 0; i < count && !reader->isError(); i++) {
+            Vec2 position;
+            reader->read(&position);
+            m_movePositions.push(position);
+        }
+    }
+    
+    if (reader->isError()) {
+        return false;
+    }
+    
+    // 次のオプションの状態を読み込む
+    if (m_next != NULL) {
+        return m_next->readSnapshot(reader);
+    }
+    
+    return true;
+}
+
 /*!
  @brief キャラクター固有の動作
  
@@ -37,6 +37,7 @@
 #define AKOPTION_H
 
 #include "AKCharacter.h"
+#include "AKRingBuffer.h"
 
 /*!
  @brief オプションクラス
@@ -44,9 +45,13 @@
  オプションを管理するクラス。
  */
 class AKOption : public AKCharacter {
+private:
+    /// オプション間の距離(移動座標を保持するフレーム数)
+    static const int kAKOptionSpace = 20;
+    
 private:
     /// 移動座標
-    std::vector<cocos2d::Vec2> m_movePositions;
+    AKRingBuffer<cocos2d::Vec2, kAKOptionSpace> m_movePositions;
     /// 弾発射までの残りフレーム数
     int m_shootFrame;
     /// 次のオプション
@@ -75,12 +80,16 @@ public:
     void optionMove(AKPlayDataInterface *data);
     // 次のオプション取得
     AKOption* getNext();
+    // スナップショット書き込み
+    void writeSnapshot(AKSnapshotWriter *writer);
+    // スナップショット読み込み
+    bool readSnapshot(AKSnapshotReader *reader);
+    // 衝突処理
+    virtual void hit(AKCharacter *character, AKPlayDataInterface *data);
 
 protected:
     // キャラクター固有の動作
     virtual void action(AKPlayDataInterface *data);
-    // 衝突処理
-    virtual void hit(AKCharacter *character, AKPlayDataInterface *data);
 };
 
 #endif
@@ -40,22 +40,20 @@
 #include "AKEnemy.h"
 #include "AKEffect.h"
 #include "AKBlock.h"
-#include "AKNWayAngle.h"
-#include "OnlineScore.h"
+#include "ScoreSubmitter.h"
 #include "SettingFileIO.h"
 #include "string.h"
 
 using std::chrono::system_clock;
 using std::chrono::duration_cast;
 using std::chrono::milliseconds;
+using std::chrono::microseconds;
 using std::vector;
 using cocos2d::Node;
 using cocos2d::Vec2;
-using cocos2d::SpriteFrameCache;
 using cocos2d::SpriteBatchNode;
 using cocos2d::Application;
 using cocos2d::LanguageType;
-using CocosDenshion::SimpleAudioEngine;
 using aklib::LocalizedResource;
 
 /// ステージの数
@@ -71,14 +69,12 @@ static const int kAKMaxPlayerShotCount = 128;
 static const int kAKMaxEnemyCount = 32;
 /// 敵弾の同時出現最大数
 static const int kAKMaxEnemyShotCount = 512;
+/// 速度変更弾の同時出現最大数
+static const int kAKMaxChangeSpeedShotCount = 256;
 /// 画面効果の同時出現最大数
 static const int kAKMaxEffectCount = 64;
 /// 障害物の同時出現最大数
 static const int kAKMaxBlockCount = 128;
-/// キャラクターテクスチャアトラス定義ファイル名
-const char *kAKTextureAtlasDefFile = "Character.plist";
-/// キャラクターテクスチャアトラスファイル名
-const char *kAKTextureAtlasFile = "Character.png";
 // TODO:ハイスコア処理作成
 /// ハイスコアファイル名
 //static const char *kAKDataFileName = "hiscore.dat";
@@ -97,6 +93,14 @@ static const int kAKExtendScore = 10000;
 static const int kAKClearWait = 540;
 /// ボス体力ゲージ最小値
 static const float kAKBossLifeMin = 4.0f;
+/// スコア表示を実際のスコアに近づける割合の分母
+static const int kAKScoreRollDivision = 4;
+/// 乱数の初期値
+static const unsigned int kAKRandomSeed = 2463534242u;
+/// スナップショットの識別子("AKSS")
+static const unsigned int kAKSnapshotMagic = 0x53534b41;
+/// スナップショットの形式のバージョン
+static const int kAKSnapshotVersion = 3;
 
 /// ゲームクリア時のツイートのフォーマットのキー
 //static const char *kAKGameClearTweetKey = "GameClearTweet";
@@ -121,24 +125,29 @@ enum AKCharacterPositionZ {
  @brief シーンを指定したコンストラクタ
  
  シーンをメンバに設定する。
- テクスチャアトラスを読み込む。
+ テクスチャアトラスと敵の動作スクリプトを読み込む。
  メンバの初期化を行う。
+ キャラクタープールの中身はcreateCharactersで作成する。
  @param scene プレイシーン
  */
 AKPlayData::AKPlayData(AKPlayingScene *scene) :
 m_scene(scene), m_playerShotPool(kAKMaxPlayerShotCount),
 m_reflectShotPool(kAKMaxEnemyShotCount), m_enemyPool(kAKMaxEnemyCount),
-m_enemyShotPool(kAKMaxEnemyShotCount), m_effectPool(kAKMaxEffectCount),
+m_enemyShotPool(kAKMaxEnemyShotCount), m_changeSpeedShotPool(kAKMaxChangeSpeedShotCount),
+m_effectPool(kAKMaxEffectCount),
 m_blockPool(kAKMaxBlockCount), m_tileMap(NULL), m_player(NULL), m_boss(NULL),
-m_loopCount(0), m_hiScore(0), m_playerSpeedX(0.0f), m_playerSpeedY(0.0f)
+m_loopCount(0), m_hiScore(0), m_displayScore(0), m_playerSpeedX(0.0f), m_playerSpeedY(0.0f),
+m_random(kAKRandomSeed)
 {
     // シーンを確保する
     m_scene->retain();
     
     // テクスチャアトラスを読み込む
-    SpriteFrameCache *spriteFrameCache = SpriteFrameCache::getInstance();
-    spriteFrameCache->addSpriteFramesWithFile(kAKTextureAtlasDefFile,
-                                              kAKTextureAtlasFile);
+    AKAssetLoader::getInstance()->addSpriteFrames(kAKCharacterTextureAtlasDefFile,
+                                                  kAKCharacterTextureAtlasFile);
+    
+    // 敵の動作スクリプトを読み込む
+    AKEnemyScriptTable::load();
     
     // メンバオブジェクトを生成する
     createMember();
@@ -174,8 +183,8 @@ void AKPlayData::createMember()
     for (int i = 0; i < kAKCharaPosZCount; i++) {
 
         // バッチノードをファイルから作成する
-        SpriteBatchNode *batch = SpriteBatchNode::create(kAKTextureAtlasFile, 1280);
-        AKAssert(batch, "バッチノード作成に失敗:%s", kAKTextureAtlasFile);
+        SpriteBatchNode *batch = SpriteBatchNode::create(kAKCharacterTextureAtlasFile, 1280);
+        AKAssert(batch, "バッチノード作成に失敗:%s", kAKCharacterTextureAtlasFile);
 
         // 配列に保存する
         m_batches.push_back(batch);
@@ -190,6 +199,37 @@ void AKPlayData::createMember()
                             m_batches.at(kAKCharaPosZOption));
 }
 
+/*!
+ @brief キャラクター作成
+ 
+ キャラクタープールのキャラクターを指定数を上限に作成する。
+ プールは宣言順に1つずつ作成していき、作成済みのプールは飛ばす。
+ すべてのプールの作成が終わるまで繰り返し呼び出す。
+ @param count 作成する数の上限
+ @return すべてのプールの作成が終わったかどうか
+ */
+bool AKPlayData::createCharacters(int count)
+{
+    // 各プールで作成した数を上限から差し引いていく
+    count -= m_playerShotPool.createCharacters(count);
+    count -= m_reflectShotPool.createCharacters(count);
+    count -= m_enemyPool.createCharacters(count);
+    count -= m_enemyShotPool.createCharacters(count);
+    count -= m_changeSpeedShotPool.createCharacters(count);
+    count -= m_effectPool.createCharacters(count);
+    count -= m_blockPool.createCharacters(count);
+    
+    AKLog(kAKLogPlayData_1, "remain count=%d", count);
+    
+    return m_playerShotPool.isCreated() &&
+        m_reflectShotPool.isCreated() &&
+        m_enemyPool.isCreated() &&
+        m_enemyShotPool.isCreated() &&
+        m_changeSpeedShotPool.isCreated() &&
+        m_effectPool.isCreated() &&
+        m_blockPool.isCreated();
+}
+
 /*!
  @brief x軸方向のスクロールスピード取得
  
@@ -205,11 +245,15 @@ float AKPlayData::getScrollSpeedX()
  @brief x軸方向のスクロールスピード設定
  
  x軸方向のスクロールスピードを設定する。
+ 等速直線移動している弾はスクロールの影響を再計算させる。
  @param speed x軸方向のスクロールスピード
  */
 void AKPlayData::setScrollSpeedX(float speed)
 {
     m_scrollSpeedX = speed;
+    
+    // 等速直線移動している弾の速度と画面外に出るまでの移動回数を再計算させる
+    resetLinearMove();
 }
 
 /*!
@@ -227,11 +271,33 @@ float AKPlayData::getScrollSpeedY()
  @brief y軸方向のスクロールスピード設定
  
  y軸方向のスクロールスピードを設定する。
+ 等速直線移動している弾はスクロールの影響を再計算させる。
  @param speed y軸方向のスクロールスピード
  */
 void AKPlayData::setScrollSpeedY(float speed)
 {
     m_scrollSpeedY = speed;
+    
+    // 等速直線移動している弾の速度と画面外に出るまでの移動回数を再計算させる
+    resetLinearMove();
+}
+
+/*!
+ @brief 等速直線移動の再計算要求
+ 
+ 等速直線移動している弾に対して、次の移動時に速度と画面外に出るまでの移動回数を再計算させる。
+ */
+void AKPlayData::resetLinearMove()
+{
+    for (AKPlayerShot *playerShot : *m_playerShotPool.getPool()) {
+        playerShot->resetLinearMove();
+    }
+    for (AKEnemyShot *reflectShot : *m_reflectShotPool.getPool()) {
+        reflectShot->resetLinearMove();
+    }
+    for (AKEnemyShot *enemyShot : *m_enemyShotPool.getPool()) {
+        enemyShot->resetLinearMove();
+    }
 }
 
 /*!
@@ -266,10 +332,17 @@ void AKPlayData::clearPlayData(bool resetScore)
         readHiScore();
 
         // スコアを初期化する
+        // 表示中のスコアと同じ値になるため、スコア表示もここで更新する
         m_score = 0;
+        m_displayScore = 0;
+        m_scene->setScoreLabel(m_displayScore);
 
         // 周回数の初期化
         m_loopCount = DEBUG_MODE_START_LOOP;
+        
+        // 乱数を初期化する
+        // 毎回同じ系列とし、同じ操作であれば同じ展開になるようにする
+        m_random = kAKRandomSeed;
     }
     
     // その他のメンバを初期化する
@@ -297,6 +370,17 @@ const Vec2* AKPlayData::getPlayerPosition()
     return m_player->getPosition();
 }
 
+/*!
+ @brief ステージ番号取得
+ 
+ 現在のステージ番号を取得する。
+ @return ステージ番号
+ */
+int AKPlayData::getStage()
+{
+    return m_stage;
+}
+
 /*!
  @brief 障害物キャラクター取得
  
@@ -408,7 +492,8 @@ void AKPlayData::writeHiScore()
     setting.WriteHighScore(m_hiScore);
     
     // Game Centerにスコアを送信する
-    aklib::OnlineScore::postHighScore(m_hiScore);
+    // 送信は送信キューの専用スレッドで行うため、完了は待たない
+    aklib::ScoreSubmitter::getInstance().post(m_hiScore);
 }
 
 #pragma mark シーンクラスからのデータ操作用
@@ -518,11 +603,7 @@ void AKPlayData::update()
 #endif
     
     // 障害物を更新する
-    for (AKBlock *block : *m_blockPool.getPool()) {
-        if (block->isStaged()) {
-            block->move(this);
-        }
-    }
+    m_blockPool.update(this);
     
 #ifdef DEBUG
     // 処理途中のシステム時刻を計測する
@@ -543,11 +624,7 @@ void AKPlayData::update()
 #endif
     
     // 自機弾を更新する
-    for (AKPlayerShot *playerShot : *m_playerShotPool.getPool()) {
-        if (playerShot->isStaged()) {
-            playerShot->move(this);
-        }
-    }
+    m_playerShotPool.update(this);
     
 #ifdef DEBUG
     // 処理途中のシステム時刻を計測する
@@ -557,7 +634,7 @@ void AKPlayData::update()
     // 反射弾を更新する
     for (AKEnemyShot *refrectedShot : *m_reflectShotPool.getPool()) {
         if (refrectedShot->isStaged()) {
-            refrectedShot->move(this);
+            refrectedShot->moveNormal(this);
         }
     }
     
@@ -567,12 +644,7 @@ void AKPlayData::update()
 #endif
     
     // 敵を更新する
-    for (AKEnemy *enemy : *m_enemyPool.getPool()) {
-        if (enemy->isStaged()) {
-//            AKLog(kAKLogPlayData_3, "enemy move start.");
-            enemy->move(this);
-        }
-    }
+    m_enemyPool.update(this);
     
 #ifdef DEBUG
     // 処理途中のシステム時刻を計測する
@@ -580,9 +652,15 @@ void AKPlayData::update()
 #endif
     
     // 敵弾を更新する
+    // 種別ごとにプールを分けているため、種別による分岐は行わない
     for (AKEnemyShot *enemyShot : *m_enemyShotPool.getPool()) {
         if (enemyShot->isStaged()) {
-            enemyShot->move(this);
+            enemyShot->moveNormal(this);
+        }
+    }
+    for (AKEnemyShot *enemyShot : *m_changeSpeedShotPool.getPool()) {
+        if (enemyShot->isStaged()) {
+            enemyShot->moveChangeSpeed(this);
         }
     }
     
@@ -592,11 +670,7 @@ void AKPlayData::update()
 #endif
     
     // 画面効果を更新する
-    for (AKEffect *effect : *m_effectPool.getPool()) {
-        if (effect->isStaged()) {
-            effect->move(this);
-        }
-    }
+    m_effectPool.update(this);
     
 #ifdef DEBUG
     // 処理途中のシステム時刻を計測する
@@ -610,16 +684,17 @@ void AKPlayData::update()
             // 自機との当たり判定を行う
             std::vector<AKPlayer*> playerArray;
             playerArray.push_back(m_player);
-            block->checkHit(playerArray, this);
+            block->checkHit<AKBlock>(playerArray, this);
             
             // 自機弾との当たり判定を行う
-            block->checkHit(*m_playerShotPool.getPool(), this);
+            block->checkHit<AKBlock>(*m_playerShotPool.getPool(), this);
             
             // 敵は移動処理の中で障害物との当たり判定を処理しているので
             // ここでは処理しない。
             
             // 敵弾との当たり判定を行う
-            block->checkHit(*m_enemyShotPool.getPool(), this);
+            block->checkHit<AKBlock>(*m_enemyShotPool.getPool(), this);
+            block->checkHit<AKBlock>(*m_changeSpeedShotPool.getPool(), this);
         }
     }
     
@@ -633,10 +708,10 @@ void AKPlayData::update()
     for (AKEnemy *enemy : *m_enemyPool.getPool()) {
         
         // 自機弾との当たり判定を行う
-        isHit = enemy->checkHit(*m_playerShotPool.getPool(), this) || isHit;
+        isHit = enemy->checkHit<AKEnemy>(*m_playerShotPool.getPool(), this) || isHit;
         
         // 反射弾との当たり判定を行う
-        isHit = enemy->checkHit(*m_reflectShotPool.getPool(), this) || isHit;
+        isHit = enemy->checkHit<AKEnemy>(*m_reflectShotPool.getPool(), this) || isHit;
     }
     
 #ifdef DEBUG
@@ -646,7 +721,7 @@ void AKPlayData::update()
     
     // 敵が自機弾と当たっている場合は効果音を鳴らす
     if (isHit) {
-        SimpleAudioEngine::getInstance()->playEffect(kAKHitSEFileName);
+        AKSEScheduler::getInstance()->playEffect(kAKHitSEFileName);
     }
     
 #ifdef DEBUG
@@ -666,7 +741,8 @@ void AKPlayData::update()
             AKLog(kAKLogPlayData_2, "反射判定");
             
             // 敵弾との当たり判定を行う
-            option->checkHit(*m_enemyShotPool.getPool(), this);
+            option->checkHit<AKOption>(*m_enemyShotPool.getPool(), this);
+            option->checkHit<AKOption>(*m_changeSpeedShotPool.getPool(), this);
             
             // 次のオプションを取得する
             option = option->getNext();
@@ -678,14 +754,16 @@ void AKPlayData::update()
         
         // 自機と敵弾のかすり判定処理を行う
         m_player->graze(*m_enemyShotPool.getPool());
+        m_player->graze(*m_changeSpeedShotPool.getPool());
         
 #ifndef DEBUG_MODE_PLAYER_INVINCIBLE
         
         // 自機と敵の当たり判定処理を行う
-        m_player->checkHit(*m_enemyPool.getPool(), this);
+        m_player->checkHit<AKPlayer>(*m_enemyPool.getPool(), this);
         
         // 自機と敵弾の当たり判定処理を行う
-        m_player->checkHit(*m_enemyShotPool.getPool(), this);
+        m_player->checkHit<AKPlayer>(*m_enemyShotPool.getPool(), this);
+        m_player->checkHit<AKPlayer>(*m_changeSpeedShotPool.getPool(), this);
         
 #endif
         
@@ -707,14 +785,11 @@ void AKPlayData::update()
     checkPoints.push_back(system_clock::now());
 #endif
     
-    // チキンゲージの溜まっている比率を更新する
-    m_scene->getChickenGauge()->setPercent(m_player->getChickenGaugePercent());
-    
     // チキンゲージからオプション個数を決定する
     m_player->updateOptionCount();
     
-    // ボス体力ゲージの表示を更新する
-    updateBossLifeGage();
+    // フレーム中の変化をまとめて情報表示に反映する
+    updateHud(true);
 
 #ifdef DEBUG
     // 処理時間計測のため、処理終了時のシステム時刻を取得する
@@ -798,7 +873,7 @@ std::string AKPlayData::makeTweet()
     // 1周目と2周目以降でメッセージを変える
     if (!is2ndLoop()) {
         
-        snprintf(tweet, sizeof(tweet), LocalizedResource::getInstance().getString("Tweet1stLoop").c_str(), m_stage, m_score);
+        snprintf(tweet, sizeof(tweet), LocalizedResource::getInstance().getString(aklib::kAKLocalizedTweet1stLoop), m_stage, m_score);
         
     }
     else {
@@ -806,12 +881,12 @@ std::string AKPlayData::makeTweet()
         // 2周目以降は周回数が英語の場合は序数がつく
         if (lang == cocos2d::LanguageType::ENGLISH) {
             
-            snprintf(tweet, sizeof(tweet), LocalizedResource::getInstance().getString("Tweet2ndLoop").c_str(),
+            snprintf(tweet, sizeof(tweet), LocalizedResource::getInstance().getString(aklib::kAKLocalizedTweet2ndLoop),
                      m_stage, m_loopCount, MakeOrdinal(m_loopCount).c_str(), m_score);
         }
         else {
             
-            snprintf(tweet, sizeof(tweet), LocalizedResource::getInstance().getString("Tweet2ndLoop").c_str(),
+            snprintf(tweet, sizeof(tweet), LocalizedResource::getInstance().getString(aklib::kAKLocalizedTweet2ndLoop),
                      m_loopCount, m_stage, m_score);
         }
     }
@@ -859,6 +934,11 @@ void AKPlayData::resume()
             character->getImage()->resume();
         }
     }
+    for (AKCharacter *character : *m_changeSpeedShotPool.getPool()) {
+        if (character->hasImage()) {
+            character->getImage()->resume();
+        }
+    }
     
     // 画面効果
     for (AKCharacter *character : *m_effectPool.getPool()) {
@@ -875,6 +955,9 @@ void AKPlayData::resume()
  */
 void AKPlayData::pause()
 {
+    // 停止中の表示が実際の値とずれないように情報表示を確定させる
+    updateHud(false);
+    
     // すべてのキャラクターのアニメーションを停止する
     // 自機
     if (m_player->hasImage()) {
@@ -901,6 +984,11 @@ void AKPlayData::pause()
             character->getImage()->pause();
         }
     }
+    for (AKCharacter *character : *m_changeSpeedShotPool.getPool()) {
+        if (character->hasImage()) {
+            character->getImage()->pause();
+        }
+    }
     
     // 画面効果
     for (AKCharacter *character : *m_effectPool.getPool()) {
@@ -929,6 +1017,220 @@ void AKPlayData::restartStage(int stage)
     changeStage(stage);
 }
 
+/*!
+ @brief スナップショット書き込み
+ 
+ ゲームの状態をバイト列に書き込む。
+ キャラクターは画面に配置されているもののみ状態を書き込み、
+ ポインタで参照している敵キャラはプール内の位置に置き換える。
+ バイト列の内容はクリアしてから書き込むため、同じバッファを使い回すことで
+ メモリの確保を最初の1回のみにできる。
+ 画面表示のみの状態(スコア表示のロールアップ、ボタンの選択状態)は書き込まない。
+ @param buffer 書き込み先のバイト列
+ */
+void AKPlayData::writeSnapshot(std::vector<unsigned char> *buffer)
+{
+#ifdef DEBUG
+    // 処理時間計測のため、処理開始時のシステム時刻を取得する
+    auto begin = system_clock::now();
+#endif
+    
+    // バイト列をクリアする
+    buffer->clear();
+    AKSnapshotWriter writer(buffer);
+    
+    // 識別子とバージョン、ビルド識別子を書き込む
+    writer.write(kAKSnapshotMagic);
+    writer.write(kAKSnapshotVersion);
+    writer.write(AKEnemy::getSnapshotBuildId());
+    
+    // ゲームの進行状況を書き込む
+    writer.write(m_stage);
+    writer.write(m_clearWait);
+    writer.write(m_rebirthWait);
+    writer.write(m_life);
+    writer.write(m_score);
+    writer.write(m_hiScore);
+    writer.write(m_shield);
+    writer.write(m_hold);
+    writer.write(m_scrollSpeedX);
+    writer.write(m_scrollSpeedY);
+    writer.write(m_playerSpeedX);
+    writer.write(m_playerSpeedY);
+    writer.write(getEnemyIndex(m_boss));
+    writer.write(m_bossHP);
+    writer.write(m_loopCount);
+    writer.write(m_random);
+    
+    // タイルマップの状態を書き込む
+    m_tileMap->writeSnapshot(&writer);
+    
+    // 自機、オプションの状態を書き込む
+    m_player->writeSnapshot(&writer);
+    
+    // 自機弾、反射弾の状態を書き込む
+    m_playerShotPool.writeSnapshot(&writer);
+    m_reflectShotPool.writeSnapshot(&writer);
+    
+    // 敵キャラの状態を書き込む
+    m_enemyPool.writeSnapshot(&writer);
+    
+    // 敵キャラの親子関係をプール内の位置で書き込む
+    for (AKEnemy *enemy : *m_enemyPool.getPool()) {
+        if (enemy->isStaged()) {
+            writer.write(getEnemyIndex(enemy->getParentEnemy()));
+            writer.write(getEnemyIndex(enemy->getChildEnemy()));
+        }
+    }
+    
+    // 敵弾、画面効果、障害物の状態を書き込む
+    m_enemyShotPool.writeSnapshot(&writer);
+    m_changeSpeedShotPool.writeSnapshot(&writer);
+    m_effectPool.writeSnapshot(&writer);
+    m_blockPool.writeSnapshot(&writer);
+    
+#ifdef DEBUG
+    auto end = system_clock::now();
+    AKLog(kAKLogPlayData_1, "writeSnapshot() size=%d time=%dus",
+          (int)buffer->size(), (int)duration_cast<microseconds>(end - begin).count());
+#endif
+}
+
+/*!
+ @brief スナップショット読み込み
+ 
+ writeSnapshotで書き込んだバイト列からゲームの状態を復元する。
+ ステージが異なる場合はタイルマップを読み込み直す。
+ キャラクターの画像は作り直してバッチノードに配置し、残機やボタン等の画面表示も更新する。
+ 識別子、バージョン、ビルド識別子が異なる場合は失敗とする。
+ 失敗した場合はキャラクターをすべて削除してゲームデータを初期化するため、
+ 呼び出し側でスクリプト読み込みからやり直すこと。
+ @param buffer 読み込むバイト列
+ @return 読み込めたかどうか
+ */
+bool AKPlayData::readSnapshot(const std::vector<unsigned char> &buffer)
+{
+#ifdef DEBUG
+    // 処理時間計測のため、処理開始時のシステム時刻を取得する
+    auto begin = system_clock::now();
+#endif
+    
+    AKSnapshotReader reader(buffer.data(), buffer.size());
+    
+    // 識別子とバージョン、ビルド識別子を確認する
+    // アプリの更新をまたいだ中断データはコルーチンやスクリプトの実行位置が一致しないため使用しない
+    unsigned int magic = 0;
+    int version = 0;
+    unsigned int buildId = 0;
+    int stage = 0;
+    reader.read(&magic);
+    reader.read(&version);
+    reader.read(&buildId);
+    reader.read(&stage);
+    if (reader.isError() || magic != kAKSnapshotMagic || version != kAKSnapshotVersion ||
+        buildId != AKEnemy::getSnapshotBuildId() || stage < 1 || stage > kAKStageCount) {
+        
+        AKLog(kAKLogPlayData_0, "スナップショットの形式が不正:magic=%08x version=%d buildId=%08x stage=%d",
+              magic, version, buildId, stage);
+        clearCharacters();
+        clearPlayData(true);
+        return false;
+    }
+    
+    // ステージが異なる場合はタイルマップを読み込み直す
+    if (m_tileMap == NULL || m_stage != stage) {
+        delete m_tileMap;
+        m_tileMap = new AKTileMap(stage, m_scene->getBackgroundLayer());
+    }
+    m_stage = stage;
+    
+    // ゲームの進行状況を読み込む
+    int hiScore = 0;
+    int bossIndex = -1;
+    reader.read(&m_clearWait);
+    reader.read(&m_rebirthWait);
+    reader.read(&m_life);
+    reader.read(&m_score);
+    reader.read(&hiScore);
+    reader.read(&m_shield);
+    reader.read(&m_hold);
+    reader.read(&m_scrollSpeedX);
+    reader.read(&m_scrollSpeedY);
+    reader.read(&m_playerSpeedX);
+    reader.read(&m_playerSpeedY);
+    reader.read(&bossIndex);
+    reader.read(&m_bossHP);
+    reader.read(&m_loopCount);
+    reader.read(&m_random);
+    
+    // キャラクターの状態を読み込む
+    bool isSuccess = !reader.isError() &&
+        m_tileMap->readSnapshot(&reader) &&
+        m_player->readSnapshot(&reader) &&
+        m_playerShotPool.readSnapshot(&reader, m_batches.at(kAKCharaPosZPlayerShot)) &&
+        m_reflectShotPool.readSnapshot(&reader, m_batches.at(kAKCharaPosZPlayerShot)) &&
+        m_enemyPool.readSnapshot(&reader, m_batches.at(kAKCharaPosZEnemy));
+    
+    // 敵キャラの親子関係をプール内の位置から復元する
+    for (AKEnemy *enemy : *m_enemyPool.getPool()) {
+        if (isSuccess && enemy->isStaged()) {
+            int parentIndex = -1;
+            int childIndex = -1;
+            reader.read(&parentIndex);
+            reader.read(&childIndex);
+            enemy->setParentEnemy(getEnemyByIndex(parentIndex));
+            enemy->setChildEnemy(getEnemyByIndex(childIndex));
+        }
+    }
+    
+    isSuccess = isSuccess && !reader.isError() &&
+        m_enemyShotPool.readSnapshot(&reader, m_batches.at(kAKCharaPosZEnemyShot)) &&
+        m_changeSpeedShotPool.readSnapshot(&reader, m_batches.at(kAKCharaPosZEnemyShot)) &&
+        m_effectPool.readSnapshot(&reader, m_batches.at(kAKCharaPosZEffect)) &&
+        m_blockPool.readSnapshot(&reader, m_batches.at(kAKCharaPosZBlock)) &&
+        reader.isEnd();
+    
+    // 失敗した場合はキャラクターをすべて削除し、ゲームデータを初期化する
+    if (!isSuccess) {
+        
+        AKLog(kAKLogPlayData_0, "スナップショットの読み込みに失敗");
+        
+        clearCharacters();
+        clearPlayData(true);
+        return false;
+    }
+    
+    // ハイスコアは現在の値とスナップショットの値の大きい方を使用する
+    if (hiScore > m_hiScore) {
+        m_hiScore = hiScore;
+    }
+    
+    // ボスキャラをプール内の位置から復元する
+    m_boss = getEnemyByIndex(bossIndex);
+    m_scene->getBossLifeGauge()->setVisible(m_boss != NULL);
+    
+    // 残機表示、ボタンの選択状態を更新する
+    setLife(m_life);
+    m_scene->setHoldButtonSelected(m_hold);
+    m_scene->setShieldButtonSelected(m_shield);
+    
+    // オプションの画像をシールド有無に合わせる
+    m_player->setShield(m_shield);
+    
+    // スコア表示を即座に反映し、ゲージの表示を更新する
+    m_displayScore = m_score;
+    m_scene->setScoreLabel(m_displayScore);
+    updateHud(false);
+    
+#ifdef DEBUG
+    auto end = system_clock::now();
+    AKLog(kAKLogPlayData_1, "readSnapshot() size=%d time=%dus",
+          (int)buffer.size(), (int)duration_cast<microseconds>(end - begin).count());
+#endif
+    
+    return true;
+}
+
 #pragma mark キャラクタークラスからのデータ操作用
 
 /*!
@@ -1049,24 +1351,34 @@ AKEnemy* AKPlayData::createEnemy(int type, Vec2 position, int progress)
 }
 
 /*!
- @brief 敵弾インスタンスの取得
+ @brief 敵弾インスタンスの一括取得
  
- 敵弾プールから次のインスタンスを取得する。
- @return 敵弾インスタンス
+ 敵弾プールから指定数分のインスタンスをまとめて取得する。
+ 速度変更弾は通常弾とは別のプールから取得する。
+ @param count 取得する数
+ @param isChangeSpeed 速度変更弾かどうか
+ @param enemyShots 取得した敵弾インスタンスを格納する配列
+ @return 取得できた数
  */
-AKEnemyShot* AKPlayData::getEnemyShot()
+int AKPlayData::getEnemyShots(int count, bool isChangeSpeed, AKEnemyShot **enemyShots)
 {
     // 自機が死んでいる間は敵弾生成を抑止する
     if (m_rebirthWait > 0 || m_player->isInvincible()) {
-        return NULL;
+        return 0;
     }
     
-    // プールから未使用のメモリを取得する
-    AKEnemyShot *enemyShot = m_enemyShotPool.getNext();
+    // プールから未使用のメモリをまとめて取得する
+    int found = 0;
+    if (isChangeSpeed) {
+        found = m_changeSpeedShotPool.getNext(count, enemyShots);
+    }
+    else {
+        found = m_enemyShotPool.getNext(count, enemyShots);
+    }
     
-    AKAssert(enemyShot, "敵弾プールに空きなし");
+    AKAssert(found == count, "敵弾プールに空きなし");
     
-    return enemyShot;
+    return found;
 }
 
 /*!
@@ -1170,7 +1482,7 @@ void AKPlayData::addScore(int score)
         !m_scene->isGameOver()) {
         
         // エクステンドの効果音を鳴らす
-        SimpleAudioEngine::getInstance()->playEffect(kAK1UpSEFileName);
+        AKSEScheduler::getInstance()->playEffect(kAK1UpSEFileName);
         
         // 残機の数を増やす
         setLife(m_life + 1);
@@ -1179,11 +1491,9 @@ void AKPlayData::addScore(int score)
     }
     
     // スコアを加算する
+    // スコア表示はフレームの最後にまとめて更新する
     m_score += score;
     
-    // スコア表示を更新する
-    m_scene->setScoreLabel(m_score);
-    
     // ハイスコアを更新している場合はハイスコアを設定する
     if (m_score > m_hiScore) {
         
@@ -1225,6 +1535,22 @@ bool AKPlayData::is2ndLoop()
     return m_loopCount > 1;
 }
 
+/*!
+ @brief 乱数取得
+ 
+ xorshiftにより乱数の状態を更新し、乱数を取得する。
+ @return 0以上の乱数
+ */
+int AKPlayData::getRandom()
+{
+    m_random ^= m_random << 13;
+    m_random ^= m_random >> 17;
+    m_random ^= m_random << 5;
+    
+    // 符号ビットを使用しないようにする
+    return static_cast<int>(m_random >> 1);
+}
+
 /*!
  @brief 敵弾削除
  
@@ -1238,6 +1564,11 @@ void AKPlayData::clearEnemyShot()
             enemyShot->setHitPoint(0);
         }
     }
+    for (AKEnemyShot *enemyShot : *m_changeSpeedShotPool.getPool()) {
+        if (enemyShot->isStaged()) {
+            enemyShot->setHitPoint(0);
+        }
+    }
 }
 
 /*!
@@ -1279,6 +1610,43 @@ void AKPlayData::updateBossLifeGage()
     }
 }
 
+/*!
+ @brief 情報表示更新
+ 
+ チキンゲージ、ボス体力ゲージ、スコアの表示を更新する。
+ 1フレームに1回だけ呼び出し、フレーム中の変化をまとめて反映する。
+ ゲージは表示上の長さが変わった場合のみ、スコアは値が変わった場合のみ画像を更新する。
+ スコアは毎フレーム差分の一定割合ずつ実際のスコアへ近づけて表示する。
+ @param isRollUp スコア表示を徐々に近づけるかどうか(falseの場合は即座に反映する)
+ */
+void AKPlayData::updateHud(bool isRollUp)
+{
+    // チキンゲージの溜まっている比率を更新する
+    m_scene->getChickenGauge()->setPercent(m_player->getChickenGaugePercent());
+    
+    // ボス体力ゲージの表示を更新する
+    updateBossLifeGage();
+    
+    // スコアが変化していない場合はスコア表示を更新しない
+    if (m_displayScore == m_score) {
+        return;
+    }
+    
+    // 徐々に近づける場合は差分の一定割合(最低1)を加算する
+    // スコアが減少している場合は即座に反映する
+    if (isRollUp && m_displayScore < m_score) {
+        m_displayScore += (m_score - m_displayScore + kAKScoreRollDivision - 1) / kAKScoreRollDivision;
+    }
+    else {
+        m_displayScore = m_score;
+    }
+    
+    AKLog(kAKLogPlayData_3, "displayScore=%d score=%d", m_displayScore, m_score);
+    
+    // スコア表示を更新する
+    m_scene->setScoreLabel(m_displayScore);
+}
+
 /*!
  @brief ステージ変更
  
@@ -1301,9 +1669,68 @@ void AKPlayData::changeStage(int stage)
     // 次のステージのスクリプトを読み込む
     readScript(stage);
     
+#ifdef DEBUG
+    // 前のステージの敵動作スクリプトの実行状況を出力する
+    AKEnemyScriptTable::outputProfile();
+#endif
+    
     // 待機フレーム数をリセットする
     m_clearWait = 0;
     
     // プレイ中状態に戻す
     m_scene->nextStage();
 }
+
+/*!
+ @brief 全キャラクター削除
+ 
+ 自機以外のキャラクターをすべて画面から取り除き、自機を初期状態に戻す。
+ */
+void AKPlayData::clearCharacters()
+{
+    m_playerShotPool.reset();
+    m_reflectShotPool.reset();
+    m_enemyPool.reset();
+    m_enemyShotPool.reset();
+    m_changeSpeedShotPool.reset();
+    m_effectPool.reset();
+    m_blockPool.reset();
+    
+    m_player->reset();
+    m_player->setChickenGauge(0);
+    m_player->updateOptionCount();
+}
+
+/*!
+ @brief 敵キャラのプール内の位置取得
+ 
+ 敵キャラが敵キャラプールの何番目にあるかを取得する。
+ @param enemy 敵キャラ
+ @return プール内の位置(NULLの場合は-1)
+ */
+int AKPlayData::getEnemyIndex(AKEnemy *enemy)
+{
+    const vector<AKEnemy*> *pool = m_enemyPool.getPool();
+    for (int i = 0; i < pool->size(); i++) {
+        if (pool->at(i) == enemy) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/*!
+ @brief プール内の位置から敵キャラ取得
+ 
+ 敵キャラプールの指定位置の敵キャラを取得する。
+ @param index プール内の位置
+ @return 敵キャラ(範囲外の場合はNULL)
+ */
+AKEnemy* AKPlayData::getEnemyByIndex(int index)
+{
+    const vector<AKEnemy*> *pool = m_enemyPool.getPool();
+    if (index < 0 || index >= pool->size()) {
+        return NULL;
+    }
+    return pool->at(index);
+}
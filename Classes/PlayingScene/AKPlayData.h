@@ -73,6 +73,8 @@ private:
     int m_score;
     /// ハイスコア
     int m_hiScore;
+    /// 表示中のスコア
+    int m_displayScore;
     /// スクリプト情報
     AKTileMap *m_tileMap;
     /// 自機
@@ -83,8 +85,10 @@ private:
     AKCharacterPool<AKEnemyShot> m_reflectShotPool;
     /// 敵キャラプール
     AKCharacterPool<AKEnemy> m_enemyPool;
-    /// 敵弾プール
+    /// 敵弾プール(通常弾、スクロール影響弾)
     AKCharacterPool<AKEnemyShot> m_enemyShotPool;
+    /// 速度変更弾プール
+    AKCharacterPool<AKEnemyShot> m_changeSpeedShotPool;
     /// 画面効果プール
     AKCharacterPool<AKEffect> m_effectPool;
     /// 障害物プール
@@ -109,6 +113,8 @@ private:
     int m_bossHP;
     /// 何周目か
     int m_loopCount;
+    /// 乱数の状態
+    unsigned int m_random;
 
 private:
     // デフォルトコンストラクタは使用禁止にする
@@ -119,6 +125,8 @@ public:
     AKPlayData(AKPlayingScene *scene);
     // デストラクタ
     ~AKPlayData();
+    // キャラクター作成
+    bool createCharacters(int count);
     // x軸方向のスクロールスピード取得
     virtual float getScrollSpeedX();
     // x軸方向のスクロールスピード設定
@@ -141,8 +149,8 @@ public:
     virtual void createReflectShot(AKEnemyShot *enemyShot);
     // 敵生成
     virtual AKEnemy* createEnemy(int type, cocos2d::Vec2 position, int progress);
-    // 敵弾インスタンスの取得
-    virtual AKEnemyShot* getEnemyShot();
+    // 敵弾インスタンスの一括取得
+    virtual int getEnemyShots(int count, bool isChangeSpeed, AKEnemyShot **enemyShots);
     // 敵弾配置ノードの取得
     virtual cocos2d::Node* getEnemyShotParent();
     // 画面効果生成
@@ -159,6 +167,8 @@ public:
     virtual void addChickenGauge(int inc);
     // 2周目かどうか
     virtual bool is2ndLoop();
+    // 乱数取得
+    virtual int getRandom();
     // 状態更新
     void update();
     // 自機の移動
@@ -171,6 +181,8 @@ public:
     void pause();
     // ハイスコアファイル書込
     void writeHiScore();
+    // ステージ番号取得
+    int getStage();
     // スクリプト読み込み
     void readScript(int stage);
     // ゲーム再開
@@ -183,6 +195,10 @@ public:
     void restartStage(int stage);
     // ツイートメッセージの作成
     std::string makeTweet();
+    // スナップショット書き込み
+    void writeSnapshot(std::vector<unsigned char> *buffer);
+    // スナップショット読み込み
+    bool readSnapshot(const std::vector<unsigned char> &buffer);
 
 private:
     // メンバオブジェクト生成処理
@@ -195,10 +211,20 @@ private:
     void setLife(int life);
     // 敵弾削除
     void clearEnemyShot();
+    // 等速直線移動の再計算要求
+    void resetLinearMove();
     // ボス体力ゲージ表示更新
     void updateBossLifeGage();
+    // 情報表示更新
+    void updateHud(bool isRollUp);
     // ステージ変更
     void changeStage(int stage);
+    // 全キャラクター削除
+    void clearCharacters();
+    // 敵キャラのプール内の位置取得
+    int getEnemyIndex(AKEnemy *enemy);
+    // プール内の位置から敵キャラ取得
+    AKEnemy* getEnemyByIndex(int index);
 };
 
 #endif
@@ -144,12 +144,16 @@ public:
     virtual AKEnemy* createEnemy(int type, cocos2d::Vec2 position, int progress) = 0;
 
     /*!
-     @brief 敵弾インスタンスの取得
- 
-     敵弾プールから次のインスタンスを取得する。
-     @return 敵弾インスタンス
+     @brief 敵弾インスタンスの一括取得
+     
+     敵弾プールから指定数分のインスタンスをまとめて取得する。
+     速度変更弾は通常弾とは別のプールから取得する。
+     @param count 取得する数
+     @param isChangeSpeed 速度変更弾かどうか
+     @param enemyShots 取得した敵弾インスタンスを格納する配列
+     @return 取得できた数
      */
-    virtual AKEnemyShot* getEnemyShot() = 0;
+    virtual int getEnemyShots(int count, bool isChangeSpeed, AKEnemyShot **enemyShots) = 0;
 
     /*!
      @brief 敵弾配置ノードの取得
@@ -216,6 +220,15 @@ public:
      @return 2周目かどうか
      */
     virtual bool is2ndLoop() = 0;
+    
+    /*!
+     @brief 乱数取得
+     
+     ゲームデータが保持する状態から乱数を取得する。
+     乱数の状態はスナップショットに含めるため、標準ライブラリのrandは使用しない。
+     @return 0以上の乱数
+     */
+    virtual int getRandom() = 0;
 };
 
 #endif
@@ -40,7 +40,6 @@
 using cocos2d::Vec2;
 using cocos2d::Node;
 using cocos2d::Blink;
-using CocosDenshion::SimpleAudioEngine;
 
 /// 自機のサイズ
 static const int kAKPlayerSize = 8;
@@ -278,7 +277,7 @@ void AKPlayer::setPosition(const Vec2 &position, bool hold, AKPlayDataInterface
 //    AKSetDebugFlg(1);
     
     // 障害物との衝突判定を行う
-    checkHit(*data->getBlocks(), data, &AKPlayer::moveOfBlockHit);
+    checkHit(*data->getBlocks(), data, AKMoveOfBlockHit());
     
 //    AKSetDebugFlg(1);
 //    AKLog(1, "after:%.0f %.0f", m_position.x, m_position.y);
@@ -384,6 +383,63 @@ int AKPlayer::getChickenGaugePercent()
     return m_chickenGauge * 100 / kAKMaxChicenGauge;
 }
 
+/*!
+ @brief スナップショット書き込み
+ 
+ キャラクター共通の状態に続けて、無敵状態、弾発射までのフレーム数、チキンゲージ、
+ オプションの状態を書き込む。
+ @param writer 書き込み先
+ */
+void AKPlayer::writeSnapshot(AKSnapshotWriter *writer)
+{
+    AKCharacter::writeSnapshot(writer);
+    writer->write(m_isInvincible);
+    writer->write(m_invincivleFrame);
+    writer->write(m_shootFrame);
+    writer->write(m_chickenGauge);
+    m_option->writeSnapshot(writer);
+}
+
+/*!
+ @brief スナップショット読み込み
+ 
+ writeSnapshotで書き込んだ状態を読み込む。
+ 復活後の無敵状態の場合は残りフレーム数分の点滅を開始する。
+ @param reader 読み込み元
+ @return 読み込めたかどうか
+ */
+bool AKPlayer::readSnapshot(AKSnapshotReader *reader)
+{
+    if (!AKCharacter::readSnapshot(reader, NULL)) {
+        return false;
+    }
+    reader->read(&m_isInvincible);
+    reader->read(&m_invincivleFrame);
+    reader->read(&m_shootFrame);
+    reader->read(&m_chickenGauge);
+    if (reader->isError() || !m_option->readSnapshot(reader)) {
+        return false;
+    }
+    
+    // 実行中の点滅を止める
+    getImage()->stopAllActions();
+    
+    // 無敵状態の残りフレーム数分の点滅を開始する
+    if (m_invincivleFrame > 0) {
+        
+        getImage()->setVisible(true);
+        
+        float duration = m_invincivleFrame / 60.0f;
+        int blinks = static_cast<int>(duration * 8);
+        if (blinks > 0) {
+            Blink *blink = Blink::create(duration, blinks);
+            getImage()->runAction(blink);
+        }
+    }
+    
+    return true;
+}
+
 /*!
  @brief キャラクター固有の動作
 
@@ -436,7 +492,7 @@ void AKPlayer::destroy(AKPlayDataInterface *data)
     AKLog(kAKLogPlayer_1, "destroy() start");
 
     // 破壊時の効果音を鳴らす
-    SimpleAudioEngine::getInstance()->playEffect(kAKMissSEFileName);
+    AKSEScheduler::getInstance()->playEffect(kAKMissSEFileName);
 
     // HPの設定
     m_hitPoint = 1;
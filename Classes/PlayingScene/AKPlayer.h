@@ -88,6 +88,10 @@ public:
     void setChickenGauge(int chickenGauge);
     // チキンゲージ%単位での習得
     int getChickenGaugePercent();
+    // スナップショット書き込み
+    void writeSnapshot(AKSnapshotWriter *writer);
+    // スナップショット読み込み
+    bool readSnapshot(AKSnapshotReader *reader);
 
 protected:
     // キャラクター固有の動作
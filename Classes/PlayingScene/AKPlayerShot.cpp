@@ -67,8 +67,8 @@ void AKPlayerShot::createPlayerShot(const Vec2 &position, float angle, Node *par
     m_power = kAKPlayerShotPower;
 
     // スピードをxとyに分割して設定する
-    m_speedX = cos(angle) * kAKPlayerShotSpeed;
-    m_speedY = sin(angle) * kAKPlayerShotSpeed;
+    m_speedX = AKFastMath::calcCos(angle) * kAKPlayerShotSpeed;
+    m_speedY = AKFastMath::calcSin(angle) * kAKPlayerShotSpeed;
     
     // その他のパラメータを設定する
     setCommonParam(position, parent);
@@ -94,6 +94,17 @@ void AKPlayerShot::createOptionShot(const Vec2 &position, Node *parent)
     setCommonParam(position, parent);
 }
 
+/*!
+ @brief 移動処理
+ 
+ 自機弾は速度が変わらないため、毎フレームの積算と画面外判定を行わない等速直線移動を使用する。
+ @param data ゲームデータ
+ */
+void AKPlayerShot::move(AKPlayDataInterface *data)
+{
+    moveLinear(data);
+}
+
 /*!
  @brief 共通項目設定
  
@@ -109,6 +120,9 @@ void AKPlayerShot::setCommonParam(const Vec2 &position, Node *parent)
     // 配置フラグを立てる
     m_isStaged = true;
     
+    // 等速直線移動は次の移動時に計算する
+    resetLinearMove();
+    
     // 画像名を設定する
     setImageName(kAKPlayerShotImage);
     
@@ -49,6 +49,8 @@ public:
     void createPlayerShot(const cocos2d::Vec2 &position, float angle, cocos2d::Node *parent);
     // オプション弾生成
     void createOptionShot(const cocos2d::Vec2 &position, cocos2d::Node *parent);
+    // 移動処理
+    virtual void move(AKPlayDataInterface *data);
 private:
     // 共通項目設定
     void setCommonParam(const cocos2d::Vec2 &position, cocos2d::Node *parent);
@@ -39,6 +39,7 @@
 #include "Twitter.h"
 #include "base/CCEventListenerController.h"
 #include "SettingFileIO.h"
+#include <chrono>
 
 using std::mem_fun;
 using cocos2d::SpriteFrameCache;
@@ -58,7 +59,11 @@ using cocos2d::FileUtils;
 using cocos2d::EventListenerController;
 using cocos2d::Controller;
 using cocos2d::Event;
-using CocosDenshion::SimpleAudioEngine;
+using cocos2d::LayerColor;
+using cocos2d::Data;
+using std::chrono::steady_clock;
+using std::chrono::duration_cast;
+using std::chrono::milliseconds;
 using aklib::Twitter;
 
 /// レイヤーのz座標、タグの値にも使用する
@@ -69,7 +74,21 @@ enum {
     kAKLayerPosZFrameBar,   ///< 枠棒レイヤー
     kAKLayerPosZInfo,       ///< 情報レイヤー
     kAKLayerPosZResult,     ///< ステージクリアレイヤー
-    kAKLayerPosZInterface   ///< インターフェースレイヤー
+    kAKLayerPosZInterface,  ///< インターフェースレイヤー
+    kAKLayerPosZLoading     ///< シーン構築中の表示レイヤー
+};
+
+/// シーン構築の手順
+enum {
+    kAKLoadStepTexture = 0,     ///< テクスチャアトラス読み込み
+    kAKLoadStepBackground,      ///< 背景レイヤー作成
+    kAKLoadStepCharacter,       ///< キャラクターレイヤー作成
+    kAKLoadStepInfo,            ///< 情報レイヤー作成
+    kAKLoadStepInterface,       ///< インターフェースレイヤー作成
+    kAKLoadStepFrame,           ///< 枠レイヤー作成
+    kAKLoadStepPlayData,        ///< ゲームデータ作成
+    kAKLoadStepCharacterPool,   ///< キャラクタープール作成
+    kAKLoadStepCount            ///< 手順の数
 };
 
 /// 情報レイヤーに配置するノードのタグ
@@ -94,6 +113,28 @@ static const int kAKSecondStartStage = DEBUG_MODE_2ND_START_STAGE;
 static const int kAKGameOverWaitFrame = 60;
 /// コントローラー移動時の速度
 static const float kAKPlayerMoveByController = 4.0f;
+/// 1フレームでシーン構築に使用する時間(ミリ秒)
+static const int kAKLoadTimeLimitPerFrame = 8;
+/// シーン構築の手順1回で作成するキャラクターの数
+static const int kAKLoadCharacterCountPerStep = 64;
+/// 中断データのファイル名
+static const char *kAKPlaySnapshotFileName = "PlaySnapshot.dat";
+#ifdef DEBUG_MODE_INPUT_LATENCY
+/// 入力遅延計測結果のファイル名
+static const char *kAKInputLatencyFileName = "input_latency.csv";
+#endif
+#ifdef DEBUG_MODE_REWIND
+/// 巻き戻し用に状態を記録する間隔(フレーム数)
+static const int kAKRewindInterval = 10;
+/// 巻き戻し用に状態を記録する最大数(30秒分)
+static const int kAKRewindMaxCount = 30 * 60 / kAKRewindInterval;
+/// 巻き戻し用の状態記録に使用する最大メモリサイズ
+static const size_t kAKRewindMaxBytes = 4 * 1024 * 1024;
+/// 巻き戻し用の状態記録でキーフレームを作成する間隔(記録数)
+static const int kAKRewindKeyInterval = 30;
+/// 1回の巻き戻しでさかのぼる記録数(3秒分)
+static const int kAKRewindStep = 3 * 60 / kAKRewindInterval;
+#endif
 
 //======================================================================
 // コントロールの表示に関する定数
@@ -197,34 +238,22 @@ m_characterLayer(NULL),
 m_infoLayer(NULL),
 m_interfaceLayer(NULL),
 m_life(NULL),
+m_score(NULL),
 m_chickenGauge(NULL),
-m_bossLifeGauge(NULL)
+m_bossLifeGauge(NULL),
+m_loadStep(kAKLoadStepTexture),
+m_isTransitionFinished(false),
+m_loadingLayer(NULL),
+m_indicator(NULL)
 {
-    // テクスチャアトラスを読み込む
-    SpriteFrameCache *spriteFrameCache = SpriteFrameCache::getInstance();
-    spriteFrameCache->addSpriteFramesWithFile(kAKControlTextureAtlasDefFile,
-                                              kAKControlTextureAtlasFile);
-
-    // 背景レイヤーを作成する
-    createBackGround();
-
-    // キャラクターレイヤーを作成する
-    createCharacterLayer();
-    
-    // 情報レイヤーを作成する
-    createInfoLayer();
-    
-    // インターフェースレイヤーを作成する
-    createInterface();
-    
-    // 枠レイヤーを作成する
-    createFrame();
-    
-    // 状態をシーン読み込み前に設定する
-    setState(kAKGameStatePreLoad);
-
-    // ゲームデータを作成する
-    m_data = new AKPlayData(this);
+    // レイヤーやゲームデータはトランジション開始後に更新処理の中で順に作成する
+    // (updatePreLoad参照)
+    
+#ifdef DEBUG_MODE_REWIND
+    // 巻き戻し用の状態履歴を作成する
+    m_rewindBuffer = new AKRewindBuffer(kAKRewindMaxBytes, kAKRewindMaxCount, kAKRewindKeyInterval);
+    m_rewindFrame = 0;
+#endif
 }
 
 /*!
@@ -261,6 +290,16 @@ AKPlayingScene::~AKPlayingScene()
     }
     delete m_data;
     
+#ifdef DEBUG_MODE_REWIND
+    delete m_rewindBuffer;
+#endif
+    
+#ifdef DEBUG_MODE_INPUT_LATENCY
+    // 入力遅延の計測を終了し、計測結果を出力する
+    AKLatencyMonitor::getInstance()->stop();
+    AKLatencyMonitor::getInstance()->exportToFile(kAKInputLatencyFileName);
+#endif
+    
     // 未使用のスプライトフレームを解放する
     SpriteFrameCache::getInstance()->removeUnusedSpriteFrames();
 }
@@ -292,10 +331,21 @@ bool AKPlayingScene::init()
     // コントローラの検出を開始する。
     Controller::startDiscoveryController();
     
-    // コントローラが接続されている場合はカーソルを表示するようにする
-    if (Controller::getAllController().size() > 0) {
-        m_interfaceLayer->setVisibleCursor(true);
-    }
+    // シーン構築中の表示レイヤーを作成する
+    // 構築中のレイヤーが見えないように、構築が終わるまでは他のレイヤーの上に配置する
+    m_loadingLayer = AKCreateBackColorLayer();
+    addChild(m_loadingLayer, kAKLayerPosZLoading, kAKLayerPosZLoading);
+    
+    // 進捗表示を画面中央に配置する
+    m_indicator = ActivityIndicator::create();
+    m_indicator->setPosition(AKScreenSize::center());
+    m_indicator->setProgress(0.0f);
+    m_loadingLayer->addChild(m_indicator);
+    
+#ifdef DEBUG_MODE_INPUT_LATENCY
+    // 入力遅延の計測を開始する
+    AKLatencyMonitor::getInstance()->start();
+#endif
     
     // 更新処理開始
     scheduleUpdate();
@@ -373,6 +423,20 @@ void AKPlayingScene::setState(enum AKGameState state)
             
             break;
     }
+    
+    // メニューを表示して入力を待つ状態の場合はフレームレートを抑制する
+    switch (state) {
+        case kAKGameStatePause:     // 一時停止中
+        case kAKGameStateQuitMenu:  // 終了メニュー
+        case kAKGameStateGameOver:  // ゲームオーバー
+        case kAKGameStateGameClear: // ゲームクリア後
+            AKFrameThrottle::getInstance()->setEnabled(true);
+            break;
+            
+        default:                    // その他
+            AKFrameThrottle::getInstance()->setEnabled(false);
+            break;
+    }
 }
 
 /*!
@@ -464,16 +528,35 @@ bool AKPlayingScene::isGameOver()
  トランジション終了時の処理。
  トランジション途中でBGM再生等が行われないようにするため、
  トランジション終了後にゲーム開始の状態にする。
+ シーンの構築が終わっていない場合は構築終了時にゲーム開始の状態にする。
  */
 void AKPlayingScene::onEnterTransitionDidFinish()
 {
-    // ゲーム状態を開始時に変更する。
-    setState(kAKGameStateStart);
+    m_isTransitionFinished = true;
+    
+    // シーンの構築が終わっている場合はゲーム状態を開始時に変更する。
+    if (m_loadStep >= kAKLoadStepCount) {
+        setState(kAKGameStateStart);
+    }
     
     // スーパークラスの処理を実行する
     Scene::onEnterTransitionDidFinish();
 }
 
+/*!
+ @brief トランジション開始時の処理
+ 
+ 他の画面への遷移開始時にフレームレートの抑制を解除する。
+ */
+void AKPlayingScene::onExitTransitionDidStart()
+{
+    // フレームレートの抑制を解除する
+    AKFrameThrottle::getInstance()->setEnabled(false);
+    
+    // スーパークラスの処理を実行する
+    Scene::onExitTransitionDidStart();
+}
+
 /*!
  @brief フォアグラウンド移行処理
  
@@ -482,13 +565,16 @@ void AKPlayingScene::onEnterTransitionDidFinish()
  */
 void AKPlayingScene::onWillEnterForeground()
 {
+    // 中断されずにフォアグラウンドに戻ったため、中断データは不要となる
+    removeSnapshot();
+    
     // ゲームプレイ中の場合は一時停止状態にする
     if (m_state == kAKGameStatePlaying) {
 
         AKLog(kAKLogPlayingScene_1, "フォアグラウンド移行処理");
         
         // BGMを一時停止する
-        SimpleAudioEngine::getInstance()->pauseBackgroundMusic();
+        AKBGMPlayer::getInstance()->pause();
 
         // ゲーム状態を一時停止に変更する
         setState(kAKGameStatePause);
@@ -498,10 +584,58 @@ void AKPlayingScene::onWillEnterForeground()
     }
 }
 
+/*!
+ @brief 中断データ保存
+ 
+ バックグラウンド移行時に呼び出し、OSに終了されても次回起動時に再開できるように
+ ゲームの状態を中断データファイルに保存する。
+ プレイ中、一時停止中、終了メニュー表示中以外は再開できないため保存しない。
+ 書き込み途中で終了されても壊れたファイルが残らないように、一時ファイルに書き込んでから置き換える。
+ */
+void AKPlayingScene::saveSnapshot()
+{
+    // 再開できる状態でない場合は保存しない
+    if (m_state != kAKGameStatePlaying &&
+        m_state != kAKGameStatePause &&
+        m_state != kAKGameStateQuitMenu) {
+        return;
+    }
+    
+    // ゲームの状態をバイト列に書き込む
+    std::vector<unsigned char> buffer;
+    m_data->writeSnapshot(&buffer);
+    
+    // 一時ファイルに書き込む
+    std::string path = FileUtils::getInstance()->getWritablePath() + kAKPlaySnapshotFileName;
+    std::string temporaryPath = path + ".tmp";
+    FILE *fp = fopen(temporaryPath.c_str(), "wb");
+    if (fp == NULL) {
+        AKLog(kAKLogPlayingScene_0, "中断データのオープンに失敗:%s", temporaryPath.c_str());
+        return;
+    }
+    size_t written = fwrite(buffer.data(), 1, buffer.size(), fp);
+    int result = fclose(fp);
+    if (written != buffer.size() || result != 0) {
+        AKLog(kAKLogPlayingScene_0, "中断データの書き込みに失敗:%s", temporaryPath.c_str());
+        remove(temporaryPath.c_str());
+        return;
+    }
+    
+    // 一時ファイルで置き換える
+    remove(path.c_str());
+    if (rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        AKLog(kAKLogPlayingScene_0, "中断データの置き換えに失敗:%s", path.c_str());
+        return;
+    }
+    
+    AKLog(kAKLogPlayingScene_1, "中断データ保存:size=%d", (int)buffer.size());
+}
+
 /*!
  @brief 自機の移動
  
- スライド入力によって自機を移動する。
+ スライド入力による自機の移動量を入力キューに追加する。
+ 1フレーム中の移動量はまとめて次の更新処理で反映する。
  @param object メニュー項目
  */
 void AKPlayingScene::movePlayer(const AKMenuItem *item)
@@ -512,10 +646,14 @@ void AKPlayingScene::movePlayer(const AKMenuItem *item)
     // cocos2dの座標系に変換する
     Vec2 location = Director::getInstance()->convertToGL(locationInView);
     
-    // 自機を移動する
+    // 自機の移動量を入力キューに追加する
     float x = (location.x - item->getPrevPoint()->x) * kAKPlayerMoveVal;
     float y = (location.y - item->getPrevPoint()->y) * kAKPlayerMoveVal;
-    m_data->movePlayer(x, y);
+    m_moveQueue.push(x, y);
+    
+#ifdef DEBUG_MODE_INPUT_LATENCY
+    AKLatencyMonitor::getInstance()->markInput();
+#endif
 }
 
 /*!
@@ -580,16 +718,21 @@ void AKPlayingScene::touchPauseButton()
     }
 
     // BGMを一時停止する
-    SimpleAudioEngine::getInstance()->pauseBackgroundMusic();
+    AKBGMPlayer::getInstance()->pause();
 
     // 一時停止効果音を鳴らす
-    SimpleAudioEngine::getInstance()->playEffect(kAKPauseSEFileName);
+    AKSEScheduler::getInstance()->playEffect(kAKPauseSEFileName);
 
     // ゲーム状態を一時停止に変更する
     setState(kAKGameStatePause);
     
     // プレイデータのポーズ処理を行う
     m_data->pause();
+    
+#ifdef DEBUG_MODE_INPUT_LATENCY
+    // 一時停止時点までの入力遅延の計測結果を出力する
+    AKLatencyMonitor::getInstance()->exportToFile(kAKInputLatencyFileName);
+#endif
 }
 
 /*!
@@ -614,7 +757,7 @@ void AKPlayingScene::touchResumeButton()
     button->runAction(action);
     
     // 一時停止効果音を鳴らす
-    SimpleAudioEngine::getInstance()->playEffect(kAKPauseSEFileName);
+    AKSEScheduler::getInstance()->playEffect(kAKPauseSEFileName);
 }
 
 /*!
@@ -641,7 +784,7 @@ void AKPlayingScene::touchQuitButton()
     button->runAction(action);
     
     // ボタン選択効果音を鳴らす
-    SimpleAudioEngine::getInstance()->playEffect(kAKSelectSEFileName);
+    AKSEScheduler::getInstance()->playEffect(kAKSelectSEFileName);
 }
 
 /*!
@@ -666,7 +809,7 @@ void AKPlayingScene::touchQuitYesButton()
     TransitionFade *transition = TransitionFade::create(0.5f, titleScene);
 
     // BGMを停止する
-    SimpleAudioEngine::getInstance()->stopBackgroundMusic();
+    AKBGMPlayer::getInstance()->stop();
     
     // タイトルシーンへと遷移する
     Director::getInstance()->replaceScene(transition);
@@ -695,7 +838,7 @@ void AKPlayingScene::touchQuitNoButton()
     button->runAction(action);
     
     // ボタン選択効果音を鳴らす
-    SimpleAudioEngine::getInstance()->playEffect(kAKSelectSEFileName);
+    AKSEScheduler::getInstance()->playEffect(kAKSelectSEFileName);
 }
 
 /*!
@@ -721,7 +864,7 @@ void AKPlayingScene::touchContinueButton()
     button->runAction(action);
     
     // ボタン選択効果音を鳴らす
-    SimpleAudioEngine::getInstance()->playEffect(kAKSelectSEFileName);
+    AKSEScheduler::getInstance()->playEffect(kAKSelectSEFileName);
 }
 
 /*!
@@ -733,7 +876,7 @@ void AKPlayingScene::touchContinueButton()
 void AKPlayingScene::touchTweetButton()
 {
     // ボタン選択効果音を鳴らす
-    SimpleAudioEngine::getInstance()->playEffect(kAKSelectSEFileName);
+    AKSEScheduler::getInstance()->playEffect(kAKSelectSEFileName);
     
     // ツイートメッセージを作成する
     std::string message = m_data->makeTweet();
@@ -755,6 +898,10 @@ void AKPlayingScene::update(float delta)
 {
     // ゲームの状態によって処理を分岐する
     switch (m_state) {
+        case kAKGameStatePreLoad:   // ゲームシーン読み込み前
+            updatePreLoad();
+            break;
+            
         case kAKGameStateStart:     // ゲーム開始時
             updateStart();
             break;
@@ -907,6 +1054,11 @@ void AKPlayingScene::setScoreLabel(int score)
  */
 void AKPlayingScene::onConnectedController(Controller* controller, Event* event)
 {
+    // シーン構築中の場合は構築終了時にカーソルの表示を設定する
+    if (m_interfaceLayer == NULL) {
+        return;
+    }
+    
     // カーソルを表示する
     m_interfaceLayer->setVisibleCursor(true);
 }
@@ -920,6 +1072,11 @@ void AKPlayingScene::onConnectedController(Controller* controller, Event* event)
  */
 void AKPlayingScene::onDisconnectedController(Controller* controller, Event* event)
 {
+    // シーン構築中の場合は構築終了時にカーソルの表示を設定する
+    if (m_interfaceLayer == NULL) {
+        return;
+    }
+    
     // カーソルを非表示にする
     m_interfaceLayer->setVisibleCursor(false);
     
@@ -1024,7 +1181,7 @@ void AKPlayingScene::onAxisEvent(Controller* controller, int keyCode, Event* eve
 void AKPlayingScene::gameOver()
 {
     // BGMを停止する
-    SimpleAudioEngine::getInstance()->stopBackgroundMusic();
+    AKBGMPlayer::getInstance()->stop();
 
     // 状態を待機中へ遷移する
     setState(kAKGameStateSleep);
@@ -1066,7 +1223,7 @@ void AKPlayingScene::stageClear()
     m_data->setShield(false);
 
     // ステージクリアのジングルを再生する
-    SimpleAudioEngine::getInstance()->playBackgroundMusic(kAKClearJingleFileName, false);
+    AKBGMPlayer::getInstance()->play(kAKClearJingleFileName, false);
 
     // 状態をステージクリア状態に遷移する
     setState(kAKGameStateStageClear);
@@ -1097,7 +1254,7 @@ void AKPlayingScene::gameClear()
     m_data->setShield(false);
     
     // ステージクリアのジングルを再生する
-    SimpleAudioEngine::getInstance()->playBackgroundMusic(kAKGameClearJingleFileName, false);
+    AKBGMPlayer::getInstance()->play(kAKGameClearJingleFileName, false);
     
     // 状態をゲームクリア待機状態に遷移する
     setState(kAKGameStateGameClearWait);
@@ -1214,7 +1371,7 @@ void AKPlayingScene::createInfoLayer()
     snprintf(scoreString, sizeof(scoreString), kAKScoreFormat, 0);
     
     // スコア表示を作成する
-    m_score = AKLabel::createLabel(scoreString, (int)strlen(scoreString), 1, kAKLabelFrameNone, AKLabel::ControlFont);
+    m_score = AKLabel::createFixedWidthLabel(scoreString, (int)strlen(scoreString), kAKLabelFrameNone);
     
     // スコア表示を情報レイヤーに配置する
     m_infoLayer->addChild(m_score, 0, kAKInfoTagScore);
@@ -1460,6 +1617,121 @@ void AKPlayingScene::createFrameBlock(Node *node,
     }
 }
 
+#pragma mark プライベートメソッド_シーン構築
+
+/*!
+ @brief シーン構築の手順実行
+ 
+ シーン構築の手順を1つ実行し、次の手順に進める。
+ キャラクタープール作成は一定数ずつ作成し、作成し終えるまで次の手順に進めない。
+ */
+void AKPlayingScene::loadNextStep()
+{
+    AKLog(kAKLogPlayingScene_1, "step=%d", m_loadStep);
+    
+    switch (m_loadStep) {
+        case kAKLoadStepTexture:        // テクスチャアトラス読み込み
+            AKAssetLoader::getInstance()->addSpriteFrames(kAKControlTextureAtlasDefFile,
+                                                          kAKControlTextureAtlasFile);
+            break;
+            
+        case kAKLoadStepBackground:     // 背景レイヤー作成
+            createBackGround();
+            break;
+            
+        case kAKLoadStepCharacter:      // キャラクターレイヤー作成
+            createCharacterLayer();
+            break;
+            
+        case kAKLoadStepInfo:           // 情報レイヤー作成
+            createInfoLayer();
+            break;
+            
+        case kAKLoadStepInterface:      // インターフェースレイヤー作成
+            createInterface();
+            
+            // 状態をシーン読み込み前に設定する
+            setState(kAKGameStatePreLoad);
+            break;
+            
+        case kAKLoadStepFrame:          // 枠レイヤー作成
+            createFrame();
+            break;
+            
+        case kAKLoadStepPlayData:       // ゲームデータ作成
+            m_data = new AKPlayData(this);
+            break;
+            
+        case kAKLoadStepCharacterPool:  // キャラクタープール作成
+            // すべてのキャラクターを作成し終えるまでは次の手順に進めない
+            if (!m_data->createCharacters(kAKLoadCharacterCountPerStep)) {
+                return;
+            }
+            break;
+            
+        default:
+            AKAssert(false, "シーン構築の手順が不正:%d", m_loadStep);
+            break;
+    }
+    
+    m_loadStep++;
+}
+
+/*!
+ @brief シーン構築終了処理
+ 
+ シーン構築中の表示を削除する。
+ トランジションが終了している場合はゲーム開始の状態にする。
+ */
+void AKPlayingScene::finishLoading()
+{
+    // シーン構築中の表示レイヤーを削除する
+    m_loadingLayer->removeFromParentAndCleanup(true);
+    m_loadingLayer = NULL;
+    m_indicator = NULL;
+    
+    // コントローラが接続されている場合はカーソルを表示するようにする
+    if (Controller::getAllController().size() > 0) {
+        m_interfaceLayer->setVisibleCursor(true);
+    }
+    
+    // トランジションが終了している場合はゲーム状態を開始時に変更する
+    if (m_isTransitionFinished) {
+        setState(kAKGameStateStart);
+    }
+}
+
+/*!
+ @brief シーン構築中の更新処理
+ 
+ シーン構築の手順を1フレームあたりの制限時間まで実行し、進捗を表示する。
+ 手順は最低1つは実行する。
+ タイトル画面からの遷移開始時にまとめて構築すると画面が止まるため、
+ トランジション中に複数フレームに分けて構築する。
+ */
+void AKPlayingScene::updatePreLoad()
+{
+    // 構築が終わってトランジション終了を待っている場合は無処理とする
+    if (m_loadStep >= kAKLoadStepCount) {
+        return;
+    }
+    
+    // 制限時間まで手順を実行する
+    steady_clock::time_point begin = steady_clock::now();
+    do {
+        loadNextStep();
+    } while (m_loadStep < kAKLoadStepCount &&
+             duration_cast<milliseconds>(steady_clock::now() - begin).count() < kAKLoadTimeLimitPerFrame);
+    
+    // 進捗を表示する
+    m_indicator->setProgress(static_cast<float>(m_loadStep) / kAKLoadStepCount);
+    
+    // すべての手順が終わった場合は構築終了処理を行う
+    if (m_loadStep >= kAKLoadStepCount) {
+        finishLoading();
+    }
+}
+
 #pragma mark プライベートメソッド_更新処理
 
 /*!
@@ -1471,6 +1743,18 @@ void AKPlayingScene::updateStart()
 {
     AKLog(kAKLogPlayingScene_1, "start");
     
+    // 前回バックグラウンドで終了された場合は中断データから再開する
+    if (restoreSnapshot()) {
+        
+        AKLog(kAKLogPlayingScene_1, "中断データから再開");
+        
+        // 一時停止状態で再開し、再開ボタンが選択されるまで待つ
+        AKBGMPlayer::getInstance()->pause();
+        setState(kAKGameStatePause);
+        m_data->pause();
+        return;
+    }
+    
     // 開始ステージのスクリプトを読み込む
     m_data->readScript(kAKStartStage);
     
@@ -1485,8 +1769,27 @@ void AKPlayingScene::updateStart()
  */
 void AKPlayingScene::updatePlaying()
 {
+#ifdef DEBUG_MODE_INPUT_LATENCY
+    AKLatencyMonitor::getInstance()->markUpdateBegin();
+#endif
+    
+    // 前回の更新以降のスライド入力をまとめて、1回で自機を移動する
+    AKMoveInput move;
+    if (m_moveQueue.coalesce(&move)) {
+        m_data->movePlayer(move.dx, move.dy);
+    }
+    
     // ゲームデータの更新を行う
     m_data->update();
+    
+#ifdef DEBUG_MODE_REWIND
+    // 巻き戻し用に状態を記録する
+    recordRewind();
+#endif
+    
+#ifdef DEBUG_MODE_INPUT_LATENCY
+    AKLatencyMonitor::getInstance()->markUpdateEnd();
+#endif
 }
 
 /*!
@@ -1528,7 +1831,10 @@ void AKPlayingScene::resumePlaying()
     AKAssert(m_state == kAKGameStateWait, "状態遷移異常");
     
     // 一時停止したBGMを再開する
-    SimpleAudioEngine::getInstance()->resumeBackgroundMusic();
+    AKBGMPlayer::getInstance()->resume();
+    
+    // 一時停止中に溜まった移動入力は破棄する
+    m_moveQueue.clear();
     
     // ゲーム状態をプレイ中に変更する
     setState(kAKGameStatePlaying);
@@ -1537,6 +1843,100 @@ void AKPlayingScene::resumePlaying()
     m_data->resume();
 }
 
+/*!
+ @brief 中断データからの再開
+ 
+ 中断データファイルがある場合はゲームの状態を復元する。
+ 読み込んだ中断データファイルは、再開に失敗した場合も含めて削除する。
+ @return 再開したかどうか
+ */
+bool AKPlayingScene::restoreSnapshot()
+{
+    // 中断データファイルがない場合は再開しない
+    std::string path = FileUtils::getInstance()->getWritablePath() + kAKPlaySnapshotFileName;
+    if (!FileUtils::getInstance()->isFileExist(path)) {
+        return false;
+    }
+    
+    // ファイルを読み込み、削除する
+    Data data = FileUtils::getInstance()->getDataFromFile(path);
+    removeSnapshot();
+    if (data.isNull()) {
+        AKLog(kAKLogPlayingScene_0, "中断データの読み込みに失敗:%s", path.c_str());
+        return false;
+    }
+    
+    // ゲームの状態を復元する
+    std::vector<unsigned char> buffer(data.getBytes(), data.getBytes() + data.getSize());
+    return m_data->readSnapshot(buffer);
+}
+
+/*!
+ @brief 中断データ削除
+ 
+ 中断データファイルを削除する。
+ */
+void AKPlayingScene::removeSnapshot()
+{
+    std::string path = FileUtils::getInstance()->getWritablePath() + kAKPlaySnapshotFileName;
+    remove(path.c_str());
+}
+
+#ifdef DEBUG_MODE_REWIND
+/*!
+ @brief 巻き戻し用の状態記録
+ 
+ プレイ中の場合、一定フレーム数ごとにゲームの状態を巻き戻し用の状態履歴に記録する。
+ */
+void AKPlayingScene::recordRewind()
+{
+    // 更新処理でプレイ中以外の状態に遷移した場合は記録しない
+    if (m_state != kAKGameStatePlaying) {
+        return;
+    }
+    
+    // 記録間隔に達していない場合は処理しない
+    m_rewindFrame++;
+    if (m_rewindFrame < kAKRewindInterval) {
+        return;
+    }
+    m_rewindFrame = 0;
+    
+    // 状態を記録する
+    m_data->writeSnapshot(&m_rewindSnapshot);
+    m_rewindBuffer->push(m_rewindSnapshot);
+}
+
+/*!
+ @brief 巻き戻し
+ 
+ 巻き戻し用の状態履歴から数秒前の状態を取り出し、ゲームの状態を復元する。
+ 復元に失敗した場合は状態履歴を破棄し、現在のステージを最初からやり直す。
+ */
+void AKPlayingScene::rewind()
+{
+    // 状態履歴から数秒前の状態を取り出す
+    if (!m_rewindBuffer->rewind(kAKRewindStep, &m_rewindSnapshot)) {
+        return;
+    }
+    
+    // 復元に失敗した場合にやり直すため、現在のステージ番号を取得しておく
+    int stage = m_data->getStage();
+    
+    // ゲームの状態を復元する
+    // 失敗した場合はゲームデータが初期化されるため、現在のステージのスクリプトを読み込み直す
+    if (!m_data->readSnapshot(m_rewindSnapshot)) {
+        AKLog(kAKLogPlayingScene_0, "巻き戻しに失敗、ステージ%dをやり直す", stage);
+        m_rewindBuffer->clear();
+        m_data->readScript(stage);
+    }
+    
+    // 巻き戻し前のスライド入力は破棄する
+    m_moveQueue.clear();
+    m_rewindFrame = 0;
+}
+#endif
+
 /*!
  @brief 終了メニュー表示
  
@@ -1594,6 +1994,10 @@ void AKPlayingScene::onAxisEventOnPlaying(int keyCode, float value)
         speed = value * kAKPlayerMoveByController;
     }
     
+#ifdef DEBUG_MODE_INPUT_LATENCY
+    AKLatencyMonitor::getInstance()->markInput();
+#endif
+    
     // キー種類によって設定する方向を変える
     switch (keyCode) {
         case Controller::JOYSTICK_LEFT_X:
@@ -1632,7 +2036,7 @@ void AKPlayingScene::onAxisEventOnMenu(int keyCode, float value)
                 m_interfaceLayer->setCursorPosition(m_interfaceLayer->getCursorPosition() - 1);
                 
                 // カーソル移動時の効果音を鳴らす
-                SimpleAudioEngine::getInstance()->playEffect(kAKCursorSEFileName);
+                AKSEScheduler::getInstance()->playEffect(kAKCursorSEFileName);
                 
                 // 連続入力を防止するために今回入力内容を記憶する
                 m_prevLStickInput = -1;
@@ -1648,7 +2052,7 @@ void AKPlayingScene::onAxisEventOnMenu(int keyCode, float value)
                 m_interfaceLayer->setCursorPosition(m_interfaceLayer->getCursorPosition() + 1);
                 
                 // カーソル移動時の効果音を鳴らす
-                SimpleAudioEngine::getInstance()->playEffect(kAKCursorSEFileName);
+                AKSEScheduler::getInstance()->playEffect(kAKCursorSEFileName);
                 
                 // 連続入力を防止するために今回入力内容を記憶する
                 m_prevLStickInput = 1;
@@ -1668,6 +2072,7 @@ void AKPlayingScene::onAxisEventOnMenu(int keyCode, float value)
  プレイ中のコントローラーボタンを押した時の処理を行う。
  Aボタン:シールドを有効にする。
  Pauseボタン:ポーズボタンタップ処理を行う。
+ Lボタン:数秒前の状態に巻き戻す(DEBUG_MODE_REWIND有効時のみ)。
  @param keyCode キーの種類
  */
 void AKPlayingScene::onKeyDownOnPlaying(int keyCode)
@@ -1687,6 +2092,14 @@ void AKPlayingScene::onKeyDownOnPlaying(int keyCode)
             touchPauseButton();
             break;
             
+#ifdef DEBUG_MODE_REWIND
+        case Controller::BUTTON_LEFT_SHOULDER:
+            
+            // 数秒前の状態に巻き戻す
+            rewind();
+            break;
+#endif
+            
         default:
             break;
     }
@@ -42,6 +42,7 @@
 #include "AKGauge.h"
 #include "AKLife.h"
 #include "AKTitleScene.h"
+#include "ActivityIndicator.h"
 
 /// ゲームプレイの状態
 enum AKGameState {
@@ -96,6 +97,24 @@ private:
     AKGauge *m_bossLifeGauge;
     /// Lスティックの前回入力値
     float m_prevLStickInput;
+    /// スライド入力による自機移動のキュー
+    AKInputQueue m_moveQueue;
+    /// シーン構築の次の手順
+    int m_loadStep;
+    /// トランジションが終了したかどうか
+    bool m_isTransitionFinished;
+    /// シーン構築中の表示レイヤー
+    cocos2d::LayerColor *m_loadingLayer;
+    /// シーン構築中の進捗表示
+    ActivityIndicator *m_indicator;
+#ifdef DEBUG_MODE_REWIND
+    /// 巻き戻し用の状態履歴
+    AKRewindBuffer *m_rewindBuffer;
+    /// 巻き戻し用のスナップショット作業領域
+    std::vector<unsigned char> m_rewindSnapshot;
+    /// 前回の状態記録からのフレーム数
+    int m_rewindFrame;
+#endif
 
 private:
     // コンストラクタ
@@ -108,6 +127,8 @@ public:
     virtual bool init();
     // バックグラウンド移行処理
     void onWillEnterForeground();
+    // 中断データ保存
+    void saveSnapshot();
     // ゲームプレイの状態設定
     void setState(enum AKGameState state);
     // 背景レイヤー取得
@@ -126,6 +147,8 @@ public:
     void setHoldButtonSelected(bool selected);
     // トランジション終了時の処理
     virtual void onEnterTransitionDidFinish();
+    // トランジション開始時の処理
+    virtual void onExitTransitionDidStart();
     // 更新処理
     virtual void update(float delta);
     // イベント実行
@@ -202,6 +225,12 @@ private:
                           const cocos2d::Rect &rect);
     // ツイートボタン選択処理
     void touchTweetButton();
+    // シーン構築の手順実行
+    void loadNextStep();
+    // シーン構築終了処理
+    void finishLoading();
+    // シーン構築中の更新処理
+    void updatePreLoad();
     // ゲーム開始時の更新処理
     void updateStart();
     // プレイ中の更新処理
@@ -210,6 +239,16 @@ private:
     void updateSleep();
     // ゲーム再開
     void resumePlaying();
+    // 中断データからの再開
+    bool restoreSnapshot();
+    // 中断データ削除
+    void removeSnapshot();
+#ifdef DEBUG_MODE_REWIND
+    // 巻き戻し用の状態記録
+    void recordRewind();
+    // 巻き戻し
+    void rewind();
+#endif
     // 終了メニュー表示
     void viewQuitMenu();
     // 一時停止メニュー表示
@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2015 Akihiro Kaneda.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1.Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   2.Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   3.Neither the name of the Monochrome Soft nor the names of its contributors
+ *     may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!
+ @file AKShotPattern.cpp
+ @brief 弾発射パターンクラス定義
+ 
+ 敵弾の発射パターンを記述し、まとめて発射するクラスを定義する。
+ */
+
+#include "AKShotPattern.h"
+#include "AKEnemyShot.h"
+
+using cocos2d::Vec2;
+using cocos2d::Node;
+
+/*!
+ @brief 弾発射パターンによる発射
+ 
+ 弾発射パターンに従って敵弾を発射する。
+ 敵弾プールからまとめてインスタンスを確保し、
+ 1弾目の方向の単位ベクトルを弾の間の角度ずつ回転させながら各弾の速度を設定する。
+ 敵弾プールに空きがない場合は確保できた分だけ発射する。
+ @param pattern 弾発射パターン
+ @param position 発射する位置
+ @param data ゲームデータ
+ */
+void AKShotEmitter::fire(const struct AKShotPattern &pattern,
+                         const Vec2 &position,
+                         AKPlayDataInterface *data)
+{
+    // 弾数が0の場合は処理しない
+    if (pattern.count <= 0) {
+        return;
+    }
+    
+    // 狙った方向の単位ベクトルを計算する
+    Vec2 center = calcCenterDirection(pattern, position, data);
+    
+    // 散開する場合は中心角度を基準に各弾の方向を決める
+    // 散開しない場合は狙った方向を基準にする
+    Vec2 spreadCenter = center;
+    if (pattern.delay > 0) {
+        AKFastMath::calcSinCos(pattern.angle, &spreadCenter.y, &spreadCenter.x);
+    }
+    
+    // 1弾目の方向へ回転させる
+    float startAngle = -pattern.interval * (pattern.count - 1) / 2.0f;
+    float startCos = 0.0f;
+    float startSin = 0.0f;
+    AKFastMath::calcSinCos(startAngle, &startSin, &startCos);
+    Vec2 direction(spreadCenter.x * startCos - spreadCenter.y * startSin,
+                   spreadCenter.x * startSin + spreadCenter.y * startCos);
+    
+    // 1弾ごとの回転量を計算する
+    float stepCos = 0.0f;
+    float stepSin = 0.0f;
+    AKFastMath::calcSinCos(pattern.interval, &stepSin, &stepCos);
+    
+    // 一塊になって進む場合の速度を計算する
+    Vec2 groupSpeed(center.x * pattern.speed, center.y * pattern.speed);
+    
+    // 敵弾配置ノードを取得する
+    Node *parent = data->getEnemyShotParent();
+    
+    // 敵弾インスタンスの確保領域
+    AKEnemyShot *shots[kAKShotReserveCount];
+    
+    // すべての弾を発射するまで繰り返す
+    int fired = 0;
+    while (fired < pattern.count) {
+        
+        // 敵弾インスタンスをまとめて確保する
+        int request = MIN(pattern.count - fired, kAKShotReserveCount);
+        int reserved = data->getEnemyShots(request, pattern.delay > 0, shots);
+        
+        // 確保した敵弾を生成する
+        for (int i = 0; i < reserved; i++, fired++) {
+            
+            // 発射位置を計算する
+            Vec2 shotPosition(position.x + direction.x * pattern.distance,
+                              position.y + direction.y * pattern.distance);
+            if (pattern.offset != NULL) {
+                shotPosition.x += pattern.offset[fired][0];
+                shotPosition.y += pattern.offset[fired][1];
+            }
+            
+            // 速度変更が設定されている場合は速度変更弾を生成する
+            if (pattern.delay > 0) {
+                shots[i]->createChangeSpeedShot(shotPosition,
+                                                groupSpeed,
+                                                pattern.delay,
+                                                Vec2(direction.x * pattern.delaySpeed,
+                                                     direction.y * pattern.delaySpeed),
+                                                parent);
+            }
+            // スクロールの影響を受ける場合はスクロール影響弾を生成する
+            else if (pattern.isScroll) {
+                shots[i]->createScrollShot(shotPosition,
+                                           Vec2(direction.x * pattern.speed,
+                                                direction.y * pattern.speed),
+                                           parent);
+            }
+            // それ以外は通常弾を生成する
+            else {
+                shots[i]->createNormalShot(shotPosition,
+                                           Vec2(direction.x * pattern.speed,
+                                                direction.y * pattern.speed),
+                                           parent);
+            }
+            
+            // 次の弾の方向へ回転させる
+            direction.set(direction.x * stepCos - direction.y * stepSin,
+                          direction.x * stepSin + direction.y * stepCos);
+        }
+        
+        // 要求数を確保できなかった場合は処理を終了する
+        if (reserved < request) {
+            break;
+        }
+    }
+}
+
+/*!
+ @brief 弾発射パターンの初期化
+ 
+ 弾数、弾の間の角度、速度を指定して弾発射パターンを作成する。
+ その他の項目は角度0の方向へ、発射位置からずらさずに発射する設定とする。
+ @param count 弾数
+ @param interval 弾の間の角度
+ @param speed 弾の速度
+ @return 弾発射パターン
+ */
+struct AKShotPattern AKShotEmitter::makePattern(int count,
+                                                float interval,
+                                                float speed)
+{
+    struct AKShotPattern pattern;
+    pattern.count = count;
+    pattern.interval = interval;
+    pattern.speed = speed;
+    pattern.aim = kAKShotAimAngle;
+    pattern.angle = 0.0f;
+    pattern.isScroll = false;
+    pattern.distance = 0.0f;
+    pattern.offset = NULL;
+    pattern.delay = 0;
+    pattern.delaySpeed = 0.0f;
+    return pattern;
+}
+
+/*!
+ @brief 中心方向の単位ベクトル計算
+ 
+ 狙い方に応じて中心の弾の方向の単位ベクトルを計算する。
+ 自機狙いの場合は角度を経由せずに自機への方向ベクトルを正規化する。
+ @param pattern 弾発射パターン
+ @param position 発射する位置
+ @param data ゲームデータ
+ @return 中心方向の単位ベクトル
+ */
+Vec2 AKShotEmitter::calcCenterDirection(const struct AKShotPattern &pattern,
+                                        const Vec2 &position,
+                                        AKPlayDataInterface *data)
+{
+    // 角度指定の場合は指定角度の単位ベクトルを返す
+    if (pattern.aim != kAKShotAimPlayer) {
+        Vec2 direction;
+        AKFastMath::calcSinCos(pattern.angle, &direction.y, &direction.x);
+        return direction;
+    }
+    
+    // 自機への方向ベクトルを計算する
+    const Vec2 *playerPosition = data->getPlayerPosition();
+    Vec2 vector(playerPosition->x - position.x, playerPosition->y - position.y);
+    
+    // 自機と同じ位置の場合はatan2と同様に角度0の方向とする
+    float length = vector.length();
+    if (length <= 0.0f) {
+        return Vec2(1.0f, 0.0f);
+    }
+    
+    return Vec2(vector.x / length, vector.y / length);
+}
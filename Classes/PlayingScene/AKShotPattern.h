@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2015 Akihiro Kaneda.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ *   1.Redistributions of source code must retain the above copyright notice,
+ *     this list of conditions and the following disclaimer.
+ *   2.Redistributions in binary form must reproduce the above copyright notice,
+ *     this list of conditions and the following disclaimer in the documentation
+ *     and/or other materials provided with the distribution.
+ *   3.Neither the name of the Monochrome Soft nor the names of its contributors
+ *     may be used to endorse or promote products derived from this software
+ *     without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+/*!
+ @file AKShotPattern.h
+ @brief 弾発射パターンクラス定義
+ 
+ 敵弾の発射パターンを記述し、まとめて発射するクラスを定義する。
+ */
+
+#ifndef AKSHOTPATTERN_H
+#define AKSHOTPATTERN_H
+
+#include "AKToritoma.h"
+#include "AKPlayDataInterface.h"
+
+/// 弾の狙い方
+enum AKShotAim {
+    kAKShotAimAngle = 0,    ///< 角度指定
+    kAKShotAimPlayer        ///< 自機狙い
+};
+
+/*!
+ @brief 弾発射パターン
+ 
+ 一度に発射する弾の弾数、弾の間の角度、速度、狙い方、速度変更までの時間を定義する。
+ 速度変更までの時間が設定されている場合は、各弾は最初は狙った方向へ一塊になって進み、
+ 指定時間経過後に中心角度を基準にした各弾の方向へ散開する。
+ */
+struct AKShotPattern {
+    int count;                  ///< 弾数
+    float interval;             ///< 弾の間の角度
+    float speed;                ///< 弾の速度
+    enum AKShotAim aim;         ///< 狙い方
+    float angle;                ///< 中心角度(角度指定の場合、または散開する場合に使用)
+    bool isScroll;              ///< スクロールの影響を受けるか
+    float distance;             ///< 発射位置から各弾の方向へずらす距離
+    const float (*offset)[2];   ///< 各弾の発射位置のずれ(NULLの場合はずらさない)
+    int delay;                  ///< 速度変更までのフレーム数(0の場合は速度変更なし)
+    float delaySpeed;           ///< 速度変更後の速度
+};
+
+/*!
+ @brief 弾発射パターン処理クラス
+ 
+ 弾発射パターンに従って敵弾をまとめて発射する。
+ 敵弾プールからまとめてインスタンスを確保し、単位ベクトルを回転させて各弾の速度を計算する。
+ 発射中に三角関数の計算やメモリの確保は行わない。
+ */
+class AKShotEmitter {
+public:
+    /// 一度に確保する敵弾の最大数
+    static const int kAKShotReserveCount = 64;
+    
+public:
+    // 弾発射パターンによる発射
+    static void fire(const struct AKShotPattern &pattern,
+                     const cocos2d::Vec2 &position,
+                     AKPlayDataInterface *data);
+    // 弾発射パターンの初期化
+    static struct AKShotPattern makePattern(int count,
+                                            float interval,
+                                            float speed);
+    
+private:
+    // 中心方向の単位ベクトル計算
+    static cocos2d::Vec2 calcCenterDirection(const struct AKShotPattern &pattern,
+                                             const cocos2d::Vec2 &position,
+                                             AKPlayDataInterface *data);
+};
+
+#endif
@@ -41,7 +41,6 @@ using cocos2d::TMXTiledMap;
 using cocos2d::TMXLayer;
 using cocos2d::__String;
 using cocos2d::Node;
-using CocosDenshion::SimpleAudioEngine;
 using std::vector;
 using cocos2d::Value;
 using cocos2d::ValueMap;
@@ -60,7 +59,7 @@ const int AKTileMap::TileSize = 32;
  @param parent 親ノード
  */
 AKTileMap::AKTileMap(int stage, Node *parent) :
-m_currentCol(0), m_progress(0), m_isClear(false)
+m_currentCol(0), m_progress(0), m_isClear(false), m_bgmEventCount(0)
 {
     // ステージ番号からタイルマップのファイル名を決定する
     char fileName[16] = "";
@@ -97,6 +96,12 @@ m_currentCol(0), m_progress(0), m_isClear(false)
     m_enemy->setVisible(false);
     m_event->setVisible(false);
     
+    // BGM変更イベントを検索し、最初に再生するBGMを先読みする
+    findBGMEvents();
+    if (!m_bgmNumbers.empty()) {
+        AKBGMPlayer::getInstance()->prefetch(getBGMFileName(m_bgmNumbers[0]).c_str());
+    }
+    
     // レイヤーに配置する
     parent->addChild(m_tileMap, 1);
     
@@ -255,6 +260,115 @@ bool AKTileMap::isClear()
     return m_isClear;
 }
 
+/*!
+ @brief スナップショット書き込み
+ 
+ スクロール位置、実行した列番号、進行度、進行待ちのイベント、実行したBGM変更イベントの数を書き込む。
+ 進行待ちのイベントはプロパティをすべて文字列として書き込む。
+ @param writer 書き込み先
+ */
+void AKTileMap::writeSnapshot(AKSnapshotWriter *writer)
+{
+    // スクロール位置と進行状況を書き込む
+    writer->write(m_tileMap->getPosition());
+    writer->write(m_currentCol);
+    writer->write(m_progress);
+    writer->write(m_isClear);
+    writer->write(m_bgmEventCount);
+    
+    // 進行待ちのイベントを書き込む
+    writer->write(static_cast<int>(m_waitEvents.size()));
+    for (const ValueMap &event : m_waitEvents) {
+        writer->write(static_cast<int>(event.size()));
+        for (const auto &property : event) {
+            writer->writeString(property.first);
+            writer->writeString(property.second.asString());
+        }
+    }
+}
+
+/*!
+ @brief スナップショット読み込み
+ 
+ writeSnapshotで書き込んだ状態を読み込む。
+ 実行したBGM変更イベントの数が変わる場合は、その時点で再生しているはずのBGMに切り替える。
+ @param reader 読み込み元
+ @return 読み込めたかどうか
+ */
+bool AKTileMap::readSnapshot(AKSnapshotReader *reader)
+{
+    // 進行待ちのイベント、プロパティの最大数(不正なデータで大きな領域を確保しないようにする)
+    const int kAKMaxWaitEvents = 1024;
+    const int kAKMaxProperties = 32;
+    
+    // スクロール位置と進行状況を読み込む
+    Vec2 position;
+    int bgmEventCount = 0;
+    reader->read(&position);
+    reader->read(&m_currentCol);
+    reader->read(&m_progress);
+    reader->read(&m_isClear);
+    reader->read(&bgmEventCount);
+    
+    // 進行待ちのイベントを読み込む
+    int eventCount = 0;
+    reader->read(&eventCount);
+    if (eventCount < 0 || eventCount > kAKMaxWaitEvents) {
+        reader->setError();
+    }
+    m_waitEvents.clear();
+    for (int i = 0; i < eventCount && !reader->isError(); i++) {
+        
+        int propertyCount = 0;
+        reader->read(&propertyCount);
+        if (propertyCount < 0 || propertyCount > kAKMaxProperties) {
+            reader->setError();
+        }
+        
+        ValueMap event;
+        for (int j = 0; j < propertyCount && !reader->isError(); j++) {
+            std::string key;
+            std::string value;
+            reader->readString(&key);
+            reader->readString(&value);
+            event[key] = Value(value);
+        }
+        m_waitEvents.push_back(event);
+    }
+    
+    if (bgmEventCount < 0 || bgmEventCount > (int)m_bgmNumbers.size()) {
+        reader->setError();
+    }
+    if (reader->isError()) {
+        AKLog(kAKLogTileMap_1, "スナップショットの読み込みに失敗");
+        return false;
+    }
+    
+    // スクロール位置を設定する
+    m_tileMap->setPosition(position);
+    
+    // 実行したBGM変更イベントの数が変わる場合はBGMを切り替える
+    if (bgmEventCount != m_bgmEventCount) {
+        
+        m_bgmEventCount = bgmEventCount;
+        
+        // BGM変更イベントを実行済みの場合は最後に実行したBGMを再生する
+        if (m_bgmEventCount > 0) {
+            std::string fileName = getBGMFileName(m_bgmNumbers[m_bgmEventCount - 1]);
+            AKBGMPlayer::getInstance()->play(fileName.c_str(), true);
+        }
+        // 実行していない場合はBGMを停止し、最初のBGMを先読みする
+        else {
+            AKBGMPlayer::getInstance()->stop();
+            if (!m_bgmNumbers.empty()) {
+                AKBGMPlayer::getInstance()->prefetch(getBGMFileName(m_bgmNumbers[0]).c_str());
+            }
+        }
+    }
+    
+    return true;
+}
+
 /*!
  @brief 列単位のイベント実行
  
@@ -438,13 +552,22 @@ void AKTileMap::execEvent(const AKTileMapEventParameter &param, AKPlayDataInterf
     else if (type.compare("bgm") == 0) {
 
         // ファイル名を作成する
-        char fileName[32] = "";
-        snprintf(fileName, sizeof(fileName), kAKStageBGMFileName, value);
+        std::string fileName = getBGMFileName(value);
         
-        AKLog(kAKLogTileMap_1, "BGM:%.32sを再生", fileName);
+        AKLog(kAKLogTileMap_1, "BGM:%sを再生", fileName.c_str());
 
         // BGMを再生する
-        SimpleAudioEngine::getInstance()->playBackgroundMusic(fileName, true);
+        AKBGMPlayer::getInstance()->play(fileName.c_str(), true);
+        m_bgmEventCount++;
+        
+        // ステージ内に次のBGM変更イベントがある場合はそのBGMを、
+        // ない場合はステージクリアのジングルを先読みする
+        if (m_bgmEventCount < (int)m_bgmNumbers.size()) {
+            AKBGMPlayer::getInstance()->prefetch(getBGMFileName(m_bgmNumbers[m_bgmEventCount]).c_str());
+        }
+        else {
+            AKBGMPlayer::getInstance()->prefetch(kAKClearJingleFileName);
+        }
     }
     // ステージクリアの場合
     else if (type.compare("clear") == 0) {
@@ -460,3 +583,54 @@ void AKTileMap::execEvent(const AKTileMapEventParameter &param, AKPlayDataInterf
         AKAssert(false, "不明な種別:%s", type.c_str());
     }
 }
+
+/*!
+ @brief BGM変更イベント検索
+ 
+ イベントレイヤーのすべての列からBGM変更イベントを検索し、
+ BGM番号を列の順に保持する。次に再生するBGMの先読みに使用する。
+ */
+void AKTileMap::findBGMEvents()
+{
+    m_bgmNumbers.clear();
+    
+    // 左端の列から右端の列まで、各列の一番上の行から一番下の行まで検索する
+    for (int col = 0; col < m_tileMap->getMapSize().width; col++) {
+        for (int row = 0; row < m_tileMap->getMapSize().height; row++) {
+            
+            // タイルが存在しない場合は次のタイルへ進む
+            int tileGid = m_event->getTileGIDAt(Vec2(col, row));
+            if (tileGid <= 0) {
+                continue;
+            }
+            
+            // プロパティを取得する
+            Value value = m_tileMap->getPropertiesForGID(tileGid);
+            if (value.isNull()) {
+                continue;
+            }
+            
+            // BGM変更イベントの場合はBGM番号を追加する
+            ValueMap properties = value.asValueMap();
+            if (properties.at("Type").asString().compare("bgm") == 0) {
+                m_bgmNumbers.push_back(atoi(properties.at("Value").asString().c_str()));
+            }
+        }
+    }
+    
+    AKLog(kAKLogTileMap_1, "BGM変更イベント数:%d", (int)m_bgmNumbers.size());
+}
+
+/*!
+ @brief BGMファイル名取得
+ 
+ BGM番号に対応するBGMのファイル名を取得する。
+ @param bgmNumber BGM番号
+ @return BGMのファイル名
+ */
+std::string AKTileMap::getBGMFileName(int bgmNumber) const
+{
+    char fileName[32] = "";
+    snprintf(fileName, sizeof(fileName), kAKStageBGMFileName, bgmNumber);
+    return fileName;
+}
@@ -68,6 +68,10 @@ public:
     void setProgress(int progress);
     // クリアしたかどうか取得
     bool isClear();
+    // スナップショット書き込み
+    void writeSnapshot(AKSnapshotWriter *writer);
+    // スナップショット読み込み
+    bool readSnapshot(AKSnapshotReader *reader);
     
 private:
     /// タイルサイズ。ファイルから読み込むとContentScaleFactorを変えた時に数値が合わなくなるので、固定で持つ。
@@ -92,6 +96,10 @@ private:
     bool m_isClear;
     /// 進行待ちのイベント
     std::vector<cocos2d::ValueMap> m_waitEvents;
+    /// ステージ内のBGM変更イベントのBGM番号(列の順)
+    std::vector<int> m_bgmNumbers;
+    /// 実行したBGM変更イベントの数
+    int m_bgmEventCount;
     
     // デフォルトコンストラクタは使用禁止にする
     AKTileMap();
@@ -109,6 +117,10 @@ private:
     void createEnemy(const AKTileMapEventParameter &param, AKPlayDataInterface *data);
     // イベント実行
     void execEvent(const AKTileMapEventParameter &param, AKPlayDataInterface *data);
+    // BGM変更イベント検索
+    void findBGMEvents();
+    // BGMファイル名取得
+    std::string getBGMFileName(int bgmNumber) const;
 };
 
 #endif
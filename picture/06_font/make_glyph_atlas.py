@@ -0,0 +1,228 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#
+# Copyright (c) 2015 Akihiro Kaneda.
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+#   1.Redistributions of source code must retain the above copyright notice,
+#     this list of conditions and the following disclaimer.
+#   2.Redistributions in binary form must reproduce the above copyright notice,
+#     this list of conditions and the following disclaimer in the documentation
+#     and/or other materials provided with the distribution.
+#   3.Neither the name of the Monochrome Soft nor the names of its contributors
+#     may be used to endorse or promote products derived from this software
+#     without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+"""グリフアトラス作成ツール
+
+ローカライズ文字列ファイルとソースコード中の固定文字列で使用しているすべての文字を
+抽出し、フォントタイプ・言語・解像度ごとにBMFont形式(.fnt + .png)のグリフアトラスを作成する。
+AKLabelは作成したグリフアトラスがある場合はTTFフォントの代わりにこれを使用する。
+
+使い方:
+    python3 picture/06_font/make_glyph_atlas.py \\
+        --control-font Resources/fonts/misaki_gothic.ttf \\
+        --message-font Resources/fonts/NotoSansCJKjp-Regular.ttf
+
+出力先:
+    Resources/pictures/2x/Glyph_{Control,Message}_{en,ja,zh,ko}.{fnt,png} (等倍)
+    Resources/pictures/4x/Glyph_{Control,Message}_{en,ja,zh,ko}.{fnt,png} (2倍)
+
+必要なモジュール: Pillow
+"""
+
+import argparse
+import glob
+import os
+import re
+import sys
+
+from PIL import Image, ImageDraw, ImageFont
+
+# リポジトリのルートディレクトリ
+ROOT_DIR = os.path.abspath(os.path.join(os.path.dirname(__file__), '..', '..'))
+
+# 言語コード
+LANGUAGES = ['en', 'ja', 'zh', 'ko']
+
+# 解像度ごとの出力先ディレクトリと拡大率
+RESOLUTIONS = [('2x', 1), ('4x', 2)]
+
+# フォントサイズ(AKLabelのFontSizeと合わせる)
+FONT_SIZE = 16
+
+# 文字間の余白(テクスチャのにじみ防止)
+PADDING = 2
+
+# AKLabel::convertHalfCharacterで変換される全角文字
+FULL_WIDTH_CHARACTERS = ('０１２３４５６７８９'
+                         'ＡＢＣＤＥＦＧＨＩＪＫＬＭＮＯＰＱＲＳＴＵＶＷＸＹＺ'
+                         '．　−？')
+
+# ソースコード中の文字列リテラル
+STRING_LITERAL = re.compile(r'"((?:[^"\\\n]|\\.)*)"')
+
+# ログ出力・アサーションの行(表示されない文字列のため対象外とする)
+LOG_LINE = re.compile(r'\bAK(Log|Assert)\s*\(|cocos2d::log\s*\(')
+
+
+def read_localized_characters(language):
+    """ローカライズ文字列ファイルの値に含まれる文字を取得する。
+
+    tools/make_localized_bundle.pyと同じ規則で値を取り出す。
+    """
+    characters = set()
+    path = os.path.join(ROOT_DIR, 'Resources', 'text', 'Localized_' + language)
+    with open(path, encoding='utf-8') as f:
+        for line in f:
+            if line.startswith('//') or '=' not in line:
+                continue
+            value = line.split('=', 1)[1].strip().strip('";')
+            characters.update(value.replace('\\n', ''))
+    return characters
+
+
+def read_source_characters():
+    """ソースコード中の表示用の文字列リテラルに含まれる文字を取得する。"""
+    characters = set()
+    for pattern in ('**/*.cpp', '**/*.h'):
+        for path in glob.glob(os.path.join(ROOT_DIR, 'Classes', pattern), recursive=True):
+            with open(path, encoding='utf-8', errors='ignore') as f:
+                for line in f:
+                    if LOG_LINE.search(line):
+                        continue
+                    code = line.split('//', 1)[0]
+                    for literal in STRING_LITERAL.findall(code):
+                        characters.update(literal.replace('\\n', ''))
+    return characters
+
+
+def collect_characters(language, source_characters):
+    """言語ごとのグリフアトラスに含める文字を取得する。"""
+    characters = set(chr(c) for c in range(0x20, 0x7f))
+    characters.update(FULL_WIDTH_CHARACTERS)
+    characters.update(source_characters)
+    characters.update(read_localized_characters(language))
+    characters.discard('\n')
+    characters.discard('\r')
+    characters.discard('\t')
+    return sorted(characters)
+
+
+def pack_glyphs(font, characters):
+    """各文字の画像を作成し、テクスチャ上の配置を決める。
+
+    高さ順に並べて行単位で詰め込み、収まる最小の2のべき乗の正方形に配置する。
+    """
+    glyphs = []
+    for character in characters:
+        left, top, right, bottom = font.getbbox(character)
+        width = max(right - left, 0)
+        height = max(bottom - top, 0)
+        glyphs.append({
+            'character': character,
+            'left': left,
+            'top': top,
+            'width': width,
+            'height': height,
+            'advance': int(round(font.getlength(character))),
+        })
+
+    order = sorted(glyphs, key=lambda g: (-g['height'], g['character']))
+    size = 64
+    while True:
+        x = PADDING
+        y = PADDING
+        row_height = 0
+        fits = True
+        for glyph in order:
+            if x + glyph['width'] + PADDING > size:
+                x = PADDING
+                y += row_height + PADDING
+                row_height = 0
+            if y + glyph['height'] + PADDING > size:
+                fits = False
+                break
+            glyph['x'] = x
+            glyph['y'] = y
+            x += glyph['width'] + PADDING
+            row_height = max(row_height, glyph['height'])
+        if fits:
+            return glyphs, size
+        size *= 2
+
+
+def make_atlas(font_path, font_name, language, characters, resolution, scale):
+    """グリフアトラスを1個作成する。"""
+    font = ImageFont.truetype(font_path, FONT_SIZE * scale)
+    ascent, descent = font.getmetrics()
+    glyphs, size = pack_glyphs(font, characters)
+
+    # 白で文字を描画し、アルファ値で形を表す
+    mask = Image.new('L', (size, size), 0)
+    draw = ImageDraw.Draw(mask)
+    for glyph in glyphs:
+        if glyph['width'] > 0 and glyph['height'] > 0:
+            draw.text((glyph['x'] - glyph['left'], glyph['y'] - glyph['top']),
+                      glyph['character'], font=font, fill=255)
+    image = Image.new('RGBA', (size, size), (255, 255, 255, 0))
+    image.putalpha(mask)
+
+    output_dir = os.path.join(ROOT_DIR, 'Resources', 'pictures', resolution)
+    base_name = 'Glyph_%s_%s' % (font_name, language)
+    image.save(os.path.join(output_dir, base_name + '.png'))
+
+    # BMFont(テキスト形式)の定義ファイルを出力する
+    lines = [
+        'info face="%s" size=%d bold=0 italic=0 charset="" unicode=1 stretchH=100 '
+        'smooth=1 aa=1 padding=0,0,0,0 spacing=%d,%d'
+        % (os.path.basename(font_path), FONT_SIZE * scale, PADDING, PADDING),
+        'common lineHeight=%d base=%d scaleW=%d scaleH=%d pages=1 packed=0'
+        % (ascent + descent, ascent, size, size),
+        'page id=0 file="%s.png"' % base_name,
+        'chars count=%d' % len(glyphs),
+    ]
+    for glyph in glyphs:
+        lines.append('char id=%d x=%d y=%d width=%d height=%d xoffset=%d yoffset=%d '
+                     'xadvance=%d page=0 chnl=15'
+                     % (ord(glyph['character']), glyph['x'], glyph['y'],
+                        glyph['width'], glyph['height'], glyph['left'], glyph['top'],
+                        glyph['advance']))
+    with open(os.path.join(output_dir, base_name + '.fnt'), 'w', encoding='utf-8') as f:
+        f.write('\n'.join(lines) + '\n')
+
+    print('%s/%s: %d glyphs, %dx%d' % (resolution, base_name, len(glyphs), size, size))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='グリフアトラスを作成する')
+    parser.add_argument('--control-font', required=True, help='コントロール用フォント(CONTROL_FONT)')
+    parser.add_argument('--message-font', required=True, help='メッセージ用フォント(JAPANESE_FONT)')
+    args = parser.parse_args()
+
+    source_characters = read_source_characters()
+    for language in LANGUAGES:
+        characters = collect_characters(language, source_characters)
+        for resolution, scale in RESOLUTIONS:
+            make_atlas(args.control_font, 'Control', language, characters, resolution, scale)
+            make_atlas(args.message_font, 'Message', language, characters, resolution, scale)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
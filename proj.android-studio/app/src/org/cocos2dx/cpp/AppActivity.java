@@ -381,21 +381,25 @@ public class AppActivity extends GameControllerActivity implements
     /**
      * Leaderboardにハイスコアを送信する。
      * @param score スコア
+     * @return 送信できたかどうか。接続していない場合は送信せずにfalseを返す。
      */
-    public static void postHighScore(int score) {
+    public static boolean postHighScore(int score) {
 
         //Log.d("toritoma", "postHighScore: begin.");
 
-        if (me.mGoogleApiClient != null && me.mGoogleApiClient.isConnected()) {
-
-            // Leaderboardにハイスコアを送信する
-            Games.Leaderboards.submitScore(
-                    me.mGoogleApiClient,
-                    me.getString(R.string.leaderboard_id),
-                    score);
+        if (me.mGoogleApiClient == null || !me.mGoogleApiClient.isConnected()) {
+            return false;
         }
 
+        // Leaderboardにハイスコアを送信する
+        Games.Leaderboards.submitScore(
+                me.mGoogleApiClient,
+                me.getString(R.string.leaderboard_id),
+                score);
+
         //Log.d("toritoma", "postHighScore: end.");
+
+        return true;
     }
 
     /**
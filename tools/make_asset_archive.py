@@ -0,0 +1,186 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#
+# Copyright (c) 2015 Akihiro Kaneda.
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+#   1.Redistributions of source code must retain the above copyright notice,
+#     this list of conditions and the following disclaimer.
+#   2.Redistributions in binary form must reproduce the above copyright notice,
+#     this list of conditions and the following disclaimer in the documentation
+#     and/or other materials provided with the distribution.
+#   3.Neither the name of the Monochrome Soft nor the names of its contributors
+#     may be used to endorse or promote products derived from this software
+#     without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+"""アセットアーカイブ作成ツール
+
+解像度ごとに、画像リソース(Resources/pictures/{2x,4x})とローカライズ文字列バンドル
+(Resources/text/*.bin)、敵動作スクリプト(Resources/text/*.txt)を
+1個のアーカイブファイル(Assets_{2x,4x}.pak)にまとめる。
+AKArchiveFileUtilsはアーカイブがある場合、個別のファイルの代わりにアーカイブを
+メモリマップして読み込む。
+
+古いアーカイブが変更後のリソースを隠さないように、アーカイブはResourcesには出力せず、
+ビルドのたびに出力先のディレクトリに作り直す。各プロジェクトの扱いは次のとおり。
+    proj.android-studio: build.gradleのmakeAssetArchiveタスクでassetsに出力する。
+                         build-cfg.jsonでアーカイブに格納したファイルはコピーしない。
+    proj.android(ant):   アーカイブは使用しない(個別のファイルを読み込む)。
+                         antのビルドはassetsを圧縮するため、メモリマップできない。
+    proj.ios_mac:        アーカイブは使用しない(個別のファイルを読み込む)。
+
+使い方:
+    python3 tools/make_asset_archive.py --output-dir <出力先のディレクトリ>
+
+アーカイブの形式(数値はすべてリトルエンディアン):
+    char[4]  マジックナンバー "AKPK"
+    uint32   バージョン
+    uint32   ファイル数
+    uint32   ファイル名領域のサイズ
+    エントリ[] ファイル数分(ハッシュ値の昇順)
+        uint64 ファイル名のハッシュ値(FNV-1a 64bit)
+        uint32 ファイル名のファイル名領域先頭からのオフセット
+        uint32 ファイル名の長さ
+        uint32 データのアーカイブ先頭からのオフセット
+        uint32 データのサイズ
+    char[]   ファイル名領域(Resourcesからの相対パス、UTF-8、終端文字なし)
+    データ領域(各ファイルの先頭をDATA_ALIGNMENTバイト境界に揃える)
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+# リポジトリのルートディレクトリ
+ROOT_DIR = os.path.abspath(os.path.join(os.path.dirname(__file__), '..'))
+
+# リソースのディレクトリ
+RESOURCES_DIR = os.path.join(ROOT_DIR, 'Resources')
+
+# 解像度
+RESOLUTIONS = ['2x', '4x']
+
+# 解像度によらず格納するファイルのディレクトリと拡張子
+COMMON_FILES = [('text', '.bin'), ('text', '.txt')]
+
+# マジックナンバー
+MAGIC = b'AKPK'
+
+# バージョン(AKAssetArchive.cppのkAKArchiveVersionと合わせる)
+VERSION = 1
+
+# ヘッダのサイズ
+HEADER_SIZE = 16
+
+# エントリのサイズ
+ENTRY_SIZE = 24
+
+# データの境界
+DATA_ALIGNMENT = 16
+
+# FNV-1a 64bitのパラメータ
+FNV_OFFSET_BASIS = 0xcbf29ce484222325
+FNV_PRIME = 0x100000001b3
+
+
+def fnv1a64(name):
+    """ファイル名のハッシュ値を計算する。"""
+    value = FNV_OFFSET_BASIS
+    for byte in name:
+        value ^= byte
+        value = (value * FNV_PRIME) & 0xffffffffffffffff
+    return value
+
+
+def collect_files(resolution):
+    """アーカイブに格納するファイルのResourcesからの相対パスを取得する。"""
+    names = []
+    picture_dir = os.path.join(RESOURCES_DIR, 'pictures', resolution)
+    for directory, _, files in os.walk(picture_dir):
+        for file_name in files:
+            if file_name.startswith('.'):
+                continue
+            names.append(os.path.relpath(os.path.join(directory, file_name), RESOURCES_DIR))
+    for directory, extension in COMMON_FILES:
+        for file_name in os.listdir(os.path.join(RESOURCES_DIR, directory)):
+            if file_name.endswith(extension):
+                names.append(os.path.join(directory, file_name))
+    return sorted(name.replace(os.sep, '/') for name in names)
+
+
+def align(value):
+    """データの境界に切り上げる。"""
+    return (value + DATA_ALIGNMENT - 1) // DATA_ALIGNMENT * DATA_ALIGNMENT
+
+
+def write_archive(resolution, output_dir):
+    """アーカイブを出力する。"""
+    entries = []
+    for name in collect_files(resolution):
+        encoded = name.encode('utf-8')
+        with open(os.path.join(RESOURCES_DIR, name), 'rb') as f:
+            entries.append((fnv1a64(encoded), encoded, f.read()))
+    entries.sort(key=lambda entry: (entry[0], entry[1]))
+
+    hashes = set()
+    for hash_value, encoded, _ in entries:
+        if hash_value in hashes:
+            raise ValueError('ファイル名のハッシュ値が重複している: %s' % encoded.decode('utf-8'))
+        hashes.add(hash_value)
+
+    names = b''.join(encoded for _, encoded, _ in entries)
+    offset = align(HEADER_SIZE + ENTRY_SIZE * len(entries) + len(names))
+    table = b''
+    data = b''
+    name_offset = 0
+    for hash_value, encoded, content in entries:
+        table += struct.pack('<QIIII', hash_value, name_offset, len(encoded), offset, len(content))
+        name_offset += len(encoded)
+        padding = align(len(content)) - len(content)
+        data += content + b'\0' * padding
+        offset += len(content) + padding
+
+    header = MAGIC + struct.pack('<III', VERSION, len(entries), len(names))
+    index = header + table + names
+    index += b'\0' * (align(len(index)) - len(index))
+    path = os.path.join(output_dir, 'Assets_%s.pak' % resolution)
+    with open(path, 'wb') as f:
+        f.write(index + data)
+
+    print('%s: %d files, %d bytes' % (path, len(entries), len(index) + len(data)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='アセットアーカイブを作成する')
+    parser.add_argument('--output-dir', required=True, help='アーカイブの出力先のディレクトリ')
+    args = parser.parse_args()
+
+    output_dir = os.path.abspath(args.output_dir)
+    if output_dir == RESOURCES_DIR:
+        parser.error('Resourcesには出力しない(古いアーカイブが変更後のリソースを隠すため)')
+    if not os.path.isdir(output_dir):
+        os.makedirs(output_dir)
+
+    for resolution in RESOLUTIONS:
+        write_archive(resolution, output_dir)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
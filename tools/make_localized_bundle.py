@@ -0,0 +1,196 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+#
+# Copyright (c) 2015 Akihiro Kaneda.
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+#   1.Redistributions of source code must retain the above copyright notice,
+#     this list of conditions and the following disclaimer.
+#   2.Redistributions in binary form must reproduce the above copyright notice,
+#     this list of conditions and the following disclaimer in the documentation
+#     and/or other materials provided with the distribution.
+#   3.Neither the name of the Monochrome Soft nor the names of its contributors
+#     may be used to endorse or promote products derived from this software
+#     without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+"""ローカライズ文字列バンドル作成ツール
+
+Resources/text/Localized_{en,ja,zh,ko}の文字列ファイルを読み込み、
+キーを整数IDに置き換えたバイナリテーブル(Localized_{言語}.bin)と、
+キーIDを定義したヘッダファイル(Classes/AKLibrary/LocalizedKey.h)を作成する。
+文字列ファイルを変更した場合はこのツールを再実行すること。
+
+使い方:
+    python3 tools/make_localized_bundle.py
+
+バイナリテーブルの形式(数値はすべてリトルエンディアン):
+    char[4]  マジックナンバー "AKLB"
+    uint32   バージョン
+    uint32   文字列数(キーIDの数)
+    uint32[] 各文字列の文字列領域先頭からのオフセット(キーIDの順)
+    char[]   文字列領域(UTF-8、終端文字付き)
+"""
+
+import os
+import re
+import struct
+import sys
+
+# リポジトリのルートディレクトリ
+ROOT_DIR = os.path.abspath(os.path.join(os.path.dirname(__file__), '..'))
+
+# 文字列ファイルのディレクトリ
+TEXT_DIR = os.path.join(ROOT_DIR, 'Resources', 'text')
+
+# キーIDヘッダファイル
+HEADER_PATH = os.path.join(ROOT_DIR, 'Classes', 'AKLibrary', 'LocalizedKey.h')
+
+# 言語コード(先頭の言語のキーの並び順をキーIDの順とする)
+LANGUAGES = ['en', 'ja', 'zh', 'ko']
+
+# マジックナンバー
+MAGIC = b'AKLB'
+
+# バージョン(LocalizedResource.cppのBUNDLE_VERSIONと合わせる)
+VERSION = 1
+
+# キーIDの定数名に使用できない文字
+INVALID_NAME_CHARACTER = re.compile(r'[^0-9A-Za-z_]')
+
+# ヘッダファイルのコメントの開始桁
+COMMENT_COLUMN = 40
+
+# 連番のキー
+NUMBERED_KEY = re.compile(r'^(.*_)(\d+)$')
+
+
+def read_strings(language):
+    """文字列ファイルを読み込み、キーと文字列の組を出現順に返す。
+
+    LocalizedResourceの旧実装(readStringData)と同じ規則で解析する。
+    同じキーが複数ある場合は最初のものを使用する。
+    """
+    path = os.path.join(TEXT_DIR, 'Localized_' + language)
+    strings = []
+    keys = set()
+    with open(path, encoding='utf-8') as f:
+        for line in f.read().split('\n'):
+            if line.startswith('//'):
+                continue
+            sep = line.find('=')
+            if sep < 0:
+                continue
+            key = line[:sep - 1].strip(' "')
+            value = line[sep + 1:].lstrip(' "').rstrip(' ";')
+            if key in keys:
+                continue
+            keys.add(key)
+            strings.append((key, value))
+    return strings
+
+
+def check_numbered_keys(keys):
+    """連番のキーが番号順に連続して並んでいることを確認する。
+
+    呼び出し側で先頭のキーIDに番号を足して使用できるようにするため。
+    """
+    for index, key in enumerate(keys):
+        match = NUMBERED_KEY.match(key)
+        if match is None or int(match.group(2)) <= 1:
+            continue
+        previous = '%s%d' % (match.group(1), int(match.group(2)) - 1)
+        if previous in keys and keys[index - 1] != previous:
+            raise ValueError('連番のキーが連続していない: %s' % key)
+
+
+def write_bundle(language, keys, strings):
+    """バイナリテーブルを出力する。"""
+    values = dict(strings)
+    missing = [key for key in keys if key not in values]
+    extra = [key for key in values if key not in keys]
+    if missing or extra:
+        raise ValueError('キーが一致しない(%s): 不足=%s 余分=%s' % (language, missing, extra))
+
+    offsets = []
+    data = b''
+    for key in keys:
+        offsets.append(len(data))
+        data += values[key].encode('utf-8') + b'\0'
+
+    header = MAGIC + struct.pack('<II', VERSION, len(keys))
+    table = struct.pack('<%dI' % len(keys), *offsets)
+    path = os.path.join(TEXT_DIR, 'Localized_%s.bin' % language)
+    with open(path, 'wb') as f:
+        f.write(header + table + data)
+
+    print('%s: %d strings, %d bytes' % (os.path.relpath(path, ROOT_DIR), len(keys),
+                                        len(header) + len(table) + len(data)))
+
+
+def write_header(keys):
+    """キーIDヘッダファイルを出力する。"""
+    license_lines = []
+    with open(os.path.join(ROOT_DIR, 'Classes', 'AKLibrary', 'LocalizedResource.h'), encoding='utf-8') as f:
+        for line in f:
+            license_lines.append(line)
+            if line.startswith(' */'):
+                break
+
+    lines = [''.join(license_lines).rstrip('\n'),
+             '/*!',
+             ' @file LocalizedKey.h',
+             ' @brief ローカライズ文字列キーID定義',
+             ' ',
+             ' ローカライズ文字列のキーIDを定義する。',
+             ' このファイルはtools/make_localized_bundle.pyで自動生成するため、直接編集しないこと。',
+             ' */',
+             '',
+             '#ifndef LOCALIZEDKEY_H',
+             '#define LOCALIZEDKEY_H',
+             '',
+             'namespace aklib {',
+             '    ',
+             '    /// ローカライズ文字列のキーID(連番のキーは番号順に連続する)',
+             '    enum LocalizedKey {']
+    for index, key in enumerate(keys):
+        name = 'kAKLocalized' + INVALID_NAME_CHARACTER.sub('_', key)
+        entry = '%s = %d,' % (name, index)
+        lines.append('        %s ///< "%s"' % (entry.ljust(COMMENT_COLUMN), key))
+    lines += ['        %s ///< キーIDの数' % 'kAKLocalizedKeyCount'.ljust(COMMENT_COLUMN),
+              '    };',
+              '}',
+              '',
+              '#endif',
+              '']
+    with open(HEADER_PATH, 'w', encoding='utf-8') as f:
+        f.write('\n'.join(lines))
+
+    print('%s: %d keys' % (os.path.relpath(HEADER_PATH, ROOT_DIR), len(keys)))
+
+
+def main():
+    keys = [key for key, value in read_strings(LANGUAGES[0])]
+    check_numbered_keys(keys)
+    for language in LANGUAGES:
+        write_bundle(language, keys, read_strings(language))
+    write_header(keys)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())